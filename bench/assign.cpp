@@ -0,0 +1,217 @@
+// Measures assignments that replace one alternative of a 'Result' with the
+// other, with and without a 'tim::traits::nothrow_assign_hint' for the
+// payload types.  Each benchmark runs over arrays of 1024 elements whose
+// alternatives all differ from those of the source array:
+//
+//  - copy_value: copying 'Result's that hold a value over ones that hold an
+//    error.
+//  - copy_error: the other way round.
+//  - move_error: moving 'Result's that hold an error over ones that hold a
+//    value.
+//  - emplace: 'emplace()'ing a copy of a value into 'Result's that hold an
+//    error.
+//
+// The payload owns a heap buffer, so copying one allocates, and its copy
+// constructor is not 'noexcept'.  Refilling the arrays before each run is not
+// timed.  Besides the time per element, the
+// allocations ('tests/support/count_new.h') and payload copies and moves per
+// element are printed.  'tests/support/tracked_value.h' asserts that no
+// payload is used after it was moved from or destroyed.
+
+#include "bench.hpp"
+#include "tim/result/Result.hpp"
+
+#include "support/count_new.h"
+#include "support/tracked_value.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t elements = 1024;
+
+struct Constructions {
+	long copies = 0;
+	long moves = 0;
+};
+
+Constructions constructions;
+
+template <bool Hinted>
+struct Payload {
+	explicit Payload(std::int64_t v):
+		bytes(32, v)
+	{
+
+	}
+
+	Payload(const Payload& other) noexcept(false):
+		bytes(other.bytes), tracked(other.tracked)
+	{
+		++constructions.copies;
+	}
+
+	Payload(Payload&& other) noexcept:
+		bytes(std::move(other.bytes)), tracked(std::move(other.tracked))
+	{
+		++constructions.moves;
+	}
+
+	Payload& operator=(const Payload&) = default;
+	Payload& operator=(Payload&&) = default;
+
+	std::vector<std::int64_t> bytes;
+	TrackedValue tracked;
+};
+
+} /* namespace */
+
+template <>
+struct tim::traits::nothrow_assign_hint<Payload<true>>: std::true_type {};
+
+namespace {
+
+struct CounterRow {
+	std::string name;
+	double allocations;
+	double copies;
+	double moves;
+};
+
+class Suite {
+public:
+	explicit Suite(bench::Arguments args):
+		args_(std::move(args))
+	{
+
+	}
+
+	// Times 'fn()', which performs 'elements' operations, after calling
+	// 'setup()' outside of the timed region.  Reports the best time per
+	// operation over five batches of 20ms.
+	template <class Setup, class F>
+	void add(const std::string& name, Setup setup, F fn) {
+		if(!bench::selected(args_, name)) {
+			return;
+		}
+		using clock = std::chrono::steady_clock;
+		double best = 0.0;
+		std::size_t calls = 0;
+		for(int batch = 0; batch < 5; ++batch) {
+			clock::duration elapsed{};
+			std::size_t n = 0;
+			while(elapsed < std::chrono::milliseconds(20)) {
+				setup();
+				bench::clobber_memory();
+				auto start = clock::now();
+				fn();
+				bench::clobber_memory();
+				elapsed += clock::now() - start;
+				++n;
+			}
+			double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count())
+				/ static_cast<double>(n * elements);
+			if(batch == 0 || ns < best) {
+				best = ns;
+			}
+			calls += n;
+		}
+		results_.push_back(bench::Measurement{name, calls * elements, best});
+		setup();
+		globalMemCounter.reset();
+		constructions = Constructions{};
+		fn();
+		auto per_element = [](long n) { return static_cast<double>(n) / elements; };
+		rows_.push_back(CounterRow{
+			name,
+			per_element(globalMemCounter.new_called),
+			per_element(constructions.copies),
+			per_element(constructions.moves)
+		});
+	}
+
+	int report() const {
+		int status = bench::report(args_, results_);
+		if(args_.json == "-") {
+			return status;
+		}
+		std::size_t width = 0;
+		for(const auto& row: rows_) {
+			width = std::max(width, row.name.size());
+		}
+		std::printf("\n%-*s %12s %12s %12s\n", static_cast<int>(width), "per element",
+			"allocations", "copies", "moves");
+		for(const auto& row: rows_) {
+			std::printf("%-*s %12.2f %12.2f %12.2f\n", static_cast<int>(width), row.name.c_str(),
+				row.allocations, row.copies, row.moves);
+		}
+		return status;
+	}
+
+private:
+	bench::Arguments args_;
+	std::vector<bench::Measurement> results_;
+	std::vector<CounterRow> rows_;
+};
+
+template <bool Hinted>
+void benchmarks(Suite& suite, const std::string& suffix) {
+	using P = Payload<Hinted>;
+	using R = tim::Result<P, P>;
+	const std::vector<R> values(elements, R(tim::in_place, 1));
+	const std::vector<R> errors(elements, R(tim::in_place_error, 2));
+	std::vector<R> rs;
+	// Refills 'rs' by copy construction, keeping its capacity, so that the
+	// cost does not depend on what 'rs' held before.
+	auto reset_to = [&](const std::vector<R>& source) {
+		return [&rs, &source] {
+			rs.clear();
+			rs.insert(rs.end(), source.begin(), source.end());
+		};
+	};
+	suite.add("copy_value" + suffix, reset_to(errors), [&] {
+		for(std::size_t i = 0; i < elements; ++i) {
+			rs[i] = values[i];
+		}
+		bench::do_not_optimize(rs.data());
+	});
+	suite.add("copy_error" + suffix, reset_to(values), [&] {
+		for(std::size_t i = 0; i < elements; ++i) {
+			rs[i] = errors[i];
+		}
+		bench::do_not_optimize(rs.data());
+	});
+	std::vector<R> sources;
+	suite.add("move_error" + suffix, [&] {
+		reset_to(values)();
+		sources.clear();
+		sources.insert(sources.end(), errors.begin(), errors.end());
+	}, [&] {
+		for(std::size_t i = 0; i < elements; ++i) {
+			rs[i] = std::move(sources[i]);
+		}
+		bench::do_not_optimize(rs.data());
+	});
+	const P payload(3);
+	suite.add("emplace" + suffix, reset_to(errors), [&] {
+		for(std::size_t i = 0; i < elements; ++i) {
+			rs[i].emplace(payload);
+		}
+		bench::do_not_optimize(rs.data());
+	});
+}
+
+} /* namespace */
+
+int main(int argc, char** argv) {
+	Suite suite(bench::parse_arguments(argc, argv));
+	benchmarks<false>(suite, "/no_hint");
+	benchmarks<true>(suite, "/hint");
+	return suite.report();
+}
@@ -0,0 +1,184 @@
+#ifndef TIM_RESULT_BENCH_HPP
+#define TIM_RESULT_BENCH_HPP
+
+// A minimal timing harness for the result-cpp benchmarks.
+//
+// 'bench::measure(name, fn)' calls 'fn()' repeatedly, growing the batch size
+// until one batch takes at least 'min_batch_time', and reports the best time
+// per call over 'repetitions' batches.  Use 'bench::do_not_optimize()' on the
+// results of the code under test so that it is not optimized away.
+//
+// 'bench::report(arguments, results)' prints a table and, given '--json FILE'
+// on the command line ('-' for stdout), writes the results as JSON too:
+//
+//   {"context": {...}, "benchmarks": [{"name": ..., "iterations": ...,
+//    "ns_per_op": ...}, ...]}
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+template <class T>
+inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "r,m"(value) : "memory");
+#else
+	static volatile const void* sink;
+	sink = &value;
+#endif
+}
+
+inline void clobber_memory() {
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : : "memory");
+#endif
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+# define BENCH_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+# define BENCH_NOINLINE __declspec(noinline)
+#else
+# define BENCH_NOINLINE
+#endif
+
+struct Measurement {
+	std::string name;
+	std::size_t iterations;
+	double ns_per_iteration;
+};
+
+struct Options {
+	std::chrono::nanoseconds min_batch_time = std::chrono::milliseconds(50);
+	int repetitions = 5;
+	// Operations performed by one call; times are reported per operation.
+	std::size_t operations = 1;
+};
+
+template <class F>
+Measurement measure(std::string name, F&& fn, Options options = Options{}) {
+	using clock = std::chrono::steady_clock;
+	auto run_batch = [&](std::size_t n) {
+		auto start = clock::now();
+		for(std::size_t i = 0; i < n; ++i) {
+			fn();
+			clobber_memory();
+		}
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start);
+	};
+	std::size_t n = 1;
+	auto elapsed = run_batch(n);
+	while(elapsed < options.min_batch_time) {
+		n *= 2;
+		elapsed = run_batch(n);
+	}
+	double ops = static_cast<double>(n) * static_cast<double>(options.operations);
+	double best = static_cast<double>(elapsed.count()) / ops;
+	for(int i = 1; i < options.repetitions; ++i) {
+		best = std::min(best, static_cast<double>(run_batch(n).count()) / ops);
+	}
+	return Measurement{std::move(name), n * options.operations, best};
+}
+
+inline void print(const std::vector<Measurement>& results) {
+	std::size_t width = 0;
+	for(const auto& m: results) {
+		width = std::max(width, m.name.size());
+	}
+	for(const auto& m: results) {
+		std::printf("%-*s %12.2f ns/op  (%zu iterations)\n",
+			static_cast<int>(width), m.name.c_str(), m.ns_per_iteration, m.iterations);
+	}
+}
+
+struct Arguments {
+	// Only benchmarks whose name contains 'filter' are run.
+	std::string filter;
+	// Where to write JSON results; empty for none, "-" for stdout.
+	std::string json;
+};
+
+inline Arguments parse_arguments(int argc, char** argv) {
+	Arguments args;
+	for(int i = 1; i < argc; ++i) {
+		if(std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+			args.json = argv[++i];
+		} else if(std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+			args.filter = argv[++i];
+		} else {
+			std::fprintf(stderr, "usage: %s [--filter SUBSTRING] [--json FILE]\n", argv[0]);
+			std::exit(2);
+		}
+	}
+	return args;
+}
+
+inline bool selected(const Arguments& args, const std::string& name) {
+	return name.find(args.filter) != std::string::npos;
+}
+
+inline void write_json_string(std::FILE* out, const std::string& s) {
+	std::fputc('"', out);
+	for(char c: s) {
+		if(c == '"' || c == '\\') {
+			std::fputc('\\', out);
+		}
+		std::fputc(c, out);
+	}
+	std::fputc('"', out);
+}
+
+inline void write_json(std::FILE* out, const std::vector<Measurement>& results) {
+	std::fprintf(out, "{\n  \"context\": {\n    \"compiler\": ");
+#if defined(__clang__)
+	write_json_string(out, std::string("clang ") + __clang_version__);
+#elif defined(__GNUC__)
+	write_json_string(out, std::string("gcc ") + __VERSION__);
+#elif defined(_MSC_VER)
+	write_json_string(out, "msvc " + std::to_string(_MSC_VER));
+#else
+	write_json_string(out, "unknown");
+#endif
+	std::fprintf(out, ",\n    \"cplusplus\": %ld,\n", static_cast<long>(__cplusplus));
+#if defined(NDEBUG)
+	std::fprintf(out, "    \"ndebug\": true\n  },\n");
+#else
+	std::fprintf(out, "    \"ndebug\": false\n  },\n");
+#endif
+	std::fprintf(out, "  \"benchmarks\": [");
+	for(std::size_t i = 0; i < results.size(); ++i) {
+		std::fprintf(out, "%s\n    {\"name\": ", i ? "," : "");
+		write_json_string(out, results[i].name);
+		std::fprintf(out, ", \"iterations\": %zu, \"ns_per_op\": %.4f}",
+			results[i].iterations, results[i].ns_per_iteration);
+	}
+	std::fprintf(out, "\n  ]\n}\n");
+}
+
+inline int report(const Arguments& args, const std::vector<Measurement>& results) {
+	if(args.json == "-") {
+		write_json(stdout, results);
+		return 0;
+	}
+	print(results);
+	if(!args.json.empty()) {
+		std::FILE* out = std::fopen(args.json.c_str(), "w");
+		if(!out) {
+			std::fprintf(stderr, "cannot open '%s'\n", args.json.c_str());
+			return 1;
+		}
+		write_json(out, results);
+		std::fclose(out);
+	}
+	return 0;
+}
+
+} /* namespace bench */
+
+#endif /* TIM_RESULT_BENCH_HPP */
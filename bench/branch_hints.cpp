@@ -0,0 +1,296 @@
+// Measures the effect of the 'TIM_RESULT_EXPECT' branch layout policy on code
+// that mostly sees values.  The build compiles this file once per policy
+// (bench_branch_hints_none, _success and _failure); compare their output.
+//
+// Each benchmark runs over arrays of 4096 inputs at error rates of 0%, 0.1%
+// and 1%, with the failing elements scattered at random:
+//
+//  - chain: a non-inlined producer's 'Result' goes through 'and_then()',
+//    'map()' and 'value_or()'.
+//  - propagate: 'TIM_TRY_ASSIGN' through four non-inlined callers.
+//  - copy_assign: assigning 'Result<std::string, std::string>' elements
+//    that mostly hold values.
+//
+// Besides the time per element, where the kernel lets this process use
+// hardware performance counters (Linux 'perf_event_open'), the instructions,
+// branch misses and L1 instruction cache misses per element are printed.
+// '-' means the counter is unavailable (e.g. 'perf_event_paranoid' is too
+// high, or the code runs in a virtual machine without a PMU).
+
+#include "bench.hpp"
+#include "tim/result/Result.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__) && __has_include(<linux/perf_event.h>)
+# include <linux/perf_event.h>
+# include <sys/ioctl.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+# define BENCH_HAS_PERF_EVENTS 1
+#else
+# define BENCH_HAS_PERF_EVENTS 0
+#endif
+
+namespace {
+
+constexpr std::size_t elements = 4096;
+
+const char* policy_name() {
+	switch(TIM_RESULT_EXPECT) {
+	case tim::Expectation::success:
+		return "success";
+	case tim::Expectation::failure:
+		return "failure";
+	default:
+		return "none";
+	}
+}
+
+// 'fails[i]' is true for 'rate * elements' randomly chosen elements.
+std::vector<bool> make_pattern(double rate, std::uint32_t seed) {
+	std::vector<bool> fails(elements, false);
+	auto errors = static_cast<std::size_t>(rate * static_cast<double>(elements) + 0.5);
+	std::fill(fails.begin(), fails.begin() + static_cast<std::ptrdiff_t>(errors), true);
+	std::shuffle(fails.begin(), fails.end(), std::mt19937(seed));
+	return fails;
+}
+
+// Counts instructions, branch misses and L1 instruction cache misses of this
+// thread between 'start()' and 'stop()'.
+class Counters {
+public:
+	static constexpr int count = 3;
+
+	Counters() {
+#if BENCH_HAS_PERF_EVENTS
+		const std::uint64_t configs[count][2] = {
+			{PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+			{PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+			{PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1I
+				| (PERF_COUNT_HW_CACHE_OP_READ << 8)
+				| (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)}
+		};
+		for(int i = 0; i < count; ++i) {
+			perf_event_attr attr{};
+			attr.size = sizeof(attr);
+			attr.type = static_cast<std::uint32_t>(configs[i][0]);
+			attr.config = configs[i][1];
+			attr.disabled = 1;
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+			fds_[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+		}
+#endif
+	}
+
+	Counters(const Counters&) = delete;
+	Counters& operator=(const Counters&) = delete;
+
+	~Counters() {
+#if BENCH_HAS_PERF_EVENTS
+		for(int fd: fds_) {
+			if(fd >= 0) {
+				close(fd);
+			}
+		}
+#endif
+	}
+
+	void start() {
+#if BENCH_HAS_PERF_EVENTS
+		for(int fd: fds_) {
+			if(fd >= 0) {
+				ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+				ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+			}
+		}
+#endif
+	}
+
+	// Stops counting and stores each counter in 'values', or -1 for those that
+	// are unavailable.
+	void stop(long long (&values)[count]) {
+		for(int i = 0; i < count; ++i) {
+			values[i] = -1;
+#if BENCH_HAS_PERF_EVENTS
+			long long value = 0;
+			if(fds_[i] >= 0) {
+				ioctl(fds_[i], PERF_EVENT_IOC_DISABLE, 0);
+				if(read(fds_[i], &value, sizeof(value)) == static_cast<ssize_t>(sizeof(value))) {
+					values[i] = value;
+				}
+			}
+#endif
+		}
+	}
+
+private:
+	int fds_[count] = {-1, -1, -1};
+};
+
+struct CounterRow {
+	std::string name;
+	double per_op[Counters::count];
+};
+
+using R = tim::Result<std::int64_t, int>;
+
+BENCH_NOINLINE R produce(bool fail, std::int64_t i) {
+	if(fail) {
+		return R(tim::in_place_error, static_cast<int>(i));
+	}
+	return R(tim::in_place, i);
+}
+
+BENCH_NOINLINE R validate(std::int64_t v) {
+	if(v < 0) {
+		return R(tim::in_place_error, -1);
+	}
+	return R(tim::in_place, v);
+}
+
+template <int Depth>
+BENCH_NOINLINE R propagate(bool fail, std::int64_t i) {
+	if constexpr(Depth == 0) {
+		return produce(fail, i);
+	} else {
+		TIM_TRY_ASSIGN(auto v, propagate<Depth - 1>(fail, i));
+		return R(tim::in_place, v + 1);
+	}
+}
+
+using S = tim::Result<std::string, std::string>;
+
+std::vector<S> make_strings(const std::vector<bool>& fails, const char* prefix) {
+	std::vector<S> rs;
+	rs.reserve(elements);
+	for(std::size_t i = 0; i < elements; ++i) {
+		// Short enough for the small string optimization.
+		std::string s = prefix + std::to_string(i % 1000u);
+		if(fails[i]) {
+			rs.emplace_back(tim::in_place_error, std::move(s));
+		} else {
+			rs.emplace_back(tim::in_place, std::move(s));
+		}
+	}
+	return rs;
+}
+
+class Suite {
+public:
+	explicit Suite(bench::Arguments args):
+		args_(std::move(args))
+	{
+		options_.min_batch_time = std::chrono::milliseconds(20);
+		options_.repetitions = 5;
+		options_.operations = elements;
+	}
+
+	template <class F>
+	void add(const std::string& name, F fn) {
+		if(!bench::selected(args_, name)) {
+			return;
+		}
+		results_.push_back(bench::measure(name, fn, options_));
+		// Warm up, then count over enough calls to drown the noise of
+		// starting and stopping the counters.
+		constexpr int calls = 64;
+		fn();
+		long long values[Counters::count];
+		counters_.start();
+		for(int i = 0; i < calls; ++i) {
+			fn();
+			bench::clobber_memory();
+		}
+		counters_.stop(values);
+		CounterRow row{name, {}};
+		for(int i = 0; i < Counters::count; ++i) {
+			row.per_op[i] = values[i] < 0 ? -1.0 : static_cast<double>(values[i]) / (calls * static_cast<double>(elements));
+		}
+		rows_.push_back(std::move(row));
+	}
+
+	int report() const {
+		int status = bench::report(args_, results_);
+		if(args_.json == "-") {
+			return status;
+		}
+		std::size_t width = 0;
+		for(const auto& row: rows_) {
+			width = std::max(width, row.name.size());
+		}
+		std::printf("\n%-*s %14s %14s %14s\n", static_cast<int>(width), "per element",
+			"instructions", "branch-misses", "L1I-misses");
+		for(const auto& row: rows_) {
+			std::printf("%-*s", static_cast<int>(width), row.name.c_str());
+			for(double value: row.per_op) {
+				if(value < 0) {
+					std::printf(" %14s", "-");
+				} else {
+					std::printf(" %14.4f", value);
+				}
+			}
+			std::printf("\n");
+		}
+		return status;
+	}
+
+private:
+	bench::Arguments args_;
+	bench::Options options_;
+	Counters counters_;
+	std::vector<bench::Measurement> results_;
+	std::vector<CounterRow> rows_;
+};
+
+void benchmarks(Suite& suite, const std::vector<bool>& fails, const std::string& rate) {
+	const std::string suffix = std::string("/") + policy_name() + "/" + rate;
+	suite.add("chain" + suffix, [&] {
+		std::int64_t sum = 0;
+		for(std::size_t i = 0; i < elements; ++i) {
+			sum += produce(fails[i], static_cast<std::int64_t>(i))
+				.and_then(validate)
+				.map([](std::int64_t v) { return v * 3; })
+				.value_or(-1);
+		}
+		bench::do_not_optimize(sum);
+	});
+	suite.add("propagate" + suffix, [&] {
+		std::int64_t sum = 0;
+		for(std::size_t i = 0; i < elements; ++i) {
+			R r = propagate<4>(fails[i], static_cast<std::int64_t>(i));
+			sum += r.has_value() ? *r : -1;
+		}
+		bench::do_not_optimize(sum);
+	});
+	auto a = make_strings(fails, "a");
+	auto b = make_strings(std::vector<bool>(fails.rbegin(), fails.rend()), "b");
+	suite.add("copy_assign" + suffix, [a, b]() mutable {
+		for(std::size_t i = 0; i < elements; ++i) {
+			a[i] = b[i];
+		}
+		bench::do_not_optimize(a.data());
+	});
+}
+
+} /* namespace */
+
+int main(int argc, char** argv) {
+	Suite suite(bench::parse_arguments(argc, argv));
+	const std::pair<double, const char*> rates[] = {
+		{0.0, "0%"},
+		{0.001, "0.1%"},
+		{0.01, "1%"}
+	};
+	for(const auto& [rate, label]: rates) {
+		benchmarks(suite, make_pattern(rate, 12345u), label);
+	}
+	return suite.report();
+}
@@ -0,0 +1,79 @@
+// Compares 'tim::collect' with the loop it replaces: check 'has_value()' and
+// 'push_back' each element.  Runs over 100k records that all succeed, and over
+// records whose middle element fails.
+
+#include "bench.hpp"
+#include "tim/result/collect.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+struct Record {
+	std::int64_t id;
+	double x;
+	double y;
+};
+
+struct ParseError {
+	std::int64_t line;
+};
+
+using RecordResult = tim::Result<Record, ParseError>;
+
+constexpr std::size_t records = 100000;
+
+std::vector<RecordResult> make_records(bool fail_middle) {
+	std::vector<RecordResult> rs;
+	rs.reserve(records);
+	for(std::size_t i = 0; i < records; ++i) {
+		auto id = static_cast<std::int64_t>(i);
+		if(fail_middle && i == records / 2) {
+			rs.emplace_back(tim::in_place_error, ParseError{id});
+		} else {
+			rs.emplace_back(tim::in_place, Record{id, 0.5 * static_cast<double>(i), 2.0});
+		}
+	}
+	return rs;
+}
+
+tim::Result<std::vector<Record>, ParseError> hand_loop(const std::vector<RecordResult>& rs) {
+	std::vector<Record> out;
+	for(const auto& r: rs) {
+		if(!r.has_value()) {
+			return tim::Error(r.error());
+		}
+		out.push_back(*r);
+	}
+	return out;
+}
+
+tim::Result<std::vector<Record>, ParseError> hand_loop_reserved(const std::vector<RecordResult>& rs) {
+	std::vector<Record> out;
+	out.reserve(rs.size());
+	for(const auto& r: rs) {
+		if(!r.has_value()) {
+			return tim::Error(r.error());
+		}
+		out.push_back(*r);
+	}
+	return out;
+}
+
+} /* namespace */
+
+int main() {
+	const auto ok = make_records(false);
+	const auto bad = make_records(true);
+	bench::Options options;
+	options.operations = records;
+	bench::print({
+		bench::measure("hand_loop/success", [&] { bench::do_not_optimize(hand_loop(ok)); }, options),
+		bench::measure("hand_loop_reserved/success", [&] { bench::do_not_optimize(hand_loop_reserved(ok)); }, options),
+		bench::measure("collect/success", [&] { bench::do_not_optimize(tim::collect(ok)); }, options),
+		bench::measure("hand_loop/error", [&] { bench::do_not_optimize(hand_loop(bad)); }, options),
+		bench::measure("collect/error", [&] { bench::do_not_optimize(tim::collect(bad)); }, options),
+		bench::measure("collect(all_errors)/error", [&] { bench::do_not_optimize(tim::collect(tim::all_errors, bad)); }, options)
+	});
+}
@@ -0,0 +1,52 @@
+// A translation unit that uses 'Result' the way client code does.  Compiled by
+// 'inclusion.cmake' with 'Result.hpp' included textually, from a precompiled
+// header and, with RESULT_USE_MODULE defined, by importing 'tim.result'.
+
+#ifdef RESULT_USE_MODULE
+# if defined(__GNUC__) && !defined(__clang__)
+// GCC 12 does not make placement new, which 'Result' uses in its templates,
+// reachable from the global module fragment of 'tim.result'.
+#  include <new>
+# endif
+import tim.result;
+#else
+# include "tim/result/Result.hpp"
+#endif
+
+namespace {
+
+enum class Errc { negative, odd, too_large };
+
+[[gnu::noinline]] tim::Result<int, Errc> parse(int x) {
+	if(x < 0) {
+		return tim::make_error(Errc::negative);
+	}
+	return x;
+}
+
+[[gnu::noinline]] tim::Result<void, Errc> check_even(int x) {
+	if(x % 2 != 0) {
+		return tim::make_error(Errc::odd);
+	}
+	return tim::Result<void, Errc>(tim::in_place);
+}
+
+tim::Result<long, Errc> widen(int x) {
+	if(x > 1000) {
+		return tim::make_error(Errc::too_large);
+	}
+	return static_cast<long>(x) * 2;
+}
+
+} /* namespace */
+
+int consume(int x) {
+	tim::Result<long, Errc> r = parse(x).and_then(widen).map([](long v) { return v + 1; });
+	tim::Result<void, Errc> even = check_even(x);
+	tim::Result<long, Errc> s(r);
+	swap(r, s);
+	if(!even) {
+		return static_cast<int>(even.error());
+	}
+	return static_cast<int>(r.value_or(-1L));
+}
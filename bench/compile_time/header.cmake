@@ -0,0 +1,61 @@
+# Measures what 'Result.hpp' costs every translation unit that includes it:
+# the time (best of RUNS) and, for GCC, the memory to parse 'header.cpp', and
+# the size of the object file built from 'void_results.cpp' at -O0 and -O2.
+#
+# Invoked by the 'result-compile-bench' target as
+#   cmake -DCOMPILER=... -DCOMPILER_ID=... -DINCLUDE_DIR=... -DSOURCE_DIR=...
+#         -DOUTPUT_DIR=... [-DCXXSTD=17] [-DRUNS=5] -P header.cmake
+
+if(NOT CXXSTD)
+	set(CXXSTD 17)
+endif()
+if(NOT RUNS)
+	set(RUNS 5)
+endif()
+
+set(time_report)
+if(COMPILER_ID STREQUAL "GNU")
+	set(time_report -ftime-report)
+endif()
+
+file(MAKE_DIRECTORY ${OUTPUT_DIR})
+
+set(best)
+set(memory "-")
+foreach(run RANGE 1 ${RUNS})
+	string(TIMESTAMP start "%s%f" UTC)
+	execute_process(
+		COMMAND ${COMPILER} -std=c++${CXXSTD} -fsyntax-only ${time_report}
+			-I${INCLUDE_DIR} ${SOURCE_DIR}/header.cpp
+		RESULT_VARIABLE status
+		OUTPUT_VARIABLE output
+		ERROR_VARIABLE output)
+	string(TIMESTAMP stop "%s%f" UTC)
+	if(NOT status EQUAL 0)
+		message(FATAL_ERROR "header.cpp failed to compile:\n${output}")
+	endif()
+	math(EXPR micros "${stop} - ${start}")
+	if(NOT best OR micros LESS best)
+		set(best ${micros})
+	endif()
+	if(output MATCHES "TOTAL[ \t]*:[^\n]*[ \t]([0-9]+[kMG])")
+		set(memory ${CMAKE_MATCH_1})
+	endif()
+endforeach()
+math(EXPR best_millis "${best} / 1000")
+message("parse Result.hpp:          ${best_millis} ms, ${memory}")
+
+foreach(opt IN ITEMS -O0 -O2)
+	set(object ${OUTPUT_DIR}/void_results${opt}.o)
+	execute_process(
+		COMMAND ${COMPILER} -std=c++${CXXSTD} ${opt} -c -I${INCLUDE_DIR}
+			${SOURCE_DIR}/void_results.cpp -o ${object}
+		RESULT_VARIABLE status
+		OUTPUT_VARIABLE output
+		ERROR_VARIABLE output)
+	if(NOT status EQUAL 0)
+		message(FATAL_ERROR "void_results.cpp failed to compile:\n${output}")
+	endif()
+	file(SIZE ${object} size)
+	message("void_results.cpp ${opt} object: ${size} bytes")
+endforeach()
@@ -0,0 +1,4 @@
+// Includes 'Result.hpp' and nothing else.  Compiled by 'header.cmake' to
+// measure what parsing the header costs every translation unit.
+
+#include "tim/result/Result.hpp"
@@ -0,0 +1,124 @@
+# Compares the ways a translation unit can get at 'Result': including
+# 'Result.hpp' textually, including it from a precompiled header, and (for
+# C++20 and later) importing the 'tim.result' module.  For each it prints the
+# one-time cost of building the precompiled header or the module and the time
+# (best of RUNS) and, for GCC, the memory to compile 'consumer.cpp' to an
+# object file.  The module is only built for GCC and Clang.
+#
+# Invoked by the 'result-compile-bench' target as
+#   cmake -DCOMPILER=... -DCOMPILER_ID=... -DINCLUDE_DIR=... -DSOURCE_DIR=...
+#         -DMODULE_SOURCE=... -DOUTPUT_DIR=... [-DCXXSTD=20] [-DRUNS=5]
+#         -P inclusion.cmake
+
+if(NOT CXXSTD)
+	set(CXXSTD 20)
+endif()
+if(NOT RUNS)
+	set(RUNS 5)
+endif()
+
+set(report)
+if(COMPILER_ID STREQUAL "GNU")
+	set(report -ftime-report)
+endif()
+
+# Left-aligns 'text' in a column 'width' characters wide.
+function(pad text width out)
+	string(LENGTH "${text}" len)
+	while(len LESS width)
+		string(APPEND text " ")
+		math(EXPR len "${len} + 1")
+	endwhile()
+	set(${out} "${text}" PARENT_SCOPE)
+endfunction()
+
+# Runs the compiler with the remaining arguments in 'dir' and sets 'out_ms' to
+# the wall time in milliseconds and 'out_memory' to the memory GCC reports.
+function(compile what dir out_ms out_memory)
+	string(TIMESTAMP start "%s%f" UTC)
+	execute_process(
+		COMMAND ${COMPILER} -std=c++${CXXSTD} ${ARGN}
+		WORKING_DIRECTORY ${dir}
+		RESULT_VARIABLE status
+		OUTPUT_VARIABLE output
+		ERROR_VARIABLE output)
+	string(TIMESTAMP stop "%s%f" UTC)
+	if(NOT status EQUAL 0)
+		message(FATAL_ERROR "${what} failed to compile:\n${output}")
+	endif()
+	math(EXPR millis "(${stop} - ${start}) / 1000")
+	set(memory "-")
+	if(output MATCHES "TOTAL[ \t]*:[^\n]*[ \t]([0-9]+[kMG])")
+		set(memory ${CMAKE_MATCH_1})
+	endif()
+	set(${out_ms} ${millis} PARENT_SCOPE)
+	set(${out_memory} ${memory} PARENT_SCOPE)
+endfunction()
+
+# Compiles 'consumer.cpp' RUNS times with the remaining arguments and prints a
+# row of the table.  The memory comes from one more run with 'report', since
+# -ftime-report slows the compiler down.
+function(measure config setup_ms dir)
+	set(best)
+	foreach(run RANGE 1 ${RUNS})
+		compile("consumer.cpp (${config})" ${dir} millis memory
+			-c ${ARGN} ${SOURCE_DIR}/consumer.cpp -o consumer.o)
+		if(NOT best OR millis LESS best)
+			set(best ${millis})
+		endif()
+	endforeach()
+	if(report)
+		compile("consumer.cpp (${config})" ${dir} millis memory
+			-c ${report} ${ARGN} ${SOURCE_DIR}/consumer.cpp -o consumer.o)
+	endif()
+	pad("${config}" 10 c1)
+	pad("${setup_ms}" 12 c2)
+	pad("${best}" 12 c3)
+	message("${c1}${c2}${c3}${memory}")
+endfunction()
+
+set(header ${INCLUDE_DIR}/tim/result/Result.hpp)
+
+message("config    setup ms    per TU ms   memory")
+
+set(dir ${OUTPUT_DIR}/textual)
+file(MAKE_DIRECTORY ${dir})
+measure(textual "-" ${dir} -I${INCLUDE_DIR})
+
+# GCC picks up 'Result.hpp.gch' when the header it sits next to is the first
+# thing the translation unit includes; Clang has to be told about the PCH.
+set(dir ${OUTPUT_DIR}/pch)
+file(MAKE_DIRECTORY ${dir}/tim/result)
+if(COMPILER_ID MATCHES "Clang")
+	compile("Result.hpp (pch)" ${dir} setup_ms memory
+		-x c++-header ${header} -o Result.hpp.pch)
+	measure(pch ${setup_ms} ${dir} -I${INCLUDE_DIR} -include-pch Result.hpp.pch)
+else()
+	compile("Result.hpp (pch)" ${dir} setup_ms memory
+		-x c++-header ${header} -o tim/result/Result.hpp.gch)
+	measure(pch ${setup_ms} ${dir} -Winvalid-pch -I${dir} -I${INCLUDE_DIR}
+		-include tim/result/Result.hpp)
+endif()
+
+if(CXXSTD LESS 20)
+	message("module    -           -           (needs C++20)")
+	return()
+endif()
+
+set(dir ${OUTPUT_DIR}/module)
+file(MAKE_DIRECTORY ${dir})
+if(COMPILER_ID STREQUAL "GNU")
+	compile("tim.result.cppm" ${dir} setup_ms memory
+		-fmodules-ts -I${INCLUDE_DIR} -x c++ -c ${MODULE_SOURCE} -o tim.result.o)
+	# GCC 12 crashes in -ftime-report when it loads declarations lazily from
+	# a module.
+	set(report)
+	measure(module ${setup_ms} ${dir} -fmodules-ts -DRESULT_USE_MODULE)
+elseif(COMPILER_ID MATCHES "Clang")
+	compile("tim.result.cppm" ${dir} setup_ms memory
+		-I${INCLUDE_DIR} -x c++-module --precompile ${MODULE_SOURCE} -o tim.result.pcm)
+	measure(module ${setup_ms} ${dir} -fmodule-file=tim.result=tim.result.pcm
+		-DRESULT_USE_MODULE)
+else()
+	message("module    -           -           (not supported for ${COMPILER_ID})")
+endif()
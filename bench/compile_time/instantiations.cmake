@@ -0,0 +1,85 @@
+# Measures what instantiating 'Result' costs the compiler: compiles
+# 'instantiations.cpp' with -fsyntax-only for each of COUNTS instantiations,
+# once per configuration, and prints the wall time and (for GCC, from
+# -ftime-report) the memory used.  The configurations are C++17, which always
+# uses the chain of special member base classes, and, when STD20 is set, C++20
+# with the chain and C++20 with the conditionally trivial members.
+#
+# Invoked by the 'result-compile-bench' target as
+#   cmake -DCOMPILER=... -DCOMPILER_ID=... -DINCLUDE_DIR=... -DSUPPORT_DIR=...
+#         -DSOURCE=... [-DCOUNTS="100;500"] [-DSTD20=ON] -P instantiations.cmake
+
+if(NOT COUNTS)
+	set(COUNTS 100 200 500)
+endif()
+
+set(configs "c++17")
+set(flags_c++17 -std=c++17)
+if(STD20)
+	list(APPEND configs "c++20-chain" "c++20")
+	set(flags_c++20-chain -std=c++20 -DTIM_RESULT_NO_CONDITIONALLY_TRIVIAL_MEMBERS)
+	set(flags_c++20 -std=c++20)
+endif()
+
+set(time_report)
+if(COMPILER_ID STREQUAL "GNU")
+	set(time_report -ftime-report)
+endif()
+
+# Seconds since the epoch, with microseconds.
+function(now out)
+	string(TIMESTAMP t "%s%f" UTC)
+	set(${out} ${t} PARENT_SCOPE)
+endfunction()
+
+# Left-aligns 'text' in a column 'width' characters wide.
+function(pad text width out)
+	string(LENGTH "${text}" len)
+	while(len LESS width)
+		string(APPEND text " ")
+		math(EXPR len "${len} + 1")
+	endwhile()
+	set(${out} "${text}" PARENT_SCOPE)
+endfunction()
+
+message("config        count    seconds   ms/inst    memory")
+foreach(config IN LISTS configs)
+	foreach(count IN LISTS COUNTS)
+		now(start)
+		execute_process(
+			COMMAND ${COMPILER} ${flags_${config}} -fsyntax-only ${time_report}
+				-DCOUNT=${count} -I${INCLUDE_DIR} -I${SUPPORT_DIR} ${SOURCE}
+			RESULT_VARIABLE status
+			OUTPUT_VARIABLE output
+			ERROR_VARIABLE output)
+		now(stop)
+		if(NOT status EQUAL 0)
+			message(FATAL_ERROR "${config} with COUNT=${count} failed to compile:\n${output}")
+		endif()
+
+		math(EXPR micros "${stop} - ${start}")
+		math(EXPR millis "${micros} / 1000")
+		math(EXPR per_instantiation "${micros} / ${count}")
+		math(EXPR seconds_int "${millis} / 1000")
+		math(EXPR seconds_frac "${millis} % 1000")
+		string(LENGTH "${seconds_frac}" len)
+		while(len LESS 3)
+			set(seconds_frac "0${seconds_frac}")
+			string(LENGTH "${seconds_frac}" len)
+		endwhile()
+		math(EXPR per_int "${per_instantiation} / 1000")
+		math(EXPR per_frac "(${per_instantiation} % 1000) / 100")
+
+		set(memory "-")
+		if(output MATCHES "TOTAL[ \t]*:[^\n]*[ \t]([0-9]+[kMG])")
+			set(memory ${CMAKE_MATCH_1})
+		endif()
+
+		pad("${config}" 14 c1)
+		pad("${count}" 9 c2)
+		pad("${seconds_int}.${seconds_frac}" 10 c3)
+		pad("${per_int}.${per_frac}" 10 c4)
+		set(line "${c1}${c2}${c3}${c4}${memory}")
+		message("${line}")
+	endforeach()
+endforeach()
@@ -0,0 +1,54 @@
+// Instantiates the special members of 'COUNT' distinct 'Result' types, half of
+// them trivially copyable and half not.  Compiled (not run) by
+// 'instantiations.cmake' to measure what the special member machinery of
+// 'Result' costs the compiler per instantiation.
+
+#include "tim/result/Result.hpp"
+#include "template_cost_testing.h"
+
+#include <string>
+#include <utility>
+
+#ifndef COUNT
+#define COUNT 100
+#endif
+
+template <int N>
+struct Trivial {
+	int value;
+};
+
+template <int N>
+struct NonTrivial {
+	std::string value;
+};
+
+template <class T, class E>
+void exercise(tim::Result<T, E>& a, tim::Result<T, E>& b) {
+	tim::Result<T, E> c(a);
+	tim::Result<T, E> d(std::move(b));
+	a = c;
+	b = std::move(d);
+}
+
+template <int N>
+struct Instantiate {
+	void run(tim::Result<Trivial<N>, int>& a, tim::Result<NonTrivial<N>, Trivial<N>>& b) {
+		exercise(a, a);
+		exercise(b, b);
+	}
+};
+
+#define INSTANTIATE() template struct Instantiate<__COUNTER__>;
+
+#if COUNT == 100
+REPEAT_100(INSTANTIATE)
+#elif COUNT == 200
+REPEAT_200(INSTANTIATE)
+#elif COUNT == 500
+REPEAT_500(INSTANTIATE)
+#elif COUNT == 1000
+REPEAT_1000(INSTANTIATE)
+#else
+#error "COUNT must be one of 100, 200, 500 or 1000."
+#endif
@@ -0,0 +1,46 @@
+// Uses 'Result<cv void, E>' for each cv-qualification of 'void' and a few
+// error types.  Compiled to an object file by 'header.cmake' to measure the
+// code the 'void' specializations generate.
+
+#include "tim/result/Result.hpp"
+
+#include <string>
+
+namespace {
+
+template <class V, class E>
+[[gnu::noinline]] tim::Result<V, E> check(int x, E e) {
+	if(x < 0) {
+		return tim::Result<V, E>(tim::in_place_error, std::move(e));
+	}
+	return tim::Result<V, E>(tim::in_place);
+}
+
+template <class V, class E>
+int use(int x, E e) {
+	tim::Result<V, E> r = check<V, E>(x, e);
+	tim::Result<V, E> s(r);
+	s = tim::Result<V, E>(tim::in_place_error, e);
+	r.swap(s);
+	if(r.has_value()) {
+		r.value();
+		return 0;
+	}
+	return s.has_value() ? 1 : 2;
+}
+
+template <class V>
+int use_all(int x) {
+	return use<V, int>(x, 1)
+		+ use<V, long>(x, 2)
+		+ use<V, std::string>(x, "error");
+}
+
+} /* namespace */
+
+int void_results(int x) {
+	return use_all<void>(x)
+		+ use_all<const void>(x)
+		+ use_all<volatile void>(x)
+		+ use_all<const volatile void>(x);
+}
@@ -0,0 +1,105 @@
+// Compares error propagation through a chain of Result-returning calls written
+// three ways: explicit branching, TIM_TRY_ASSIGN, and a coroutine using
+// 'co_await'.  Each variant is run over inputs where every call succeeds and
+// inputs where the innermost call fails.  The coroutine is not expected to
+// match the other two: it allocates a frame on every call (see
+// tim/result/coroutine.hpp).
+
+#include "bench.hpp"
+#include "tim/result/coroutine.hpp"
+
+#include <cstdio>
+
+#if TIM_RESULT_HAS_COROUTINES
+
+namespace {
+
+using IntResult = tim::Result<int, int>;
+
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((noinline))
+#endif
+IntResult leaf(int v) {
+	if(v < 0) {
+		return tim::Error(v);
+	}
+	return v + 1;
+}
+
+namespace manual {
+
+IntResult step2(int v) {
+	auto r = leaf(v);
+	if(!r.has_value()) {
+		return tim::Error(std::move(r).error());
+	}
+	return *r * 2;
+}
+
+IntResult step1(int v) {
+	auto r = step2(v);
+	if(!r.has_value()) {
+		return tim::Error(std::move(r).error());
+	}
+	return *r + 3;
+}
+
+} /* namespace manual */
+
+namespace try_macro {
+
+IntResult step2(int v) {
+	TIM_TRY_ASSIGN(int x, leaf(v));
+	return x * 2;
+}
+
+IntResult step1(int v) {
+	TIM_TRY_ASSIGN(int x, step2(v));
+	return x + 3;
+}
+
+} /* namespace try_macro */
+
+namespace coroutine {
+
+IntResult step2(int v) {
+	int x = co_await leaf(v);
+	co_return x * 2;
+}
+
+IntResult step1(int v) {
+	int x = co_await step2(v);
+	co_return x + 3;
+}
+
+} /* namespace coroutine */
+
+template <IntResult (*Fn)(int)>
+bench::Measurement run(const char* name, int input) {
+	return bench::measure(name, [input] {
+		int v = input;
+		bench::do_not_optimize(v);
+		bench::do_not_optimize(Fn(v));
+	});
+}
+
+} /* namespace */
+
+int main() {
+	bench::print({
+		run<manual::step1>("manual/success", 1),
+		run<try_macro::step1>("tim_try/success", 1),
+		run<coroutine::step1>("coroutine/success", 1),
+		run<manual::step1>("manual/error", -1),
+		run<try_macro::step1>("tim_try/error", -1),
+		run<coroutine::step1>("coroutine/error", -1)
+	});
+}
+
+#else
+
+int main() {
+	std::puts("coroutine benchmark: coroutines are not supported by this compiler");
+}
+
+#endif /* TIM_RESULT_HAS_COROUTINES */
@@ -0,0 +1,467 @@
+// The result-bench suite: 'tim::Result' against the usual alternatives for
+// reporting failure, at error rates of 0%, 0.1%, 1%, 10% and 50%.
+//
+// Benchmarks are named 'operation/implementation/error_rate' and report the
+// time per element over arrays of 4096 inputs, with the failing elements
+// scattered at random.  The implementations are 'tim::Result', throwing an
+// exception, 'std::optional', 'std::variant' and (when the standard library
+// has it) 'std::expected'.
+//
+//  - construct: a non-inlined function returns a value or an error; the
+//    caller inspects it.
+//  - propagate_N: as 'construct', but the result is propagated up through N
+//    (1, 4, 16) non-inlined callers ('TIM_TRY_ASSIGN' for 'tim::Result').
+//  - value: 'value()' (or 'std::get') on each element, catching the
+//    exception thrown for errors.
+//  - copy_assign_same / copy_assign_cross, move_assign_same /
+//    move_assign_cross: assigning elements that hold the same alternative
+//    as the target, or the other one.  These and 'swap' use 'std::string'
+//    values and errors, so that they go through the non-trivial assignment
+//    paths.  Exceptions have nothing to assign and are left out.
+//  - swap: swapping elements of two arrays.
+//  - shuffle, swap_cross: 'std::shuffle' of an array, and swapping elements
+//    holding opposite alternatives, for 'Result<std::unique_ptr<...>,
+//    std::vector<...>>'.  Both alternatives are trivially relocatable, so
+//    swapping a value with an error exchanges bytes ('result'); the same
+//    types wrapped so that they are not go through a temporary
+//    ('result_moving').
+//  - convert: reading 'Result's directly, and after converting them to
+//    'std::expected' and back with 'tim::to_std()' and 'tim::from_std()'
+//    (when the standard library has 'std::expected').
+//
+// Run with '--json FILE' to record the results, and '--filter SUBSTRING' to
+// run some of them.
+
+#include "bench.hpp"
+#include "tim/result/Result.hpp"
+#include "tim/result/expected.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+#if __has_include(<version>)
+# include <version>
+#endif
+#if defined(__cpp_lib_expected)
+# include <expected>
+#endif
+
+namespace {
+
+constexpr std::size_t elements = 4096;
+
+struct Failure {
+	int code;
+};
+
+// 'fails[i]' is true for 'rate * elements' randomly chosen elements.
+std::vector<bool> make_pattern(double rate, std::uint32_t seed) {
+	std::vector<bool> fails(elements, false);
+	auto errors = static_cast<std::size_t>(rate * static_cast<double>(elements) + 0.5);
+	std::fill(fails.begin(), fails.begin() + static_cast<std::ptrdiff_t>(errors), true);
+	std::shuffle(fails.begin(), fails.end(), std::mt19937(seed));
+	return fails;
+}
+
+std::string make_string(const char* prefix, std::size_t i) {
+	// Short enough for the small string optimization.
+	return prefix + std::to_string(i % 1000u);
+}
+
+template <class T, class E>
+struct ResultImpl {
+	static constexpr const char* name = "result";
+	using type = tim::Result<T, E>;
+
+	static type value(T v) { return type(tim::in_place, std::move(v)); }
+	static type error(E e) { return type(tim::in_place_error, std::move(e)); }
+	static bool has_value(const type& r) { return r.has_value(); }
+	static const T& get(const type& r) { return *r; }
+	static const T& checked(const type& r) { return r.value(); }
+};
+
+template <class T, class E>
+struct OptionalImpl {
+	static constexpr const char* name = "optional";
+	using type = std::optional<T>;
+
+	static type value(T v) { return type(std::in_place, std::move(v)); }
+	static type error(E) { return std::nullopt; }
+	static bool has_value(const type& r) { return r.has_value(); }
+	static const T& get(const type& r) { return *r; }
+	static const T& checked(const type& r) { return r.value(); }
+};
+
+template <class T, class E>
+struct VariantImpl {
+	static constexpr const char* name = "variant";
+	using type = std::variant<T, E>;
+
+	static type value(T v) { return type(std::in_place_index<0>, std::move(v)); }
+	static type error(E e) { return type(std::in_place_index<1>, std::move(e)); }
+	static bool has_value(const type& r) { return r.index() == 0u; }
+	static const T& get(const type& r) { return *std::get_if<0>(&r); }
+	static const T& checked(const type& r) { return std::get<0>(r); }
+};
+
+#if defined(__cpp_lib_expected)
+template <class T, class E>
+struct ExpectedImpl {
+	static constexpr const char* name = "expected";
+	using type = std::expected<T, E>;
+
+	static type value(T v) { return type(std::in_place, std::move(v)); }
+	static type error(E e) { return type(std::unexpect, std::move(e)); }
+	static bool has_value(const type& r) { return r.has_value(); }
+	static const T& get(const type& r) { return *r; }
+	static const T& checked(const type& r) { return r.value(); }
+};
+#endif
+
+template <class Impl>
+BENCH_NOINLINE typename Impl::type produce(bool fail, std::int64_t i) {
+	if(fail) {
+		return Impl::error(static_cast<int>(i));
+	}
+	return Impl::value(i);
+}
+
+template <class Impl, int Depth>
+BENCH_NOINLINE typename Impl::type propagate(bool fail, std::int64_t i) {
+	if constexpr(Depth == 0) {
+		return produce<Impl>(fail, i);
+	} else {
+		auto r = propagate<Impl, Depth - 1>(fail, i);
+		if(!Impl::has_value(r)) {
+			return r;
+		}
+		return Impl::value(Impl::get(r) + 1);
+	}
+}
+
+template <class T, class E, int Depth>
+BENCH_NOINLINE tim::Result<T, E> propagate_try(bool fail, std::int64_t i) {
+	if constexpr(Depth == 0) {
+		return produce<ResultImpl<T, E>>(fail, i);
+	} else {
+		TIM_TRY_ASSIGN(auto v, propagate_try<T, E, Depth - 1>(fail, i));
+		return tim::Result<T, E>(tim::in_place, v + 1);
+	}
+}
+
+BENCH_NOINLINE std::int64_t produce_or_throw(bool fail, std::int64_t i) {
+	if(fail) {
+		throw Failure{static_cast<int>(i)};
+	}
+	return i;
+}
+
+template <int Depth>
+BENCH_NOINLINE std::int64_t propagate_throw(bool fail, std::int64_t i) {
+	if constexpr(Depth == 0) {
+		return produce_or_throw(fail, i);
+	} else {
+		return propagate_throw<Depth - 1>(fail, i) + 1;
+	}
+}
+
+class Suite {
+public:
+	explicit Suite(bench::Arguments args):
+		args_(std::move(args))
+	{
+		options_.min_batch_time = std::chrono::milliseconds(20);
+		options_.repetitions = 3;
+		options_.operations = elements;
+	}
+
+	template <class F>
+	void add(const std::string& name, F&& fn, std::size_t passes = 1) {
+		if(!bench::selected(args_, name)) {
+			return;
+		}
+		bench::Options options = options_;
+		options.operations *= passes;
+		results_.push_back(bench::measure(name, std::forward<F>(fn), options));
+	}
+
+	int report() const {
+		return bench::report(args_, results_);
+	}
+
+private:
+	bench::Arguments args_;
+	bench::Options options_;
+	std::vector<bench::Measurement> results_;
+};
+
+template <class Impl, int Depth>
+void propagate_benchmark(Suite& suite, const std::vector<bool>& fails, const std::string& suffix) {
+	suite.add("propagate_" + std::to_string(Depth) + suffix, [&] {
+		std::int64_t sum = 0;
+		for(std::size_t i = 0; i < elements; ++i) {
+			typename Impl::type r = [&] {
+				if constexpr(std::is_same_v<Impl, ResultImpl<std::int64_t, int>>) {
+					return propagate_try<std::int64_t, int, Depth>(fails[i], static_cast<std::int64_t>(i));
+				} else {
+					return propagate<Impl, Depth>(fails[i], static_cast<std::int64_t>(i));
+				}
+			}();
+			sum += Impl::has_value(r) ? Impl::get(r) : -1;
+		}
+		bench::do_not_optimize(sum);
+	});
+}
+
+template <class Impl>
+void scalar_benchmarks(Suite& suite, const std::vector<bool>& fails, const std::string& rate) {
+	const std::string suffix = std::string("/") + Impl::name + "/" + rate;
+	suite.add("construct" + suffix, [&] {
+		std::int64_t sum = 0;
+		for(std::size_t i = 0; i < elements; ++i) {
+			auto r = produce<Impl>(fails[i], static_cast<std::int64_t>(i));
+			sum += Impl::has_value(r) ? Impl::get(r) : -1;
+		}
+		bench::do_not_optimize(sum);
+	});
+	propagate_benchmark<Impl, 1>(suite, fails, suffix);
+	propagate_benchmark<Impl, 4>(suite, fails, suffix);
+	propagate_benchmark<Impl, 16>(suite, fails, suffix);
+	std::vector<typename Impl::type> rs;
+	for(std::size_t i = 0; i < elements; ++i) {
+		rs.push_back(fails[i] ? Impl::error(static_cast<int>(i)) : Impl::value(static_cast<std::int64_t>(i)));
+	}
+	suite.add("value" + suffix, [&, rs = std::move(rs)] {
+		std::int64_t sum = 0;
+		for(const auto& r: rs) {
+			try {
+				sum += Impl::checked(r);
+			} catch(...) {
+				sum -= 1;
+			}
+		}
+		bench::do_not_optimize(sum);
+	});
+}
+
+template <int Depth>
+void exception_propagate_benchmark(Suite& suite, const std::vector<bool>& fails, const std::string& suffix) {
+	suite.add("propagate_" + std::to_string(Depth) + suffix, [&] {
+		std::int64_t sum = 0;
+		for(std::size_t i = 0; i < elements; ++i) {
+			try {
+				sum += propagate_throw<Depth>(fails[i], static_cast<std::int64_t>(i));
+			} catch(const Failure&) {
+				sum -= 1;
+			}
+		}
+		bench::do_not_optimize(sum);
+	});
+}
+
+void exception_benchmarks(Suite& suite, const std::vector<bool>& fails, const std::string& rate) {
+	const std::string suffix = "/exception/" + rate;
+	suite.add("construct" + suffix, [&] {
+		std::int64_t sum = 0;
+		for(std::size_t i = 0; i < elements; ++i) {
+			try {
+				sum += produce_or_throw(fails[i], static_cast<std::int64_t>(i));
+			} catch(const Failure&) {
+				sum -= 1;
+			}
+		}
+		bench::do_not_optimize(sum);
+	});
+	exception_propagate_benchmark<1>(suite, fails, suffix);
+	exception_propagate_benchmark<4>(suite, fails, suffix);
+	exception_propagate_benchmark<16>(suite, fails, suffix);
+}
+
+template <class Impl>
+std::vector<typename Impl::type> make_strings(const std::vector<bool>& fails, bool flip, const char* prefix) {
+	std::vector<typename Impl::type> rs;
+	rs.reserve(elements);
+	for(std::size_t i = 0; i < elements; ++i) {
+		if(fails[i] != flip) {
+			rs.push_back(Impl::error(make_string(prefix, i)));
+		} else {
+			rs.push_back(Impl::value(make_string(prefix, i)));
+		}
+	}
+	return rs;
+}
+
+template <class Impl>
+void assignment_benchmarks(Suite& suite, const std::vector<bool>& fails, const std::string& rate) {
+	const std::string suffix = std::string("/") + Impl::name + "/" + rate;
+	// Each call assigns 'a' and then 'b' to every element of 'dst'.  For the
+	// 'same' cases 'a' and 'b' hold the same alternatives; for the 'cross'
+	// cases they hold opposite ones.
+	for(bool cross: {false, true}) {
+		const std::string kind = cross ? "cross" : "same";
+		auto a = make_strings<Impl>(fails, false, "a");
+		auto b = make_strings<Impl>(fails, cross, "b");
+		auto dst = b;
+		suite.add("copy_assign_" + kind + suffix, [a, b, dst]() mutable {
+			for(std::size_t i = 0; i < elements; ++i) {
+				dst[i] = a[i];
+			}
+			bench::clobber_memory();
+			for(std::size_t i = 0; i < elements; ++i) {
+				dst[i] = b[i];
+			}
+			bench::do_not_optimize(dst.data());
+		}, 2);
+		// Moved-from strings keep their alternative, so the sources can be
+		// reused.
+		suite.add("move_assign_" + kind + suffix, [a, b, dst]() mutable {
+			for(std::size_t i = 0; i < elements; ++i) {
+				dst[i] = std::move(a[i]);
+			}
+			bench::clobber_memory();
+			for(std::size_t i = 0; i < elements; ++i) {
+				dst[i] = std::move(b[i]);
+			}
+			bench::do_not_optimize(dst.data());
+		}, 2);
+	}
+	auto a = make_strings<Impl>(fails, false, "a");
+	auto b = make_strings<Impl>(std::vector<bool>(fails.rbegin(), fails.rend()), false, "b");
+	suite.add("swap" + suffix, [a, b]() mutable {
+		using std::swap;
+		for(std::size_t i = 0; i < elements; ++i) {
+			swap(a[i], b[i]);
+		}
+		bench::do_not_optimize(a.data());
+	});
+}
+
+// An owning error, which this benchmark declares relocatable where the
+// standard library's 'std::vector' is.
+struct Buffer {
+	std::vector<int> data;
+};
+
+} /* namespace */
+
+#if (defined(__GLIBCXX__) && !defined(_GLIBCXX_DEBUG)) || (defined(_LIBCPP_VERSION) && !defined(_LIBCPP_ENABLE_DEBUG_MODE))
+template <>
+struct tim::traits::is_trivially_relocatable<Buffer>: std::true_type {};
+#endif
+
+namespace {
+
+// Wraps 'X' so that it is not 'tim::traits::is_trivially_relocatable'.
+template <class X>
+struct NotRelocatable {
+	X x;
+};
+
+template <class T, class E>
+std::vector<tim::Result<T, E>> make_owning(const std::vector<bool>& fails, bool flip) {
+	std::vector<tim::Result<T, E>> rs;
+	rs.reserve(elements);
+	for(std::size_t i = 0; i < elements; ++i) {
+		if(fails[i] != flip) {
+			rs.emplace_back(tim::in_place_error, E{std::vector<int>(1, static_cast<int>(i))});
+		} else {
+			rs.emplace_back(tim::in_place, T{std::make_unique<std::int64_t>(static_cast<std::int64_t>(i))});
+		}
+	}
+	return rs;
+}
+
+template <class T, class E>
+void relocation_benchmark(Suite& suite, const std::vector<bool>& fails, const std::string& suffix) {
+	suite.add("shuffle" + suffix, [rs = make_owning<T, E>(fails, false), rng = std::mt19937(1)]() mutable {
+		std::shuffle(rs.begin(), rs.end(), rng);
+		bench::do_not_optimize(rs.data());
+	});
+	// Every element of 'a' holds the other alternative from that of 'b'.
+	suite.add("swap_cross" + suffix, [a = make_owning<T, E>(fails, false), b = make_owning<T, E>(fails, true)]() mutable {
+		using std::swap;
+		for(std::size_t i = 0; i < elements; ++i) {
+			swap(a[i], b[i]);
+		}
+		bench::do_not_optimize(a.data());
+	});
+}
+
+void relocation_benchmarks(Suite& suite, const std::vector<bool>& fails, const std::string& rate) {
+	using Owned = std::unique_ptr<std::int64_t>;
+	static_assert(tim::traits::is_trivially_relocatable_v<tim::Result<Owned, Buffer>>
+		|| !tim::traits::is_trivially_relocatable_v<Buffer>);
+	static_assert(!tim::traits::is_trivially_relocatable_v<NotRelocatable<Owned>>);
+	relocation_benchmark<Owned, Buffer>(suite, fails, "/result/" + rate);
+	relocation_benchmark<NotRelocatable<Owned>, NotRelocatable<Buffer>>(suite, fails, "/result_moving/" + rate);
+}
+
+#if TIM_RESULT_HAS_STD_EXPECTED
+// Reads each element of an array of 'Result's, either directly ('result') or
+// after converting it to 'std::expected' and back ('result_via_expected').
+// The conversions should compile away, so the two should take the same time.
+void conversion_benchmarks(Suite& suite, const std::vector<bool>& fails, const std::string& rate) {
+	using R = tim::Result<std::int64_t, std::int64_t>;
+	std::vector<R> rs;
+	rs.reserve(elements);
+	for(std::size_t i = 0; i < elements; ++i) {
+		rs.push_back(fails[i] ? R(tim::in_place_error, 1) : R(tim::in_place, static_cast<std::int64_t>(i)));
+	}
+	suite.add("convert/result/" + rate, [rs] {
+		std::int64_t sum = 0;
+		for(const R& r: rs) {
+			R copy = r;
+			sum += copy.has_value() ? *copy : -copy.error();
+		}
+		bench::do_not_optimize(sum);
+	});
+	suite.add("convert/result_via_expected/" + rate, [rs] {
+		std::int64_t sum = 0;
+		for(const R& r: rs) {
+			R copy = tim::from_std(tim::to_std(r));
+			sum += copy.has_value() ? *copy : -copy.error();
+		}
+		bench::do_not_optimize(sum);
+	});
+}
+#endif
+
+template <template <class, class> class Impl>
+void implementation_benchmarks(Suite& suite, const std::vector<bool>& fails, const std::string& rate) {
+	scalar_benchmarks<Impl<std::int64_t, int>>(suite, fails, rate);
+	assignment_benchmarks<Impl<std::string, std::string>>(suite, fails, rate);
+}
+
+} /* namespace */
+
+int main(int argc, char** argv) {
+	Suite suite(bench::parse_arguments(argc, argv));
+	const std::pair<double, const char*> rates[] = {
+		{0.0, "0%"},
+		{0.001, "0.1%"},
+		{0.01, "1%"},
+		{0.1, "10%"},
+		{0.5, "50%"}
+	};
+	for(const auto& [rate, label]: rates) {
+		const auto fails = make_pattern(rate, 12345u);
+		implementation_benchmarks<ResultImpl>(suite, fails, label);
+		relocation_benchmarks(suite, fails, label);
+#if TIM_RESULT_HAS_STD_EXPECTED
+		conversion_benchmarks(suite, fails, label);
+#endif
+		exception_benchmarks(suite, fails, label);
+		implementation_benchmarks<OptionalImpl>(suite, fails, label);
+		implementation_benchmarks<VariantImpl>(suite, fails, label);
+#if defined(__cpp_lib_expected)
+		implementation_benchmarks<ExpectedImpl>(suite, fails, label);
+#endif
+	}
+	return suite.report();
+}
@@ -0,0 +1,120 @@
+// Compares the bulk status queries of tim/result/scan.hpp with the loops they
+// replace, over 4096 'Result<double, int>' of which 1% are errors.  That is
+// 64 KiB, small enough that neither side is bound by memory bandwidth.  The
+// 'find_error' cases use an array whose only error is the last element.
+
+#include "bench.hpp"
+#include "tim/result/scan.hpp"
+
+#include <random>
+#include <vector>
+
+namespace {
+
+using R = tim::Result<double, int>;
+
+constexpr std::size_t elements = 4096;
+
+std::vector<R> make_results(unsigned error_permille) {
+	std::mt19937 rng(1);
+	std::uniform_int_distribution<unsigned> dist(0, 999);
+	std::vector<R> rs;
+	rs.reserve(elements);
+	for(std::size_t i = 0; i < elements; ++i) {
+		if(dist(rng) < error_permille) {
+			rs.emplace_back(tim::in_place_error, static_cast<int>(i));
+		} else {
+			rs.emplace_back(tim::in_place, 0.5 * static_cast<double>(i));
+		}
+	}
+	return rs;
+}
+
+std::size_t loop_count_errors(const std::vector<R>& rs) {
+	std::size_t n = 0;
+	for(const auto& r: rs) {
+		if(!r.has_value()) {
+			++n;
+		}
+	}
+	return n;
+}
+
+std::size_t loop_find_error(const std::vector<R>& rs) {
+	for(std::size_t i = 0; i < rs.size(); ++i) {
+		if(!rs[i].has_value()) {
+			return i;
+		}
+	}
+	return rs.size();
+}
+
+void loop_bitmap(const std::vector<R>& rs, std::uint64_t* words) {
+	for(std::size_t w = 0; w < (rs.size() + 63u) / 64u; ++w) {
+		words[w] = 0;
+	}
+	for(std::size_t i = 0; i < rs.size(); ++i) {
+		if(rs[i].has_value()) {
+			words[i / 64u] |= std::uint64_t(1) << (i % 64u);
+		}
+	}
+}
+
+const char* kernel_name(tim::detail::StatusKernel kernel) {
+	switch(kernel) {
+	case tim::detail::StatusKernel::SSE2:
+		return "sse2";
+	case tim::detail::StatusKernel::AVX2:
+		return "avx2";
+	case tim::detail::StatusKernel::NEON:
+		return "neon";
+	default:
+		return "scalar";
+	}
+}
+
+} /* namespace */
+
+int main() {
+	const auto rs = make_results(10);
+	auto last = make_results(0);
+	last.back() = R(tim::in_place_error, 0);
+	std::vector<std::uint64_t> words((elements + 63u) / 64u);
+	std::vector<double> values(elements);
+	std::vector<int> errors(elements);
+	bench::Options options;
+	options.operations = elements;
+	std::printf("kernel: %s\n", kernel_name(tim::detail::status_kernel()));
+	bench::print({
+		bench::measure("loop/count_errors", [&] { bench::do_not_optimize(loop_count_errors(rs)); }, options),
+		bench::measure("scan/count_errors", [&] { bench::do_not_optimize(tim::count_errors(rs)); }, options),
+		bench::measure("loop/find_error", [&] { bench::do_not_optimize(loop_find_error(last)); }, options),
+		bench::measure("scan/find_error", [&] { bench::do_not_optimize(tim::find_error(last)); }, options),
+		bench::measure("loop/status_bitmap", [&] {
+			loop_bitmap(rs, words.data());
+			bench::clobber_memory();
+		}, options),
+		bench::measure("scan/status_bitmap", [&] {
+			tim::status_bitmap(rs, words.data());
+			bench::clobber_memory();
+		}, options),
+		bench::measure("loop/partition_copy", [&] {
+			double* v = values.data();
+			int* e = errors.data();
+			for(const auto& r: rs) {
+				if(r.has_value()) {
+					*v++ = *r;
+				} else {
+					*e++ = r.error();
+				}
+			}
+			bench::do_not_optimize(v);
+			bench::do_not_optimize(e);
+			bench::clobber_memory();
+		}, options),
+		bench::measure("scan/partition_copy", [&] {
+			bench::do_not_optimize(tim::partition_copy(rs, values.data(), errors.data()));
+			bench::clobber_memory();
+		}, options)
+	});
+}
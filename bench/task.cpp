@@ -0,0 +1,94 @@
+// Compares running many small fallible operations concurrently as 'Task's on
+// a 'ThreadPool' against 'std::async' with 'std::future<Result>'.  Every
+// operation fails with probability 1/16; the 'Task' version stops at the first
+// failure, as 'when_all' does.
+
+#include "bench.hpp"
+#include "tim/result/task.hpp"
+
+#include <cstdio>
+#include <future>
+#include <vector>
+
+#if TIM_RESULT_HAS_COROUTINES
+
+namespace {
+
+constexpr std::size_t operations = 1024;
+
+using IntResult = tim::Result<int, int>;
+
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((noinline))
+#endif
+IntResult work(int v) {
+	if((v & 15) == 15) {
+		return tim::Error(v);
+	}
+	return v * 3;
+}
+
+tim::Task<int, int> task_work(int v) {
+	co_return co_await work(v);
+}
+
+long run_tasks(tim::ThreadPool& pool, int offset) {
+	std::vector<tim::Task<int, int>> tasks;
+	tasks.reserve(operations);
+	for(std::size_t i = 0; i < operations; ++i) {
+		tasks.push_back(task_work(static_cast<int>(i) * 16 + offset));
+	}
+	auto r = tim::sync_wait(pool, tim::when_all(std::move(tasks)));
+	return r.has_value() ? static_cast<long>(r->size()) : -r.error();
+}
+
+long run_futures(int offset) {
+	std::vector<std::future<IntResult>> futures;
+	futures.reserve(operations);
+	for(std::size_t i = 0; i < operations; ++i) {
+		futures.push_back(std::async(std::launch::async, work, static_cast<int>(i) * 16 + offset));
+	}
+	long total = 0;
+	for(auto& f: futures) {
+		auto r = f.get();
+		total += r.has_value() ? 1 : 0;
+	}
+	return total;
+}
+
+long run_deferred(int offset) {
+	std::vector<std::future<IntResult>> futures;
+	futures.reserve(operations);
+	for(std::size_t i = 0; i < operations; ++i) {
+		futures.push_back(std::async(std::launch::deferred, work, static_cast<int>(i) * 16 + offset));
+	}
+	long total = 0;
+	for(auto& f: futures) {
+		auto r = f.get();
+		total += r.has_value() ? 1 : 0;
+	}
+	return total;
+}
+
+} /* namespace */
+
+int main() {
+	tim::ThreadPool pool;
+	bench::Options options;
+	options.operations = operations;
+	// Offset 0 never fails; offset 15 makes the first operation fail.
+	bench::print({
+		bench::measure("task/success", [&] { bench::do_not_optimize(run_tasks(pool, 0)); }, options),
+		bench::measure("task/error", [&] { bench::do_not_optimize(run_tasks(pool, 15)); }, options),
+		bench::measure("std::async/success", [] { bench::do_not_optimize(run_futures(0)); }, options),
+		bench::measure("std::async(deferred)/success", [] { bench::do_not_optimize(run_deferred(0)); }, options)
+	});
+}
+
+#else
+
+int main() {
+	std::puts("task benchmark: coroutines are not supported by this compiler");
+}
+
+#endif /* TIM_RESULT_HAS_COROUTINES */
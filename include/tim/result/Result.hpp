@@ -5,7 +5,102 @@
 #include <exception>
 #include <utility>
 #include <memory>
+#include <cstddef>
+#include <cstdint>
 #include <new>
+#include <variant>
+#include <tuple>
+#if !defined(__GNUC__) && !defined(__clang__)
+# include <cstring>
+#endif
+
+// Whether 'Result' gets its special members from a single class with
+// constrained, conditionally trivial members (C++20) instead of the chain of
+// one base class per member.  Both give the same members with the same
+// triviality; define 'TIM_RESULT_NO_CONDITIONALLY_TRIVIAL_MEMBERS' to use the
+// chain regardless.
+#ifndef TIM_RESULT_HAS_CONDITIONALLY_TRIVIAL_MEMBERS
+# if !defined(TIM_RESULT_NO_CONDITIONALLY_TRIVIAL_MEMBERS) && defined(__cpp_concepts) && __cpp_concepts >= 202002L
+#  define TIM_RESULT_HAS_CONDITIONALLY_TRIVIAL_MEMBERS 1
+# else
+#  define TIM_RESULT_HAS_CONDITIONALLY_TRIVIAL_MEMBERS 0
+# endif
+#endif
+
+#ifndef TIM_RESULT_HAS_EXCEPTIONS
+# if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+#  define TIM_RESULT_HAS_EXCEPTIONS 1
+# else
+#  define TIM_RESULT_HAS_EXCEPTIONS 0
+# endif
+#endif
+
+// What 'value()' does when the 'Result' holds an error.  Define
+// 'TIM_RESULT_ACCESS_POLICY' (identically in every translation unit) to one of
+//
+//   TIM_RESULT_ACCESS_THROW        throw a 'BadResultAccess' (the default when
+//                                  exceptions are enabled);
+//   TIM_RESULT_ACCESS_TERMINATE    call 'std::terminate()' (the default
+//                                  otherwise);
+//   TIM_RESULT_ACCESS_HANDLER      call the handler installed with
+//                                  'set_bad_result_access_handler()', and
+//                                  'std::terminate()' if it returns;
+//   TIM_RESULT_ACCESS_UNREACHABLE  assume it never happens.  For trusted builds
+//                                  only: the access is undefined behavior.
+//
+// Except for the last, the failure is reported by a cold function that is
+// never inlined, so that 'value()' inlines to a test and a branch.
+#define TIM_RESULT_ACCESS_THROW 1
+#define TIM_RESULT_ACCESS_TERMINATE 2
+#define TIM_RESULT_ACCESS_HANDLER 3
+#define TIM_RESULT_ACCESS_UNREACHABLE 4
+
+#ifndef TIM_RESULT_ACCESS_POLICY
+# if TIM_RESULT_HAS_EXCEPTIONS
+#  define TIM_RESULT_ACCESS_POLICY TIM_RESULT_ACCESS_THROW
+# else
+#  define TIM_RESULT_ACCESS_POLICY TIM_RESULT_ACCESS_TERMINATE
+# endif
+#endif
+
+#if TIM_RESULT_ACCESS_POLICY == TIM_RESULT_ACCESS_THROW && !TIM_RESULT_HAS_EXCEPTIONS
+# error "TIM_RESULT_ACCESS_THROW needs exceptions to be enabled."
+#elif TIM_RESULT_ACCESS_POLICY < TIM_RESULT_ACCESS_THROW || TIM_RESULT_ACCESS_POLICY > TIM_RESULT_ACCESS_UNREACHABLE
+# error "TIM_RESULT_ACCESS_POLICY must be one of the TIM_RESULT_ACCESS_* policies."
+#endif
+
+#if TIM_RESULT_ACCESS_POLICY == TIM_RESULT_ACCESS_HANDLER
+# include <atomic>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+# define TIM_RESULT_COLD [[gnu::cold, gnu::noinline]]
+#elif defined(_MSC_VER)
+# define TIM_RESULT_COLD __declspec(noinline)
+#else
+# define TIM_RESULT_COLD
+#endif
+
+// Which alternative the branches on 'has_value()' inside 'Result' are laid out
+// for: 'tim::expect_none' (no hint, the default), 'tim::expect_success' or
+// 'tim::expect_failure'.  Define 'TIM_RESULT_EXPECT' to one of these to change
+// it for every 'Result', or specialize 'tim::traits::expectation' to change it
+// for one.
+#ifndef TIM_RESULT_EXPECT
+# define TIM_RESULT_EXPECT ::tim::result::expect_none
+#endif
+
+// 'cond', a test of whether a 'Result<T, E>' ('...' is 'T, E') holds a
+// value, with the hint given by 'traits::expectation<T, E>'.
+#if defined(__GNUC__) || defined(__clang__)
+# define TIM_RESULT_EXPECT_HAS_VALUE(cond, ...) \
+	(::tim::result::traits::expectation_v<__VA_ARGS__> == ::tim::result::Expectation::none \
+		? static_cast<bool>(cond) \
+		: static_cast<bool>(__builtin_expect(static_cast<bool>(cond), \
+			::tim::result::traits::expectation_v<__VA_ARGS__> == ::tim::result::Expectation::success)))
+#else
+# define TIM_RESULT_EXPECT_HAS_VALUE(cond, ...) (static_cast<bool>(cond))
+#endif
 
 namespace tim {
 
@@ -104,6 +199,412 @@ private:
 	E error_;
 };
 
+enum class Expectation {
+	none,
+	success,
+	failure
+};
+
+inline constexpr Expectation expect_none = Expectation::none;
+inline constexpr Expectation expect_success = Expectation::success;
+inline constexpr Expectation expect_failure = Expectation::failure;
+
+namespace traits {
+
+// Whether a 'Result<T, E>' is expected to hold a value ('expect_success'), an
+// error ('expect_failure'), or either ('expect_none').  The branches on its
+// state are laid out for the expected alternative.  Defaults to
+// 'TIM_RESULT_EXPECT'; may be specialized.
+template <class T, class E>
+struct expectation: std::integral_constant<Expectation, TIM_RESULT_EXPECT> {};
+
+template <class T, class E>
+inline constexpr Expectation expectation_v = expectation<std::remove_cv_t<T>, E>::value;
+
+/*
+ * How 'value()' reports a 'Result' holding an error of type 'E' under
+ * 'TIM_RESULT_ACCESS_THROW'.  By default it throws a 'BadResultAccess<E, true>'
+ * holding its own copy of the error (moved out of an rvalue 'Result').
+ * Specialize this with
+ *
+ *   static constexpr bool shared = true;
+ *
+ * to throw a 'BadResultAccess<void, true>' instead, whose copies all share one
+ * reference-counted, type-erased copy of the error.  That suits errors that
+ * are expensive to copy, such as ones carrying lists of diagnostics.
+ * 'BadResultAccess<void, true>' is defined in 'tim/result/shared_error.hpp',
+ * which must be included wherever 'value()' may throw such an error.  The
+ * specialization may also declare
+ *
+ *   static std::string what(const E& error);
+ *
+ * which 'what()' then calls, on first use, to describe the error, and
+ *
+ *   using allocator_type = A;
+ *
+ * to allocate the shared copy with a default-constructed 'A' (e.g.
+ * 'tim::error_arena_allocator<E>', from 'tim/result/error_arena.hpp')
+ * instead of 'std::allocator'.
+ */
+template <class E>
+struct bad_result_access_traits {
+	static constexpr bool shared = false;
+};
+
+} /* namespace traits */
+
+#if TIM_RESULT_ACCESS_POLICY == TIM_RESULT_ACCESS_HANDLER
+
+// Called by 'value()' on a 'Result' that holds an error.  The handler should
+// not return (it may throw, or end the program); if it does, or if no handler
+// is installed, 'std::terminate()' is called.
+using bad_result_access_handler = void (*)();
+
+namespace detail {
+
+inline std::atomic<bad_result_access_handler> bad_result_access_handler_{nullptr};
+
+} /* namespace detail */
+
+// Installs 'handler' and returns the previous one.
+inline bad_result_access_handler set_bad_result_access_handler(bad_result_access_handler handler) noexcept {
+	return detail::bad_result_access_handler_.exchange(handler);
+}
+
+inline bad_result_access_handler get_bad_result_access_handler() noexcept {
+	return detail::bad_result_access_handler_.load();
+}
+
+#endif /* TIM_RESULT_ACCESS_POLICY == TIM_RESULT_ACCESS_HANDLER */
+
+namespace detail {
+
+#if TIM_RESULT_ACCESS_POLICY == TIM_RESULT_ACCESS_THROW
+
+// 'BadResultAccess<void, true>', named through 'E' so that it only needs to be
+// complete where an error that opts in to it is thrown.
+template <class E>
+using shared_bad_result_access_t = std::conditional_t<sizeof(E) != 0u, BadResultAccess<void, true>, void>;
+
+// 'P' is 'E' for small trivially copyable errors, which are passed in
+// registers so that the caller need not spill its 'Result' to memory, and a
+// reference to the error otherwise.
+template <class E, class P>
+[[noreturn]] TIM_RESULT_COLD void throw_bad_result_access(P err) {
+	if constexpr(traits::bad_result_access_traits<std::remove_cv_t<E>>::shared && std::is_constructible_v<std::remove_cv_t<E>, P&&>) {
+		throw shared_bad_result_access_t<E>(std::forward<P>(err));
+	} else if constexpr(std::is_constructible_v<E, P&&>) {
+		throw BadResultAccess<E, true>(tim::in_place, std::forward<P>(err));
+	} else if constexpr(std::is_constructible_v<E, const E&>) {
+		throw BadResultAccess<E, true>(tim::in_place, std::as_const(err));
+	} else {
+		throw BadResultAccess<E, false>();
+	}
+}
+
+#elif TIM_RESULT_ACCESS_POLICY == TIM_RESULT_ACCESS_TERMINATE
+
+[[noreturn]] TIM_RESULT_COLD inline void terminate_bad_result_access() noexcept {
+	std::terminate();
+}
+
+#elif TIM_RESULT_ACCESS_POLICY == TIM_RESULT_ACCESS_HANDLER
+
+[[noreturn]] TIM_RESULT_COLD inline void handle_bad_result_access() {
+	if(bad_result_access_handler handler = get_bad_result_access_handler()) {
+		handler();
+	}
+	std::terminate();
+}
+
+#endif
+
+// Reports an access to the value of a 'Result' holding the error 'err',
+// according to 'TIM_RESULT_ACCESS_POLICY'.
+template <class E, class Err>
+[[noreturn]] void bad_result_access(Err&& err) {
+#if TIM_RESULT_ACCESS_POLICY == TIM_RESULT_ACCESS_THROW
+	using param_type = std::conditional_t<
+		std::is_trivially_copyable_v<E>
+			&& std::is_copy_constructible_v<E>
+			&& std::is_move_constructible_v<E>
+			&& sizeof(E) <= 2 * sizeof(void*),
+		std::remove_cv_t<E>,
+		Err&&
+	>;
+	detail::throw_bad_result_access<E, param_type>(std::forward<Err>(err));
+#else
+	static_cast<void>(err);
+# if TIM_RESULT_ACCESS_POLICY == TIM_RESULT_ACCESS_TERMINATE
+	detail::terminate_bad_result_access();
+# elif TIM_RESULT_ACCESS_POLICY == TIM_RESULT_ACCESS_HANDLER
+	detail::handle_bad_result_access();
+# elif defined(__GNUC__) || defined(__clang__)
+	__builtin_unreachable();
+# elif defined(_MSC_VER)
+	__assume(false);
+# else
+	std::terminate();
+# endif
+#endif
+}
+
+} /* namespace detail */
+
+namespace traits {
+
+/*
+ * Opt-in trait describing a "niche" in the object representation of 'T': a
+ * run of bytes that never holds a particular bit pattern while a 'T' is alive.
+ * When either alternative of a 'Result<T, E>' has a niche and the other
+ * alternative fits in the remaining bytes, the discriminant is stored in the
+ * niche instead of in a separate 'bool', so that e.g.
+ * 'sizeof(Result<std::unique_ptr<T>, E>) == sizeof(T*)' for a 'T*' with a
+ * niche.
+ *
+ * Specializations that enable a niche must provide:
+ *
+ *   static constexpr bool has_niche = true;
+ *   static constexpr std::size_t offset;  // First byte of the niche within 'T'.
+ *   static constexpr std::size_t size;    // Number of bytes in the niche.
+ *   static bool is_niche(const unsigned char* niche) noexcept;
+ *   static void set_niche(unsigned char* niche) noexcept;
+ *
+ * 'is_niche()' must return false for every live 'T', and must return true after
+ * 'set_niche()' has been applied to storage holding no live 'T'.
+ *
+ * The niche is read and written through the object representation, which
+ * constant evaluation does not allow: a 'Result' whose layout uses a niche
+ * cannot be used in constant expressions.  Niches are therefore only used for
+ * types that opt in.
+ */
+template <class T, class = void>
+struct niche_traits {
+	static constexpr bool has_niche = false;
+};
+
+template <class T>
+inline constexpr bool has_niche_v = niche_traits<std::remove_cv_t<T>>::has_niche;
+
+namespace detail {
+
+inline constexpr bool is_little_endian =
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+	false;
+#else
+	true;
+#endif
+
+} /* namespace detail */
+
+/*
+ * Niche in the least significant bit of a pointer-sized object whose value is
+ * always a pointer to an object aligned to at least 2 bytes.  Pointers have no
+ * niche by default, since a pointer may be tagged or point into a byte buffer;
+ * a pointer type whose values are always aligned opts in with:
+ *
+ *   template <>
+ *   struct tim::traits::niche_traits<Node*>:
+ *       tim::traits::pointer_low_bit_niche<Node*> {};
+ *
+ * 'std::unique_ptr<Node>' then gets the same niche.
+ */
+template <class P>
+struct pointer_low_bit_niche {
+	static_assert(sizeof(P) == sizeof(void*));
+
+	static constexpr bool has_niche = true;
+	static constexpr std::size_t offset = detail::is_little_endian ? 0u : sizeof(P) - 1u;
+	static constexpr std::size_t size = 1u;
+
+	static bool is_niche(const unsigned char* niche) noexcept { return (*niche & 1u) != 0u; }
+	static void set_niche(unsigned char* niche) noexcept { *niche = 1u; }
+};
+
+/*
+ * Niche for a pointer-sized object that is never null.
+ */
+template <class P>
+struct pointer_null_niche {
+	static_assert(sizeof(P) == sizeof(void*));
+
+	static constexpr bool has_niche = true;
+	static constexpr std::size_t offset = 0u;
+	static constexpr std::size_t size = sizeof(P);
+
+	static bool is_niche(const unsigned char* niche) noexcept {
+		for(std::size_t i = 0; i < size; ++i) {
+			if(niche[i] != 0u) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	static void set_niche(unsigned char* niche) noexcept {
+		for(std::size_t i = 0; i < size; ++i) {
+			niche[i] = 0u;
+		}
+	}
+};
+
+/*
+ * Niche for an enumeration that never holds the value 'Sentinel'.  Scoped
+ * enumerations opt in with:
+ *
+ *   template <>
+ *   struct tim::traits::niche_traits<MyError>:
+ *       tim::traits::enum_niche<MyError, MyError(0xFF)> {};
+ */
+template <class Enum, Enum Sentinel>
+struct enum_niche {
+	static_assert(std::is_enum_v<Enum>, "'enum_niche<Enum, Sentinel>' requires an enumeration type 'Enum'.");
+
+	static constexpr bool has_niche = true;
+	static constexpr std::size_t offset = 0u;
+	static constexpr std::size_t size = sizeof(Enum);
+
+	static bool is_niche(const unsigned char* niche) noexcept {
+		const auto value = static_cast<std::underlying_type_t<Enum>>(Sentinel);
+		const auto* sentinel = reinterpret_cast<const unsigned char*>(std::addressof(value));
+		for(std::size_t i = 0; i < size; ++i) {
+			if(niche[i] != sentinel[i]) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	static void set_niche(unsigned char* niche) noexcept {
+		const auto value = static_cast<std::underlying_type_t<Enum>>(Sentinel);
+		const auto* sentinel = reinterpret_cast<const unsigned char*>(std::addressof(value));
+		for(std::size_t i = 0; i < size; ++i) {
+			niche[i] = sentinel[i];
+		}
+	}
+};
+
+template <class T>
+struct niche_traits<
+	std::unique_ptr<T>,
+	std::enable_if_t<
+		has_niche_v<T*>
+		&& sizeof(std::unique_ptr<T>) == sizeof(T*)
+	>
+>: pointer_low_bit_niche<std::unique_ptr<T>> {};
+
+/*
+ * Opt-in trait: whether moving a 'T' to a new address and destroying the
+ * original can be done by copying its bytes instead (and not running the
+ * destructor of the original).  True for trivially copyable types and for the
+ * standard library types below; specialize it for others.  When both
+ * alternatives of a 'Result' are trivially relocatable, swapping a 'Result'
+ * holding a value with one holding an error exchanges their bytes instead of
+ * moving each alternative through a temporary.
+ *
+ * Standard containers are left out: whether they are relocatable depends on
+ * the standard library and on its debug mode.
+ */
+template <class T>
+struct is_trivially_relocatable: std::is_trivially_copyable<T> {};
+
+template <class T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<std::remove_cv_t<T>>::value;
+
+template <class T>
+struct is_trivially_relocatable<std::unique_ptr<T, std::default_delete<T>>>: std::true_type {};
+
+template <class T>
+struct is_trivially_relocatable<std::shared_ptr<T>>: std::true_type {};
+
+template <class T>
+struct is_trivially_relocatable<std::weak_ptr<T>>: std::true_type {};
+
+template <>
+struct is_trivially_relocatable<std::exception_ptr>: std::true_type {};
+
+template <class T, class E>
+struct is_trivially_relocatable<Result<T, E>>: std::bool_constant<
+	(std::is_void_v<T> || is_trivially_relocatable_v<T>) && is_trivially_relocatable_v<E>
+> {};
+
+/*
+ * Opt-in trait: whether the constructors of 'T' that assigning a 'Result'
+ * runs may be treated as if they cannot throw (e.g. a copy constructor that
+ * only throws 'std::bad_alloc', in a program that does not recover from
+ * running out of memory).  When an assignment or 'emplace()' replaces one
+ * alternative of a 'Result' with the other, it normally builds the new
+ * alternative in a temporary first, or moves the old one aside, so that it can
+ * restore the old state if the construction throws.  For hinted types the new
+ * alternative is constructed in place instead.  If such a construction does
+ * throw, 'std::terminate()' is called.
+ */
+template <class T>
+struct nothrow_assign_hint: std::false_type {};
+
+template <class T>
+inline constexpr bool nothrow_assign_hint_v = nothrow_assign_hint<std::remove_cv_t<T>>::value;
+
+} /* namespace traits */
+
+// Where a function was called from, as filled in by a default argument of
+// 'source_location::current()'.  Empty where the compiler cannot tell.
+struct source_location {
+#if defined(__GNUC__) || defined(__clang__) || (defined(_MSC_VER) && _MSC_VER >= 1926)
+	static constexpr source_location current(
+		const char* file = __builtin_FILE(),
+		const char* function = __builtin_FUNCTION(),
+		unsigned line = __builtin_LINE()
+	) noexcept {
+		return source_location{file, function, line};
+	}
+#else
+	static constexpr source_location current() noexcept {
+		return source_location{"", "", 0u};
+	}
+#endif
+
+	const char* file;
+	const char* function;
+	unsigned line;
+};
+
+namespace traits {
+
+/*
+ * Opt-in trait: how 'Result<T, E>::context()' records a breadcrumb in an 'E'.
+ * Specializations provide
+ *
+ *   static void append(E& error, const char* what, const source_location& where) noexcept;
+ *
+ * 'tim/result/error_trail.hpp' provides it for errors holding an
+ * 'error_trail', and 'tim/result/boxed_error.hpp' for boxed errors that do.
+ */
+template <class E, class = void>
+struct error_context_traits {};
+
+} /* namespace traits */
+
+namespace detail {
+
+template <class E, class = void>
+struct has_error_context: std::false_type {};
+
+template <class E>
+struct has_error_context<
+	E,
+	std::void_t<decltype(traits::error_context_traits<E>::append(
+		std::declval<E&>(),
+		std::declval<const char*>(),
+		std::declval<const source_location&>()
+	))>
+>: std::true_type {};
+
+template <class E>
+inline constexpr bool has_error_context_v = has_error_context<E>::value;
+
+} /* namespace detail */
+
 namespace detail {
 
 template <class T>
@@ -112,6 +613,204 @@ using is_cv_void = std::is_same<std::remove_cv_t<T>, void>;
 template <class T>
 inline constexpr bool is_cv_void_v = is_cv_void<T>::value;
 
+// Whether swapping a 'Result<T, E>' holding a value with one holding an error
+// exchanges their bytes.  Not done when both alternatives are trivially
+// copyable, since moving them through a temporary costs as much and can be
+// done in constant expressions.
+template <class T, class E>
+inline constexpr bool relocate_on_swap_v =
+	(is_cv_void_v<T> || traits::is_trivially_relocatable_v<T>)
+	&& traits::is_trivially_relocatable_v<E>
+	&& !((is_cv_void_v<T> || std::is_trivially_copyable_v<T>) && std::is_trivially_copyable_v<E>);
+
+inline void copy_bytes(void* dst, const void* src, std::size_t n) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+	__builtin_memcpy(dst, src, n);
+#else
+	std::memcpy(dst, src, n);
+#endif
+}
+
+template <class X>
+void swap_object_representations(X& a, X& b) noexcept {
+	unsigned char tmp[sizeof(X)];
+	detail::copy_bytes(tmp, static_cast<void*>(std::addressof(a)), sizeof(X));
+	detail::copy_bytes(static_cast<void*>(std::addressof(a)), static_cast<void*>(std::addressof(b)), sizeof(X));
+	detail::copy_bytes(static_cast<void*>(std::addressof(b)), tmp, sizeof(X));
+}
+
+// Whether replacing the other alternative of a 'Result' with an 'X' built from
+// 'Args' may construct the 'X' directly in the storage of the alternative it
+// replaces.
+template <class X, class ... Args>
+inline constexpr bool construct_in_place_v =
+	std::is_nothrow_constructible_v<X, Args&&...> || traits::nothrow_assign_hint_v<X>;
+
+// Calls 'f()', terminating if it throws.  Wraps the in place constructions
+// that 'construct_in_place_v' allows only because of a 'nothrow_assign_hint'.
+template <class F>
+constexpr void invoke_nothrow(F&& f) noexcept {
+	std::forward<F>(f)();
+}
+
+/*
+ * Allocators.
+ *
+ * A 'Result' has no allocator of its own: each alternative keeps its own.
+ * When one alternative replaces another (by assignment, 'emplace()' or
+ * 'swap()'), the new one is built by uses-allocator construction with the
+ * allocator of the old one ('get_allocator()'), if it uses that allocator
+ * ('std::uses_allocator').  So a 'Result<std::pmr::vector<int>,
+ * std::pmr::string>' keeps drawing from the same memory resource whichever
+ * alternative it holds.  Allocators that are always equal are not passed on,
+ * which leaves 'Result's of standard containers with 'std::allocator' as they
+ * were.  When the new alternative is assigned from another 'Result' or swapped
+ * with one, and its allocator propagates on that operation
+ * ('propagate_on_container_copy_assignment' and so on), it is built from the
+ * source as usual instead, taking the source's allocator.
+ */
+struct no_allocator_t {};
+
+// The allocator of an 'X', unless it has none or it is always equal.
+template <class X, class = void>
+struct alternative_allocator {
+	using type = no_allocator_t;
+};
+
+template <class X>
+struct alternative_allocator<
+	X,
+	std::void_t<typename X::allocator_type, decltype(std::declval<const X&>().get_allocator())>
+> {
+	using type = std::conditional_t<
+		std::allocator_traits<typename X::allocator_type>::is_always_equal::value,
+		no_allocator_t,
+		typename X::allocator_type
+	>;
+};
+
+template <class X>
+using alternative_allocator_t = typename alternative_allocator<X>::type;
+
+// Whether the allocator of an 'X' propagates on assignment and swap.
+template <class X, class = void>
+struct allocator_propagation {
+	static constexpr bool copy_assign = false;
+	static constexpr bool move_assign = false;
+	static constexpr bool swap = false;
+};
+
+template <class X>
+struct allocator_propagation<X, std::void_t<typename X::allocator_type>> {
+	using alloc_traits = std::allocator_traits<typename X::allocator_type>;
+	static constexpr bool copy_assign = alloc_traits::propagate_on_container_copy_assignment::value;
+	static constexpr bool move_assign = alloc_traits::propagate_on_container_move_assignment::value;
+	static constexpr bool swap = alloc_traits::propagate_on_container_swap::value;
+};
+
+// The allocator to build a 'To' with in place of a 'From'.
+template <class To, class From, bool Propagate = false>
+using replacement_allocator_t = std::conditional_t<
+	!Propagate
+	&& !std::is_same_v<alternative_allocator_t<From>, no_allocator_t>
+	&& std::uses_allocator_v<To, alternative_allocator_t<From>>,
+	alternative_allocator_t<From>,
+	no_allocator_t
+>;
+
+template <class To, bool Propagate = false, class From>
+constexpr replacement_allocator_t<To, From, Propagate> replacement_allocator(const From& from) noexcept {
+	if constexpr(std::is_same_v<replacement_allocator_t<To, From, Propagate>, no_allocator_t>) {
+		return no_allocator_t{};
+	} else {
+		return from.get_allocator();
+	}
+}
+
+// How uses-allocator construction builds an 'X' from 'Args' with an 'Alloc':
+// 0 without the allocator, 1 with leading 'std::allocator_arg, alloc', 2 with
+// a trailing 'alloc'.  Falls back to 0 if 'X' uses 'Alloc' but takes it in
+// neither position for these 'Args'.
+template <class X, class Alloc, class ... Args>
+constexpr int uses_allocator_form() noexcept {
+	if constexpr(std::is_same_v<Alloc, no_allocator_t> || !std::uses_allocator_v<X, Alloc>) {
+		return 0;
+	} else if constexpr(std::is_constructible_v<X, std::allocator_arg_t, const Alloc&, Args&&...>) {
+		return 1;
+	} else if constexpr(std::is_constructible_v<X, Args&&..., const Alloc&>) {
+		return 2;
+	} else {
+		return 0;
+	}
+}
+
+// 'std::uses_allocator_construction_args()' (C++20), but without the special
+// case for 'std::pair'.
+template <class X, class Alloc, class ... Args>
+constexpr auto uses_allocator_construction_args(const Alloc& alloc, Args&& ... args) noexcept {
+	constexpr int form = uses_allocator_form<X, Alloc, Args...>();
+	if constexpr(form == 1) {
+		return std::forward_as_tuple(std::allocator_arg, alloc, std::forward<Args>(args)...);
+	} else if constexpr(form == 2) {
+		return std::forward_as_tuple(std::forward<Args>(args)..., alloc);
+	} else {
+		(void)alloc;
+		return std::forward_as_tuple(std::forward<Args>(args)...);
+	}
+}
+
+template <class X, class Alloc, class ... Args>
+constexpr X make_obj_using_allocator(const Alloc& alloc, Args&& ... args) {
+	return std::make_from_tuple<X>(detail::uses_allocator_construction_args<X>(alloc, std::forward<Args>(args)...));
+}
+
+template <class X, class Alloc, class ... Args>
+inline constexpr bool is_nothrow_constructible_using_v =
+	uses_allocator_form<X, Alloc, Args...>() == 1
+		? std::is_nothrow_constructible_v<X, std::allocator_arg_t, const Alloc&, Args&&...>
+	: uses_allocator_form<X, Alloc, Args...>() == 2
+		? std::is_nothrow_constructible_v<X, Args&&..., const Alloc&>
+	: std::is_nothrow_constructible_v<X, Args&&...>;
+
+// 'construct_in_place_v' for uses-allocator construction with an 'Alloc'.
+template <class X, class Alloc, class ... Args>
+inline constexpr bool construct_in_place_using_v =
+	is_nothrow_constructible_using_v<X, Alloc, Args...> || traits::nothrow_assign_hint_v<X>;
+
+template <class X, class Alloc, class ... Args>
+inline constexpr bool is_constructible_using_v =
+	uses_allocator_form<X, Alloc, Args...>() == 1
+		? std::is_constructible_v<X, std::allocator_arg_t, const Alloc&, Args&&...>
+	: uses_allocator_form<X, Alloc, Args...>() == 2
+		? std::is_constructible_v<X, Args&&..., const Alloc&>
+	: std::is_constructible_v<X, Args&&...>;
+
+// A 'Data' (the storage of a 'Result') holding the alternative selected by
+// 'tag', an 'X' built from 'args' by uses-allocator construction.
+template <class Data, class X, class Tag, class Alloc, class ... Args>
+constexpr Data make_alternative_using(Tag tag, const Alloc& alloc, Args&& ... args) {
+	return std::make_from_tuple<Data>(std::tuple_cat(
+		std::make_tuple(tag),
+		detail::uses_allocator_construction_args<X>(alloc, std::forward<Args>(args)...)
+	));
+}
+
+// 'self.emplace_value()' and 'self.emplace_error()' by uses-allocator
+// construction of a 'T' or an 'E'.
+template <class T, class Self, class Alloc, class ... Args>
+constexpr void emplace_value_using(Self& self, const Alloc& alloc, Args&& ... args) {
+	std::apply([&self](auto&& ... xs) {
+		self.emplace_value(std::forward<decltype(xs)>(xs)...);
+	}, detail::uses_allocator_construction_args<T>(alloc, std::forward<Args>(args)...));
+}
+
+template <class E, class Self, class Alloc, class ... Args>
+constexpr void emplace_error_using(Self& self, const Alloc& alloc, Args&& ... args) {
+	std::apply([&self](auto&& ... xs) {
+		self.emplace_error(std::forward<decltype(xs)>(xs)...);
+	}, detail::uses_allocator_construction_args<E>(alloc, std::forward<Args>(args)...));
+}
+
 template <class T>
 struct ManualScopeGuard {
 
@@ -130,6 +829,65 @@ ManualScopeGuard<std::decay_t<T>> make_manual_scope_guard(T&& action) {
 	return ManualScopeGuard<std::decay_t<T>>{std::forward<T>(action), true};
 }
 
+// Replaces the value of 'self' with an error built from 'args' using 'alloc'.
+// The error is constructed in place if that cannot throw.  Otherwise the
+// value is moved aside first and restored if constructing the error throws,
+// or, if only 'E' can be moved without throwing, the error is built in a
+// temporary.  Failing both, the error is constructed in place without the
+// allocator, which cannot throw.
+template <class T, class E, class Self, class Alloc, class ... Args>
+constexpr void guarded_emplace_error_using(Self& self, const Alloc& alloc, Args&& ... args) {
+	if constexpr(construct_in_place_using_v<E, Alloc, Args&&...>) {
+		self.destruct_value();
+		invoke_nothrow([&](){
+			emplace_error_using<E>(self, alloc, std::forward<Args>(args)...);
+		});
+	} else if constexpr(std::is_nothrow_move_constructible_v<T>) {
+		T tmp(std::move(self.value()));
+		self.destruct_value();
+		auto guard = make_manual_scope_guard([&](){
+			self.emplace_value(std::move(tmp));
+		});
+		emplace_error_using<E>(self, alloc, std::forward<Args>(args)...);
+		guard.active = false;
+	} else if constexpr(std::is_nothrow_move_constructible_v<E>) {
+		E tmp = detail::make_obj_using_allocator<E>(alloc, std::forward<Args>(args)...);
+		self.destruct_value();
+		self.emplace_error(std::move(tmp));
+	} else {
+		static_assert(construct_in_place_v<E, Args&&...>);
+		self.destruct_value();
+		self.emplace_error(std::forward<Args>(args)...);
+	}
+}
+
+// Replaces the error of 'self' with a value, as above.
+template <class T, class E, class Self, class Alloc, class ... Args>
+constexpr void guarded_emplace_value_using(Self& self, const Alloc& alloc, Args&& ... args) {
+	if constexpr(construct_in_place_using_v<T, Alloc, Args&&...>) {
+		self.destruct_error();
+		invoke_nothrow([&](){
+			emplace_value_using<T>(self, alloc, std::forward<Args>(args)...);
+		});
+	} else if constexpr(std::is_nothrow_move_constructible_v<E>) {
+		E tmp(std::move(self.error()));
+		self.destruct_error();
+		auto guard = make_manual_scope_guard([&](){
+			self.emplace_error(std::move(tmp));
+		});
+		emplace_value_using<T>(self, alloc, std::forward<Args>(args)...);
+		guard.active = false;
+	} else if constexpr(std::is_nothrow_move_constructible_v<T>) {
+		T tmp = detail::make_obj_using_allocator<T>(alloc, std::forward<Args>(args)...);
+		self.destruct_error();
+		self.emplace_value(std::move(tmp));
+	} else {
+		static_assert(construct_in_place_v<T, Args&&...>);
+		self.destruct_error();
+		self.emplace_value(std::forward<Args>(args)...);
+	}
+}
+
 struct EmptyAlternative {};
 
 enum class MemberStatus {
@@ -147,6 +905,11 @@ struct error_tag_t {};
 inline constexpr value_tag_t value_tag = value_tag_t{};
 inline constexpr error_tag_t error_tag = error_tag_t{};
 
+// Constructs a storage from the active alternative of another one.
+struct other_tag_t {};
+
+inline constexpr other_tag_t other_tag = other_tag_t{};
+
 template <class Type, class ... T>
 struct first_type_matches: std::false_type {};
 
@@ -277,55 +1040,203 @@ struct ValueWrapper<T, true>: private T {
 
 };
 
-template <class T, class E>
-struct ResultUnionImpl<MemberStatus::Defaulted, T, E> {
+template <class T, std::size_t Offset>
+struct PlacedValueWrapper {
+	static_assert(Offset > 0u);
+	static_assert(Offset % alignof(ValueWrapper<T>) == 0u);
 
-	constexpr ResultUnionImpl() = default;
-	constexpr ResultUnionImpl(const ResultUnionImpl&) = default;
-	constexpr ResultUnionImpl(ResultUnionImpl&&) = default;
-	constexpr ResultUnionImpl& operator=(const ResultUnionImpl&) = default;
-	constexpr ResultUnionImpl& operator=(ResultUnionImpl&&) = default;
+	using value_type = T;
 
-	template <class ... Args>
-	constexpr ResultUnionImpl(value_tag_t, Args&& ... args):
-		value(std::forward<Args>(args)...)
-	{
-		
-	}
+	PlacedValueWrapper() = default;
 
-	template <class U, class ... Args>
-	constexpr ResultUnionImpl(value_tag_t, std::initializer_list<U> ilist, Args&& ... args):
-		value(ilist, std::forward<Args>(args)...)
-	{
-		
-	}
+	PlacedValueWrapper(const PlacedValueWrapper&) = default;
+	PlacedValueWrapper(PlacedValueWrapper&&) = default;
 
-	template <class ... Args>
-	constexpr ResultUnionImpl(error_tag_t, Args&& ... args):
-		error(std::forward<Args>(args)...)
+	template <
+		class ... Args,
+		std::enable_if_t<
+			std::is_constructible_v<T, Args&& ...>
+			&& std::conditional_t<
+				(sizeof...(Args) == 1),
+				std::negation<
+					std::disjunction<
+						std::is_same<PlacedValueWrapper, std::decay_t<Args>>...
+					>
+				>,
+				std::true_type
+			>::value,
+			bool
+		> = false
+	>
+	PlacedValueWrapper(Args&& ... args):
+		wrapped_(std::forward<Args>(args)...)
 	{
-		
+
 	}
 
-	template <class U, class ... Args>
-	constexpr ResultUnionImpl(error_tag_t, std::initializer_list<U> ilist, Args&& ... args):
-		error(ilist, std::forward<Args>(args)...)
+	template <
+		class U,
+		class ... Args,
+		std::enable_if_t<
+			std::is_constructible_v<T, std::initializer_list<U>&, Args&& ...>,
+			bool
+		> = false
+	>
+	PlacedValueWrapper(std::initializer_list<U> ilist, Args&& ... args):
+		wrapped_(ilist, std::forward<Args>(args)...)
 	{
-		
+
 	}
 
-	union {
-		ValueWrapper<std::conditional_t<is_cv_void_v<T>, EmptyAlternative, T>> value;
-		ValueWrapper<E> error;
-		EmptyAlternative hidden_;
-	};
+	PlacedValueWrapper& operator=(const PlacedValueWrapper&) = default;
+	PlacedValueWrapper& operator=(PlacedValueWrapper&&) = default;
+
+	constexpr const value_type&  value() const&  { return this->wrapped_.value(); }
+	constexpr       value_type&  value()      &  { return this->wrapped_.value(); }
+	constexpr const value_type&& value() const&& { return std::move(this->wrapped_).value(); }
+	constexpr       value_type&& value()      && { return std::move(this->wrapped_).value(); }
+
+private:
+	// Never written; these bytes belong to the niche of the other alternative.
+	unsigned char padding_[Offset];
+	ValueWrapper<T> wrapped_;
 };
 
-template <class T, class E>
-struct ResultUnionImpl<MemberStatus::Deleted, T, E> {
+template <class T, std::size_t Offset>
+using placed_value_wrapper_t = std::conditional_t<
+	(Offset == 0u),
+	ValueWrapper<T>,
+	PlacedValueWrapper<T, Offset>
+>;
 
-	constexpr ResultUnionImpl() = default;
-                  
+enum class NicheKind {
+	None,
+	Value,
+	Error
+};
+
+inline constexpr std::size_t no_placement = static_cast<std::size_t>(-1);
+
+// Byte offset at which an 'Other' can live inside the storage of an 'X'
+// without overlapping the niche of 'X', or 'no_placement' if it cannot.
+template <class X, class Other>
+constexpr std::size_t niche_placement() noexcept {
+	using niche = traits::niche_traits<std::remove_cv_t<X>>;
+	if constexpr(std::is_empty_v<Other>) {
+		return 0u;
+	} else if constexpr(sizeof(Other) > sizeof(X) || alignof(Other) > alignof(X)) {
+		return no_placement;
+	} else if constexpr(sizeof(Other) <= niche::offset) {
+		return 0u;
+	} else {
+		constexpr std::size_t niche_end = niche::offset + niche::size;
+		constexpr std::size_t offset = (niche_end + alignof(Other) - 1u) / alignof(Other) * alignof(Other);
+		if constexpr(offset + sizeof(Other) <= sizeof(X)) {
+			return offset;
+		} else {
+			return no_placement;
+		}
+	}
+}
+
+template <class T, class E>
+struct niche_layout {
+	using value_type = std::conditional_t<is_cv_void_v<T>, EmptyAlternative, T>;
+
+	static constexpr NicheKind niche_kind() noexcept {
+		if constexpr(!is_cv_void_v<T> && traits::has_niche_v<T>) {
+			if constexpr(niche_placement<T, E>() != no_placement) {
+				return NicheKind::Value;
+			}
+		}
+		if constexpr(traits::has_niche_v<E>) {
+			if constexpr(niche_placement<E, value_type>() != no_placement) {
+				return NicheKind::Error;
+			}
+		}
+		return NicheKind::None;
+	}
+
+	static constexpr NicheKind kind = niche_kind();
+
+	static constexpr std::size_t placed_value_offset() noexcept {
+		if constexpr(kind == NicheKind::Error) {
+			return niche_placement<E, value_type>();
+		} else {
+			return 0u;
+		}
+	}
+
+	static constexpr std::size_t placed_error_offset() noexcept {
+		if constexpr(kind == NicheKind::Value) {
+			return niche_placement<T, E>();
+		} else {
+			return 0u;
+		}
+	}
+
+	static constexpr std::size_t value_offset = placed_value_offset();
+	static constexpr std::size_t error_offset = placed_error_offset();
+
+	using value_wrapper = placed_value_wrapper_t<value_type, value_offset>;
+	using error_wrapper = placed_value_wrapper_t<E, error_offset>;
+};
+
+template <class T, class E>
+using result_value_wrapper_t = typename niche_layout<T, E>::value_wrapper;
+
+template <class T, class E>
+using result_error_wrapper_t = typename niche_layout<T, E>::error_wrapper;
+
+template <class T, class E>
+struct ResultUnionImpl<MemberStatus::Defaulted, T, E> {
+
+	constexpr ResultUnionImpl() = default;
+	constexpr ResultUnionImpl(const ResultUnionImpl&) = default;
+	constexpr ResultUnionImpl(ResultUnionImpl&&) = default;
+	constexpr ResultUnionImpl& operator=(const ResultUnionImpl&) = default;
+	constexpr ResultUnionImpl& operator=(ResultUnionImpl&&) = default;
+
+	template <class ... Args>
+	constexpr ResultUnionImpl(value_tag_t, Args&& ... args):
+		value(std::forward<Args>(args)...)
+	{
+		
+	}
+
+	template <class U, class ... Args>
+	constexpr ResultUnionImpl(value_tag_t, std::initializer_list<U> ilist, Args&& ... args):
+		value(ilist, std::forward<Args>(args)...)
+	{
+		
+	}
+
+	template <class ... Args>
+	constexpr ResultUnionImpl(error_tag_t, Args&& ... args):
+		error(std::forward<Args>(args)...)
+	{
+		
+	}
+
+	template <class U, class ... Args>
+	constexpr ResultUnionImpl(error_tag_t, std::initializer_list<U> ilist, Args&& ... args):
+		error(ilist, std::forward<Args>(args)...)
+	{
+		
+	}
+
+	union {
+		result_value_wrapper_t<T, E> value;
+		result_error_wrapper_t<T, E> error;
+		EmptyAlternative hidden_;
+	};
+};
+
+template <class T, class E>
+struct ResultUnionImpl<MemberStatus::Deleted, T, E> {
+
+	constexpr ResultUnionImpl() = default;
+                  
 	constexpr ResultUnionImpl(const ResultUnionImpl&) = default;
 	constexpr ResultUnionImpl(ResultUnionImpl&&) = default;
 
@@ -363,8 +1274,8 @@ struct ResultUnionImpl<MemberStatus::Deleted, T, E> {
 	}
 
 	union {
-		ValueWrapper<std::conditional_t<is_cv_void_v<T>, EmptyAlternative, T>> value;
-		ValueWrapper<E> error;
+		result_value_wrapper_t<T, E> value;
+		result_error_wrapper_t<T, E> error;
 		EmptyAlternative hidden_;
 	};
 };
@@ -411,8 +1322,8 @@ struct ResultUnionImpl<MemberStatus::Defined, T, E> {
 	}
 
 	union {
-		ValueWrapper<std::conditional_t<is_cv_void_v<T>, EmptyAlternative, T>> value;
-		ValueWrapper<E> error;
+		result_value_wrapper_t<T, E> value;
+		result_error_wrapper_t<T, E> error;
 		EmptyAlternative hidden_;
 	};
 };
@@ -440,52 +1351,244 @@ using ResultUnion = std::conditional_t<
 	ResultUnionImpl<MemberStatus::Deleted, T, E>
 >;
 
-template <class T, class E>
-struct ResultBaseMethods {
-	using value_type = std::conditional_t<is_cv_void_v<T>, EmptyAlternative, T>;
+template <class Storage>
+struct NicheDiscriminant {
+	operator bool() const noexcept { return storage->load_has_value(); }
 
-	constexpr ResultBaseMethods() = default;
+	NicheDiscriminant& operator=(bool v) noexcept {
+		storage->store_has_value(v);
+		return *this;
+	}
+
+	Storage* storage;
+};
+
+// Copies (or, if 'Other' is not an lvalue reference, moves) an alternative
+// of a 'Result' being copied (or moved) from.
+template <class Other, class X>
+constexpr decltype(auto) forward_alternative(X& x) noexcept {
+	if constexpr(std::is_lvalue_reference_v<Other>) {
+		return static_cast<const X&>(x);
+	} else {
+		return static_cast<X&&>(x);
+	}
+}
+
+// A union holding a copy of the active alternative of 'other', which provides
+// the accessors of 'ResultBaseMethods'.
+template <class T, class E, class Other>
+constexpr ResultUnion<T, E> make_result_union(Other&& other) {
+	if(TIM_RESULT_EXPECT_HAS_VALUE(other.has_value(), T, E)) {
+		return ResultUnion<T, E>(value_tag, forward_alternative<Other>(other.value()));
+	} else {
+		return ResultUnion<T, E>(error_tag, forward_alternative<Other>(other.error()));
+	}
+}
+
+template <class T, class E, NicheKind K = niche_layout<T, E>::kind>
+struct ResultStorage {
+	// The discriminant lives in a niche of 'T' (K == NicheKind::Value) or of
+	// 'E' (K == NicheKind::Error).  The niche is always written after the
+	// alternative sharing its bytes has been constructed.
+	using niche_owner = std::conditional_t<K == NicheKind::Value, T, E>;
+	using niche = traits::niche_traits<std::remove_cv_t<niche_owner>>;
+
+	static_assert(K != NicheKind::None);
+	static_assert(niche::offset + niche::size <= sizeof(niche_owner));
+
+	ResultStorage() = default;
+
+	template <class ... Args>
+	ResultStorage(value_tag_t, Args&& ... args):
+		data_(value_tag, std::forward<Args>(args)...)
+	{
+		store_has_value(true);
+	}
+
+	template <class U, class ... Args>
+	ResultStorage(value_tag_t, std::initializer_list<U> ilist, Args&& ... args):
+		data_(value_tag, ilist, std::forward<Args>(args)...)
+	{
+		store_has_value(true);
+	}
+
+	template <class ... Args>
+	ResultStorage(error_tag_t, Args&& ... args):
+		data_(error_tag, std::forward<Args>(args)...)
+	{
+		store_has_value(false);
+	}
+
+	template <class U, class ... Args>
+	ResultStorage(error_tag_t, std::initializer_list<U> ilist, Args&& ... args):
+		data_(error_tag, ilist, std::forward<Args>(args)...)
+	{
+		store_has_value(false);
+	}
+
+	// Reads the discriminant before moving from 'other', whose niche may be
+	// part of the moved-from alternative.
+	template <class Other>
+	ResultStorage(other_tag_t, Other&& other):
+		ResultStorage(other_tag, std::forward<Other>(other), other.has_value())
+	{
+
+	}
+
+	bool has_value() const noexcept { return load_has_value(); }
+	NicheDiscriminant<ResultStorage> has_value() noexcept { return NicheDiscriminant<ResultStorage>{this}; }
+
+protected:
+	ResultUnion<T, E> data_;
+
+private:
+	template <class Storage>
+	friend struct NicheDiscriminant;
+
+	template <class Other>
+	ResultStorage(other_tag_t, Other&& other, bool has_value):
+		data_(make_result_union<T, E>(std::forward<Other>(other)))
+	{
+		store_has_value(has_value);
+	}
+
+	bool load_has_value() const noexcept {
+		return niche::is_niche(niche_bytes()) == (K == NicheKind::Error);
+	}
+
+	void store_has_value(bool v) noexcept {
+		if(v == (K == NicheKind::Error)) {
+			niche::set_niche(niche_bytes());
+		}
+	}
+
+	const unsigned char* niche_bytes() const noexcept {
+		return reinterpret_cast<const unsigned char*>(std::addressof(data_)) + niche::offset;
+	}
+
+	unsigned char* niche_bytes() noexcept {
+		return reinterpret_cast<unsigned char*>(std::addressof(data_)) + niche::offset;
+	}
+};
+
+// The flag is stored as an unsigned word as wide as the alignment of the union,
+// so that the storage has no tail padding and every copy moves the whole word.
+// Otherwise the Itanium ABI lets derived classes reuse the padding, and GCC can
+// no longer keep a 'Result' that is passed or returned in registers out of
+// memory, nor forward one unchanged through a chain of branches.
+template <std::size_t Align>
+struct result_flag_word { using type = std::uint64_t; };
+
+template <>
+struct result_flag_word<1> { using type = std::uint8_t; };
+
+template <>
+struct result_flag_word<2> { using type = std::uint16_t; };
+
+template <>
+struct result_flag_word<4> { using type = std::uint32_t; };
+
+template <std::size_t Align>
+struct alignas(Align) ResultFlag {
+	typename result_flag_word<Align>::type value;
+};
+
+template <class Word>
+struct ResultFlagReference {
+	constexpr operator bool() const noexcept { return *word != 0; }
+
+	constexpr ResultFlagReference& operator=(bool v) noexcept {
+		*word = v;
+		return *this;
+	}
+
+	Word* word;
+};
+
+template <class T, class E>
+struct ResultStorage<T, E, NicheKind::None> {
+	constexpr ResultStorage() = default;
 
 	template <class ... Args>
-	constexpr ResultBaseMethods(value_tag_t, Args&& ... args):
+	constexpr ResultStorage(value_tag_t, Args&& ... args):
 		data_(value_tag, std::forward<Args>(args)...),
-		has_value_(true)
+		has_value_{true}
 	{
 		
 	}
 
 	template <class U, class ... Args>
-	constexpr ResultBaseMethods(value_tag_t, std::initializer_list<U> ilist, Args&& ... args):
+	constexpr ResultStorage(value_tag_t, std::initializer_list<U> ilist, Args&& ... args):
 		data_(value_tag, ilist, std::forward<Args>(args)...),
-		has_value_(true)
+		has_value_{true}
 	{
 		
 	}
 
 	template <class ... Args>
-	constexpr ResultBaseMethods(error_tag_t, Args&& ... args):
+	constexpr ResultStorage(error_tag_t, Args&& ... args):
 		data_(error_tag, std::forward<Args>(args)...),
-		has_value_(false)
+		has_value_{false}
 	{
 		
 	}
 
 	template <class U, class ... Args>
-	constexpr ResultBaseMethods(error_tag_t, std::initializer_list<U> ilist, Args&& ... args):
+	constexpr ResultStorage(error_tag_t, std::initializer_list<U> ilist, Args&& ... args):
 		data_(error_tag, ilist, std::forward<Args>(args)...),
-		has_value_(false)
+		has_value_{false}
 	{
 		
 	}
 
-	constexpr const value_type& value() const { return std::launder(std::addressof(data_.value))->value(); }
-	constexpr       value_type& value()       { return std::launder(std::addressof(data_.value))->value(); }
+	template <class Other>
+	constexpr ResultStorage(other_tag_t, Other&& other):
+		data_(make_result_union<T, E>(std::forward<Other>(other))),
+		has_value_{other.has_value()}
+	{
+
+	}
+
+	constexpr bool has_value() const noexcept { return has_value_.value != 0; }
+	constexpr auto has_value()       noexcept { return ResultFlagReference<flag_word>{&has_value_.value}; }
+
+protected:
+	ResultUnion<T, E> data_;
+
+private:
+	using flag_type = ResultFlag<alignof(ResultUnion<T, E>)>;
+	using flag_word = decltype(flag_type::value);
+
+	flag_type has_value_{true};
+};
+
+// 'std::launder()' is only needed when the replaced alternative might have const
+// or reference subobjects.  Non-const scalars never do, and skipping the launder
+// for them matters: GCC treats it as an escape of the pointer and forces the
+// whole 'Result' into memory.
+template <class T, class P>
+constexpr P* launder_alternative(P* p) noexcept {
+	if constexpr(std::is_scalar_v<T> && !std::is_const_v<T>) {
+		return p;
+	} else {
+		return std::launder(p);
+	}
+}
+
+template <class T, class E>
+struct ResultBaseMethods: ResultStorage<T, E> {
+	using value_type = std::conditional_t<is_cv_void_v<T>, EmptyAlternative, T>;
+	using storage_type = ResultStorage<T, E>;
+	using storage_type::storage_type;
+	using storage_type::has_value;
+
+	constexpr ResultBaseMethods() = default;
 
-	constexpr const E& error() const { return std::launder(std::addressof(data_.error))->value(); }
-	constexpr       E& error()       { return std::launder(std::addressof(data_.error))->value(); }
+	constexpr const value_type& value() const { return launder_alternative<value_type>(std::addressof(this->data_.value))->value(); }
+	constexpr       value_type& value()       { return launder_alternative<value_type>(std::addressof(this->data_.value))->value(); }
 
-	constexpr const bool& has_value() const noexcept { return has_value_; }
-	constexpr bool&       has_value()       noexcept { return has_value_; }
+	constexpr const E& error() const { return launder_alternative<E>(std::addressof(this->data_.error))->value(); }
+	constexpr       E& error()       { return launder_alternative<E>(std::addressof(this->data_.error))->value(); }
 
 	template <
 		class ... Args,
@@ -497,7 +1600,7 @@ struct ResultBaseMethods {
 	constexpr void emplace_value(Args&& ... args)
 		noexcept(std::is_nothrow_constructible_v<value_type, Args&&...>)
 	{
-		new (std::addressof(data_.value)) ValueWrapper<T>(std::forward<Args>(args)...);
+		new (std::addressof(this->data_.value)) result_value_wrapper_t<T, E>(std::forward<Args>(args)...);
 	}
 
 	template <
@@ -511,7 +1614,7 @@ struct ResultBaseMethods {
 	constexpr void emplace_value(std::initializer_list<U> ilist, Args&& ... args)
 		noexcept(std::is_nothrow_constructible_v<value_type, std::initializer_list<U>&, Args&&...>)
 	{
-		new (std::addressof(data_.value)) ValueWrapper<T>(ilist, std::forward<Args>(args)...);
+		new (std::addressof(this->data_.value)) result_value_wrapper_t<T, E>(ilist, std::forward<Args>(args)...);
 	}
 
 	template <
@@ -524,7 +1627,7 @@ struct ResultBaseMethods {
 	constexpr void emplace_error(Args&& ... args)
 		noexcept(std::is_nothrow_constructible_v<E, Args&&...>)
 	{
-		(new (std::addressof(data_.error)) ValueWrapper<E>(std::forward<Args>(args)...))->value();
+		(new (std::addressof(this->data_.error)) result_error_wrapper_t<T, E>(std::forward<Args>(args)...))->value();
 	}
 
 	template <
@@ -538,7 +1641,7 @@ struct ResultBaseMethods {
 	constexpr void emplace_error(std::initializer_list<U> ilist, Args&& ... args)
 		noexcept(std::is_nothrow_constructible_v<E, std::initializer_list<U>&, Args&&...>)
 	{
-		(new (std::addressof(data_.error)) ValueWrapper<E>(ilist, std::forward<Args>(args)...))->value();
+		(new (std::addressof(this->data_.error)) result_error_wrapper_t<T, E>(ilist, std::forward<Args>(args)...))->value();
 	}
 
 	constexpr void destruct_value() noexcept {
@@ -548,18 +1651,18 @@ struct ResultBaseMethods {
 				std::negation<std::is_trivially_destructible<T>>
 			>
 		) {
-			std::destroy_at(std::addressof(data_.value));
+			std::destroy_at(std::addressof(this->data_.value));
 		}
 	}
 
 	constexpr void destruct_error() noexcept {
 		if constexpr(!std::is_trivially_destructible_v<E>) {
-			std::destroy_at(std::addressof(data_.error));
+			std::destroy_at(std::addressof(this->data_.error));
 		}
 	}
 
 	constexpr void destruct() noexcept {
-		if(has_value()) {
+		if(TIM_RESULT_EXPECT_HAS_VALUE(has_value(), T, E)) {
 			destruct_value();
 		} else {
 			destruct_error();
@@ -575,17 +1678,7 @@ struct ResultBaseMethods {
 		> = false
 	>
 	constexpr void guarded_emplace_error(Args&& ... args) {
-		T tmp(std::move(this->value()));
-		destruct_value();
-		if constexpr(std::is_nothrow_constructible_v<E, Args&&...>) {
-			this->emplace_error(std::forward<Args>(args)...);
-		} else {
-			auto guard = make_manual_scope_guard([&](){
-				this->emplace_value(std::move(tmp));
-			});
-			this->emplace_error(std::forward<Args>(args)...);
-			guard.active = false;
-		}
+		detail::guarded_emplace_error_using<T, E>(*this, detail::replacement_allocator<E>(this->value()), std::forward<Args>(args)...);
 	}
 
 	template <
@@ -597,17 +1690,7 @@ struct ResultBaseMethods {
 		> = false
 	>
 	constexpr void guarded_emplace_error(std::initializer_list<U> ilist, Args&& ... args) {
-		T tmp(std::move(this->value()));
-		destruct_value();
-		if constexpr(std::is_nothrow_constructible_v<E, std::initializer_list<U>&, Args&&...>) {
-			this->emplace_error(ilist, std::forward<Args>(args)...);
-		} else {
-			auto guard = make_manual_scope_guard([&](){
-				this->emplace_value(std::move(tmp));
-			});
-			this->emplace_error(ilist, std::forward<Args>(args)...);
-			guard.active = false;
-		}
+		detail::guarded_emplace_error_using<T, E>(*this, detail::replacement_allocator<E>(this->value()), ilist, std::forward<Args>(args)...);
 	}
 
 	template <
@@ -619,17 +1702,7 @@ struct ResultBaseMethods {
 		> = false
 	>
 	constexpr void guarded_emplace_value(Args&& ... args) {
-		E tmp(std::move(this->error()));
-		this->destruct_error();
-		if constexpr(std::is_nothrow_constructible_v<T, Args&&...>) {
-			this->emplace_value(std::forward<Args>(args)...);
-		} else {
-			auto guard = make_manual_scope_guard([&](){
-				this->emplace_error(std::move(tmp));
-			});
-			this->emplace_value(std::forward<Args>(args)...);
-			guard.active = false;
-		}
+		detail::guarded_emplace_value_using<T, E>(*this, detail::replacement_allocator<T>(this->error()), std::forward<Args>(args)...);
 	}
 
 	template <
@@ -641,43 +1714,19 @@ struct ResultBaseMethods {
 		> = false
 	>
 	constexpr void guarded_emplace_value(std::initializer_list<U> ilist, Args&& ... args) {
-		E tmp(std::move(this->error()));
-		this->destruct_error();
-		if constexpr(std::is_nothrow_constructible_v<T, std::initializer_list<U>&, Args&&...>) {
-			this->emplace_value(ilist, std::forward<Args>(args)...);
-		} else {
-			auto guard = make_manual_scope_guard([&](){
-				this->emplace_error(std::move(tmp));
-			});
-			this->emplace_value(ilist, std::forward<Args>(args)...);
-			guard.active = false;
-		}
+		detail::guarded_emplace_value_using<T, E>(*this, detail::replacement_allocator<T>(this->error()), ilist, std::forward<Args>(args)...);
 	}
 
 	[[noreturn]]
-	void throw_bad_result_access() const& noexcept(false) {
-		if constexpr(std::is_constructible_v<E, const E&>) {
-			throw BadResultAccess<E, true>(tim::in_place, this->error());
-		} else {
-			throw BadResultAccess<E, false>();
-		}
+	void bad_result_access() const& noexcept(false) {
+		detail::bad_result_access<E>(this->error());
 	}
 	
 	[[noreturn]]
-	void throw_bad_result_access() && noexcept(false) {
-		if constexpr(std::is_constructible_v<E, E&&>) {
-			throw BadResultAccess<E, true>(tim::in_place, std::move(this->error()));
-		} else if constexpr(std::is_constructible_v<E, const E&>) {
-			throw BadResultAccess<E, true>(tim::in_place, this->error());
-		} else {
-			throw BadResultAccess<E, false>();
-		}
+	void bad_result_access() && noexcept(false) {
+		detail::bad_result_access<E>(std::move(this->error()));
 	}
-	
 
-private:
-	ResultUnion<T, E> data_;
-	bool has_value_ = true;
 };
 
 template <MemberStatus S, class T, class E>
@@ -698,170 +1747,234 @@ struct ResultCopyAssign;
 template <MemberStatus S, class T, class E>
 struct ResultMoveAssign;
 
+constexpr MemberStatus member_status(bool available, bool trivial) noexcept {
+	return !available ? MemberStatus::Deleted : trivial ? MemberStatus::Defaulted : MemberStatus::Defined;
+}
+
+// Which special members 'Result<T, E>' has, and which of them are trivial.
 template <class T, class E>
-using result_destructor_type = std::conditional_t<
-	std::conjunction_v<
-		std::disjunction<
-			detail::is_cv_void<T>,
-			std::is_trivially_destructible<T>
-		>,
-		std::is_trivially_destructible<E>
-	>,
-	ResultDestructor<MemberStatus::Defaulted, T, E>,
-	ResultDestructor<MemberStatus::Defined, T, E>
->;
+struct result_member_traits {
+	static constexpr bool void_value = is_cv_void_v<T>;
+
+	static constexpr bool trivially_destructible =
+		(void_value || std::is_trivially_destructible_v<T>)
+		&& std::is_trivially_destructible_v<E>;
+
+	static constexpr bool default_constructible =
+		void_value || std::is_default_constructible_v<T>;
+
+	static constexpr bool copy_constructible =
+		(void_value || std::is_copy_constructible_v<T>)
+		&& std::is_copy_constructible_v<E>;
+	static constexpr bool trivially_copy_constructible = copy_constructible
+		&& (void_value || std::is_trivially_copy_constructible_v<T>)
+		&& std::is_trivially_copy_constructible_v<E>;
+
+	static constexpr bool move_constructible =
+		(void_value || std::is_move_constructible_v<T>)
+		&& std::is_move_constructible_v<E>;
+	static constexpr bool trivially_move_constructible = move_constructible
+		&& (void_value || std::is_trivially_move_constructible_v<T>)
+		&& std::is_trivially_move_constructible_v<E>;
+
+	static constexpr bool copy_assignable = void_value
+		? std::is_copy_assignable_v<E> && std::is_copy_constructible_v<E>
+		: std::is_copy_assignable_v<T> && std::is_copy_assignable_v<E>
+			&& std::is_copy_constructible_v<T> && std::is_copy_constructible_v<E>
+			&& (std::is_nothrow_move_constructible_v<T> || std::is_nothrow_move_constructible_v<E>);
+	static constexpr bool trivially_copy_assignable = copy_assignable
+		&& (void_value || (
+			std::is_trivially_copy_assignable_v<T>
+			&& std::is_trivially_copy_constructible_v<T>
+			&& std::is_trivially_destructible_v<T>
+		))
+		&& std::is_trivially_copy_assignable_v<E>
+		&& std::is_trivially_copy_constructible_v<E>
+		&& std::is_trivially_destructible_v<E>;
+
+	static constexpr bool move_assignable = void_value
+		? std::is_move_assignable_v<E> && std::is_move_constructible_v<E>
+		: std::is_move_assignable_v<T> && std::is_move_constructible_v<T>
+			&& std::is_move_assignable_v<E> && std::is_move_constructible_v<E>
+			&& (std::is_nothrow_move_constructible_v<T> || std::is_nothrow_move_constructible_v<E>);
+	static constexpr bool trivially_move_assignable = move_assignable
+		&& (void_value || (
+			std::is_trivially_move_assignable_v<T>
+			&& std::is_trivially_move_constructible_v<T>
+			&& std::is_trivially_destructible_v<T>
+		))
+		&& std::is_trivially_move_assignable_v<E>
+		&& std::is_trivially_move_constructible_v<E>
+		&& std::is_trivially_destructible_v<E>;
+
+	static constexpr MemberStatus destructor =
+		trivially_destructible ? MemberStatus::Defaulted : MemberStatus::Defined;
+	// Don't actually want trivial default initialization.
+	static constexpr MemberStatus default_constructor = member_status(default_constructible, false);
+	static constexpr MemberStatus copy_constructor = member_status(copy_constructible, trivially_copy_constructible);
+	static constexpr MemberStatus move_constructor = member_status(move_constructible, trivially_move_constructible);
+	static constexpr MemberStatus copy_assign = member_status(copy_assignable, trivially_copy_assignable);
+	static constexpr MemberStatus move_assign = member_status(move_assignable, trivially_move_assignable);
+};
 
 template <class T, class E>
-using result_default_constructor_type = std::conditional_t<
-	std::disjunction_v<
-		detail::is_cv_void<T>,
-		std::is_default_constructible<T>
-	>,
-	std::conditional_t<
-		// Don't actually want trivial default initialization.
-		// std::conjunction_v<
-		// 	std::disjunction<
-		// 		detail::is_cv_void<T>,
-		// 		std::is_trivially_default_constructible<T>
-		// 	>,
-		// 	std::is_trivially_default_constructible<E>
-		// >,
-		false,
-		ResultDefaultConstructor<MemberStatus::Defaulted, T, E>,
-		ResultDefaultConstructor<MemberStatus::Defined, T, E>
-	>,
-	ResultDefaultConstructor<MemberStatus::Deleted, T, E>
->;
+using result_destructor_type = ResultDestructor<result_member_traits<T, E>::destructor, T, E>;
 
+template <class T, class E>
+using result_default_constructor_type = ResultDefaultConstructor<result_member_traits<T, E>::default_constructor, T, E>;
 
 template <class T, class E>
-using result_copy_constructor_type = std::conditional_t<
-	std::conjunction_v<
-		std::disjunction<
-			detail::is_cv_void<T>,
-			std::is_copy_constructible<T>
-		>,
-		std::is_copy_constructible<E>
-	>,
-	std::conditional_t<
-		std::conjunction_v<
-			std::disjunction<
-				detail::is_cv_void<T>,
-				std::is_trivially_copy_constructible<T>
-			>,
-			std::is_trivially_copy_constructible<E>
-		>,
-		ResultCopyConstructor<MemberStatus::Defaulted, T, E>,
-		ResultCopyConstructor<MemberStatus::Defined, T, E>
-	>,
-	ResultCopyConstructor<MemberStatus::Deleted, T, E>
->;
+using result_copy_constructor_type = ResultCopyConstructor<result_member_traits<T, E>::copy_constructor, T, E>;
 
 template <class T, class E>
-using result_move_constructor_type = std::conditional_t<
-	std::conjunction_v<
-		std::disjunction<
-			detail::is_cv_void<T>,
-			std::is_move_constructible<T>
-		>,
-		std::is_move_constructible<E>
-	>,
-	std::conditional_t<
-		std::conjunction_v<
-			std::disjunction<
-				detail::is_cv_void<T>,
-				std::is_trivially_move_constructible<T>
-			>,
-			std::is_trivially_move_constructible<E>
-		>,
-		ResultMoveConstructor<MemberStatus::Defaulted, T, E>,
-		ResultMoveConstructor<MemberStatus::Defined, T, E>
-	>,
-	ResultMoveConstructor<MemberStatus::Deleted, T, E>
->;
+using result_move_constructor_type = ResultMoveConstructor<result_member_traits<T, E>::move_constructor, T, E>;
 
 template <class T, class E>
-using result_copy_assign_type = std::conditional_t<
-	std::disjunction_v<
-		std::conjunction<
-			detail::is_cv_void<T>,
-			std::is_copy_assignable<E>,
-			std::is_copy_constructible<E>
-		>,
-		std::conjunction<
-			std::negation<detail::is_cv_void<T>>,
-			std::is_copy_assignable<T>,
-			std::is_copy_assignable<E>,
-			std::is_copy_constructible<T>,
-			std::is_copy_constructible<E>,
-			std::disjunction<
-				std::is_nothrow_move_constructible<T>,
-				std::is_nothrow_move_constructible<E>
-			>
-		>
-	>,
-	std::conditional_t<
-		std::conjunction_v<
-			std::disjunction<
-				detail::is_cv_void<T>,
-				std::conjunction<
-					std::is_trivially_copy_assignable<T>,
-					std::is_trivially_copy_constructible<T>,
-					std::is_trivially_destructible<T>
-				>
-			>,
-			std::is_trivially_copy_assignable<E>,
-			std::is_trivially_copy_constructible<E>,
-			std::is_trivially_destructible<E>
-		>,
-		ResultCopyAssign<MemberStatus::Defaulted, T, E>,
-		ResultCopyAssign<MemberStatus::Defined, T, E>
-	>,
-	ResultCopyAssign<MemberStatus::Deleted, T, E>
->;
+using result_copy_assign_type = ResultCopyAssign<result_member_traits<T, E>::copy_assign, T, E>;
 
 template <class T, class E>
-using result_move_assign_type = std::conditional_t<
-	std::disjunction_v<
-		std::conjunction<
-			detail::is_cv_void<T>,
-			std::is_move_assignable<E>,
-			std::is_move_constructible<E>
-		>,
-		std::conjunction<
-			std::negation<detail::is_cv_void<T>>,
-			std::is_move_assignable<T>,
-			std::is_move_constructible<T>,
-			std::is_move_assignable<E>,
-			std::is_move_constructible<E>,
-			std::disjunction<
-				std::is_nothrow_move_constructible<T>,
-				std::is_nothrow_move_constructible<E>
-			>
-		>
-	>,
-	std::conditional_t<
-		std::conjunction_v<
-			std::disjunction<
-				detail::is_cv_void<T>,
-				std::conjunction<
-					std::is_trivially_move_assignable<T>,
-					std::is_trivially_move_constructible<T>,
-					std::is_trivially_destructible<T>
-				>
-			>,
-			std::is_trivially_move_assignable<E>,
-			std::is_trivially_move_constructible<E>,
-			std::is_trivially_destructible<E>
-		>,
-		ResultMoveAssign<MemberStatus::Defaulted, T, E>,
-		ResultMoveAssign<MemberStatus::Defined, T, E>
-	>,
-	ResultMoveAssign<MemberStatus::Deleted, T, E>
->;
+using result_move_assign_type = ResultMoveAssign<result_member_traits<T, E>::move_assign, T, E>;
 
-template <class T, class E>
-using result_data_type = result_move_assign_type<T, E>;
+// Copy and move assignment between two 'Result<T, E>' storages.  The case
+// selected by the pair of 'bool_constant's is (this has a value, other has a
+// value).  Shared by the member chain below and 'ResultData'.
+template <class T, class E, class Self>
+constexpr void copy_assign_case(Self& self, const Self& other, std::true_type, std::true_type) {
+	if constexpr(!is_cv_void_v<T>) {
+		self.value() = other.value();
+	}
+}
+
+template <class T, class E, class Self>
+constexpr void copy_assign_case(Self& self, const Self& other, std::false_type, std::false_type) {
+	self.error() = other.error();
+}
+
+template <class T, class E, class Self>
+constexpr void copy_assign_case(Self& self, const Self& other, std::false_type, std::true_type) {
+	if constexpr(is_cv_void_v<T>) {
+		self.destruct_error();
+	} else {
+		constexpr bool propagate = allocator_propagation<T>::copy_assign;
+		using alloc_type = replacement_allocator_t<T, E, propagate>;
+		const alloc_type alloc = replacement_allocator<T, propagate>(self.error());
+		if constexpr(construct_in_place_using_v<T, alloc_type, const T&>) {
+			self.destruct_error();
+			invoke_nothrow([&](){
+				emplace_value_using<T>(self, alloc, other.value());
+			});
+		} else if constexpr(std::is_nothrow_move_constructible_v<T>) {
+			T tmp = detail::make_obj_using_allocator<T>(alloc, other.value());
+			self.destruct_error();
+			self.emplace_value(std::move(tmp));
+		} else {
+			static_assert(std::is_nothrow_move_constructible_v<E>);
+			guarded_emplace_value_using<T, E>(self, alloc, other.value());
+		}
+	}
+	self.has_value() = true;
+}
+
+template <class T, class E, class Self>
+constexpr void copy_assign_case(Self& self, const Self& other, std::true_type, std::false_type) {
+	if constexpr(is_cv_void_v<T>) {
+		self.emplace_error(other.error());
+	} else {
+		constexpr bool propagate = allocator_propagation<E>::copy_assign;
+		using alloc_type = replacement_allocator_t<E, T, propagate>;
+		const alloc_type alloc = replacement_allocator<E, propagate>(self.value());
+		if constexpr(construct_in_place_using_v<E, alloc_type, const E&>) {
+			self.destruct_value();
+			invoke_nothrow([&](){
+				emplace_error_using<E>(self, alloc, other.error());
+			});
+		} else if constexpr(std::is_nothrow_move_constructible_v<E>) {
+			E tmp = detail::make_obj_using_allocator<E>(alloc, other.error());
+			self.destruct_value();
+			self.emplace_error(std::move(tmp));
+		} else {
+			static_assert(std::is_nothrow_move_constructible_v<T>);
+			guarded_emplace_error_using<T, E>(self, alloc, other.error());
+		}
+	}
+	self.has_value() = false;
+}
+
+template <class T, class E, class Self>
+constexpr void move_assign_case(Self& self, Self&& other, std::true_type, std::true_type) {
+	if constexpr(!is_cv_void_v<T>) {
+		self.value() = std::move(other.value());
+	}
+}
+
+template <class T, class E, class Self>
+constexpr void move_assign_case(Self& self, Self&& other, std::false_type, std::false_type) {
+	self.error() = std::move(other.error());
+}
+
+template <class T, class E, class Self>
+constexpr void move_assign_case(Self& self, Self&& other, std::false_type, std::true_type) {
+	if constexpr(is_cv_void_v<T>) {
+		self.destruct_error();
+	} else {
+		constexpr bool propagate = allocator_propagation<T>::move_assign;
+		guarded_emplace_value_using<T, E>(
+			self,
+			replacement_allocator<T, propagate>(self.error()),
+			std::move(other.value())
+		);
+	}
+	self.has_value() = true;
+}
+
+template <class T, class E, class Self>
+constexpr void move_assign_case(Self& self, Self&& other, std::true_type, std::false_type) {
+	if constexpr(is_cv_void_v<T>) {
+		self.emplace_error(std::move(other.error()));
+	} else {
+		constexpr bool propagate = allocator_propagation<E>::move_assign;
+		guarded_emplace_error_using<T, E>(
+			self,
+			replacement_allocator<E, propagate>(self.value()),
+			std::move(other.error())
+		);
+	}
+	self.has_value() = false;
+}
+
+template <class T, class E, class Self>
+constexpr void copy_assign_result(Self& self, const Self& other) {
+	if(TIM_RESULT_EXPECT_HAS_VALUE(self.has_value(), T, E)) {
+		if(TIM_RESULT_EXPECT_HAS_VALUE(other.has_value(), T, E)) {
+			copy_assign_case<T, E>(self, other, std::true_type{}, std::true_type{});
+		} else {
+			copy_assign_case<T, E>(self, other, std::true_type{}, std::false_type{});
+		}
+	} else {
+		if(TIM_RESULT_EXPECT_HAS_VALUE(other.has_value(), T, E)) {
+			copy_assign_case<T, E>(self, other, std::false_type{}, std::true_type{});
+		} else {
+			copy_assign_case<T, E>(self, other, std::false_type{}, std::false_type{});
+		}
+	}
+}
+
+template <class T, class E, class Self>
+constexpr void move_assign_result(Self& self, Self&& other) {
+	if(TIM_RESULT_EXPECT_HAS_VALUE(self.has_value(), T, E)) {
+		if(TIM_RESULT_EXPECT_HAS_VALUE(other.has_value(), T, E)) {
+			move_assign_case<T, E>(self, std::move(other), std::true_type{}, std::true_type{});
+		} else {
+			move_assign_case<T, E>(self, std::move(other), std::true_type{}, std::false_type{});
+		}
+	} else {
+		if(TIM_RESULT_EXPECT_HAS_VALUE(other.has_value(), T, E)) {
+			move_assign_case<T, E>(self, std::move(other), std::false_type{}, std::true_type{});
+		} else {
+			move_assign_case<T, E>(self, std::move(other), std::false_type{}, std::false_type{});
+		}
+	}
+}
 
 template <class T, class E>
 struct ResultDestructor<MemberStatus::Defaulted, T, E>:
@@ -879,7 +1992,7 @@ struct ResultDestructor<MemberStatus::Defaulted, T, E>:
 	using base_type::emplace_error;
 	using base_type::guarded_emplace_value;
 	using base_type::guarded_emplace_error;
-	using base_type::throw_bad_result_access;
+	using base_type::bad_result_access;
 
 	constexpr ResultDestructor() = default;
 
@@ -906,7 +2019,7 @@ struct ResultDestructor<MemberStatus::Defined, T, E>:
 	using base_type::emplace_error;
 	using base_type::guarded_emplace_value;
 	using base_type::guarded_emplace_error;
-	using base_type::throw_bad_result_access;
+	using base_type::bad_result_access;
 	
 	constexpr ResultDestructor() = default;
 	constexpr ResultDestructor(const ResultDestructor&) = default;
@@ -935,7 +2048,7 @@ struct ResultDefaultConstructor<MemberStatus::Defaulted, T, E>:
 	using base_type::emplace_error;
 	using base_type::guarded_emplace_value;
 	using base_type::guarded_emplace_error;
-	using base_type::throw_bad_result_access;
+	using base_type::bad_result_access;
 
 	constexpr ResultDefaultConstructor() = default;
 	constexpr ResultDefaultConstructor(const ResultDefaultConstructor&) = default;
@@ -960,7 +2073,7 @@ struct ResultDefaultConstructor<MemberStatus::Deleted, T, E>:
 	using base_type::emplace_error;
 	using base_type::guarded_emplace_value;
 	using base_type::guarded_emplace_error;
-	using base_type::throw_bad_result_access;
+	using base_type::bad_result_access;
 
 	constexpr ResultDefaultConstructor() = delete;
 	constexpr ResultDefaultConstructor(const ResultDefaultConstructor&) = default;
@@ -985,7 +2098,7 @@ struct ResultDefaultConstructor<MemberStatus::Defined, T, E>:
 	using base_type::emplace_error;
 	using base_type::guarded_emplace_value;
 	using base_type::guarded_emplace_error;
-	using base_type::throw_bad_result_access;
+	using base_type::bad_result_access;
 	
 	constexpr ResultDefaultConstructor() noexcept(std::is_nothrow_default_constructible_v<T>):
 		base_type(value_tag)
@@ -1015,7 +2128,7 @@ struct ResultCopyConstructor<MemberStatus::Defaulted, T, E>:
 	using base_type::emplace_error;
 	using base_type::guarded_emplace_value;
 	using base_type::guarded_emplace_error;
-	using base_type::throw_bad_result_access;
+	using base_type::bad_result_access;
 
 	constexpr ResultCopyConstructor() = default;
 	constexpr ResultCopyConstructor(const ResultCopyConstructor&) = default;
@@ -1040,7 +2153,7 @@ struct ResultCopyConstructor<MemberStatus::Deleted, T, E>:
 	using base_type::emplace_error;
 	using base_type::guarded_emplace_value;
 	using base_type::guarded_emplace_error;
-	using base_type::throw_bad_result_access;
+	using base_type::bad_result_access;
 
 	constexpr ResultCopyConstructor() = default;
 	constexpr ResultCopyConstructor(const ResultCopyConstructor&) = delete;
@@ -1058,7 +2171,7 @@ struct ResultCopyConstructor<MemberStatus::Defined, T, E>
 	constexpr ResultCopyConstructor() = default;
 	constexpr ResultCopyConstructor(const ResultCopyConstructor& other):
 		base_([&other]{
-			if(other.has_value()) {
+			if(TIM_RESULT_EXPECT_HAS_VALUE(other.has_value(), T, E)) {
 				return base_type(value_tag, other.value());
 			} else {
 				return base_type(error_tag, other.error());
@@ -1107,8 +2220,8 @@ struct ResultCopyConstructor<MemberStatus::Defined, T, E>
 	constexpr const E& error() const { return base_.error(); }
 	constexpr       E& error()       { return base_.error(); }
 
-	constexpr const bool& has_value() const noexcept { return base_.has_value(); }
-	constexpr bool&       has_value()       noexcept { return base_.has_value(); }
+	constexpr decltype(auto) has_value() const noexcept { return base_.has_value(); }
+	constexpr decltype(auto) has_value()       noexcept { return base_.has_value(); }
 
 	template <
 		class ... Args,
@@ -1213,10 +2326,10 @@ struct ResultCopyConstructor<MemberStatus::Defined, T, E>
 	}
 
 	[[noreturn]]
-	void throw_bad_result_access() const& noexcept(false) { base_.throw_bad_result_access(); }
+	void bad_result_access() const& noexcept(false) { base_.bad_result_access(); }
 
 	[[noreturn]]
-	void throw_bad_result_access() && noexcept(false) { std::move(base_).throw_bad_result_access(); }
+	void bad_result_access() && noexcept(false) { std::move(base_).bad_result_access(); }
 
 	constexpr void destruct_value() noexcept {
 		return base_.destruct_value();
@@ -1252,7 +2365,7 @@ struct ResultMoveConstructor<MemberStatus::Defaulted, T, E>:
 	using base_type::emplace_error;
 	using base_type::guarded_emplace_value;
 	using base_type::guarded_emplace_error;
-	using base_type::throw_bad_result_access;
+	using base_type::bad_result_access;
 
 	constexpr ResultMoveConstructor() = default;
 	constexpr ResultMoveConstructor(const ResultMoveConstructor&) = default;
@@ -1281,7 +2394,7 @@ struct ResultMoveConstructor<MemberStatus::Deleted, T, E>:
 	using base_type::emplace_error;
 	using base_type::guarded_emplace_value;
 	using base_type::guarded_emplace_error;
-	using base_type::throw_bad_result_access;
+	using base_type::bad_result_access;
 
 	constexpr ResultMoveConstructor() = default;
 	constexpr ResultMoveConstructor(const ResultMoveConstructor&) = default;
@@ -1307,7 +2420,7 @@ struct ResultMoveConstructor<MemberStatus::Defined, T, E> {
 		>
 	):
 		base_([&]{
-			if(other.has_value()) {
+			if(TIM_RESULT_EXPECT_HAS_VALUE(other.has_value(), T, E)) {
 				return base_type(value_tag, std::move(other.value()));
 			} else {
 				return base_type(error_tag, std::move(other.error()));
@@ -1354,8 +2467,8 @@ struct ResultMoveConstructor<MemberStatus::Defined, T, E> {
 	constexpr const E& error() const { return base_.error(); }
 	constexpr       E& error()       { return base_.error(); }
 
-	constexpr const bool& has_value() const noexcept { return base_.has_value(); }
-	constexpr bool&       has_value()       noexcept { return base_.has_value(); }
+	constexpr decltype(auto) has_value() const noexcept { return base_.has_value(); }
+	constexpr decltype(auto) has_value()       noexcept { return base_.has_value(); }
 
 	template <
 		class ... Args,
@@ -1460,10 +2573,10 @@ struct ResultMoveConstructor<MemberStatus::Defined, T, E> {
 	}
 
 	[[noreturn]]
-	void throw_bad_result_access() const& noexcept(false) { base_.throw_bad_result_access(); }
+	void bad_result_access() const& noexcept(false) { base_.bad_result_access(); }
 
 	[[noreturn]]
-	void throw_bad_result_access() && noexcept(false) { std::move(base_).throw_bad_result_access(); }
+	void bad_result_access() && noexcept(false) { std::move(base_).bad_result_access(); }
 
 	constexpr void destruct_value() noexcept {
 		return base_.destruct_value();
@@ -1497,7 +2610,7 @@ struct ResultCopyAssign<MemberStatus::Defaulted, T, E>:
 	using base_type::emplace_error;
 	using base_type::guarded_emplace_value;
 	using base_type::guarded_emplace_error;
-	using base_type::throw_bad_result_access;
+	using base_type::bad_result_access;
 
 	constexpr ResultCopyAssign() = default;
 	constexpr ResultCopyAssign(const ResultCopyAssign&) = default;
@@ -1522,7 +2635,7 @@ struct ResultCopyAssign<MemberStatus::Deleted, T, E>:
 	using base_type::emplace_error;
 	using base_type::guarded_emplace_value;
 	using base_type::guarded_emplace_error;
-	using base_type::throw_bad_result_access;
+	using base_type::bad_result_access;
 
 	constexpr ResultCopyAssign() = default;
 	constexpr ResultCopyAssign(const ResultCopyAssign&) = default;
@@ -1547,7 +2660,7 @@ struct ResultCopyAssign<MemberStatus::Defined, T, E>:
 	using base_type::emplace_error;
 	using base_type::guarded_emplace_value;
 	using base_type::guarded_emplace_error;
-	using base_type::throw_bad_result_access;
+	using base_type::bad_result_access;
 	
 	constexpr ResultCopyAssign() = default;
 	constexpr ResultCopyAssign(const ResultCopyAssign& other) = default;
@@ -1558,68 +2671,11 @@ struct ResultCopyAssign<MemberStatus::Defined, T, E>:
 		&& std::is_nothrow_copy_constructible_v<E>
 		&& std::is_nothrow_copy_assignable_v<E>
 	) {
-		if(this->has_value()) {
-			if(other.has_value()) {
-				copy_assign_case(other, std::true_type{}, std::true_type{});
-			} else {
-				copy_assign_case(other, std::true_type{}, std::false_type{});
-			}
-		} else {
-			if(other.has_value()) {
-				copy_assign_case(other, std::false_type{}, std::true_type{});
-			} else {
-				copy_assign_case(other, std::false_type{}, std::false_type{});
-			}
-		}
+		detail::copy_assign_result<T, E>(*this, other);
 		return *this;
 	}
 
 	constexpr ResultCopyAssign& operator=(ResultCopyAssign&&) = default;
-
-private:
-	constexpr void copy_assign_case(const ResultCopyAssign& other, std::true_type, std::true_type) {
-		if constexpr(!is_cv_void_v<T>) {
-			value() = other.value();
-		}
-	}
-
-	constexpr void copy_assign_case(const ResultCopyAssign& other, std::false_type, std::false_type) {
-		error() = other.error();
-	}
-
-	constexpr void copy_assign_case(const ResultCopyAssign& other, std::false_type, std::true_type) {
-		if constexpr(is_cv_void_v<T>) {
-			destruct_error();
-		} else if constexpr(std::is_nothrow_copy_constructible_v<T>) {
-			destruct_error();
-			this->emplace_value(other.value());
-		} else if constexpr(std::is_nothrow_move_constructible_v<T>) {
-			T tmp(other.value());
-			destruct_error();
-			this->emplace_value(std::move(tmp));
-		} else {
-			static_assert(std::is_nothrow_move_constructible_v<E>);
-			this->guarded_emplace_value(other.value());
-		}
-		has_value() = true;
-	}
-
-	constexpr void copy_assign_case(const ResultCopyAssign& other, std::true_type, std::false_type) {
-		if constexpr(is_cv_void_v<T>) {
-			this->emplace_error(other.error());
-		} else if constexpr(std::is_nothrow_copy_constructible_v<E>) {
-			destruct_value();
-			this->emplace_error(other.error());
-		} else if constexpr(std::is_nothrow_move_constructible_v<E>) {
-			E tmp(other.error());
-			destruct_value();
-			this->emplace_error(std::move(tmp));
-		} else {
-			static_assert(std::is_nothrow_move_constructible_v<T>);
-			this->guarded_emplace_error(other.error());
-		}
-		has_value() = false;
-	}
 };
 
 template <class T, class E>
@@ -1638,7 +2694,7 @@ struct ResultMoveAssign<MemberStatus::Defaulted, T, E>:
 	using base_type::emplace_error;
 	using base_type::guarded_emplace_value;
 	using base_type::guarded_emplace_error;
-	using base_type::throw_bad_result_access;
+	using base_type::bad_result_access;
 
 	constexpr ResultMoveAssign() = default;
 	constexpr ResultMoveAssign(const ResultMoveAssign&) = default;
@@ -1663,7 +2719,7 @@ struct ResultMoveAssign<MemberStatus::Deleted, T, E>:
 	using base_type::emplace_error;
 	using base_type::guarded_emplace_value;
 	using base_type::guarded_emplace_error;
-	using base_type::throw_bad_result_access;
+	using base_type::bad_result_access;
 
 	constexpr ResultMoveAssign() = default;
 	constexpr ResultMoveAssign(const ResultMoveAssign&) = default;
@@ -1688,7 +2744,7 @@ struct ResultMoveAssign<MemberStatus::Defined, T, E>:
 	using base_type::emplace_error;
 	using base_type::guarded_emplace_value;
 	using base_type::guarded_emplace_error;
-	using base_type::throw_bad_result_access;
+	using base_type::bad_result_access;
 	
 	constexpr ResultMoveAssign() = default;
 	constexpr ResultMoveAssign(const ResultMoveAssign& other) = default;
@@ -1700,62 +2756,183 @@ struct ResultMoveAssign<MemberStatus::Defined, T, E>:
 		&& std::is_nothrow_move_constructible_v<E>
 		&& std::is_nothrow_move_assignable_v<E>
 	) {
-		if(this->has_value()) {
-			if(other.has_value()) {
-				move_assign_case(std::move(other), std::true_type{}, std::true_type{});
-			} else {
-				move_assign_case(std::move(other), std::true_type{}, std::false_type{});
-			}
-		} else {
-			if(other.has_value()) {
-				move_assign_case(std::move(other), std::false_type{}, std::true_type{});
-			} else {
-				move_assign_case(std::move(other), std::false_type{}, std::false_type{});
-			}
-		}
+		detail::move_assign_result<T, E>(*this, std::move(other));
 		return *this;
 	}
-private:
-	constexpr void move_assign_case(ResultMoveAssign&& other, std::true_type, std::true_type) {
-		if constexpr(!is_cv_void_v<T>) {
-			value() = std::move(other.value());
-		}
+};
+
+#if TIM_RESULT_HAS_CONDITIONALLY_TRIVIAL_MEMBERS
+// With C++20 constraints, each special member can be trivial, user-provided or
+// deleted according to 'result_member_traits' within a single class, rather
+// than through one base class per member as above.  This is much cheaper to
+// instantiate.
+template <class T, class E>
+struct ResultData: ResultBaseMethods<T, E> {
+	using base_type = ResultBaseMethods<T, E>;
+	using traits_type = result_member_traits<T, E>;
+
+	// Not 'using base_type::base_type': GCC 12 then no longer sees the
+	// constrained default constructor as user-provided, so a 'const Result'
+	// could not be default-initialized.
+	template <class ... Args>
+	constexpr ResultData(value_tag_t, Args&& ... args):
+		base_type(value_tag, std::forward<Args>(args)...)
+	{
+
 	}
 
-	constexpr void move_assign_case(ResultMoveAssign&& other, std::false_type, std::false_type) {
-		error() = std::move(other.error());
+	template <class U, class ... Args>
+	constexpr ResultData(value_tag_t, std::initializer_list<U> ilist, Args&& ... args):
+		base_type(value_tag, ilist, std::forward<Args>(args)...)
+	{
+
 	}
 
-	constexpr void move_assign_case(ResultMoveAssign&& other, std::false_type, std::true_type) {
-		if constexpr(is_cv_void_v<T>) {
-			destruct_error();
-		} else if constexpr(std::is_nothrow_move_constructible_v<T>) {
-			destruct_error();
-			this->emplace_value(std::move(other.value()));
-		} else {
-			static_assert(
-				std::is_nothrow_move_constructible_v<E>,
-				"The move assignment operator should be defined as deleted!"
-			);
-			this->guarded_emplace_value(std::move(other.value()));
-		}
-		has_value() = true;
+	template <class ... Args>
+	constexpr ResultData(error_tag_t, Args&& ... args):
+		base_type(error_tag, std::forward<Args>(args)...)
+	{
+
 	}
 
-	constexpr void move_assign_case(ResultMoveAssign&& other, std::true_type, std::false_type) {
-		if constexpr(is_cv_void_v<T>) {
-			this->emplace_error(std::move(other.error()));
-		} else if constexpr(std::is_nothrow_move_constructible_v<E>) {
-			destruct_value();
-			this->emplace_error(std::move(other.error()));
-		} else {
-			static_assert(std::is_nothrow_move_constructible_v<T>);
-			this->guarded_emplace_error(std::move(other.error()));
-		}
-		has_value() = false;
+	template <class U, class ... Args>
+	constexpr ResultData(error_tag_t, std::initializer_list<U> ilist, Args&& ... args):
+		base_type(error_tag, ilist, std::forward<Args>(args)...)
+	{
+
+	}
+
+	constexpr ResultData() noexcept(std::is_nothrow_default_constructible_v<T>)
+		requires traits_type::default_constructible:
+		base_type(value_tag)
+	{
+
+	}
+
+	constexpr ResultData() requires (!traits_type::default_constructible) = delete;
+
+	constexpr ResultData(const ResultData&)
+		requires traits_type::trivially_copy_constructible = default;
+
+	constexpr ResultData(const ResultData& other)
+		requires (traits_type::copy_constructible && !traits_type::trivially_copy_constructible):
+		base_type(other_tag, other)
+	{
+
+	}
+
+	constexpr ResultData(const ResultData&) requires (!traits_type::copy_constructible) = delete;
+
+	constexpr ResultData(ResultData&&)
+		requires traits_type::trivially_move_constructible = default;
+
+	constexpr ResultData(ResultData&& other) noexcept(
+		std::conjunction_v<
+			std::disjunction<
+				detail::is_cv_void<T>,
+				std::is_nothrow_move_constructible<T>
+			>,
+			std::is_nothrow_move_constructible<E>
+		>
+	)
+		requires (traits_type::move_constructible && !traits_type::trivially_move_constructible):
+		base_type(other_tag, std::move(other))
+	{
+
+	}
+
+	constexpr ResultData(ResultData&&) requires (!traits_type::move_constructible) = delete;
+
+	constexpr ResultData& operator=(const ResultData&)
+		requires traits_type::trivially_copy_assignable = default;
+
+	constexpr ResultData& operator=(const ResultData& other) noexcept(
+		std::disjunction_v<detail::is_cv_void<T>, std::is_nothrow_copy_constructible<T>>
+		&& std::disjunction_v<detail::is_cv_void<T>, std::is_nothrow_copy_assignable<T>>
+		&& std::is_nothrow_copy_constructible_v<E>
+		&& std::is_nothrow_copy_assignable_v<E>
+	)
+		requires (traits_type::copy_assignable && !traits_type::trivially_copy_assignable)
+	{
+		detail::copy_assign_result<T, E>(*this, other);
+		return *this;
+	}
+
+	constexpr ResultData& operator=(const ResultData&) requires (!traits_type::copy_assignable) = delete;
+
+	constexpr ResultData& operator=(ResultData&&)
+		requires traits_type::trivially_move_assignable = default;
+
+	constexpr ResultData& operator=(ResultData&& other) noexcept(
+		std::disjunction_v<detail::is_cv_void<T>, std::is_nothrow_move_constructible<T>>
+		&& std::disjunction_v<detail::is_cv_void<T>, std::is_nothrow_move_assignable<T>>
+		&& std::is_nothrow_move_constructible_v<E>
+		&& std::is_nothrow_move_assignable_v<E>
+	)
+		requires (traits_type::move_assignable && !traits_type::trivially_move_assignable)
+	{
+		detail::move_assign_result<T, E>(*this, std::move(other));
+		return *this;
+	}
+
+	constexpr ResultData& operator=(ResultData&&) requires (!traits_type::move_assignable) = delete;
+
+	~ResultData() requires traits_type::trivially_destructible = default;
+
+	~ResultData() requires (!traits_type::trivially_destructible) {
+		this->destruct();
 	}
 };
 
+// GCC 12 stops treating a class as trivially copyable when a deleted copy or
+// move member is selected over an unsatisfied user-provided one.  That only
+// matters when both alternatives are trivially copyable, and then only for the
+// rare ones with a deleted copy or move member, which keep the chain.
+template <class T, class E>
+inline constexpr bool result_data_needs_chain_v =
+	std::conjunction_v<
+		std::disjunction<is_cv_void<T>, std::is_trivially_copyable<T>>,
+		std::is_trivially_copyable<E>
+	>
+	&& (
+		!result_member_traits<T, E>::copy_constructible
+		|| !result_member_traits<T, E>::move_constructible
+		|| !result_member_traits<T, E>::copy_assignable
+		|| !result_member_traits<T, E>::move_assignable
+	);
+
+template <class T, class E>
+using result_data_type = std::conditional_t<
+	result_data_needs_chain_v<T, E>,
+	result_move_assign_type<T, E>,
+	ResultData<T, E>
+>;
+#else
+template <class T, class E>
+using result_data_type = result_move_assign_type<T, E>;
+#endif
+
+// The register-passable contract: when 'T' (or cv 'void') and 'E' are
+// trivially copyable, so is 'Result<T, E>', and each of its copy constructor,
+// move constructor and destructor is trivial whenever it is trivial for both
+// alternatives.  Under the Itanium C++ ABI this is what allows a 'Result' of at
+// most two eightbytes to be passed and returned in registers (RAX:RDX on
+// x86-64) instead of through a hidden pointer.  Every 'Result' specialization
+// checks this against its 'data_type', and the codegen tests under
+// 'tests/codegen' check the generated code itself.
+template <template <class> class Trait, class T, class E>
+inline constexpr bool preserves_trait_v = !std::conjunction_v<
+	std::disjunction<is_cv_void<T>, Trait<T>>,
+	Trait<E>
+> || Trait<result_data_type<T, E>>::value;
+
+template <class T, class E>
+inline constexpr bool satisfies_register_passable_contract_v =
+	preserves_trait_v<std::is_trivially_copyable, T, E>
+	&& preserves_trait_v<std::is_trivially_copy_constructible, T, E>
+	&& preserves_trait_v<std::is_trivially_move_constructible, T, E>
+	&& preserves_trait_v<std::is_trivially_destructible, T, E>;
+
 } /* namespace detail */
 
 
@@ -1995,9 +3172,9 @@ struct Error {
 	}
 
 	constexpr const E&  value() const &  { return error_; }
-	constexpr const E&& value() const && { return error_; }
+	constexpr const E&& value() const && { return std::move(error_); }
 	constexpr       E&  value()       &  { return error_; }
-	constexpr       E&& value()       && { return error_; }
+	constexpr       E&& value()       && { return std::move(error_); }
 
 	constexpr void swap(Error& other) noexcept(std::is_nothrow_swappable_v<E>) {
 		using std::swap;
@@ -2067,6 +3244,199 @@ struct error_value_type<Error<E>> {
 template <class E>
 using error_value_type_t = typename error_value_type<E>::type;
 
+// A reference to the error of a 'Result' that is being propagated to the
+// caller by 'TIM_TRY()'.  Every 'Result' whose error type can be converted from
+// the referenced error is implicitly constructible from an 'ErrorReference', so
+// that the error is constructed directly in the caller's 'Result' instead of
+// going through an 'Error<E>' temporary.
+template <class Ref>
+struct ErrorReference {
+	static_assert(std::is_reference_v<Ref>);
+	Ref error;
+};
+
+template <class T>
+struct is_error_reference: std::false_type {};
+
+template <class Ref>
+struct is_error_reference<ErrorReference<Ref>>: std::true_type {};
+
+template <class R>
+constexpr ErrorReference<decltype(std::declval<R>().error())> propagate_error(R&& r) noexcept {
+	static_assert(traits::is_result_v<std::remove_cv_t<std::remove_reference_t<R>>>,
+		"TIM_TRY() requires an expression of type Result<T, E>.");
+	return {std::forward<R>(r).error()};
+}
+
+template <class R>
+constexpr decltype(auto) try_value(R&& r) noexcept {
+	if constexpr(!is_cv_void_v<typename std::remove_reference_t<R>::value_type>) {
+		return *std::forward<R>(r);
+	}
+}
+
+template <class C, class T, class = void>
+struct gets_member_object: std::false_type {};
+
+// Whether 'T' wraps a 'C' that 'get()' returns, like 'std::reference_wrapper'.
+template <class C, class T>
+struct gets_member_object<C, T, std::void_t<decltype(std::declval<T&>().get())>>:
+	std::is_base_of<C, std::remove_cv_t<std::remove_reference_t<decltype(std::declval<T&>().get())>>> {};
+
+// The object a pointer to a member of 'C' is applied to, as with 'std::invoke()'.
+template <class C, class T>
+constexpr decltype(auto) member_object(T&& t) {
+	if constexpr(std::is_base_of_v<C, std::remove_cv_t<std::remove_reference_t<T>>>) {
+		return std::forward<T>(t);
+	} else if constexpr(gets_member_object<C, std::remove_reference_t<T>>::value) {
+		return t.get();
+	} else {
+		return *std::forward<T>(t);
+	}
+}
+
+template <class C, class M, class T, class ... Args>
+constexpr decltype(auto) invoke_member(M C::* f, T&& t, Args&& ... args) {
+	if constexpr(std::is_function_v<M>) {
+		return (member_object<C>(std::forward<T>(t)).*f)(std::forward<Args>(args)...);
+	} else {
+		static_assert(sizeof...(Args) == 0, "A pointer to a data member takes no arguments.");
+		return member_object<C>(std::forward<T>(t)).*f;
+	}
+}
+
+// 'std::invoke()' is not constexpr until C++20, and needs '<functional>'.
+template <class F, class ... Args>
+constexpr decltype(auto) invoke(F&& f, Args&& ... args) {
+	if constexpr(std::is_member_pointer_v<std::decay_t<F>>) {
+		return detail::invoke_member(f, std::forward<Args>(args)...);
+	} else {
+		return std::forward<F>(f)(std::forward<Args>(args)...);
+	}
+}
+
+template <class R>
+using result_value_t = typename std::remove_cv_t<std::remove_reference_t<R>>::value_type;
+
+template <class R>
+using result_error_t = typename std::remove_cv_t<std::remove_reference_t<R>>::error_type;
+
+// Calls 'f' with the value held by 'self', forwarded with the value category
+// of 'self', or with no arguments if 'self' is a 'Result<cv void, E>'.
+template <class Self, class F>
+constexpr decltype(auto) invoke_with_value(Self&& self, F&& f) {
+	if constexpr(is_cv_void_v<result_value_t<Self>>) {
+		return detail::invoke(std::forward<F>(f));
+	} else {
+		return detail::invoke(std::forward<F>(f), *std::forward<Self>(self));
+	}
+}
+
+template <class Self, class F>
+constexpr decltype(auto) invoke_with_error(Self&& self, F&& f) {
+	return detail::invoke(std::forward<F>(f), std::forward<Self>(self).error());
+}
+
+template <class Self, class F>
+using value_invoke_result_t = decltype(detail::invoke_with_value(std::declval<Self>(), std::declval<F>()));
+
+template <class Self, class F>
+using error_invoke_result_t = decltype(detail::invoke_with_error(std::declval<Self>(), std::declval<F>()));
+
+// Constructs a 'Result' of type 'R' holding the value of 'self'.
+template <class R, class Self>
+constexpr R forward_value(Self&& self) {
+	if constexpr(is_cv_void_v<result_value_t<Self>>) {
+		return R(tim::in_place);
+	} else {
+		return R(tim::in_place, *std::forward<Self>(self));
+	}
+}
+
+// Constructs a 'Result' of type 'R' holding the error of 'self'.  When 'R' is
+// the type of 'self' the whole object is copied or moved instead, which lets
+// the compiler keep a register-passed 'Result' in the same registers rather
+// than rebuilding it from the error alone.
+template <class R, class Self>
+constexpr R forward_error(Self&& self) {
+	if constexpr(std::is_same_v<R, std::remove_cv_t<std::remove_reference_t<Self>>>) {
+		return R(std::forward<Self>(self));
+	} else {
+		return R(tim::in_place_error, std::forward<Self>(self).error());
+	}
+}
+
+template <class Self, class F>
+constexpr auto result_map(Self&& self, F&& f) {
+	using value_type = std::decay_t<value_invoke_result_t<Self&&, F&&>>;
+	using result_type = Result<value_type, result_error_t<Self>>;
+	if(!TIM_RESULT_EXPECT_HAS_VALUE(self.has_value(), result_value_t<Self>, result_error_t<Self>)) {
+		return forward_error<result_type>(std::forward<Self>(self));
+	}
+	if constexpr(std::is_void_v<value_type>) {
+		detail::invoke_with_value(std::forward<Self>(self), std::forward<F>(f));
+		return result_type(tim::in_place);
+	} else {
+		return result_type(tim::in_place, detail::invoke_with_value(std::forward<Self>(self), std::forward<F>(f)));
+	}
+}
+
+template <class Self, class F>
+constexpr auto result_map_error(Self&& self, F&& f) {
+	using invoke_type = std::decay_t<error_invoke_result_t<Self&&, F&&>>;
+	using error_type = std::conditional_t<std::is_void_v<invoke_type>, std::monostate, invoke_type>;
+	using result_type = Result<result_value_t<Self>, error_type>;
+	if(TIM_RESULT_EXPECT_HAS_VALUE(self.has_value(), result_value_t<Self>, result_error_t<Self>)) {
+		return forward_value<result_type>(std::forward<Self>(self));
+	}
+	if constexpr(std::is_void_v<invoke_type>) {
+		detail::invoke_with_error(std::forward<Self>(self), std::forward<F>(f));
+		return result_type(tim::in_place_error);
+	} else {
+		return result_type(tim::in_place_error, detail::invoke_with_error(std::forward<Self>(self), std::forward<F>(f)));
+	}
+}
+
+template <class Self, class F>
+constexpr auto result_and_then(Self&& self, F&& f) {
+	using result_type = std::remove_cv_t<std::remove_reference_t<value_invoke_result_t<Self&&, F&&>>>;
+	static_assert(traits::is_result_v<result_type>,
+		"The function passed to Result<T, E>::and_then() must return a Result.");
+	static_assert(std::is_same_v<result_error_t<result_type>, result_error_t<Self>>,
+		"The function passed to Result<T, E>::and_then() must return a Result with error type 'E'.");
+	if(!TIM_RESULT_EXPECT_HAS_VALUE(self.has_value(), result_value_t<Self>, result_error_t<Self>)) {
+		return forward_error<result_type>(std::forward<Self>(self));
+	}
+	return detail::invoke_with_value(std::forward<Self>(self), std::forward<F>(f));
+}
+
+template <class Self, class F>
+constexpr auto result_or_else(Self&& self, F&& f) {
+	using invoke_type = std::remove_cv_t<std::remove_reference_t<error_invoke_result_t<Self&&, F&&>>>;
+	if constexpr(std::is_void_v<invoke_type>) {
+		// The function only observes the error; the error is passed through.
+		// It sees the error as an lvalue, so that it cannot move it out of a
+		// 'Result' that is about to be forwarded.
+		using result_type = std::remove_cv_t<std::remove_reference_t<Self>>;
+		static_assert(std::is_invocable_v<F&&, decltype(self.error())>,
+			"A function passed to Result<T, E>::or_else() that returns void must accept the error as an lvalue.");
+		if(!TIM_RESULT_EXPECT_HAS_VALUE(self.has_value(), result_value_t<Self>, result_error_t<Self>)) {
+			detail::invoke_with_error(self, std::forward<F>(f));
+		}
+		return result_type(std::forward<Self>(self));
+	} else {
+		using result_type = invoke_type;
+		static_assert(traits::is_result_v<result_type>,
+			"The function passed to Result<T, E>::or_else() must return a Result or void.");
+		static_assert(std::is_same_v<result_value_t<result_type>, result_value_t<Self>>,
+			"The function passed to Result<T, E>::or_else() must return a Result with value type 'T'.");
+		if(TIM_RESULT_EXPECT_HAS_VALUE(self.has_value(), result_value_t<Self>, result_error_t<Self>)) {
+			return forward_value<result_type>(std::forward<Self>(self));
+		}
+		return detail::invoke_with_error(std::forward<Self>(self), std::forward<F>(f));
+	}
+}
+
 } /* namespace detail */
 
 template <class T, class E>
@@ -2097,6 +3467,8 @@ private:
 	using data_type = detail::result_data_type<T, E>;
 	static constexpr detail::value_tag_t value_tag = detail::value_tag;
 	static constexpr detail::error_tag_t error_tag = detail::error_tag;
+	static_assert(detail::satisfies_register_passable_contract_v<T, E>,
+		"Result<T, E> must be trivially copyable when 'T' and 'E' are.");
 public:
 
 	using value_type = T;
@@ -2147,7 +3519,7 @@ public:
 		&& std::is_nothrow_constructible_v<E, const G&>
 	):
 		data_([&]() -> data_type {
-			if(other.has_value()) {
+			if(TIM_RESULT_EXPECT_HAS_VALUE(other.has_value(), U, G)) {
 				return data_type(value_tag, other.val());
 			} else {
 				return data_type(error_tag, other.err());
@@ -2193,7 +3565,7 @@ public:
 		&& std::is_nothrow_constructible_v<E, const G&>
 	):
 		data_([&]() -> data_type {
-			if(other.has_value()) {
+			if(TIM_RESULT_EXPECT_HAS_VALUE(other.has_value(), U, G)) {
 				return data_type(value_tag, other.val());
 			} else {
 				return data_type(error_tag, other.err());
@@ -2239,7 +3611,7 @@ public:
 		&& std::is_nothrow_constructible_v<E, G&&>
 	):
 		data_([&]() -> data_type {
-			if(other.has_value()) {
+			if(TIM_RESULT_EXPECT_HAS_VALUE(other.has_value(), U, G)) {
 				return data_type(value_tag, std::move(other.val()));
 			} else {
 				return data_type(error_tag, std::move(other.err()));
@@ -2285,7 +3657,7 @@ public:
 		&& std::is_nothrow_constructible_v<E, G&&>
 	):
 		data_([&]() -> data_type {
-			if(other.has_value()) {
+			if(TIM_RESULT_EXPECT_HAS_VALUE(other.has_value(), U, G)) {
 				return data_type(value_tag, std::move(other.val()));
 			} else {
 				return data_type(error_tag, std::move(other.err()));
@@ -2303,7 +3675,8 @@ public:
 				std::is_constructible<T, U&&>,
 				std::negation<std::is_same<std::decay_t<U>, in_place_t>>,
 				std::negation<std::is_same<std::decay_t<U>, Result>>,
-				std::negation<std::is_same<std::decay_t<U>, Error<E>>>
+				std::negation<std::is_same<std::decay_t<U>, Error<E>>>,
+				std::negation<detail::is_error_reference<std::decay_t<U>>>
 			>,
 			bool
 		> = false
@@ -2322,7 +3695,8 @@ public:
 				std::is_constructible<T, U&&>,
 				std::negation<std::is_same<std::decay_t<U>, in_place_t>>,
 				std::negation<std::is_same<std::decay_t<U>, Result>>,
-				std::negation<std::is_same<std::decay_t<U>, Error<E>>>
+				std::negation<std::is_same<std::decay_t<U>, Error<E>>>,
+				std::negation<detail::is_error_reference<std::decay_t<U>>>
 			>,
 			bool
 		> = false
@@ -2398,7 +3772,20 @@ public:
 	}
 
 	template <
-		class ... Args,
+		class G,
+		std::enable_if_t<
+			std::is_convertible_v<G, E>,
+			bool
+		> = false
+	>
+	constexpr Result(detail::ErrorReference<G> e) noexcept(std::is_nothrow_constructible_v<E, G>):
+		data_(error_tag, std::forward<G>(e.error))
+	{
+			
+	}
+
+	template <
+		class ... Args,
 		std::enable_if_t<
 			std::is_constructible_v<T, Args...>,
 			bool
@@ -2452,6 +3839,147 @@ public:
 			
 	}
 
+	// Allocator-extended constructors.  The alternative constructed is built by
+	// uses-allocator construction with 'alloc'; the 'Result' does not keep it.
+	template <
+		class Alloc,
+		std::enable_if_t<detail::is_constructible_using_v<T, Alloc>, bool> = false
+	>
+	constexpr Result(std::allocator_arg_t, const Alloc& alloc):
+		data_(detail::make_alternative_using<data_type, T>(value_tag, alloc))
+	{
+
+	}
+
+	template <
+		class Alloc,
+		std::enable_if_t<
+			detail::is_constructible_using_v<T, Alloc, const T&>
+			&& detail::is_constructible_using_v<E, Alloc, const E&>,
+			bool
+		> = false
+	>
+	constexpr Result(std::allocator_arg_t, const Alloc& alloc, const Result& other):
+		data_([&]() -> data_type {
+			if(TIM_RESULT_EXPECT_HAS_VALUE(other.has_value(), T, E)) {
+				return detail::make_alternative_using<data_type, T>(value_tag, alloc, other.val());
+			} else {
+				return detail::make_alternative_using<data_type, E>(error_tag, alloc, other.err());
+			}
+		}())
+	{
+
+	}
+
+	template <
+		class Alloc,
+		std::enable_if_t<
+			detail::is_constructible_using_v<T, Alloc, T&&>
+			&& detail::is_constructible_using_v<E, Alloc, E&&>,
+			bool
+		> = false
+	>
+	constexpr Result(std::allocator_arg_t, const Alloc& alloc, Result&& other):
+		data_([&]() -> data_type {
+			if(TIM_RESULT_EXPECT_HAS_VALUE(other.has_value(), T, E)) {
+				return detail::make_alternative_using<data_type, T>(value_tag, alloc, std::move(other.val()));
+			} else {
+				return detail::make_alternative_using<data_type, E>(error_tag, alloc, std::move(other.err()));
+			}
+		}())
+	{
+
+	}
+
+	template <
+		class Alloc,
+		class U,
+		std::enable_if_t<
+			std::conjunction_v<
+				std::negation<std::is_same<std::decay_t<U>, Result>>,
+				std::negation<std::is_same<std::decay_t<U>, in_place_t>>,
+				std::negation<std::is_same<std::decay_t<U>, in_place_error_t>>,
+				std::negation<detail::is_error_type<std::decay_t<U>>>,
+				std::negation<detail::is_error_reference<std::decay_t<U>>>
+			>
+			&& detail::is_constructible_using_v<T, Alloc, U&&>,
+			bool
+		> = false
+	>
+	constexpr Result(std::allocator_arg_t, const Alloc& alloc, U&& v):
+		data_(detail::make_alternative_using<data_type, T>(value_tag, alloc, std::forward<U>(v)))
+	{
+
+	}
+
+	template <
+		class Alloc,
+		class G,
+		std::enable_if_t<detail::is_constructible_using_v<E, Alloc, const G&>, bool> = false
+	>
+	constexpr Result(std::allocator_arg_t, const Alloc& alloc, const Error<G>& e):
+		data_(detail::make_alternative_using<data_type, E>(error_tag, alloc, e.value()))
+	{
+
+	}
+
+	template <
+		class Alloc,
+		class G,
+		std::enable_if_t<detail::is_constructible_using_v<E, Alloc, G&&>, bool> = false
+	>
+	constexpr Result(std::allocator_arg_t, const Alloc& alloc, Error<G>&& e):
+		data_(detail::make_alternative_using<data_type, E>(error_tag, alloc, std::move(e.value())))
+	{
+
+	}
+
+	template <
+		class Alloc,
+		class ... Args,
+		std::enable_if_t<detail::is_constructible_using_v<T, Alloc, Args&&...>, bool> = false
+	>
+	constexpr explicit Result(std::allocator_arg_t, const Alloc& alloc, in_place_t, Args&& ... args):
+		data_(detail::make_alternative_using<data_type, T>(value_tag, alloc, std::forward<Args>(args)...))
+	{
+
+	}
+
+	template <
+		class Alloc,
+		class U,
+		class ... Args,
+		std::enable_if_t<detail::is_constructible_using_v<T, Alloc, std::initializer_list<U>&, Args&&...>, bool> = false
+	>
+	constexpr explicit Result(std::allocator_arg_t, const Alloc& alloc, in_place_t, std::initializer_list<U> ilist, Args&& ... args):
+		data_(detail::make_alternative_using<data_type, T>(value_tag, alloc, ilist, std::forward<Args>(args)...))
+	{
+
+	}
+
+	template <
+		class Alloc,
+		class ... Args,
+		std::enable_if_t<detail::is_constructible_using_v<E, Alloc, Args&&...>, bool> = false
+	>
+	constexpr explicit Result(std::allocator_arg_t, const Alloc& alloc, in_place_error_t, Args&& ... args):
+		data_(detail::make_alternative_using<data_type, E>(error_tag, alloc, std::forward<Args>(args)...))
+	{
+
+	}
+
+	template <
+		class Alloc,
+		class U,
+		class ... Args,
+		std::enable_if_t<detail::is_constructible_using_v<E, Alloc, std::initializer_list<U>&, Args&&...>, bool> = false
+	>
+	constexpr explicit Result(std::allocator_arg_t, const Alloc& alloc, in_place_error_t, std::initializer_list<U> ilist, Args&& ... args):
+		data_(detail::make_alternative_using<data_type, E>(error_tag, alloc, ilist, std::forward<Args>(args)...))
+	{
+
+	}
+
 	constexpr Result& operator=(const Result&) = default;
 	constexpr Result& operator=(Result&&) = default;
 
@@ -2479,17 +4007,11 @@ public:
 		&& std::is_nothrow_constructible_v<T, U&&>
 	)
 	{
-		if(this->has_value()) {
+		if(TIM_RESULT_EXPECT_HAS_VALUE(this->has_value(), T, E)) {
 			this->val() = std::forward<U>(v);
 			return *this;
 		}
-		if constexpr(std::is_nothrow_constructible_v<T, U&&>) {
-			this->destruct_error();
-			this->data_.emplace_value(std::forward<U>(v));
-		} else {
-			static_assert(std::is_nothrow_move_constructible_v<E>);
-			this->data_.guarded_emplace_value(std::forward<U>(v));
-		}
+		detail::guarded_emplace_value_using<T, E>(this->data_, detail::replacement_allocator<T>(this->err()), std::forward<U>(v));
 		data_.has_value() = true;
 		return *this;
 	}
@@ -2513,17 +4035,11 @@ public:
 		&& std::is_nothrow_constructible_v<E, const G&>
 	)
 	{
-		if(!this->has_value()) {
+		if(!TIM_RESULT_EXPECT_HAS_VALUE(this->has_value(), T, E)) {
 			this->err() = e.value();
 			return *this;
 		}
-		if constexpr(std::is_nothrow_constructible_v<E, const G&>) {
-			this->destruct_value();
-			this->data_.emplace_error(e.value());
-		} else {
-			static_assert(std::is_nothrow_move_constructible_v<T>);
-			this->data_.guarded_emplace_error(e.value());
-		}
+		detail::guarded_emplace_error_using<T, E>(this->data_, detail::replacement_allocator<E>(this->val()), e.value());
 		data_.has_value() = false;
 		return *this;
 	}
@@ -2546,17 +4062,11 @@ public:
 		std::is_nothrow_assignable_v<E&, G&&>
 		&& std::is_nothrow_constructible_v<E, G&&>
 	) {
-		if(!this->has_value()) {
+		if(!TIM_RESULT_EXPECT_HAS_VALUE(this->has_value(), T, E)) {
 			this->err() = std::move(e.value());
 			return *this;
 		}
-		if constexpr(std::is_nothrow_constructible_v<E, G&&>) {
-			this->destruct_value();
-			this->data_.emplace_error(std::move(e.value()));
-		} else {
-			static_assert(std::is_nothrow_move_constructible_v<T>);
-			this->data_.guarded_emplace_error(std::move(e.value()));
-		}
+		detail::guarded_emplace_error_using<T, E>(this->data_, detail::replacement_allocator<E>(this->val()), std::move(e.value()));
 		data_.has_value() = false;
 		return *this;
 	}
@@ -2581,37 +4091,8 @@ public:
 	constexpr T& emplace(Args&& ... args) noexcept(
 		std::is_nothrow_constructible_v<T, Args&&...>
 	) {
-		if constexpr(std::is_nothrow_constructible_v<T, Args&& ...>) {
-			if(this->has_value()) {
-				this->destruct_value();
-				this->data_.emplace_value(std::forward<Args>(args)...);
-			} else {
-				this->destruct_error();
-				this->data_.emplace_value(std::forward<Args>(args)...);
-				data_.has_value() = true;
-			}
-			return this->val();
-		} else if constexpr(std::is_nothrow_move_constructible_v<T>) {
-			T tmp(std::forward<Args>(args)...);
-			if(this->has_value()) {
-				this->destruct_value();
-				this->data_.emplace_value(std::move(tmp));
-			} else {
-				this->destruct_error();
-				this->data_.emplace_value(std::move(tmp));
-				data_.has_value() = true;
-			}
-			return this->val();
-		} else {
-			static_assert(std::is_nothrow_move_constructible_v<E> && std::is_move_assignable_v<T>);
-			if(this->has_value()) {
-				this->val() = T(std::forward<Args>(args)...);
-				return this->val();
-			} else {
-				this->data_.guarded_emplace_value(std::forward<Args>(args)...);
-				data_.has_value() = true;
-			}
-		}
+		this->emplace_impl(std::forward<Args>(args)...);
+		return this->val();
 	}
 
 	template <
@@ -2635,37 +4116,8 @@ public:
 	constexpr T& emplace(std::initializer_list<U> ilist, Args&& ... args) noexcept(
 		std::is_nothrow_constructible_v<T, std::initializer_list<U>&, Args&&...>
 	) {
-		if constexpr(std::is_nothrow_constructible_v<T, Args&& ...>) {
-			if(this->has_value()) {
-				this->destruct_value();
-				this->data_.emplace_value(ilist, std::forward<Args>(args)...);
-			} else {
-				this->destruct_error();
-				this->data_.emplace_value(ilist, std::forward<Args>(args)...);
-				data_.has_value() = true;
-			}
-			return this->val();
-		} else if constexpr(std::is_nothrow_move_constructible_v<T>) {
-			T tmp(ilist, std::forward<Args>(args)...);
-			if(this->has_value()) {
-				this->destruct_value();
-				this->data_.emplace_value(std::move(tmp));
-			} else {
-				this->destruct_error();
-				this->data_.emplace_value(std::move(tmp));
-				data_.has_value() = true;
-			}
-			return this->val();
-		} else {
-			static_assert(std::is_nothrow_move_constructible_v<E> && std::is_move_assignable_v<T>);
-			if(this->has_value()) {
-				this->val() = T(ilist, std::forward<Args>(args)...);
-				return this->val();
-			} else {
-				this->data_.guarded_emplace_value(ilist, std::forward<Args>(args)...);
-				data_.has_value() = true;
-			}
-		}
+		this->emplace_impl(ilist, std::forward<Args>(args)...);
+		return this->val();
 	}
 
 	template <
@@ -2692,15 +4144,22 @@ public:
 			std::is_nothrow_swappable<T>,
 			std::is_nothrow_swappable<E>
 		>
+		&& (!swap_uses_allocators() || nothrow_swap_using_allocators())
 	) -> std::enable_if_t<std::is_same_v<Other, Result>, void> {
-		if(this->has_value()) {
-			if(other.has_value()) {
+		if constexpr(detail::relocate_on_swap_v<T, E> && !swap_uses_allocators()) {
+			if(this->has_value() != other.has_value()) {
+				detail::swap_object_representations(this->data_, other.data_);
+				return;
+			}
+		}
+		if(TIM_RESULT_EXPECT_HAS_VALUE(this->has_value(), T, E)) {
+			if(TIM_RESULT_EXPECT_HAS_VALUE(other.has_value(), T, E)) {
 				this->swap_case(other, std::true_type{}, std::true_type{});
 			} else {
 				this->swap_case(other, std::true_type{}, std::false_type{});
 			}
 		} else {
-			if(other.has_value()) {
+			if(TIM_RESULT_EXPECT_HAS_VALUE(other.has_value(), T, E)) {
 				this->swap_case(other, std::false_type{}, std::true_type{});
 			} else {
 				this->swap_case(other, std::false_type{}, std::false_type{});
@@ -2716,6 +4175,25 @@ public:
 		return this->has_value();
 	}
 
+	// Records 'what' (which must outlive the error, e.g. a string literal) and
+	// the caller's location on the error trail of the error held, if any (see
+	// 'traits::error_context_traits').  Does nothing if a value is held.
+	Result& context(const char* what, const source_location& where = source_location::current()) & noexcept {
+		static_assert(detail::has_error_context_v<E>,
+			"'Result<T, E>::context()' requires an error type that keeps an error trail (see 'traits::error_context_traits').");
+		if(!TIM_RESULT_EXPECT_HAS_VALUE(this->has_value(), T, E)) {
+			traits::error_context_traits<E>::append(this->err(), what, where);
+		}
+		return *this;
+	}
+
+	Result context(const char* what, const source_location& where = source_location::current()) && noexcept(
+		std::is_nothrow_move_constructible_v<Result>
+	) {
+		this->context(what, where);
+		return std::move(*this);
+	}
+
 	constexpr const T* operator->() const {
 		assert_has_value();
 		return std::addressof(this->val());
@@ -2747,29 +4225,29 @@ public:
 	}
 
 	constexpr const T& value() const& {
-		if(!this->has_value()) {
-			data_.throw_bad_result_access();
+		if(!TIM_RESULT_EXPECT_HAS_VALUE(this->has_value(), T, E)) {
+			data_.bad_result_access();
 		}
 		return this->val();
 	}
 
 	constexpr const T&& value() const&& {
-		if(!this->has_value()) {
-			std::move(data_).throw_bad_result_access();
+		if(!TIM_RESULT_EXPECT_HAS_VALUE(this->has_value(), T, E)) {
+			std::move(data_).bad_result_access();
 		}
 		return std::move(this->val());
 	}
 
 	constexpr T& value() & {
-		if(!this->has_value()) {
-			data_.throw_bad_result_access();
+		if(!TIM_RESULT_EXPECT_HAS_VALUE(this->has_value(), T, E)) {
+			data_.bad_result_access();
 		}
 		return this->val();
 	}
 
 	constexpr T&& value() && {
-		if(!this->has_value()) {
-			std::move(data_).throw_bad_result_access();
+		if(!TIM_RESULT_EXPECT_HAS_VALUE(this->has_value(), T, E)) {
+			std::move(data_).bad_result_access();
 		}
 		return std::move(this->val());
 	}
@@ -2796,7 +4274,7 @@ public:
 
 	template <class U>
 	constexpr T value_or(U&& alt) const& {
-		if(this->has_value()) {
+		if(TIM_RESULT_EXPECT_HAS_VALUE(this->has_value(), T, E)) {
 			return this->val();
 		}
 		return std::forward<U>(alt);
@@ -2804,12 +4282,141 @@ public:
 
 	template <class U>
 	constexpr T value_or(U&& alt) && {
-		if(this->has_value()) {
+		if(TIM_RESULT_EXPECT_HAS_VALUE(this->has_value(), T, E)) {
 			return std::move(this->val());
 		}
 		return std::forward<U>(alt);
 	}
 
+	// Monadic operations.  'map()'/'transform()' and 'map_error()'/
+	// 'transform_error()' apply 'f' to the value or the error and wrap the
+	// result ('void' becomes 'Result<void, E>' and 'std::monostate'
+	// respectively).  'and_then()' and 'or_else()' pass the value or error to an
+	// 'f' that returns a 'Result' of its own; an 'or_else()' function returning
+	// 'void' only observes the error, which it is passed as an lvalue.  Otherwise
+	// the payload is forwarded straight into 'f' with the value category of
+	// '*this'.
+
+	template <class F>
+	constexpr auto map(F&& f) & {
+		return detail::result_map(*this, std::forward<F>(f));
+	}
+
+	template <class F>
+	constexpr auto map(F&& f) const& {
+		return detail::result_map(*this, std::forward<F>(f));
+	}
+
+	template <class F>
+	constexpr auto map(F&& f) && {
+		return detail::result_map(std::move(*this), std::forward<F>(f));
+	}
+
+	template <class F>
+	constexpr auto map(F&& f) const&& {
+		return detail::result_map(std::move(*this), std::forward<F>(f));
+	}
+
+	template <class F>
+	constexpr auto map_error(F&& f) & {
+		return detail::result_map_error(*this, std::forward<F>(f));
+	}
+
+	template <class F>
+	constexpr auto map_error(F&& f) const& {
+		return detail::result_map_error(*this, std::forward<F>(f));
+	}
+
+	template <class F>
+	constexpr auto map_error(F&& f) && {
+		return detail::result_map_error(std::move(*this), std::forward<F>(f));
+	}
+
+	template <class F>
+	constexpr auto map_error(F&& f) const&& {
+		return detail::result_map_error(std::move(*this), std::forward<F>(f));
+	}
+
+	template <class F>
+	constexpr auto and_then(F&& f) & {
+		return detail::result_and_then(*this, std::forward<F>(f));
+	}
+
+	template <class F>
+	constexpr auto and_then(F&& f) const& {
+		return detail::result_and_then(*this, std::forward<F>(f));
+	}
+
+	template <class F>
+	constexpr auto and_then(F&& f) && {
+		return detail::result_and_then(std::move(*this), std::forward<F>(f));
+	}
+
+	template <class F>
+	constexpr auto and_then(F&& f) const&& {
+		return detail::result_and_then(std::move(*this), std::forward<F>(f));
+	}
+
+	template <class F>
+	constexpr auto or_else(F&& f) & {
+		return detail::result_or_else(*this, std::forward<F>(f));
+	}
+
+	template <class F>
+	constexpr auto or_else(F&& f) const& {
+		return detail::result_or_else(*this, std::forward<F>(f));
+	}
+
+	template <class F>
+	constexpr auto or_else(F&& f) && {
+		return detail::result_or_else(std::move(*this), std::forward<F>(f));
+	}
+
+	template <class F>
+	constexpr auto or_else(F&& f) const&& {
+		return detail::result_or_else(std::move(*this), std::forward<F>(f));
+	}
+
+	template <class F>
+	constexpr auto transform(F&& f) & {
+		return detail::result_map(*this, std::forward<F>(f));
+	}
+
+	template <class F>
+	constexpr auto transform(F&& f) const& {
+		return detail::result_map(*this, std::forward<F>(f));
+	}
+
+	template <class F>
+	constexpr auto transform(F&& f) && {
+		return detail::result_map(std::move(*this), std::forward<F>(f));
+	}
+
+	template <class F>
+	constexpr auto transform(F&& f) const&& {
+		return detail::result_map(std::move(*this), std::forward<F>(f));
+	}
+
+	template <class F>
+	constexpr auto transform_error(F&& f) & {
+		return detail::result_map_error(*this, std::forward<F>(f));
+	}
+
+	template <class F>
+	constexpr auto transform_error(F&& f) const& {
+		return detail::result_map_error(*this, std::forward<F>(f));
+	}
+
+	template <class F>
+	constexpr auto transform_error(F&& f) && {
+		return detail::result_map_error(std::move(*this), std::forward<F>(f));
+	}
+
+	template <class F>
+	constexpr auto transform_error(F&& f) const&& {
+		return detail::result_map_error(std::move(*this), std::forward<F>(f));
+	}
+
 private:
 
 	constexpr void assert_has_value() const {
@@ -2824,6 +4431,42 @@ private:
 #endif
 	}
 
+	// Builds the new value with the allocator of the value or error it replaces.
+	template <class ... Args>
+	constexpr void emplace_impl(Args&& ... args) {
+		if(TIM_RESULT_EXPECT_HAS_VALUE(this->has_value(), T, E)) {
+			using alloc_type = detail::replacement_allocator_t<T, T>;
+			const alloc_type alloc = detail::replacement_allocator<T>(this->val());
+			if constexpr(detail::construct_in_place_using_v<T, alloc_type, Args&&...>) {
+				this->destruct_value();
+				detail::invoke_nothrow([&](){
+					detail::emplace_value_using<T>(this->data_, alloc, std::forward<Args>(args)...);
+				});
+			} else if constexpr(std::is_nothrow_move_constructible_v<T>) {
+				T tmp = detail::make_obj_using_allocator<T>(alloc, std::forward<Args>(args)...);
+				this->destruct_value();
+				this->data_.emplace_value(std::move(tmp));
+			} else {
+				static_assert(std::is_move_assignable_v<T>);
+				this->val() = detail::make_obj_using_allocator<T>(alloc, std::forward<Args>(args)...);
+			}
+		} else {
+			using alloc_type = detail::replacement_allocator_t<T, E>;
+			const alloc_type alloc = detail::replacement_allocator<T>(this->err());
+			if constexpr(
+				!detail::construct_in_place_using_v<T, alloc_type, Args&&...>
+				&& std::is_nothrow_move_constructible_v<T>
+			) {
+				T tmp = detail::make_obj_using_allocator<T>(alloc, std::forward<Args>(args)...);
+				this->destruct_error();
+				this->data_.emplace_value(std::move(tmp));
+			} else {
+				detail::guarded_emplace_value_using<T, E>(this->data_, alloc, std::forward<Args>(args)...);
+			}
+			data_.has_value() = true;
+		}
+	}
+
 	constexpr void swap_case(Result& other, std::false_type, std::false_type) {
 		using std::swap;
 		swap(this->err(), other.err());
@@ -2849,8 +4492,29 @@ private:
 		}
 	}
 
+	using swap_value_allocator = detail::replacement_allocator_t<T, E, detail::allocator_propagation<T>::swap>;
+	using swap_error_allocator = detail::replacement_allocator_t<E, T, detail::allocator_propagation<E>::swap>;
+
+	// Whether swapping a value with an error rebuilds each with the allocator
+	// of the alternative it replaces.  Needs both to be nothrow movable.
+	static constexpr bool swap_uses_allocators() {
+		return !(
+			std::is_same_v<swap_value_allocator, detail::no_allocator_t>
+			&& std::is_same_v<swap_error_allocator, detail::no_allocator_t>
+		)
+		&& std::is_nothrow_move_constructible_v<T>
+		&& std::is_nothrow_move_constructible_v<E>;
+	}
+
+	static constexpr bool nothrow_swap_using_allocators() {
+		return detail::is_nothrow_constructible_using_v<T, swap_value_allocator, T&&>
+			&& detail::is_nothrow_constructible_using_v<E, swap_error_allocator, E&&>;
+	}
+
 	constexpr void swap_case(Result& other, std::true_type, std::false_type) {
-		if constexpr(use_T_as_temporary_in_swap()) {
+		if constexpr(swap_uses_allocators()) {
+			swap_helper_using_allocators(other);
+		} else if constexpr(use_T_as_temporary_in_swap()) {
 			swap_helper_T_temp(other);
 		} else {
 			swap_helper_E_temp(other);
@@ -2862,6 +4526,26 @@ private:
 		swap(this->val(), other.val());
 	}
 
+	template <class Other, std::enable_if_t<std::is_same_v<std::decay_t<Other>, Result>, bool> = false>
+	constexpr void swap_helper_using_allocators(Other& other) {
+		// Both new alternatives are built before either old one is destroyed,
+		// so that each can take the allocator of the one it replaces.
+		E new_err = detail::make_obj_using_allocator<E>(
+			detail::replacement_allocator<E, detail::allocator_propagation<E>::swap>(this->val()),
+			std::move(other.err())
+		);
+		T new_val = detail::make_obj_using_allocator<T>(
+			detail::replacement_allocator<T, detail::allocator_propagation<T>::swap>(other.err()),
+			std::move(this->val())
+		);
+		this->destruct_value();
+		this->data_.emplace_error(std::move(new_err));
+		this->data_.has_value() = false;
+		other.destruct_error();
+		other.data_.emplace_value(std::move(new_val));
+		other.data_.has_value() = true;
+	}
+
 	template <class Other, std::enable_if_t<std::is_same_v<std::decay_t<Other>, Result>, bool> = false>
 	constexpr void swap_helper_T_temp(Other& other) {
 		{
@@ -2931,23 +4615,29 @@ private:
 	data_type data_;
 };
 
+namespace detail {
+
+// The members of 'Result<cv void, E>' that do not depend on the cv-qualifiers
+// of 'void', shared by all four specializations.
 template <class E>
-struct Result<void, E> {
+struct VoidResultBase {
 private:
-	template <class U, class G>
-	friend struct Result;
+	template <class G>
+	friend struct VoidResultBase;
+
+	template <class V, class G>
+	friend struct VoidResultMethods;
 
 	using data_type = detail::result_data_type<void, E>;
 	static constexpr detail::value_tag_t value_tag = detail::value_tag;
 	static constexpr detail::error_tag_t error_tag = detail::error_tag;
+	static_assert(detail::satisfies_register_passable_contract_v<void, E>,
+		"Result<void, E> must be trivially copyable when 'E' is.");
 public:
 
-	using value_type = void;
-	using error_type = E;
-
-	Result() = default;
-	Result(const Result&) = default;
-	Result(Result&&) = default;
+	VoidResultBase() = default;
+	VoidResultBase(const VoidResultBase&) = default;
+	VoidResultBase(VoidResultBase&&) = default;
 
 	template <
 		class G,
@@ -2969,9 +4659,9 @@ public:
 			bool
 		> = false
 	>
-	explicit constexpr Result(const Result<U, G>& other) noexcept(std::is_nothrow_constructible_v<E, const G&>):
+	explicit constexpr VoidResultBase(const Result<U, G>& other) noexcept(std::is_nothrow_constructible_v<E, const G&>):
 		data_([&]() -> data_type {
-			if(other.has_value()) {
+			if(TIM_RESULT_EXPECT_HAS_VALUE(other.has_value(), U, G)) {
 				return data_type(value_tag);
 			} else {
 				return data_type(error_tag, other.err());
@@ -3001,9 +4691,9 @@ public:
 			bool
 		> = false
 	>
-	constexpr Result(const Result<U, G>& other) noexcept(std::is_nothrow_constructible_v<E, const G&>):
+	constexpr VoidResultBase(const Result<U, G>& other) noexcept(std::is_nothrow_constructible_v<E, const G&>):
 		data_([&]() -> data_type {
-			if(other.has_value()) {
+			if(TIM_RESULT_EXPECT_HAS_VALUE(other.has_value(), U, G)) {
 				return data_type(value_tag);
 			} else {
 				return data_type(error_tag, other.err());
@@ -3033,9 +4723,9 @@ public:
 			bool
 		> = false
 	>
-	constexpr explicit Result(Result<U, G>&& other) noexcept(std::is_nothrow_constructible_v<E, G&&>):
+	constexpr explicit VoidResultBase(Result<U, G>&& other) noexcept(std::is_nothrow_constructible_v<E, G&&>):
 		data_([&]() -> data_type {
-			if(other.has_value()) {
+			if(TIM_RESULT_EXPECT_HAS_VALUE(other.has_value(), U, G)) {
 				return data_type(value_tag);
 			} else {
 				return data_type(error_tag, std::move(other.err()));
@@ -3065,9 +4755,9 @@ public:
 			bool
 		> = false
 	>
-	constexpr Result(Result<U, G>&& other) noexcept(std::is_nothrow_constructible_v<E, G&&>):
+	constexpr VoidResultBase(Result<U, G>&& other) noexcept(std::is_nothrow_constructible_v<E, G&&>):
 		data_([&]() -> data_type {
-			if(other.has_value()) {
+			if(TIM_RESULT_EXPECT_HAS_VALUE(other.has_value(), U, G)) {
 				return data_type(value_tag);
 			} else {
 				return data_type(error_tag, std::move(other.err()));
@@ -3087,7 +4777,7 @@ public:
 			bool
 		> = false
 	>
-	constexpr Result(const Error<G>& v) noexcept(std::is_nothrow_constructible_v<E, const G&>):
+	constexpr VoidResultBase(const Error<G>& v) noexcept(std::is_nothrow_constructible_v<E, const G&>):
 		data_(error_tag, v.value())
 	{
 			
@@ -3103,7 +4793,7 @@ public:
 			bool
 		> = false
 	>
-	constexpr explicit Result(const Error<G>& v) noexcept(std::is_nothrow_constructible_v<E, const G&>):
+	constexpr explicit VoidResultBase(const Error<G>& v) noexcept(std::is_nothrow_constructible_v<E, const G&>):
 		data_(error_tag, v.value())
 	{
 			
@@ -3119,7 +4809,7 @@ public:
 			bool
 		> = false
 	>
-	constexpr Result(Error<G>&& v) noexcept(std::is_nothrow_constructible_v<E, G&>):
+	constexpr VoidResultBase(Error<G>&& v) noexcept(std::is_nothrow_constructible_v<E, G&>):
 		data_(error_tag, std::move(v.value()))
 	{
 			
@@ -3135,13 +4825,26 @@ public:
 			bool
 		> = false
 	>
-	constexpr explicit Result(Error<G>&& v) noexcept(std::is_nothrow_constructible_v<E, G&&>):
+	constexpr explicit VoidResultBase(Error<G>&& v) noexcept(std::is_nothrow_constructible_v<E, G&&>):
 		data_(error_tag, std::move(v.value()))
 	{
 			
 	}
 
-	constexpr explicit Result(in_place_t) noexcept:
+	template <
+		class G,
+		std::enable_if_t<
+			std::is_convertible_v<G, E>,
+			bool
+		> = false
+	>
+	constexpr VoidResultBase(ErrorReference<G> e) noexcept(std::is_nothrow_constructible_v<E, G>):
+		data_(error_tag, std::forward<G>(e.error))
+	{
+			
+	}
+
+	constexpr explicit VoidResultBase(in_place_t) noexcept:
 		data_(value_tag)
 	{
 			
@@ -3151,7 +4854,7 @@ public:
 		class ... Args,
 		std::enable_if_t<std::is_constructible_v<E, Args&&...>, bool> = false
 	>
-	constexpr explicit Result(in_place_error_t, Args&& ... args) noexcept(std::is_nothrow_constructible_v<E, Args&&...>):
+	constexpr explicit VoidResultBase(in_place_error_t, Args&& ... args) noexcept(std::is_nothrow_constructible_v<E, Args&&...>):
 		data_(error_tag, std::forward<Args>(args)...)
 	{
 			
@@ -3165,7 +4868,7 @@ public:
 			bool
 		> = false
 	>
-	constexpr explicit Result(in_place_error_t, std::initializer_list<U> ilist, Args&& ... args) noexcept(
+	constexpr explicit VoidResultBase(in_place_error_t, std::initializer_list<U> ilist, Args&& ... args) noexcept(
 		std::is_nothrow_constructible_v<E, std::initializer_list<U>, Args&&...>
 	):
 		data_(error_tag, ilist, std::forward<Args>(args)...)
@@ -3173,1256 +4876,203 @@ public:
 			
 	}
 
-	constexpr Result& operator=(const Result&) = default;
-	constexpr Result& operator=(Result&&) = default;
-
-	template <
-		class G,
-		std::enable_if_t<
-			std::conjunction_v<
-    				std::is_constructible<E, const G&>,
-    				std::is_assignable<E&, const G&>
-			>,
-			bool
-		> = false
-	>
-	constexpr Result& operator=(const Error<G>& e) noexcept(
-		std::is_nothrow_assignable_v<E&, const G&>
-		&& std::is_nothrow_constructible_v<E, const G&>
-	)
+	// Allocator-extended constructors; see those of 'Result<T, E>'.
+	template <class Alloc>
+	constexpr VoidResultBase(std::allocator_arg_t, const Alloc&) noexcept:
+		data_(value_tag)
 	{
-		if(!this->has_value()) {
-			this->err() = e.value();
-			return *this;
-		}
-		this->data_.emplace_error(e.value());
-		data_.has_value() = false;
-		return *this;
-	}
-
-	template <
-		class G,
-		std::enable_if_t<
-			std::conjunction_v<
-    				std::is_constructible<E, G&&>,
-    				std::is_assignable<E&, G&&>
-			>,
-			bool
-		> = false
-	>
-	constexpr Result& operator=(Error<G>&& e) noexcept(
-		std::is_nothrow_assignable_v<E&, G&&>
-		&& std::is_nothrow_constructible_v<E, G&&>
-	) {
-		if(!this->has_value()) {
-			this->err() = std::move(e.value());
-			return *this;
-		}
-		this->data_.emplace_error(std::move(e.value()));
-		data_.has_value() = false;
-		return *this;
-	}
-
-	constexpr void emplace() noexcept {
-		if(this->has_value()) {
-			return;
-		}
-		this->destruct_error();
-		data_.has_value() = true;
-	}
-
-	template <
-		class Other = Result,
-		std::enable_if_t<
-			std::conjunction_v<
-				std::is_same<Other, Result>,
-				std::is_move_constructible<E>,
-				std::is_swappable<E>
-			>,
-			bool
-		> = false
-	>
-	constexpr void swap(Other& other) noexcept(
-		std::conjunction_v<
-			std::is_nothrow_move_constructible<E>,
-			std::is_nothrow_swappable<E>
-		>
-	) {
-		if(this->has_value()) {
-			if(other.has_value()) {
-				return;
-			} else {
-				this->data_.emplace_error(std::move(other.error()));
-				this->data_.has_value() = false;
-				other.destruct_error();
-				other.data_.has_value() = true;
-			}
-		} else {
-			if(other.has_value()) {
-				other.data_.emplace_error(std::move(this->error()));
-				other.data_.has_value() = false;
-				this->destruct_error();
-				this->data_.has_value() = true;
-				
-			} else {
-				using std::swap;
-				swap(this->error(), other.error());
-			}
-		}
-	}
-
-	constexpr bool has_value() const {
-		return this->data_.has_value();
-	}
-
-	explicit constexpr operator bool() const {
-		return this->has_value();
-	}
-
-	constexpr void value() const& {
-		if(!this->has_value()) {
-			data_.throw_bad_result_access();
-		}
-	}
-
-	constexpr void value() && {
-		if(!this->has_value()) {
-			std::move(data_).throw_bad_result_access();
-		}
-	}
-
-	constexpr E&& error() && {
-		assert_not_has_value();
-		return std::move(this->err());
-	}
-
-	constexpr const E&& error() const&& {
-		assert_not_has_value();
-		return std::move(this->err());
-	}
-
-	constexpr E& error() & {
-		assert_not_has_value();
-		return this->err();
-	}
-
-	constexpr const E& error() const& {
-		assert_not_has_value();
-		return this->err();
-	}
-
-private:
-	constexpr void assert_has_value() const {
-#if defined(assert) && !defined(TIM_RESULT_DISABLE_ASSERTIONS)
-		assert(this->has_value());
-#endif
-	}
-
-	constexpr void assert_not_has_value() const {
-#if defined(assert) && defined(TIM_RESULT_DISABLE_ASSERTIONS)
-		assert(not this->has_value());
-#endif
-	}
-
-	constexpr void destruct_value() noexcept {
-		return data_.destruct_value();
-	}
-
-	constexpr void destruct_error() noexcept {
-		return data_.destruct_error();
-	}
-
-	constexpr void destruct() noexcept {
-		return data_.destruct();
-	}
-
-	constexpr const E& err() const {
-		return this->data_.error();
-	}
-
-	constexpr E& err() {
-		return this->data_.error();
-	}
-
-	data_type data_;
-};
-
-template <class E>
-struct Result<const void, E> {
-private:
-	template <class U, class G>
-	friend struct Result;
-
-	using data_type = detail::result_data_type<const void, E>;
-	static constexpr detail::value_tag_t value_tag = detail::value_tag;
-	static constexpr detail::error_tag_t error_tag = detail::error_tag;
-public:
-
-	using value_type = const void;
-	using error_type = E;
-
-	Result() = default;
-	Result(const Result&) = default;
-	Result(Result&&) = default;
 
-	template <
-		class G,
-		class U,
-		std::enable_if_t<
-			!std::is_convertible_v<const G&, E>
-			&& std::conjunction_v<
-				detail::is_cv_void<U>,
-				std::is_constructible<E, const G&>,
-				std::negation<std::is_constructible<Error<E>, Result<U, G>&>>,
-				std::negation<std::is_constructible<Error<E>, Result<U, G>&&>>,
-				std::negation<std::is_constructible<Error<E>, const Result<U, G>&>>,
-				std::negation<std::is_constructible<Error<E>, const Result<U, G>&&>>,
-				std::negation<std::is_convertible<Result<U, G>&, Error<E>>>,
-				std::negation<std::is_convertible<Result<U, G>&&, Error<E>>>,
-				std::negation<std::is_convertible<const Result<U, G>&, Error<E>>>,
-				std::negation<std::is_convertible<const Result<U, G>&&, Error<E>>>
-			>,
-			bool
-		> = false
-	>
-	explicit constexpr Result(const Result<U, G>& other) noexcept(std::is_nothrow_constructible_v<E, const G&>):
-		data_([&]() -> data_type {
-			if(other.has_value()) {
-				return data_type(value_tag);
-			} else {
-				return data_type(error_tag, other.err());
-			}
-		}())
-	{
-		
 	}
 
 	template <
+		class Alloc,
 		class U,
 		class G,
 		std::enable_if_t<
-			std::is_convertible_v<const G&, E>
-			&& std::conjunction_v<
-				detail::is_cv_void<U>,
-				std::is_constructible<E, const G&>,
-				std::negation<std::is_constructible<Error<E>, Result<U, G>&>>,
-				std::negation<std::is_constructible<Error<E>, Result<U, G>&&>>,
-				std::negation<std::is_constructible<Error<E>, const Result<U, G>&>>,
-				std::negation<std::is_constructible<Error<E>, const Result<U, G>&&>>,
-				std::negation<std::is_convertible<Result<U, G>&, Error<E>>>,
-				std::negation<std::is_convertible<Result<U, G>&&, Error<E>>>,
-				std::negation<std::is_convertible<const Result<U, G>&, Error<E>>>,
-				std::negation<std::is_convertible<const Result<U, G>&&, Error<E>>>
-			>,
+			detail::is_cv_void_v<U>
+			&& detail::is_constructible_using_v<E, Alloc, const G&>,
 			bool
 		> = false
 	>
-	constexpr Result(const Result<U, G>& other) noexcept(std::is_nothrow_constructible_v<E, const G&>):
+	constexpr VoidResultBase(std::allocator_arg_t, const Alloc& alloc, const Result<U, G>& other):
 		data_([&]() -> data_type {
-			if(other.has_value()) {
+			if(TIM_RESULT_EXPECT_HAS_VALUE(other.has_value(), U, G)) {
 				return data_type(value_tag);
 			} else {
-				return data_type(error_tag, other.err());
+				return detail::make_alternative_using<data_type, E>(error_tag, alloc, other.err());
 			}
 		}())
 	{
-		
-	}
 
-	template <
-		class U,
-		class G,
-		std::enable_if_t<
-			!std::is_convertible_v<G&&, E>
-			&& std::conjunction_v<
-				detail::is_cv_void<U>,
-				std::is_constructible<E, G&&>,
-				std::negation<std::is_constructible<Error<E>, Result<U, G>&>>,
-				std::negation<std::is_constructible<Error<E>, Result<U, G>&&>>,
-				std::negation<std::is_constructible<Error<E>, const Result<U, G>&>>,
-				std::negation<std::is_constructible<Error<E>, const Result<U, G>&&>>,
-				std::negation<std::is_convertible<Result<U, G>&, Error<E>>>,
-				std::negation<std::is_convertible<Result<U, G>&&, Error<E>>>,
-				std::negation<std::is_convertible<const Result<U, G>&, Error<E>>>,
-				std::negation<std::is_convertible<const Result<U, G>&&, Error<E>>>
-			>,
-			bool
-		> = false
-	>
-	constexpr explicit Result(Result<U, G>&& other) noexcept(std::is_nothrow_constructible_v<E, G&&>):
-		data_([&]() -> data_type {
-			if(other.has_value()) {
-				return data_type(value_tag);
-			} else {
-				return data_type(error_tag, std::move(other.err()));
-			}
-		}())
-	{
-		
 	}
-	
+
 	template <
+		class Alloc,
 		class U,
-		class G,
-		std::enable_if_t<
-			std::is_convertible_v<G&&, E>
-			&& std::conjunction_v<
-				detail::is_cv_void<U>,
-				std::is_constructible<E, G&&>,
-				std::negation<std::is_constructible<Error<E>, Result<U, G>&>>,
-				std::negation<std::is_constructible<Error<E>, Result<U, G>&&>>,
-				std::negation<std::is_constructible<Error<E>, const Result<U, G>&>>,
-				std::negation<std::is_constructible<Error<E>, const Result<U, G>&&>>,
-				std::negation<std::is_convertible<Result<U, G>&, Error<E>>>,
-				std::negation<std::is_convertible<Result<U, G>&&, Error<E>>>,
-				std::negation<std::is_convertible<const Result<U, G>&, Error<E>>>,
-				std::negation<std::is_convertible<const Result<U, G>&&, Error<E>>>
-			>,
-			bool
-		> = false
-	>
-	constexpr Result(Result<U, G>&& other) noexcept(std::is_nothrow_constructible_v<E, G&>):
-		data_([&]() -> data_type {
-			if(other.has_value()) {
-				return data_type(value_tag);
-			} else {
-				return data_type(error_tag, std::move(other.err()));
-			}
-		}())
-	{
-		
-	}
-	
-	template <
-		class G = E,
-		std::enable_if_t<
-			std::conjunction_v<
-				std::is_convertible<const G&, E>,
-				std::is_constructible<E, const G&>
-			>,
-			bool
-		> = false
-	>
-	constexpr Result(const Error<G>& v) noexcept(std::is_nothrow_constructible_v<E, const G&>):
-		data_(error_tag, v.value())
-	{
-			
-	}
-
-	template <
-		class G = E,
-		std::enable_if_t<
-			std::conjunction_v<
-				std::negation<std::is_convertible<const G&, E>>,
-				std::is_constructible<E, const G&>
-			>,
-			bool
-		> = false
-	>
-	constexpr explicit Result(const Error<G>& v) noexcept(std::is_nothrow_constructible_v<E, const G&>):
-		data_(error_tag, v.value())
-	{
-			
-	}
-
-	template <
-		class G = E,
-		std::enable_if_t<
-			std::conjunction_v<
-				std::is_convertible<G&&, E>,
-				std::is_constructible<E, G&&>
-			>,
-			bool
-		> = false
-	>
-	constexpr Result(Error<G>&& v) noexcept(std::is_nothrow_constructible_v<E, G&>):
-		data_(error_tag, std::move(v.value()))
-	{
-			
-	}
-
-	template <
-		class G = E,
-		std::enable_if_t<
-			std::conjunction_v<
-				std::negation<std::is_convertible<G&&, E>>,
-				std::is_constructible<E, G&&>
-			>,
-			bool
-		> = false
-	>
-	constexpr explicit Result(Error<G>&& v) noexcept(std::is_nothrow_constructible_v<E, G&&>):
-		data_(error_tag, std::move(v.value()))
-	{
-			
-	}
-
-	constexpr explicit Result(in_place_t) noexcept:
-		data_(value_tag)
-	{
-			
-	}
-
-	template <
-		class ... Args,
-		std::enable_if_t<std::is_constructible_v<E, Args&&...>, bool> = false
-	>
-	constexpr explicit Result(in_place_error_t, Args&& ... args) noexcept(std::is_nothrow_constructible_v<E, Args&&...>):
-		data_(error_tag, std::forward<Args>(args)...)
-	{
-			
-	}
-
-	template <
-		class U,
-		class ... Args,
-		std::enable_if_t<
-			std::is_constructible_v<E, std::initializer_list<U>&, Args&&...>,
-			bool
-		> = false
-	>
-	constexpr explicit Result(in_place_error_t, std::initializer_list<U> ilist, Args&& ... args) noexcept(
-		std::is_nothrow_constructible_v<E, std::initializer_list<U>, Args&&...>
-	):
-		data_(error_tag, ilist, std::forward<Args>(args)...)
-	{
-			
-	}
-
-	constexpr Result& operator=(const Result&) = default;
-	constexpr Result& operator=(Result&&) = default;
-
-	template <
-		class G,
-		std::enable_if_t<
-			std::conjunction_v<
-    				std::is_constructible<E, const G&>,
-    				std::is_assignable<E&, const G&>
-			>,
-			bool
-		> = false
-	>
-	constexpr Result& operator=(const Error<G>& e) noexcept(
-		std::is_nothrow_assignable_v<E&, const G&>
-		&& std::is_nothrow_constructible_v<E, const G&>
-	)
-	{
-		if(!this->has_value()) {
-			this->err() = e.value();
-			return *this;
-		}
-		this->data_.emplace_error(e.value());
-		data_.has_value() = false;
-		return *this;
-	}
-
-	template <
-		class G,
-		std::enable_if_t<
-			std::conjunction_v<
-    				std::is_constructible<E, G&&>,
-    				std::is_assignable<E&, G&&>
-			>,
-			bool
-		> = false
-	>
-	constexpr Result& operator=(Error<G>&& e) noexcept(
-		std::is_nothrow_assignable_v<E&, G&&>
-		&& std::is_nothrow_constructible_v<E, G&&>
-	) {
-		if(!this->has_value()) {
-			this->err() = std::move(e.value());
-			return *this;
-		}
-		this->data_.emplace_error(std::move(e.value()));
-		data_.has_value() = false;
-		return *this;
-	}
-
-	constexpr void emplace() noexcept {
-		if(this->has_value()) {
-			return;
-		}
-		this->destruct_error();
-		data_.has_value() = true;
-	}
-
-	template <
-		class Other = Result,
-		std::enable_if_t<
-			std::conjunction_v<
-				std::is_same<Other, Result>,
-				std::is_move_constructible<E>,
-				std::is_swappable<E>
-			>,
-			bool
-		> = false
-	>
-	constexpr void swap(Other& other) noexcept(
-		std::conjunction_v<
-			std::is_nothrow_move_constructible<E>,
-			std::is_nothrow_swappable<E>
-		>
-	) {
-		if(this->has_value()) {
-			if(other.has_value()) {
-				return;
-			} else {
-				this->data_.emplace_error(std::move(other.error()));
-				this->data_.has_value() = false;
-				other.destruct_error();
-				other.data_.has_value() = true;
-			}
-		} else {
-			if(other.has_value()) {
-				other.data_.emplace_error(std::move(this->error()));
-				other.data_.has_value() = false;
-				this->destruct_error();
-				this->data_.has_value() = true;
-				
-			} else {
-				using std::swap;
-				swap(this->error(), other.error());
-			}
-		}
-	}
-
-	constexpr bool has_value() const {
-		return this->data_.has_value();
-	}
-
-	explicit constexpr operator bool() const {
-		return this->has_value();
-	}
-
-	constexpr void value() const& {
-		if(!this->has_value()) {
-			data_.throw_bad_result_access();
-		}
-	}
-
-	constexpr void value() && {
-		if(!this->has_value()) {
-			std::move(data_).throw_bad_result_access();
-		}
-	}
-
-	constexpr E&& error() && {
-		assert_not_has_value();
-		return std::move(this->err());
-	}
-
-	constexpr const E&& error() const&& {
-		assert_not_has_value();
-		return std::move(this->err());
-	}
-
-	constexpr E& error() & {
-		assert_not_has_value();
-		return this->err();
-	}
-
-	constexpr const E& error() const& {
-		assert_not_has_value();
-		return this->err();
-	}
-
-private:
-	constexpr void assert_has_value() const {
-#if defined(assert) && !defined(TIM_RESULT_DISABLE_ASSERTIONS)
-		assert(this->has_value());
-#endif
-	}
-
-	constexpr void assert_not_has_value() const {
-#if defined(assert) && defined(TIM_RESULT_DISABLE_ASSERTIONS)
-		assert(not this->has_value());
-#endif
-	}
-
-	constexpr void destruct_value() noexcept {
-		return data_.destruct_value();
-	}
-
-	constexpr void destruct_error() noexcept {
-		return data_.destruct_error();
-	}
-
-	constexpr void destruct() noexcept {
-		return data_.destruct();
-	}
-
-	constexpr const E& err() const {
-		return this->data_.error();
-	}
-
-	constexpr E& err() {
-		return this->data_.error();
-	}
-
-	data_type data_;
-};
-
-template <class E>
-struct Result<volatile void, E> {
-private:
-	template <class U, class G>
-	friend struct Result;
-
-	using data_type = detail::result_data_type<volatile void, E>;
-	static constexpr detail::value_tag_t value_tag = detail::value_tag;
-	static constexpr detail::error_tag_t error_tag = detail::error_tag;
-public:
-
-	using value_type = volatile void;
-	using error_type = E;
-
-	Result() = default;
-	Result(const Result&) = default;
-	Result(Result&&) = default;
-
-	template <
-		class G,
-		class U,
-		std::enable_if_t<
-			!std::is_convertible_v<const G&, E>
-			&& std::conjunction_v<
-				detail::is_cv_void<U>,
-				std::is_constructible<E, const G&>,
-				std::negation<std::is_constructible<Error<E>, Result<U, G>&>>,
-				std::negation<std::is_constructible<Error<E>, Result<U, G>&&>>,
-				std::negation<std::is_constructible<Error<E>, const Result<U, G>&>>,
-				std::negation<std::is_constructible<Error<E>, const Result<U, G>&&>>,
-				std::negation<std::is_convertible<Result<U, G>&, Error<E>>>,
-				std::negation<std::is_convertible<Result<U, G>&&, Error<E>>>,
-				std::negation<std::is_convertible<const Result<U, G>&, Error<E>>>,
-				std::negation<std::is_convertible<const Result<U, G>&&, Error<E>>>
-			>,
-			bool
-		> = false
-	>
-	explicit constexpr Result(const Result<U, G>& other) noexcept(std::is_nothrow_constructible_v<E, const G&>):
-		data_([&]() -> data_type {
-			if(other.has_value()) {
-				return data_type(value_tag);
-			} else {
-				return data_type(error_tag, other.err());
-			}
-		}())
-	{
-		
-	}
-
-	template <
-		class U,
-		class G,
-		std::enable_if_t<
-			std::is_convertible_v<const G&, E>
-			&& std::conjunction_v<
-				detail::is_cv_void<U>,
-				std::is_constructible<E, const G&>,
-				std::negation<std::is_constructible<Error<E>, Result<U, G>&>>,
-				std::negation<std::is_constructible<Error<E>, Result<U, G>&&>>,
-				std::negation<std::is_constructible<Error<E>, const Result<U, G>&>>,
-				std::negation<std::is_constructible<Error<E>, const Result<U, G>&&>>,
-				std::negation<std::is_convertible<Result<U, G>&, Error<E>>>,
-				std::negation<std::is_convertible<Result<U, G>&&, Error<E>>>,
-				std::negation<std::is_convertible<const Result<U, G>&, Error<E>>>,
-				std::negation<std::is_convertible<const Result<U, G>&&, Error<E>>>
-			>,
-			bool
-		> = false
-	>
-	constexpr Result(const Result<U, G>& other) noexcept(std::is_nothrow_constructible_v<E, const G&>):
-		data_([&]() -> data_type {
-			if(other.has_value()) {
-				return data_type(value_tag);
-			} else {
-				return data_type(error_tag, other.err());
-			}
-		}())
-	{
-		
-	}
-
-	template <
-		class U,
-		class G,
-		std::enable_if_t<
-			!std::is_convertible_v<G&&, E>
-			&& std::conjunction_v<
-				detail::is_cv_void<U>,
-				std::is_constructible<E, G&&>,
-				std::negation<std::is_constructible<Error<E>, Result<U, G>&>>,
-				std::negation<std::is_constructible<Error<E>, Result<U, G>&&>>,
-				std::negation<std::is_constructible<Error<E>, const Result<U, G>&>>,
-				std::negation<std::is_constructible<Error<E>, const Result<U, G>&&>>,
-				std::negation<std::is_convertible<Result<U, G>&, Error<E>>>,
-				std::negation<std::is_convertible<Result<U, G>&&, Error<E>>>,
-				std::negation<std::is_convertible<const Result<U, G>&, Error<E>>>,
-				std::negation<std::is_convertible<const Result<U, G>&&, Error<E>>>
-			>,
-			bool
-		> = false
-	>
-	constexpr explicit Result(Result<U, G>&& other) noexcept(std::is_nothrow_constructible_v<E, G&&>):
-		data_([&]() -> data_type {
-			if(other.has_value()) {
-				return data_type(value_tag);
-			} else {
-				return data_type(error_tag, std::move(other.err()));
-			}
-		}())
-	{
-		
-	}
-	
-	template <
-		class U,
-		class G,
-		std::enable_if_t<
-			std::is_convertible_v<G&&, E>
-			&& std::conjunction_v<
-				detail::is_cv_void<U>,
-				std::is_constructible<E, G&&>,
-				std::negation<std::is_constructible<Error<E>, Result<U, G>&>>,
-				std::negation<std::is_constructible<Error<E>, Result<U, G>&&>>,
-				std::negation<std::is_constructible<Error<E>, const Result<U, G>&>>,
-				std::negation<std::is_constructible<Error<E>, const Result<U, G>&&>>,
-				std::negation<std::is_convertible<Result<U, G>&, Error<E>>>,
-				std::negation<std::is_convertible<Result<U, G>&&, Error<E>>>,
-				std::negation<std::is_convertible<const Result<U, G>&, Error<E>>>,
-				std::negation<std::is_convertible<const Result<U, G>&&, Error<E>>>
-			>,
-			bool
-		> = false
-	>
-	constexpr Result(Result<U, G>&& other) noexcept(std::is_nothrow_constructible_v<E, G&&>):
-		data_([&]() -> data_type {
-			if(other.has_value()) {
-				return data_type(value_tag);
-			} else {
-				return data_type(error_tag, std::move(other.err()));
-			}
-		}())
-	{
-		
-	}
-	
-	template <
-		class G = E,
-		std::enable_if_t<
-			std::conjunction_v<
-				std::is_convertible<const G&, E>,
-				std::is_constructible<E, const G&>
-			>,
-			bool
-		> = false
-	>
-	constexpr Result(const Error<G>& v) noexcept(std::is_nothrow_constructible_v<E, const G&>):
-		data_(error_tag, v.value())
-	{
-			
-	}
-
-	template <
-		class G = E,
-		std::enable_if_t<
-			std::conjunction_v<
-				std::negation<std::is_convertible<const G&, E>>,
-				std::is_constructible<E, const G&>
-			>,
-			bool
-		> = false
-	>
-	constexpr explicit Result(const Error<G>& v) noexcept(std::is_nothrow_constructible_v<E, const G&>):
-		data_(error_tag, v.value())
-	{
-			
-	}
-
-	template <
-		class G = E,
-		std::enable_if_t<
-			std::conjunction_v<
-				std::is_convertible<G&&, E>,
-				std::is_constructible<E, G&&>
-			>,
-			bool
-		> = false
-	>
-	constexpr Result(Error<G>&& v) noexcept(std::is_nothrow_constructible_v<E, G&>):
-		data_(error_tag, std::move(v.value()))
-	{
-			
-	}
-
-	template <
-		class G = E,
-		std::enable_if_t<
-			std::conjunction_v<
-				std::negation<std::is_convertible<G&&, E>>,
-				std::is_constructible<E, G&&>
-			>,
-			bool
-		> = false
-	>
-	constexpr explicit Result(Error<G>&& v) noexcept(std::is_nothrow_constructible_v<E, G&&>):
-		data_(error_tag, std::move(v.value()))
-	{
-			
-	}
-
-	constexpr explicit Result(in_place_t) noexcept:
-		data_(value_tag)
-	{
-			
-	}
-
-	template <
-		class ... Args,
-		std::enable_if_t<std::is_constructible_v<E, Args&&...>, bool> = false
-	>
-	constexpr explicit Result(in_place_error_t, Args&& ... args) noexcept(std::is_nothrow_constructible_v<E, Args&&...>):
-		data_(error_tag, std::forward<Args>(args)...)
-	{
-			
-	}
-
-	template <
-		class U,
-		class ... Args,
-		std::enable_if_t<
-			std::is_constructible_v<E, std::initializer_list<U>&, Args&&...>,
-			bool
-		> = false
-	>
-	constexpr explicit Result(in_place_error_t, std::initializer_list<U> ilist, Args&& ... args) noexcept(
-		std::is_nothrow_constructible_v<E, std::initializer_list<U>, Args&&...>
-	):
-		data_(error_tag, ilist, std::forward<Args>(args)...)
-	{
-			
-	}
-
-	constexpr Result& operator=(const Result&) = default;
-	constexpr Result& operator=(Result&&) = default;
-
-	template <
-		class G,
-		std::enable_if_t<
-			std::conjunction_v<
-    				std::is_constructible<E, const G&>,
-    				std::is_assignable<E&, const G&>
-			>,
-			bool
-		> = false
-	>
-	constexpr Result& operator=(const Error<G>& e) noexcept(
-		std::is_nothrow_assignable_v<E&, const G&>
-		&& std::is_nothrow_constructible_v<E, const G&>
-	)
-	{
-		if(!this->has_value()) {
-			this->err() = e.value();
-			return *this;
-		}
-		this->data_.emplace_error(e.value());
-		data_.has_value() = false;
-		return *this;
-	}
-
-	template <
-		class G,
-		std::enable_if_t<
-			std::conjunction_v<
-    				std::is_constructible<E, G&&>,
-    				std::is_assignable<E&, G&&>
-			>,
-			bool
-		> = false
-	>
-	constexpr Result& operator=(Error<G>&& e) noexcept(
-		std::is_nothrow_assignable_v<E&, G&&>
-		&& std::is_nothrow_constructible_v<E, G&&>
-	) {
-		if(!this->has_value()) {
-			this->err() = std::move(e.value());
-			return *this;
-		}
-		this->data_.emplace_error(std::move(e.value()));
-		data_.has_value() = false;
-		return *this;
-	}
-
-	constexpr void emplace() noexcept {
-		if(this->has_value()) {
-			return;
-		}
-		this->destruct_error();
-		data_.has_value() = true;
-	}
-
-	template <
-		class Other = Result,
-		std::enable_if_t<
-			std::conjunction_v<
-				std::is_same<Other, Result>,
-				std::is_move_constructible<E>,
-				std::is_swappable<E>
-			>,
-			bool
-		> = false
-	>
-	constexpr void swap(Other& other) noexcept(
-		std::conjunction_v<
-			std::is_nothrow_move_constructible<E>,
-			std::is_nothrow_swappable<E>
-		>
-	) {
-		if(this->has_value()) {
-			if(other.has_value()) {
-				return;
-			} else {
-				this->data_.emplace_error(std::move(other.error()));
-				this->data_.has_value() = false;
-				other.destruct_error();
-				other.data_.has_value() = true;
-			}
-		} else {
-			if(other.has_value()) {
-				other.data_.emplace_error(std::move(this->error()));
-				other.data_.has_value() = false;
-				this->destruct_error();
-				this->data_.has_value() = true;
-				
-			} else {
-				using std::swap;
-				swap(this->error(), other.error());
-			}
-		}
-	}
-
-	constexpr bool has_value() const {
-		return this->data_.has_value();
-	}
-
-	explicit constexpr operator bool() const {
-		return this->has_value();
-	}
-
-	constexpr void value() const& {
-		if(!this->has_value()) {
-			data_.throw_bad_result_access();
-		}
-	}
-
-	constexpr void value() && {
-		if(!this->has_value()) {
-			std::move(data_).throw_bad_result_access();
-		}
-	}
-
-	constexpr E&& error() && {
-		assert_not_has_value();
-		return std::move(this->err());
-	}
-
-	constexpr const E&& error() const&& {
-		assert_not_has_value();
-		return std::move(this->err());
-	}
-
-	constexpr E& error() & {
-		assert_not_has_value();
-		return this->err();
-	}
-
-	constexpr const E& error() const& {
-		assert_not_has_value();
-		return this->err();
-	}
-
-private:
-	constexpr void assert_has_value() const {
-#if defined(assert) && !defined(TIM_RESULT_DISABLE_ASSERTIONS)
-		assert(this->has_value());
-#endif
-	}
-
-	constexpr void assert_not_has_value() const {
-#if defined(assert) && defined(TIM_RESULT_DISABLE_ASSERTIONS)
-		assert(not this->has_value());
-#endif
-	}
-
-	constexpr void destruct_value() noexcept {
-		return data_.destruct_value();
-	}
-
-	constexpr void destruct_error() noexcept {
-		return data_.destruct_error();
-	}
-
-	constexpr void destruct() noexcept {
-		return data_.destruct();
-	}
-
-	constexpr const E& err() const {
-		return this->data_.error();
-	}
-
-	constexpr E& err() {
-		return this->data_.error();
-	}
-
-	data_type data_;
-};
-
-template <class E>
-struct Result<const volatile void, E> {
-private:
-	template <class U, class G>
-	friend struct Result;
-
-	using data_type = detail::result_data_type<const volatile void, E>;
-	static constexpr detail::value_tag_t value_tag = detail::value_tag;
-	static constexpr detail::error_tag_t error_tag = detail::error_tag;
-public:
-
-	using value_type = const volatile void;
-	using error_type = E;
-
-	Result() = default;
-	Result(const Result&) = default;
-	Result(Result&&) = default;
-
-	template <
-		class G,
-		class U,
-		std::enable_if_t<
-			!std::is_convertible_v<const G&, E>
-			&& std::conjunction_v<
-				detail::is_cv_void<U>,
-				std::is_constructible<E, const G&>,
-				std::negation<std::is_constructible<Error<E>, Result<U, G>&>>,
-				std::negation<std::is_constructible<Error<E>, Result<U, G>&&>>,
-				std::negation<std::is_constructible<Error<E>, const Result<U, G>&>>,
-				std::negation<std::is_constructible<Error<E>, const Result<U, G>&&>>,
-				std::negation<std::is_convertible<Result<U, G>&, Error<E>>>,
-				std::negation<std::is_convertible<Result<U, G>&&, Error<E>>>,
-				std::negation<std::is_convertible<const Result<U, G>&, Error<E>>>,
-				std::negation<std::is_convertible<const Result<U, G>&&, Error<E>>>
-			>,
-			bool
-		> = false
-	>
-	explicit constexpr Result(const Result<U, G>& other) noexcept(std::is_nothrow_constructible_v<E, const G&>):
-		data_([&]() -> data_type {
-			if(other.has_value()) {
-				return data_type(value_tag);
-			} else {
-				return data_type(error_tag, other.err());
-			}
-		}())
-	{
-		
-	}
-
-	template <
-		class U,
-		class G,
-		std::enable_if_t<
-			std::is_convertible_v<const G&, E>
-			&& std::conjunction_v<
-				detail::is_cv_void<U>,
-				std::is_constructible<E, const G&>,
-				std::negation<std::is_constructible<Error<E>, Result<U, G>&>>,
-				std::negation<std::is_constructible<Error<E>, Result<U, G>&&>>,
-				std::negation<std::is_constructible<Error<E>, const Result<U, G>&>>,
-				std::negation<std::is_constructible<Error<E>, const Result<U, G>&&>>,
-				std::negation<std::is_convertible<Result<U, G>&, Error<E>>>,
-				std::negation<std::is_convertible<Result<U, G>&&, Error<E>>>,
-				std::negation<std::is_convertible<const Result<U, G>&, Error<E>>>,
-				std::negation<std::is_convertible<const Result<U, G>&&, Error<E>>>
-			>,
-			bool
-		> = false
-	>
-	constexpr Result(const Result<U, G>& other) noexcept(std::is_nothrow_constructible_v<E, const G&>):
-		data_([&]() -> data_type {
-			if(other.has_value()) {
-				return data_type(value_tag);
-			} else {
-				return data_type(error_tag, other.err());
-			}
-		}())
-	{
-		
-	}
-
-	template <
-		class U,
-		class G,
-		std::enable_if_t<
-			!std::is_convertible_v<G&&, E>
-			&& std::conjunction_v<
-				detail::is_cv_void<U>,
-				std::is_constructible<E, G&&>,
-				std::negation<std::is_constructible<Error<E>, Result<U, G>&>>,
-				std::negation<std::is_constructible<Error<E>, Result<U, G>&&>>,
-				std::negation<std::is_constructible<Error<E>, const Result<U, G>&>>,
-				std::negation<std::is_constructible<Error<E>, const Result<U, G>&&>>,
-				std::negation<std::is_convertible<Result<U, G>&, Error<E>>>,
-				std::negation<std::is_convertible<Result<U, G>&&, Error<E>>>,
-				std::negation<std::is_convertible<const Result<U, G>&, Error<E>>>,
-				std::negation<std::is_convertible<const Result<U, G>&&, Error<E>>>
-			>,
-			bool
-		> = false
-	>
-	constexpr explicit Result(Result<U, G>&& other) noexcept(std::is_nothrow_constructible_v<E, G&&>):
-		data_([&]() -> data_type {
-			if(other.has_value()) {
-				return data_type(value_tag);
-			} else {
-				return data_type(error_tag, std::move(other.err()));
-			}
-		}())
-	{
-		
-	}
-	
-	template <
-		class U,
-		class G,
-		std::enable_if_t<
-			std::is_convertible_v<G&&, E>
-			&& std::conjunction_v<
-				detail::is_cv_void<U>,
-				std::is_constructible<E, G&&>,
-				std::negation<std::is_constructible<Error<E>, Result<U, G>&>>,
-				std::negation<std::is_constructible<Error<E>, Result<U, G>&&>>,
-				std::negation<std::is_constructible<Error<E>, const Result<U, G>&>>,
-				std::negation<std::is_constructible<Error<E>, const Result<U, G>&&>>,
-				std::negation<std::is_convertible<Result<U, G>&, Error<E>>>,
-				std::negation<std::is_convertible<Result<U, G>&&, Error<E>>>,
-				std::negation<std::is_convertible<const Result<U, G>&, Error<E>>>,
-				std::negation<std::is_convertible<const Result<U, G>&&, Error<E>>>
-			>,
-			bool
-		> = false
-	>
-	constexpr Result(Result<U, G>&& other) noexcept(std::is_nothrow_constructible_v<E, G&&>):
-		data_([&]() -> data_type {
-			if(other.has_value()) {
-				return data_type(value_tag);
-			} else {
-				return data_type(error_tag, std::move(other.err()));
-			}
-		}())
-	{
-		
-	}
-	
-	template <
-		class G = E,
-		std::enable_if_t<
-			std::conjunction_v<
-				std::is_convertible<const G&, E>,
-				std::is_constructible<E, const G&>
-			>,
-			bool
-		> = false
-	>
-	constexpr Result(const Error<G>& v) noexcept(std::is_nothrow_constructible_v<E, const G&>):
-		data_(error_tag, v.value())
-	{
-			
-	}
-
-	template <
-		class G = E,
+		class G,
 		std::enable_if_t<
-			std::conjunction_v<
-				std::negation<std::is_convertible<const G&, E>>,
-				std::is_constructible<E, const G&>
-			>,
+			detail::is_cv_void_v<U>
+			&& detail::is_constructible_using_v<E, Alloc, G&&>,
 			bool
 		> = false
 	>
-	constexpr explicit Result(const Error<G>& v) noexcept(std::is_nothrow_constructible_v<E, const G&>):
-		data_(error_tag, v.value())
+	constexpr VoidResultBase(std::allocator_arg_t, const Alloc& alloc, Result<U, G>&& other):
+		data_([&]() -> data_type {
+			if(TIM_RESULT_EXPECT_HAS_VALUE(other.has_value(), U, G)) {
+				return data_type(value_tag);
+			} else {
+				return detail::make_alternative_using<data_type, E>(error_tag, alloc, std::move(other.err()));
+			}
+		}())
 	{
-			
+
 	}
 
 	template <
-		class G = E,
-		std::enable_if_t<
-			std::conjunction_v<
-				std::is_convertible<G&&, E>,
-				std::is_constructible<E, G&&>
-			>,
-			bool
-		> = false
+		class Alloc,
+		class G,
+		std::enable_if_t<detail::is_constructible_using_v<E, Alloc, const G&>, bool> = false
 	>
-	constexpr Result(Error<G>&& v) noexcept(std::is_nothrow_constructible_v<E, G&>):
-		data_(error_tag, std::move(v.value()))
+	constexpr VoidResultBase(std::allocator_arg_t, const Alloc& alloc, const Error<G>& e):
+		data_(detail::make_alternative_using<data_type, E>(error_tag, alloc, e.value()))
 	{
-			
+
 	}
 
 	template <
-		class G = E,
-		std::enable_if_t<
-			std::conjunction_v<
-				std::negation<std::is_convertible<G&&, E>>,
-				std::is_constructible<E, G&&>
-			>,
-			bool
-		> = false
+		class Alloc,
+		class G,
+		std::enable_if_t<detail::is_constructible_using_v<E, Alloc, G&&>, bool> = false
 	>
-	constexpr explicit Result(Error<G>&& v) noexcept(std::is_nothrow_constructible_v<E, G&&>):
-		data_(error_tag, std::move(v.value()))
+	constexpr VoidResultBase(std::allocator_arg_t, const Alloc& alloc, Error<G>&& e):
+		data_(detail::make_alternative_using<data_type, E>(error_tag, alloc, std::move(e.value())))
 	{
-			
+
 	}
 
-	constexpr explicit Result(in_place_t) noexcept:
+	template <class Alloc>
+	constexpr explicit VoidResultBase(std::allocator_arg_t, const Alloc&, in_place_t) noexcept:
 		data_(value_tag)
 	{
-			
+
 	}
 
 	template <
+		class Alloc,
 		class ... Args,
-		std::enable_if_t<std::is_constructible_v<E, Args&&...>, bool> = false
+		std::enable_if_t<detail::is_constructible_using_v<E, Alloc, Args&&...>, bool> = false
 	>
-	constexpr explicit Result(in_place_error_t, Args&& ... args) noexcept(std::is_nothrow_constructible_v<E, Args&&...>):
-		data_(error_tag, std::forward<Args>(args)...)
+	constexpr explicit VoidResultBase(std::allocator_arg_t, const Alloc& alloc, in_place_error_t, Args&& ... args):
+		data_(detail::make_alternative_using<data_type, E>(error_tag, alloc, std::forward<Args>(args)...))
 	{
-			
+
 	}
 
 	template <
+		class Alloc,
 		class U,
 		class ... Args,
-		std::enable_if_t<
-			std::is_constructible_v<E, std::initializer_list<U>&, Args&&...>,
-			bool
-		> = false
+		std::enable_if_t<detail::is_constructible_using_v<E, Alloc, std::initializer_list<U>&, Args&&...>, bool> = false
 	>
-	constexpr explicit Result(in_place_error_t, std::initializer_list<U> ilist, Args&& ... args) noexcept(
-		std::is_nothrow_constructible_v<E, std::initializer_list<U>, Args&&...>
-	):
-		data_(error_tag, ilist, std::forward<Args>(args)...)
+	constexpr explicit VoidResultBase(std::allocator_arg_t, const Alloc& alloc, in_place_error_t, std::initializer_list<U> ilist, Args&& ... args):
+		data_(detail::make_alternative_using<data_type, E>(error_tag, alloc, ilist, std::forward<Args>(args)...))
 	{
-			
+
 	}
 
-	constexpr Result& operator=(const Result&) = default;
-	constexpr Result& operator=(Result&&) = default;
+	constexpr VoidResultBase& operator=(const VoidResultBase&) = default;
+	constexpr VoidResultBase& operator=(VoidResultBase&&) = default;
+
+	constexpr void emplace() noexcept {
+		if(TIM_RESULT_EXPECT_HAS_VALUE(this->has_value(), void, E)) {
+			return;
+		}
+		this->destruct_error();
+		data_.has_value() = true;
+	}
+
+	constexpr bool has_value() const {
+		return this->data_.has_value();
+	}
+
+	explicit constexpr operator bool() const {
+		return this->has_value();
+	}
+
+	constexpr void value() const& {
+		if(!TIM_RESULT_EXPECT_HAS_VALUE(this->has_value(), void, E)) {
+			data_.bad_result_access();
+		}
+	}
+
+	constexpr void value() && {
+		if(!TIM_RESULT_EXPECT_HAS_VALUE(this->has_value(), void, E)) {
+			std::move(data_).bad_result_access();
+		}
+	}
+
+	constexpr E&& error() && {
+		assert_not_has_value();
+		return std::move(this->err());
+	}
+
+	constexpr const E&& error() const&& {
+		assert_not_has_value();
+		return std::move(this->err());
+	}
+
+	constexpr E& error() & {
+		assert_not_has_value();
+		return this->err();
+	}
+
+	constexpr const E& error() const& {
+		assert_not_has_value();
+		return this->err();
+	}
+
+private:
+	constexpr void assert_has_value() const {
+#if defined(assert) && !defined(TIM_RESULT_DISABLE_ASSERTIONS)
+		assert(this->has_value());
+#endif
+	}
+
+	constexpr void assert_not_has_value() const {
+#if defined(assert) && defined(TIM_RESULT_DISABLE_ASSERTIONS)
+		assert(not this->has_value());
+#endif
+	}
+
+	constexpr void destruct_value() noexcept {
+		return data_.destruct_value();
+	}
+
+	constexpr void destruct_error() noexcept {
+		return data_.destruct_error();
+	}
+
+	constexpr void destruct() noexcept {
+		return data_.destruct();
+	}
+
+	constexpr const E& err() const {
+		return this->data_.error();
+	}
+
+	constexpr E& err() {
+		return this->data_.error();
+	}
+
+	data_type data_;
+};
+
+// The members of 'Result<V, E>', for cv 'void' 'V', that name the 'Result'
+// type itself.  An empty base of 'Result' next to 'VoidResultBase<E>'.
+template <class V, class E>
+struct VoidResultMethods {
+	using value_type = V;
+	using error_type = E;
 
 	template <
 		class G,
@@ -4434,18 +5084,18 @@ public:
 			bool
 		> = false
 	>
-	constexpr Result& operator=(const Error<G>& e) noexcept(
+	constexpr Result<V, E>& operator=(const Error<G>& e) noexcept(
 		std::is_nothrow_assignable_v<E&, const G&>
 		&& std::is_nothrow_constructible_v<E, const G&>
 	)
 	{
-		if(!this->has_value()) {
-			this->err() = e.value();
-			return *this;
+		if(!TIM_RESULT_EXPECT_HAS_VALUE(self().has_value(), V, E)) {
+			self().err() = e.value();
+			return self();
 		}
-		this->data_.emplace_error(e.value());
-		data_.has_value() = false;
-		return *this;
+		self().data_.emplace_error(e.value());
+		self().data_.has_value() = false;
+		return self();
 	}
 
 	template <
@@ -4458,32 +5108,24 @@ public:
 			bool
 		> = false
 	>
-	constexpr Result& operator=(Error<G>&& e) noexcept(
+	constexpr Result<V, E>& operator=(Error<G>&& e) noexcept(
 		std::is_nothrow_assignable_v<E&, G&&>
 		&& std::is_nothrow_constructible_v<E, G&&>
 	) {
-		if(!this->has_value()) {
-			this->err() = std::move(e.value());
-			return *this;
-		}
-		this->data_.emplace_error(std::move(e.value()));
-		data_.has_value() = false;
-		return *this;
-	}
-
-	constexpr void emplace() noexcept {
-		if(this->has_value()) {
-			return;
+		if(!TIM_RESULT_EXPECT_HAS_VALUE(self().has_value(), V, E)) {
+			self().err() = std::move(e.value());
+			return self();
 		}
-		this->destruct_error();
-		data_.has_value() = true;
+		self().data_.emplace_error(std::move(e.value()));
+		self().data_.has_value() = false;
+		return self();
 	}
 
 	template <
-		class Other = Result,
+		class Other = Result<V, E>,
 		std::enable_if_t<
 			std::conjunction_v<
-				std::is_same<Other, Result>,
+				std::is_same<Other, Result<V, E>>,
 				std::is_move_constructible<E>,
 				std::is_swappable<E>
 			>,
@@ -4496,103 +5138,206 @@ public:
 			std::is_nothrow_swappable<E>
 		>
 	) {
-		if(this->has_value()) {
-			if(other.has_value()) {
+		if constexpr(detail::relocate_on_swap_v<V, E>) {
+			if(self().has_value() != other.has_value()) {
+				detail::swap_object_representations(self().data_, other.data_);
+				return;
+			}
+		}
+		if(TIM_RESULT_EXPECT_HAS_VALUE(self().has_value(), V, E)) {
+			if(TIM_RESULT_EXPECT_HAS_VALUE(other.has_value(), V, E)) {
 				return;
 			} else {
-				this->data_.emplace_error(std::move(other.error()));
-				this->data_.has_value() = false;
+				self().data_.emplace_error(std::move(other.error()));
+				self().data_.has_value() = false;
 				other.destruct_error();
-				other.data_.has_value() = false;
+				other.data_.has_value() = true;
 			}
 		} else {
-			if(other.has_value()) {
-				other.data_.emplace_error(std::move(this->error()));
+			if(TIM_RESULT_EXPECT_HAS_VALUE(other.has_value(), V, E)) {
+				other.data_.emplace_error(std::move(self().error()));
 				other.data_.has_value() = false;
-				this->destruct_error();
-				this->data_.has_value() = true;
+				self().destruct_error();
+				self().data_.has_value() = true;
 				
 			} else {
 				using std::swap;
-				swap(this->error(), other.error());
+				swap(self().error(), other.error());
 			}
 		}
 	}
 
-	constexpr bool has_value() const {
-		return this->data_.has_value();
+	template <class F>
+	constexpr auto map(F&& f) & {
+		return detail::result_map(self(), std::forward<F>(f));
 	}
 
-	explicit constexpr operator bool() const {
-		return this->has_value();
+	template <class F>
+	constexpr auto map(F&& f) const& {
+		return detail::result_map(self(), std::forward<F>(f));
 	}
 
-	constexpr void value() const& {
-		if(!this->has_value()) {
-			data_.throw_bad_result_access();
-		}
+	template <class F>
+	constexpr auto map(F&& f) && {
+		return detail::result_map(std::move(self()), std::forward<F>(f));
 	}
 
-	constexpr void value() && {
-		if(!this->has_value()) {
-			std::move(data_).throw_bad_result_access();
-		}
+	template <class F>
+	constexpr auto map(F&& f) const&& {
+		return detail::result_map(std::move(self()), std::forward<F>(f));
 	}
 
-	constexpr E&& error() && {
-		assert_not_has_value();
-		return std::move(this->err());
+	template <class F>
+	constexpr auto map_error(F&& f) & {
+		return detail::result_map_error(self(), std::forward<F>(f));
 	}
 
-	constexpr const E&& error() const&& {
-		assert_not_has_value();
-		return std::move(this->err());
+	template <class F>
+	constexpr auto map_error(F&& f) const& {
+		return detail::result_map_error(self(), std::forward<F>(f));
 	}
 
-	constexpr E& error() & {
-		assert_not_has_value();
-		return this->err();
+	template <class F>
+	constexpr auto map_error(F&& f) && {
+		return detail::result_map_error(std::move(self()), std::forward<F>(f));
 	}
 
-	constexpr const E& error() const& {
-		assert_not_has_value();
-		return this->err();
+	template <class F>
+	constexpr auto map_error(F&& f) const&& {
+		return detail::result_map_error(std::move(self()), std::forward<F>(f));
 	}
 
-private:
-	constexpr void assert_has_value() const {
-#if defined(assert) && !defined(TIM_RESULT_DISABLE_ASSERTIONS)
-		assert(this->has_value());
-#endif
+	template <class F>
+	constexpr auto and_then(F&& f) & {
+		return detail::result_and_then(self(), std::forward<F>(f));
 	}
 
-	constexpr void assert_not_has_value() const {
-#if defined(assert) && defined(TIM_RESULT_DISABLE_ASSERTIONS)
-		assert(not this->has_value());
-#endif
+	template <class F>
+	constexpr auto and_then(F&& f) const& {
+		return detail::result_and_then(self(), std::forward<F>(f));
 	}
 
-	constexpr void destruct_value() noexcept {
-		return data_.destruct_value();
+	template <class F>
+	constexpr auto and_then(F&& f) && {
+		return detail::result_and_then(std::move(self()), std::forward<F>(f));
 	}
 
-	constexpr void destruct_error() noexcept {
-		return data_.destruct_error();
+	template <class F>
+	constexpr auto and_then(F&& f) const&& {
+		return detail::result_and_then(std::move(self()), std::forward<F>(f));
 	}
 
-	constexpr void destruct() noexcept {
-		return data_.destruct();
+	template <class F>
+	constexpr auto or_else(F&& f) & {
+		return detail::result_or_else(self(), std::forward<F>(f));
 	}
 
-	constexpr const E& err() const {
-		return this->data_.error();
+	template <class F>
+	constexpr auto or_else(F&& f) const& {
+		return detail::result_or_else(self(), std::forward<F>(f));
 	}
 
-	constexpr E& err() {
-		return this->data_.error();
+	template <class F>
+	constexpr auto or_else(F&& f) && {
+		return detail::result_or_else(std::move(self()), std::forward<F>(f));
 	}
 
-	data_type data_;
+	template <class F>
+	constexpr auto or_else(F&& f) const&& {
+		return detail::result_or_else(std::move(self()), std::forward<F>(f));
+	}
+
+	template <class F>
+	constexpr auto transform(F&& f) & {
+		return detail::result_map(self(), std::forward<F>(f));
+	}
+
+	template <class F>
+	constexpr auto transform(F&& f) const& {
+		return detail::result_map(self(), std::forward<F>(f));
+	}
+
+	template <class F>
+	constexpr auto transform(F&& f) && {
+		return detail::result_map(std::move(self()), std::forward<F>(f));
+	}
+
+	template <class F>
+	constexpr auto transform(F&& f) const&& {
+		return detail::result_map(std::move(self()), std::forward<F>(f));
+	}
+
+	template <class F>
+	constexpr auto transform_error(F&& f) & {
+		return detail::result_map_error(self(), std::forward<F>(f));
+	}
+
+	template <class F>
+	constexpr auto transform_error(F&& f) const& {
+		return detail::result_map_error(self(), std::forward<F>(f));
+	}
+
+	template <class F>
+	constexpr auto transform_error(F&& f) && {
+		return detail::result_map_error(std::move(self()), std::forward<F>(f));
+	}
+
+	template <class F>
+	constexpr auto transform_error(F&& f) const&& {
+		return detail::result_map_error(std::move(self()), std::forward<F>(f));
+	}
+
+	// See 'Result<T, E>::context()'.
+	Result<V, E>& context(const char* what, const source_location& where = source_location::current()) & noexcept {
+		static_assert(detail::has_error_context_v<E>,
+			"'Result<T, E>::context()' requires an error type that keeps an error trail (see 'traits::error_context_traits').");
+		if(!TIM_RESULT_EXPECT_HAS_VALUE(self().has_value(), V, E)) {
+			traits::error_context_traits<E>::append(self().err(), what, where);
+		}
+		return self();
+	}
+
+	Result<V, E> context(const char* what, const source_location& where = source_location::current()) && noexcept(
+		std::is_nothrow_move_constructible_v<Result<V, E>>
+	) {
+		this->context(what, where);
+		return std::move(self());
+	}
+
+private:
+	constexpr Result<V, E>& self() & noexcept {
+		return static_cast<Result<V, E>&>(*this);
+	}
+
+	constexpr const Result<V, E>& self() const& noexcept {
+		return static_cast<const Result<V, E>&>(*this);
+	}
+};
+
+} /* namespace detail */
+
+template <class E>
+struct Result<void, E>: detail::VoidResultBase<E>, detail::VoidResultMethods<void, E> {
+	using detail::VoidResultBase<E>::VoidResultBase;
+	using detail::VoidResultMethods<void, E>::operator=;
+};
+
+template <class E>
+struct Result<const void, E>: detail::VoidResultBase<E>, detail::VoidResultMethods<const void, E> {
+	using detail::VoidResultBase<E>::VoidResultBase;
+	using detail::VoidResultMethods<const void, E>::operator=;
+};
+
+template <class E>
+struct Result<volatile void, E>: detail::VoidResultBase<E>, detail::VoidResultMethods<volatile void, E> {
+	using detail::VoidResultBase<E>::VoidResultBase;
+	using detail::VoidResultMethods<volatile void, E>::operator=;
+};
+
+template <class E>
+struct Result<const volatile void, E>: detail::VoidResultBase<E>, detail::VoidResultMethods<const volatile void, E> {
+	using detail::VoidResultBase<E>::VoidResultBase;
+	using detail::VoidResultMethods<const volatile void, E>::operator=;
 };
 
 namespace traits::detail {
@@ -4693,8 +5438,8 @@ template <
 	> = false
 >
 constexpr bool operator==(const Result<T1, E1>& lhs, const Result<T2, E2>& rhs) {
-	if(lhs.has_value()) {
-		if(rhs.has_value()) {
+	if(TIM_RESULT_EXPECT_HAS_VALUE(lhs.has_value(), T1, E1)) {
+		if(TIM_RESULT_EXPECT_HAS_VALUE(rhs.has_value(), T2, E2)) {
 			if constexpr(!detail::is_cv_void_v<T1>) {
 				return *lhs == *rhs;
 			} else {
@@ -4703,7 +5448,7 @@ constexpr bool operator==(const Result<T1, E1>& lhs, const Result<T2, E2>& rhs)
 		}
 		return false;
 	} else {
-		if(!rhs.has_value()) {
+		if(!TIM_RESULT_EXPECT_HAS_VALUE(rhs.has_value(), T2, E2)) {
 			return lhs.error() == rhs.error();
 		}
 		return false;
@@ -4723,7 +5468,7 @@ template <
 	> = false
 >
 constexpr bool operator==(const Result<T1, E1>& lhs, T2&& rhs) {
-	if(lhs.has_value()) {
+	if(TIM_RESULT_EXPECT_HAS_VALUE(lhs.has_value(), T1, E1)) {
 		return *lhs == std::forward<T2>(rhs);
 	} else {
 		return false;
@@ -4743,7 +5488,7 @@ template <
 	> = false
 >
 constexpr bool operator==(T1&& lhs, const Result<T2, E2>& rhs) {
-	if(rhs.has_value()) {
+	if(TIM_RESULT_EXPECT_HAS_VALUE(rhs.has_value(), T2, E2)) {
 		return std::forward<T1>(lhs) == *rhs;
 	} else {
 		return false;
@@ -4760,7 +5505,7 @@ template <
 	> = false
 >
 constexpr bool operator==(const Result<T1, E1>& lhs, const Error<E2>& rhs) {
-	if(lhs.has_value()) {
+	if(TIM_RESULT_EXPECT_HAS_VALUE(lhs.has_value(), T1, E1)) {
 		return false;
 	}
 	return lhs.error() == rhs.value();
@@ -4776,7 +5521,7 @@ template <
 	> = false
 >
 constexpr bool operator==(const Error<E1>& lhs, const Result<T2, E2>& rhs) {
-	if(rhs.has_value()) {
+	if(TIM_RESULT_EXPECT_HAS_VALUE(rhs.has_value(), T2, E2)) {
 		return false;
 	}
 	return lhs.value() == rhs.error();
@@ -4793,8 +5538,8 @@ template <
 >
 constexpr bool operator!=(const Result<T1, E1>& lhs, const Result<T2, E2>& rhs) {
 	static_assert(detail::is_cv_void_v<T1> == detail::is_cv_void_v<T2>);
-	if(lhs.has_value()) {
-		if(rhs.has_value()) {
+	if(TIM_RESULT_EXPECT_HAS_VALUE(lhs.has_value(), T1, E1)) {
+		if(TIM_RESULT_EXPECT_HAS_VALUE(rhs.has_value(), T2, E2)) {
 			if constexpr(!detail::is_cv_void_v<T1>) {
 				return *lhs != *rhs;
 			} else {
@@ -4803,7 +5548,7 @@ constexpr bool operator!=(const Result<T1, E1>& lhs, const Result<T2, E2>& rhs)
 		}
 		return true;
 	} else {
-		if(!rhs.has_value()) {
+		if(!TIM_RESULT_EXPECT_HAS_VALUE(rhs.has_value(), T2, E2)) {
 			return lhs.error() != rhs.error();
 		}
 		return true;
@@ -4823,7 +5568,7 @@ template <
 	> = false
 >
 constexpr bool operator!=(const Result<T1, E1>& lhs, T2&& rhs) {
-	if(lhs.has_value()) {
+	if(TIM_RESULT_EXPECT_HAS_VALUE(lhs.has_value(), T1, E1)) {
 		return *lhs != std::forward<T2>(rhs);
 	} else {
 		return true;
@@ -4843,7 +5588,7 @@ template <
 	> = false
 >
 constexpr bool operator!=(T1&& lhs, const Result<T2, E2>& rhs) {
-	if(rhs.has_value()) {
+	if(TIM_RESULT_EXPECT_HAS_VALUE(rhs.has_value(), T2, E2)) {
 		return std::forward<T1>(lhs) != *rhs;
 	} else {
 		return true;
@@ -4860,7 +5605,7 @@ template <
 	> = false
 >
 constexpr bool operator!=(const Result<T1, E1>& lhs, const Error<E2>& rhs) {
-	if(lhs.has_value()) {
+	if(TIM_RESULT_EXPECT_HAS_VALUE(lhs.has_value(), T1, E1)) {
 		return true;
 	}
 	return lhs.error() != rhs.value();
@@ -4876,7 +5621,7 @@ template <
 	> = false
 >
 constexpr bool operator!=(const Error<E1>& lhs, const Result<T2, E2>& rhs) {
-	if(rhs.has_value()) {
+	if(TIM_RESULT_EXPECT_HAS_VALUE(rhs.has_value(), T2, E2)) {
 		return true;
 	}
 	return lhs.value() != rhs.error();
@@ -4900,7 +5645,6 @@ constexpr void swap(Result<T, E>& lhs, Result<T, E>& rhs) noexcept(noexcept(lhs.
 }
 
 template <
-	class T,
 	class E,
 	std::enable_if_t<
 		std::is_move_constructible_v<E>
@@ -4913,7 +5657,6 @@ constexpr void swap(Result<void, E>& lhs, Result<void, E>& rhs) noexcept(noexcep
 }
 
 template <
-	class T,
 	class E,
 	std::enable_if_t<
 		std::is_move_constructible_v<E>
@@ -4926,7 +5669,6 @@ constexpr void swap(Result<const void, E>& lhs, Result<const void, E>& rhs) noex
 }
 
 template <
-	class T,
 	class E,
 	std::enable_if_t<
 		std::is_move_constructible_v<E>
@@ -4939,7 +5681,6 @@ constexpr void swap(Result<volatile void, E>& lhs, Result<volatile void, E>& rhs
 }
 
 template <
-	class T,
 	class E,
 	std::enable_if_t<
 		std::is_move_constructible_v<E>
@@ -4955,4 +5696,68 @@ constexpr void swap(Result<const volatile void, E>& lhs, Result<const volatile v
 
 } /* namespace tim */
 
+namespace std {
+
+// Containers pass their allocator on to 'Result's whose alternatives use it.
+template <class T, class E, class Alloc>
+struct uses_allocator<tim::Result<T, E>, Alloc>: bool_constant<
+	uses_allocator_v<T, Alloc> || uses_allocator_v<E, Alloc>
+> {};
+
+} /* namespace std */
+
+// Error propagation.
+//
+// 'TIM_TRY(expr)' evaluates 'expr', which must produce a 'Result'.  If it holds
+// an error, the enclosing function returns that error; otherwise 'TIM_TRY()'
+// yields the value.  'TIM_TRY_ASSIGN(var, expr)' does the same and assigns the
+// value to 'var', which may also be a declaration ('TIM_TRY_ASSIGN(auto x, f())').
+// The enclosing function must return a 'Result' whose error type is
+// implicitly convertible from the propagated error; the error is moved (or
+// copied, if 'expr' is an lvalue) directly into the returned 'Result'.
+//
+// Using the value of 'TIM_TRY()' requires GNU statement expressions.  Without
+// them ('TIM_RESULT_HAS_STATEMENT_EXPRESSIONS' is 0) 'TIM_TRY()' is a statement
+// that discards the value; 'TIM_TRY_ASSIGN()' works everywhere.
+
+#ifndef TIM_RESULT_HAS_STATEMENT_EXPRESSIONS
+# if defined(__GNUC__) || defined(__clang__)
+#  define TIM_RESULT_HAS_STATEMENT_EXPRESSIONS 1
+# else
+#  define TIM_RESULT_HAS_STATEMENT_EXPRESSIONS 0
+# endif
+#endif
+
+#define TIM_RESULT_CONCAT_IMPL(a, b) a##b
+#define TIM_RESULT_CONCAT(a, b) TIM_RESULT_CONCAT_IMPL(a, b)
+#define TIM_RESULT_UNIQUE_NAME(prefix) TIM_RESULT_CONCAT(prefix, __COUNTER__)
+
+#define TIM_RESULT_TRY_PROPAGATE(tmp) \
+	if(!TIM_RESULT_EXPECT_HAS_VALUE(tmp.has_value(), \
+			::tim::result::detail::result_value_t<decltype(tmp)>, \
+			::tim::result::detail::result_error_t<decltype(tmp)>)) { \
+		return ::tim::result::detail::propagate_error(std::forward<decltype(tmp)>(tmp)); \
+	}
+
+#if TIM_RESULT_HAS_STATEMENT_EXPRESSIONS
+# define TIM_RESULT_TRY_IMPL(tmp, ...) __extension__ ({ \
+	auto&& tmp = (__VA_ARGS__); \
+	TIM_RESULT_TRY_PROPAGATE(tmp) \
+	::tim::result::detail::try_value(std::forward<decltype(tmp)>(tmp)); \
+})
+#else
+# define TIM_RESULT_TRY_IMPL(tmp, ...) do { \
+	auto&& tmp = (__VA_ARGS__); \
+	TIM_RESULT_TRY_PROPAGATE(tmp) \
+} while(false)
+#endif
+
+#define TIM_RESULT_TRY_ASSIGN_IMPL(tmp, var, ...) \
+	auto&& tmp = (__VA_ARGS__); \
+	TIM_RESULT_TRY_PROPAGATE(tmp) \
+	var = ::tim::result::detail::try_value(std::forward<decltype(tmp)>(tmp))
+
+#define TIM_TRY(...) TIM_RESULT_TRY_IMPL(TIM_RESULT_UNIQUE_NAME(tim_try_result_), __VA_ARGS__)
+#define TIM_TRY_ASSIGN(var, ...) TIM_RESULT_TRY_ASSIGN_IMPL(TIM_RESULT_UNIQUE_NAME(tim_try_result_), var, __VA_ARGS__)
+
 #endif /* TIM_RESULT_HPP */
@@ -0,0 +1,710 @@
+#ifndef TIM_RESULT_RESULT_VECTOR_HPP
+#define TIM_RESULT_RESULT_VECTOR_HPP
+
+#include "tim/result/Result.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace tim {
+
+inline namespace result {
+
+namespace detail {
+
+inline int popcount64(std::uint64_t word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_popcountll(word);
+#else
+	word = word - ((word >> 1) & 0x5555555555555555u);
+	word = (word & 0x3333333333333333u) + ((word >> 2) & 0x3333333333333333u);
+	word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0Fu;
+	return static_cast<int>((word * 0x0101010101010101u) >> 56);
+#endif
+}
+
+// 'word' must not be zero.
+inline int countr_zero64(std::uint64_t word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_ctzll(word);
+#else
+	int n = 0;
+	while(!(word & 1u)) {
+		word >>= 1;
+		++n;
+	}
+	return n;
+#endif
+}
+
+// One element of a 'ResultVector': storage for either alternative.  Which one
+// is alive is recorded in the vector's status bitmap.
+template <class T, class E>
+union ResultSlot {
+	ResultSlot() noexcept {}
+	~ResultSlot() {}
+
+	T value;
+	E error;
+};
+
+} /* namespace detail */
+
+template <class T, class E>
+class ResultVector;
+
+// A proxy for an element of a 'ResultVector<T, E>' that behaves like a
+// 'Result<T, E>&' (or 'const Result<T, E>&' when 'Const').
+template <class T, class E, bool Const>
+class ResultVectorReference {
+	using slot_type = std::conditional_t<Const, const detail::ResultSlot<T, E>, detail::ResultSlot<T, E>>;
+	using word_type = std::conditional_t<Const, const std::uint64_t, std::uint64_t>;
+	using value_reference = std::conditional_t<Const, const T&, T&>;
+	using error_reference = std::conditional_t<Const, const E&, E&>;
+public:
+	using value_type = T;
+	using error_type = E;
+	using result_type = Result<T, E>;
+
+	ResultVectorReference(const ResultVectorReference&) = default;
+
+	template <bool C = Const, std::enable_if_t<C, bool> = false>
+	ResultVectorReference(const ResultVectorReference<T, E, false>& other) noexcept:
+		slot_(other.slot_),
+		word_(other.word_),
+		mask_(other.mask_)
+	{
+
+	}
+
+	bool has_value() const noexcept {
+		return (*word_ & mask_) != 0u;
+	}
+
+	explicit operator bool() const noexcept {
+		return has_value();
+	}
+
+	value_reference operator*() const noexcept {
+		assert_has_value();
+		return slot_->value;
+	}
+
+	std::add_pointer_t<value_reference> operator->() const noexcept {
+		assert_has_value();
+		return std::addressof(slot_->value);
+	}
+
+	value_reference value() const {
+		if(!has_value()) {
+			detail::bad_result_access<E>(std::as_const(slot_->error));
+		}
+		return slot_->value;
+	}
+
+	error_reference error() const noexcept {
+		assert_not_has_value();
+		return slot_->error;
+	}
+
+	template <class U>
+	T value_or(U&& alt) const {
+		if(has_value()) {
+			return slot_->value;
+		}
+		return std::forward<U>(alt);
+	}
+
+	operator result_type() const {
+		if(has_value()) {
+			return result_type(tim::in_place, slot_->value);
+		}
+		return result_type(tim::in_place_error, slot_->error);
+	}
+
+	// Assignment replaces the element, as with 'std::vector<bool>::reference'.
+	const ResultVectorReference& operator=(const ResultVectorReference& other) const {
+		static_assert(!Const, "Cannot assign through a 'const_reference'.");
+		if(other.has_value()) {
+			assign_value(*other);
+		} else {
+			assign_error(other.error());
+		}
+		return *this;
+	}
+
+	template <bool C = Const, std::enable_if_t<!C, bool> = false>
+	const ResultVectorReference& operator=(const result_type& r) const {
+		if(r.has_value()) {
+			assign_value(*r);
+		} else {
+			assign_error(r.error());
+		}
+		return *this;
+	}
+
+	template <bool C = Const, std::enable_if_t<!C, bool> = false>
+	const ResultVectorReference& operator=(result_type&& r) const {
+		if(r.has_value()) {
+			assign_value(*std::move(r));
+		} else {
+			assign_error(std::move(r).error());
+		}
+		return *this;
+	}
+
+private:
+	friend class ResultVector<T, E>;
+	friend class ResultVectorReference<T, E, !Const>;
+
+	ResultVectorReference(slot_type* slot, word_type* word, std::uint64_t mask) noexcept:
+		slot_(slot),
+		word_(word),
+		mask_(mask)
+	{
+
+	}
+
+	template <class U>
+	void assign_value(U&& v) const {
+		if(has_value()) {
+			slot_->value = std::forward<U>(v);
+		} else {
+			T tmp(std::forward<U>(v));
+			slot_->error.~E();
+			::new(static_cast<void*>(std::addressof(slot_->value))) T(std::move(tmp));
+			*word_ |= mask_;
+		}
+	}
+
+	template <class G>
+	void assign_error(G&& e) const {
+		if(!has_value()) {
+			slot_->error = std::forward<G>(e);
+		} else {
+			E tmp(std::forward<G>(e));
+			slot_->value.~T();
+			::new(static_cast<void*>(std::addressof(slot_->error))) E(std::move(tmp));
+			*word_ &= ~mask_;
+		}
+	}
+
+
+	void assert_has_value() const noexcept {
+#if defined(assert) && !defined(TIM_RESULT_DISABLE_ASSERTIONS)
+		assert(has_value());
+#endif
+	}
+
+	void assert_not_has_value() const noexcept {
+#if defined(assert) && !defined(TIM_RESULT_DISABLE_ASSERTIONS)
+		assert(!has_value());
+#endif
+	}
+
+	slot_type* slot_;
+	word_type* word_;
+	std::uint64_t mask_;
+};
+
+// A random access iterator over a 'ResultVector' whose 'operator*()' returns a
+// 'ResultVectorReference' by value.
+template <class T, class E, bool Const>
+class ResultVectorIterator {
+	using vector_type = std::conditional_t<Const, const ResultVector<T, E>, ResultVector<T, E>>;
+public:
+	using iterator_category = std::random_access_iterator_tag;
+	using value_type = Result<T, E>;
+	using difference_type = std::ptrdiff_t;
+	using reference = ResultVectorReference<T, E, Const>;
+	using pointer = void;
+
+	ResultVectorIterator() = default;
+
+	template <bool C = Const, std::enable_if_t<C, bool> = false>
+	ResultVectorIterator(const ResultVectorIterator<T, E, false>& other) noexcept:
+		vec_(other.vec_),
+		index_(other.index_)
+	{
+
+	}
+
+	reference operator*() const noexcept {
+		return (*vec_)[index_];
+	}
+
+	reference operator[](difference_type n) const noexcept {
+		return (*vec_)[static_cast<std::size_t>(static_cast<difference_type>(index_) + n)];
+	}
+
+	ResultVectorIterator& operator++() noexcept {
+		++index_;
+		return *this;
+	}
+
+	ResultVectorIterator operator++(int) noexcept {
+		auto tmp = *this;
+		++index_;
+		return tmp;
+	}
+
+	ResultVectorIterator& operator--() noexcept {
+		--index_;
+		return *this;
+	}
+
+	ResultVectorIterator operator--(int) noexcept {
+		auto tmp = *this;
+		--index_;
+		return tmp;
+	}
+
+	ResultVectorIterator& operator+=(difference_type n) noexcept {
+		index_ = static_cast<std::size_t>(static_cast<difference_type>(index_) + n);
+		return *this;
+	}
+
+	ResultVectorIterator& operator-=(difference_type n) noexcept {
+		return *this += -n;
+	}
+
+	friend ResultVectorIterator operator+(ResultVectorIterator it, difference_type n) noexcept {
+		return it += n;
+	}
+
+	friend ResultVectorIterator operator+(difference_type n, ResultVectorIterator it) noexcept {
+		return it += n;
+	}
+
+	friend ResultVectorIterator operator-(ResultVectorIterator it, difference_type n) noexcept {
+		return it -= n;
+	}
+
+	friend difference_type operator-(const ResultVectorIterator& l, const ResultVectorIterator& r) noexcept {
+		return static_cast<difference_type>(l.index_) - static_cast<difference_type>(r.index_);
+	}
+
+	friend bool operator==(const ResultVectorIterator& l, const ResultVectorIterator& r) noexcept {
+		return l.index_ == r.index_;
+	}
+
+	friend bool operator!=(const ResultVectorIterator& l, const ResultVectorIterator& r) noexcept {
+		return l.index_ != r.index_;
+	}
+
+	friend bool operator<(const ResultVectorIterator& l, const ResultVectorIterator& r) noexcept {
+		return l.index_ < r.index_;
+	}
+
+	friend bool operator>(const ResultVectorIterator& l, const ResultVectorIterator& r) noexcept {
+		return l.index_ > r.index_;
+	}
+
+	friend bool operator<=(const ResultVectorIterator& l, const ResultVectorIterator& r) noexcept {
+		return l.index_ <= r.index_;
+	}
+
+	friend bool operator>=(const ResultVectorIterator& l, const ResultVectorIterator& r) noexcept {
+		return l.index_ >= r.index_;
+	}
+
+private:
+	friend class ResultVector<T, E>;
+	friend class ResultVectorIterator<T, E, !Const>;
+
+	ResultVectorIterator(vector_type* vec, std::size_t index) noexcept:
+		vec_(vec),
+		index_(index)
+	{
+
+	}
+
+	vector_type* vec_ = nullptr;
+	std::size_t index_ = 0;
+};
+
+// A sequence of 'Result<T, E>' stored as an array of slots, each big enough
+// for either a 'T' or an 'E', plus a bitmap with one bit per element that is
+// set when the element holds a value.  This saves the padding that every
+// 'Result' spends on its flag: 'Result<double, std::uint16_t>' takes 16 bytes
+// per element in a 'std::vector' and a little over 8 here.
+//
+// Elements are accessed through 'ResultVectorReference' proxies.
+// 'count_values()', 'count_errors()', 'find_value()', 'find_error()',
+// 'for_each_value()' and 'for_each_error()' only read the bitmap to decide
+// which slots to visit.
+template <class T, class E>
+class ResultVector {
+	static_assert(!detail::is_cv_void_v<T>, "'ResultVector<T, E>' requires a non-void 'T'.");
+	static_assert(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_constructible_v<E>,
+		"'ResultVector<T, E>' requires nothrow move constructible 'T' and 'E'.");
+
+	using slot_type = detail::ResultSlot<T, E>;
+	using word_type = std::uint64_t;
+	static constexpr std::size_t word_bits = 64;
+public:
+	using value_type = Result<T, E>;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using reference = ResultVectorReference<T, E, false>;
+	using const_reference = ResultVectorReference<T, E, true>;
+	using iterator = ResultVectorIterator<T, E, false>;
+	using const_iterator = ResultVectorIterator<T, E, true>;
+
+	ResultVector() = default;
+
+	ResultVector(const ResultVector& other) {
+		reserve(other.size_);
+		for(std::size_t i = 0; i < other.size_; ++i) {
+			if(other.test(i)) {
+				emplace_back(tim::in_place, other.slots_[i].value);
+			} else {
+				emplace_back(tim::in_place_error, other.slots_[i].error);
+			}
+		}
+	}
+
+	ResultVector(ResultVector&& other) noexcept:
+		slots_(std::exchange(other.slots_, nullptr)),
+		bits_(std::move(other.bits_)),
+		size_(std::exchange(other.size_, 0u)),
+		capacity_(std::exchange(other.capacity_, 0u))
+	{
+		other.bits_.clear();
+	}
+
+	ResultVector(std::initializer_list<value_type> ilist) {
+		reserve(ilist.size());
+		for(const auto& r: ilist) {
+			push_back(r);
+		}
+	}
+
+	ResultVector& operator=(const ResultVector& other) {
+		if(this != &other) {
+			ResultVector tmp(other);
+			swap(tmp);
+		}
+		return *this;
+	}
+
+	ResultVector& operator=(ResultVector&& other) noexcept {
+		if(this != &other) {
+			ResultVector tmp(std::move(other));
+			swap(tmp);
+		}
+		return *this;
+	}
+
+	~ResultVector() {
+		clear();
+		deallocate(slots_, capacity_);
+	}
+
+	void swap(ResultVector& other) noexcept {
+		using std::swap;
+		swap(slots_, other.slots_);
+		swap(bits_, other.bits_);
+		swap(size_, other.size_);
+		swap(capacity_, other.capacity_);
+	}
+
+	friend void swap(ResultVector& l, ResultVector& r) noexcept {
+		l.swap(r);
+	}
+
+	size_type size() const noexcept {
+		return size_;
+	}
+
+	bool empty() const noexcept {
+		return size_ == 0u;
+	}
+
+	size_type capacity() const noexcept {
+		return capacity_;
+	}
+
+	void reserve(size_type n) {
+		if(n > capacity_) {
+			reallocate(n);
+		}
+	}
+
+	void clear() noexcept {
+		for(std::size_t i = 0; i < size_; ++i) {
+			destroy(i);
+		}
+		std::fill(bits_.begin(), bits_.end(), word_type(0));
+		size_ = 0;
+	}
+
+	reference operator[](size_type i) noexcept {
+		return reference(slots_ + i, bits_.data() + i / word_bits, mask(i));
+	}
+
+	const_reference operator[](size_type i) const noexcept {
+		return const_reference(slots_ + i, bits_.data() + i / word_bits, mask(i));
+	}
+
+	reference front() noexcept {
+		return (*this)[0];
+	}
+
+	const_reference front() const noexcept {
+		return (*this)[0];
+	}
+
+	reference back() noexcept {
+		return (*this)[size_ - 1u];
+	}
+
+	const_reference back() const noexcept {
+		return (*this)[size_ - 1u];
+	}
+
+	iterator begin() noexcept {
+		return iterator(this, 0u);
+	}
+
+	const_iterator begin() const noexcept {
+		return const_iterator(this, 0u);
+	}
+
+	const_iterator cbegin() const noexcept {
+		return begin();
+	}
+
+	iterator end() noexcept {
+		return iterator(this, size_);
+	}
+
+	const_iterator end() const noexcept {
+		return const_iterator(this, size_);
+	}
+
+	const_iterator cend() const noexcept {
+		return end();
+	}
+
+	template <class ... Args>
+	reference emplace_back(tim::in_place_t, Args&& ... args) {
+		emplace_slot(tim::in_place, std::forward<Args>(args)...);
+		bits_[size_ / word_bits] |= mask(size_);
+		return (*this)[size_++];
+	}
+
+	template <class ... Args>
+	reference emplace_back(tim::in_place_error_t, Args&& ... args) {
+		emplace_slot(tim::in_place_error, std::forward<Args>(args)...);
+		return (*this)[size_++];
+	}
+
+	void push_back(const value_type& r) {
+		if(r.has_value()) {
+			emplace_back(tim::in_place, *r);
+		} else {
+			emplace_back(tim::in_place_error, r.error());
+		}
+	}
+
+	void push_back(value_type&& r) {
+		if(r.has_value()) {
+			emplace_back(tim::in_place, *std::move(r));
+		} else {
+			emplace_back(tim::in_place_error, std::move(r).error());
+		}
+	}
+
+	void pop_back() noexcept {
+		--size_;
+		destroy(size_);
+		bits_[size_ / word_bits] &= ~mask(size_);
+	}
+
+	// The number of elements holding a value.
+	size_type count_values() const noexcept {
+		size_type n = 0;
+		for(word_type word: bits_) {
+			n += static_cast<size_type>(detail::popcount64(word));
+		}
+		return n;
+	}
+
+	// The number of elements holding an error.
+	size_type count_errors() const noexcept {
+		return size_ - count_values();
+	}
+
+	// The index of the first element at or after 'from' that holds a value, or
+	// 'size()' if there is none.
+	size_type find_value(size_type from = 0) const noexcept {
+		return find(from, word_type(0));
+	}
+
+	// The index of the first element at or after 'from' that holds an error, or
+	// 'size()' if there is none.
+	size_type find_error(size_type from = 0) const noexcept {
+		return find(from, ~word_type(0));
+	}
+
+	// Calls 'f(i, value)' for every element 'i' that holds a value, in order.
+	template <class F>
+	void for_each_value(F&& f) {
+		visit(word_type(0), [&](size_type i) { f(i, slots_[i].value); });
+	}
+
+	template <class F>
+	void for_each_value(F&& f) const {
+		visit(word_type(0), [&](size_type i) { f(i, std::as_const(slots_[i].value)); });
+	}
+
+	// Calls 'f(i, error)' for every element 'i' that holds an error, in order.
+	template <class F>
+	void for_each_error(F&& f) {
+		visit(~word_type(0), [&](size_type i) { f(i, slots_[i].error); });
+	}
+
+	template <class F>
+	void for_each_error(F&& f) const {
+		visit(~word_type(0), [&](size_type i) { f(i, std::as_const(slots_[i].error)); });
+	}
+
+private:
+	static word_type mask(size_type i) noexcept {
+		return word_type(1) << (i % word_bits);
+	}
+
+	bool test(size_type i) const noexcept {
+		return (bits_[i / word_bits] & mask(i)) != 0u;
+	}
+
+	// The bits of word 'w' that are set in 'bits_ ^ flip' and belong to an
+	// element.
+	word_type word(size_type w, word_type flip) const noexcept {
+		word_type bits = bits_[w] ^ flip;
+		size_type end = (w + 1u) * word_bits;
+		if(end > size_) {
+			bits &= (word_type(1) << (size_ % word_bits)) - 1u;
+		}
+		return bits;
+	}
+
+	size_type find(size_type from, word_type flip) const noexcept {
+		if(from >= size_) {
+			return size_;
+		}
+		size_type w = from / word_bits;
+		word_type bits = word(w, flip) & (~word_type(0) << (from % word_bits));
+		size_type words = (size_ + word_bits - 1u) / word_bits;
+		for(;;) {
+			if(bits) {
+				return w * word_bits + static_cast<size_type>(detail::countr_zero64(bits));
+			}
+			if(++w == words) {
+				return size_;
+			}
+			bits = word(w, flip);
+		}
+	}
+
+	template <class F>
+	void visit(word_type flip, F&& f) const {
+		size_type words = (size_ + word_bits - 1u) / word_bits;
+		for(size_type w = 0; w < words; ++w) {
+			for(word_type bits = word(w, flip); bits; bits &= bits - 1u) {
+				f(w * word_bits + static_cast<size_type>(detail::countr_zero64(bits)));
+			}
+		}
+	}
+
+	void destroy(size_type i) noexcept {
+		if(test(i)) {
+			slots_[i].value.~T();
+		} else {
+			slots_[i].error.~E();
+		}
+	}
+
+	// Frees the storage it holds when it goes out of scope.
+	struct SlotsGuard {
+		~SlotsGuard() {
+			deallocate(slots, n);
+		}
+
+		slot_type* slots;
+		size_type n;
+	};
+
+	template <class ... Args>
+	static void construct(slot_type* slot, tim::in_place_t, Args&& ... args) {
+		::new(static_cast<void*>(std::addressof(slot->value))) T(std::forward<Args>(args)...);
+	}
+
+	template <class ... Args>
+	static void construct(slot_type* slot, tim::in_place_error_t, Args&& ... args) {
+		::new(static_cast<void*>(std::addressof(slot->error))) E(std::forward<Args>(args)...);
+	}
+
+	// Constructs element 'size()', growing the storage if it is full.  The new
+	// element is constructed in the new storage before the existing elements
+	// are moved over, since 'args' may refer to one of them.
+	template <class Tag, class ... Args>
+	void emplace_slot(Tag tag, Args&& ... args) {
+		if(size_ != capacity_) {
+			construct(slots_ + size_, tag, std::forward<Args>(args)...);
+			return;
+		}
+		size_type n = capacity_ ? 2u * capacity_ : word_bits;
+		bits_.resize((n + word_bits - 1u) / word_bits, word_type(0));
+		SlotsGuard guard{allocate(n), n};
+		construct(guard.slots + size_, tag, std::forward<Args>(args)...);
+		adopt(guard);
+	}
+
+	void reallocate(size_type n) {
+		bits_.resize((n + word_bits - 1u) / word_bits, word_type(0));
+		SlotsGuard guard{allocate(n), n};
+		adopt(guard);
+	}
+
+	// Moves the elements into the storage held by 'guard', which takes the old
+	// storage in exchange.
+	void adopt(SlotsGuard& guard) noexcept {
+		for(size_type i = 0; i < size_; ++i) {
+			if(test(i)) {
+				::new(static_cast<void*>(std::addressof(guard.slots[i].value))) T(std::move(slots_[i].value));
+				slots_[i].value.~T();
+			} else {
+				::new(static_cast<void*>(std::addressof(guard.slots[i].error))) E(std::move(slots_[i].error));
+				slots_[i].error.~E();
+			}
+		}
+		std::swap(slots_, guard.slots);
+		std::swap(capacity_, guard.n);
+	}
+
+	static slot_type* allocate(size_type n) {
+		return std::allocator<slot_type>().allocate(n);
+	}
+
+	static void deallocate(slot_type* slots, size_type n) noexcept {
+		if(slots) {
+			std::allocator<slot_type>().deallocate(slots, n);
+		}
+	}
+
+	slot_type* slots_ = nullptr;
+	std::vector<word_type> bits_;
+	size_type size_ = 0;
+	size_type capacity_ = 0;
+};
+
+} /* inline namespace result */
+
+} /* namespace tim */
+
+#endif /* TIM_RESULT_RESULT_VECTOR_HPP */
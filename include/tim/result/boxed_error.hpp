@@ -0,0 +1,318 @@
+#ifndef TIM_RESULT_BOXED_ERROR_HPP
+#define TIM_RESULT_BOXED_ERROR_HPP
+
+#include "tim/result/Result.hpp"
+
+#include <memory>
+
+// Errors stored out of line.
+//
+// 'boxed_error<E>' owns an 'E' allocated with 'Allocator' and is the size of a
+// pointer (when 'Allocator' is empty).  It is move-only: moving it moves the
+// pointer, so a 'Result<T, boxed_error<E>>' can be propagated without touching
+// the allocator, and only constructing an error allocates.  It provides a
+// niche (see 'traits::niche_traits'), so that e.g.
+//
+//   sizeof(tim::Result<int, tim::boxed_error<RichError>>) == sizeof(void*)
+//
+// however large 'RichError' is.  A 'boxed_error' converts implicitly from
+// 'E', so 'return tim::make_error(RichError{...});' works unchanged.
+//
+// 'auto_boxed_error_t<E>' is 'boxed_error<E>' for errors larger than two
+// pointers and 'E' otherwise.
+//
+// A moved-from 'boxed_error' owns nothing and converts to 'false'; it may only
+// be assigned to or destroyed.
+
+namespace tim {
+
+inline namespace result {
+
+namespace detail {
+
+// Holds an allocator, taking no space when it is empty.
+template <class A, bool = std::is_empty_v<A> && !std::is_final_v<A>>
+class AllocatorHolder: private A {
+protected:
+	AllocatorHolder() = default;
+
+	explicit AllocatorHolder(const A& alloc) noexcept:
+		A(alloc)
+	{
+
+	}
+
+	A& allocator() noexcept { return *this; }
+	const A& allocator() const noexcept { return *this; }
+};
+
+template <class A>
+class AllocatorHolder<A, false> {
+protected:
+	AllocatorHolder() = default;
+
+	explicit AllocatorHolder(const A& alloc) noexcept:
+		alloc_(alloc)
+	{
+
+	}
+
+	A& allocator() noexcept { return alloc_; }
+	const A& allocator() const noexcept { return alloc_; }
+
+private:
+	A alloc_;
+};
+
+} /* namespace detail */
+
+template <class E, class Allocator = std::allocator<E>>
+class boxed_error:
+	private detail::AllocatorHolder<typename std::allocator_traits<Allocator>::template rebind_alloc<E>>
+{
+	static_assert(std::is_object_v<E> && !std::is_array_v<E>, "'boxed_error<E>' requires a non-array object type 'E'.");
+	static_assert(!std::is_const_v<E> && !std::is_volatile_v<E>, "'boxed_error<E>' requires a cv-unqualified type 'E'.");
+
+public:
+	using element_type = E;
+	using allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<E>;
+
+private:
+	using holder_type = detail::AllocatorHolder<allocator_type>;
+	using alloc_traits = std::allocator_traits<allocator_type>;
+
+	static_assert(
+		std::is_same_v<typename alloc_traits::pointer, E*>,
+		"'boxed_error<E, Allocator>' requires an allocator whose pointers are 'E*'."
+	);
+
+public:
+	template <
+		class ... Args,
+		std::enable_if_t<
+			std::is_constructible_v<E, Args&&...>
+			&& std::is_default_constructible_v<allocator_type>,
+			bool
+		> = false
+	>
+	explicit boxed_error(tim::in_place_t, Args&& ... args):
+		holder_type(allocator_type()),
+		ptr_(make(this->allocator(), std::forward<Args>(args)...))
+	{
+
+	}
+
+	template <
+		class ... Args,
+		std::enable_if_t<std::is_constructible_v<E, Args&&...>, bool> = false
+	>
+	boxed_error(std::allocator_arg_t, const Allocator& alloc, Args&& ... args):
+		holder_type(allocator_type(alloc)),
+		ptr_(make(this->allocator(), std::forward<Args>(args)...))
+	{
+
+	}
+
+	template <
+		class Err = E,
+		std::enable_if_t<
+			std::is_same_v<Err, E>
+			&& std::is_copy_constructible_v<Err>
+			&& std::is_default_constructible_v<allocator_type>,
+			bool
+		> = false
+	>
+	boxed_error(const E& err):
+		boxed_error(tim::in_place, err)
+	{
+
+	}
+
+	template <
+		class Err = E,
+		std::enable_if_t<
+			std::is_same_v<Err, E>
+			&& std::is_move_constructible_v<Err>
+			&& std::is_default_constructible_v<allocator_type>,
+			bool
+		> = false
+	>
+	boxed_error(E&& err):
+		boxed_error(tim::in_place, std::move(err))
+	{
+
+	}
+
+	boxed_error(const boxed_error&) = delete;
+
+	boxed_error(boxed_error&& other) noexcept:
+		holder_type(std::move(other.allocator())),
+		ptr_(std::exchange(other.ptr_, nullptr))
+	{
+
+	}
+
+	boxed_error& operator=(const boxed_error&) = delete;
+
+	boxed_error& operator=(boxed_error&& other) noexcept(
+		alloc_traits::propagate_on_container_move_assignment::value
+		|| alloc_traits::is_always_equal::value
+	) {
+		if(this == std::addressof(other)) {
+			return *this;
+		}
+		if constexpr(alloc_traits::propagate_on_container_move_assignment::value) {
+			reset();
+			this->allocator() = std::move(other.allocator());
+			ptr_ = std::exchange(other.ptr_, nullptr);
+		} else if constexpr(alloc_traits::is_always_equal::value) {
+			reset();
+			ptr_ = std::exchange(other.ptr_, nullptr);
+		} else if(this->allocator() == other.allocator()) {
+			reset();
+			ptr_ = std::exchange(other.ptr_, nullptr);
+		} else {
+			// 'other' was allocated elsewhere: move its error into storage
+			// from this allocator.
+			E* ptr = other.ptr_ ? make(this->allocator(), std::move(*other.ptr_)) : nullptr;
+			reset();
+			ptr_ = ptr;
+		}
+		return *this;
+	}
+
+	~boxed_error() {
+		reset();
+	}
+
+	void swap(boxed_error& other) noexcept {
+		if constexpr(alloc_traits::propagate_on_container_swap::value) {
+			using std::swap;
+			swap(this->allocator(), other.allocator());
+		}
+		std::swap(ptr_, other.ptr_);
+	}
+
+	friend void swap(boxed_error& lhs, boxed_error& rhs) noexcept {
+		lhs.swap(rhs);
+	}
+
+	allocator_type get_allocator() const noexcept {
+		return this->allocator();
+	}
+
+	E* get() const noexcept {
+		return ptr_;
+	}
+
+	E& operator*() const noexcept {
+		return *ptr_;
+	}
+
+	E* operator->() const noexcept {
+		return ptr_;
+	}
+
+	explicit operator bool() const noexcept {
+		return ptr_ != nullptr;
+	}
+
+private:
+	template <class ... Args>
+	static E* make(allocator_type& alloc, Args&& ... args) {
+		E* ptr = alloc_traits::allocate(alloc, 1);
+#if TIM_RESULT_HAS_EXCEPTIONS
+		try {
+			alloc_traits::construct(alloc, ptr, std::forward<Args>(args)...);
+		} catch(...) {
+			alloc_traits::deallocate(alloc, ptr, 1);
+			throw;
+		}
+#else
+		alloc_traits::construct(alloc, ptr, std::forward<Args>(args)...);
+#endif
+		return ptr;
+	}
+
+	void reset() noexcept {
+		if(ptr_) {
+			alloc_traits::destroy(this->allocator(), ptr_);
+			alloc_traits::deallocate(this->allocator(), ptr_, 1);
+			ptr_ = nullptr;
+		}
+	}
+
+	E* ptr_;
+};
+
+// Boxed errors compare by the errors they hold.
+template <class E, class A, class F, class B>
+auto operator==(const boxed_error<E, A>& lhs, const boxed_error<F, B>& rhs) -> decltype(static_cast<bool>(*lhs == *rhs)) {
+	return static_cast<bool>(*lhs == *rhs);
+}
+
+template <class E, class A, class F, class B>
+auto operator!=(const boxed_error<E, A>& lhs, const boxed_error<F, B>& rhs) -> decltype(static_cast<bool>(*lhs != *rhs)) {
+	return static_cast<bool>(*lhs != *rhs);
+}
+
+template <class E, class A, class F>
+auto operator==(const boxed_error<E, A>& lhs, const F& rhs) -> decltype(static_cast<bool>(*lhs == rhs)) {
+	return static_cast<bool>(*lhs == rhs);
+}
+
+template <class E, class A, class F>
+auto operator==(const F& lhs, const boxed_error<E, A>& rhs) -> decltype(static_cast<bool>(lhs == *rhs)) {
+	return static_cast<bool>(lhs == *rhs);
+}
+
+template <class E, class A, class F>
+auto operator!=(const boxed_error<E, A>& lhs, const F& rhs) -> decltype(static_cast<bool>(*lhs != rhs)) {
+	return static_cast<bool>(*lhs != rhs);
+}
+
+template <class E, class A, class F>
+auto operator!=(const F& lhs, const boxed_error<E, A>& rhs) -> decltype(static_cast<bool>(lhs != *rhs)) {
+	return static_cast<bool>(lhs != *rhs);
+}
+
+template <class E, std::size_t MaxInlineSize = 2u * sizeof(void*)>
+using auto_boxed_error_t = std::conditional_t<(sizeof(E) > MaxInlineSize), boxed_error<E>, E>;
+
+namespace traits {
+
+// The owned pointer is the only member when the allocator is empty, and is
+// either null or points to an 'E' allocated with its alignment.
+template <class E, class A>
+struct niche_traits<
+	boxed_error<E, A>,
+	std::enable_if_t<
+		(alignof(E) >= 2u)
+		&& sizeof(boxed_error<E, A>) == sizeof(E*)
+	>
+>: pointer_low_bit_niche<boxed_error<E, A>> {};
+
+// Empty allocators hold no state that could refer to their own address.
+template <class E, class A>
+struct is_trivially_relocatable<boxed_error<E, A>>: std::bool_constant<
+	std::is_empty_v<typename boxed_error<E, A>::allocator_type>
+	|| is_trivially_relocatable_v<typename boxed_error<E, A>::allocator_type>
+> {};
+
+// Breadcrumbs go to the trail of the boxed error.
+template <class E, class A>
+struct error_context_traits<boxed_error<E, A>, std::enable_if_t<tim::result::detail::has_error_context_v<E>>> {
+	static void append(boxed_error<E, A>& error, const char* what, const source_location& where) noexcept {
+		if(error) {
+			error_context_traits<E>::append(*error, what, where);
+		}
+	}
+};
+
+} /* namespace traits */
+
+} /* inline namespace result */
+
+} /* namespace tim */
+
+#endif /* TIM_RESULT_BOXED_ERROR_HPP */
@@ -0,0 +1,262 @@
+#ifndef TIM_RESULT_COLLECT_HPP
+#define TIM_RESULT_COLLECT_HPP
+
+#include "tim/result/Result.hpp"
+
+#include <iterator>
+#include <vector>
+
+#if defined(__has_include)
+# if __has_include(<version>)
+#  include <version>
+# endif
+#endif
+
+#if defined(__cpp_lib_ranges) && __cpp_lib_ranges >= 201911L
+# include <ranges>
+# define TIM_RESULT_HAS_STD_RANGES 1
+#else
+# define TIM_RESULT_HAS_STD_RANGES 0
+#endif
+
+// Turning a range of 'Result's into a 'Result' of a container.
+//
+// 'collect(range)' returns the values of 'range' in a 'std::vector' (or in
+// 'Container' for 'collect<Container>(range)'), or the first error.  It stops
+// reading 'range' at that error.  'collect_into(range, out)' appends the
+// values to 'out' instead; on error, the values read before it stay in 'out'.
+// The container is reserved once up front when 'range' has a 'size()' and the
+// container has 'reserve()'.  Values and errors are moved out of 'range' when
+// it is an rvalue that owns its elements, and copied otherwise.  A range is
+// taken to own its elements when they are 'const' through a 'const' range (as
+// for the standard containers and arrays) and, where 'std::ranges' is
+// available, it is neither a view nor a borrowed range.  So an rvalue
+// 'std::span' or other view is copied from, like an lvalue; to move out of the
+// storage it refers to, pass a range of move iterators.
+//
+// Passing 'tim::all_errors' as the first argument reads the whole range and
+// collects every error into a 'std::vector<E>'.  'collect' then returns no
+// values if any element failed; 'collect_into' appends every value that
+// succeeded.
+//
+// A range of 'Result<cv void, E>' is collected into a 'Result<void, E>'.
+
+namespace tim {
+
+inline namespace result {
+
+struct all_errors_t {
+	explicit all_errors_t() = default;
+};
+
+inline constexpr all_errors_t all_errors{};
+
+namespace detail {
+
+template <class Range>
+using range_reference_t = decltype(*std::begin(std::declval<Range&>()));
+
+template <class Range>
+using range_result_t = std::remove_cv_t<std::remove_reference_t<range_reference_t<Range>>>;
+
+// Whether the elements of 'Range' are 'const' through a 'const' 'Range', as
+// they are in a container and not in a view over storage it does not own.
+template <class Range, class = void>
+struct has_deep_const_elements: std::false_type {};
+
+template <class Range>
+struct has_deep_const_elements<Range, std::void_t<range_reference_t<const Range>>>: std::is_const<std::remove_reference_t<range_reference_t<const Range>>> {};
+
+template <class Range>
+inline constexpr bool owns_elements_v =
+	has_deep_const_elements<Range>::value
+#if TIM_RESULT_HAS_STD_RANGES
+	&& !std::ranges::borrowed_range<Range>
+	&& !std::ranges::view<Range>
+#endif
+	;
+
+// How an element of 'Range' is read: as an rvalue if 'Range' is one that owns
+// its elements.
+template <class Range>
+using range_element_t = std::conditional_t<
+	std::is_lvalue_reference_v<Range> || !owns_elements_v<std::remove_cv_t<std::remove_reference_t<Range>>>,
+	range_reference_t<Range>,
+	std::remove_reference_t<range_reference_t<Range>>&&
+>;
+
+template <class Range, class = void>
+struct has_size: std::false_type {};
+
+template <class Range>
+struct has_size<Range, std::void_t<decltype(std::size(std::declval<Range&>()))>>: std::true_type {};
+
+template <class Container, class = void>
+struct has_reserve: std::false_type {};
+
+template <class Container>
+struct has_reserve<Container, std::void_t<decltype(std::declval<Container&>().reserve(std::size_t()))>>: std::true_type {};
+
+template <class Container, class V, class = void>
+struct has_push_back: std::false_type {};
+
+template <class Container, class V>
+struct has_push_back<Container, V, std::void_t<decltype(std::declval<Container&>().push_back(std::declval<V>()))>>: std::true_type {};
+
+template <class Container, class Range>
+void reserve_for(Container& out, Range& range) {
+	if constexpr(has_reserve<Container>::value && has_size<Range>::value) {
+		out.reserve(out.size() + static_cast<std::size_t>(std::size(range)));
+	}
+}
+
+template <class Container, class V>
+void append(Container& out, V&& v) {
+	if constexpr(has_push_back<Container, V&&>::value) {
+		out.push_back(std::forward<V>(v));
+	} else {
+		out.insert(out.end(), std::forward<V>(v));
+	}
+}
+
+template <class Container, class Range>
+using collect_container_t = std::conditional_t<
+	std::is_void_v<Container>,
+	std::vector<std::remove_cv_t<result_value_t<range_result_t<Range>>>>,
+	Container
+>;
+
+template <class Container, class Range>
+using collect_value_t = std::conditional_t<
+	is_cv_void_v<result_value_t<range_result_t<Range>>>,
+	void,
+	collect_container_t<Container, Range>
+>;
+
+} /* namespace detail */
+
+template <
+	class Range,
+	class Container,
+	std::enable_if_t<
+		traits::is_result_v<detail::range_result_t<Range>>,
+		bool
+	> = false
+>
+Result<void, detail::result_error_t<detail::range_result_t<Range>>> collect_into(Range&& range, Container& out) {
+	using result_type = Result<void, detail::result_error_t<detail::range_result_t<Range>>>;
+	using element_type = detail::range_element_t<Range>;
+	detail::reserve_for(out, range);
+	for(auto&& r: range) {
+		if(!r.has_value()) {
+			return result_type(tim::in_place_error, static_cast<element_type>(r).error());
+		}
+		detail::append(out, *static_cast<element_type>(r));
+	}
+	return result_type();
+}
+
+template <
+	class Range,
+	class Container,
+	std::enable_if_t<
+		traits::is_result_v<detail::range_result_t<Range>>,
+		bool
+	> = false
+>
+Result<void, std::vector<detail::result_error_t<detail::range_result_t<Range>>>> collect_into(all_errors_t, Range&& range, Container& out) {
+	using errors_type = std::vector<detail::result_error_t<detail::range_result_t<Range>>>;
+	using element_type = detail::range_element_t<Range>;
+	detail::reserve_for(out, range);
+	errors_type errors;
+	for(auto&& r: range) {
+		if(r.has_value()) {
+			detail::append(out, *static_cast<element_type>(r));
+		} else {
+			errors.push_back(static_cast<element_type>(r).error());
+		}
+	}
+	if(!errors.empty()) {
+		return Result<void, errors_type>(tim::in_place_error, std::move(errors));
+	}
+	return Result<void, errors_type>();
+}
+
+template <
+	class Container = void,
+	class Range,
+	std::enable_if_t<
+		traits::is_result_v<detail::range_result_t<Range>>,
+		bool
+	> = false
+>
+Result<detail::collect_value_t<Container, Range>, detail::result_error_t<detail::range_result_t<Range>>> collect(Range&& range) {
+	using value_type = detail::collect_value_t<Container, Range>;
+	using result_type = Result<value_type, detail::result_error_t<detail::range_result_t<Range>>>;
+	using element_type = detail::range_element_t<Range>;
+	if constexpr(std::is_void_v<value_type>) {
+		for(auto&& r: range) {
+			if(!r.has_value()) {
+				return result_type(tim::in_place_error, static_cast<element_type>(r).error());
+			}
+		}
+		return result_type();
+	} else {
+		value_type out;
+		detail::reserve_for(out, range);
+		for(auto&& r: range) {
+			if(!r.has_value()) {
+				return result_type(tim::in_place_error, static_cast<element_type>(r).error());
+			}
+			detail::append(out, *static_cast<element_type>(r));
+		}
+		return result_type(tim::in_place, std::move(out));
+	}
+}
+
+template <
+	class Container = void,
+	class Range,
+	std::enable_if_t<
+		traits::is_result_v<detail::range_result_t<Range>>,
+		bool
+	> = false
+>
+Result<detail::collect_value_t<Container, Range>, std::vector<detail::result_error_t<detail::range_result_t<Range>>>> collect(all_errors_t, Range&& range) {
+	using value_type = detail::collect_value_t<Container, Range>;
+	using errors_type = std::vector<detail::result_error_t<detail::range_result_t<Range>>>;
+	using result_type = Result<value_type, errors_type>;
+	using element_type = detail::range_element_t<Range>;
+	errors_type errors;
+	if constexpr(std::is_void_v<value_type>) {
+		for(auto&& r: range) {
+			if(!r.has_value()) {
+				errors.push_back(static_cast<element_type>(r).error());
+			}
+		}
+		if(!errors.empty()) {
+			return result_type(tim::in_place_error, std::move(errors));
+		}
+		return result_type();
+	} else {
+		value_type out;
+		detail::reserve_for(out, range);
+		for(auto&& r: range) {
+			if(!r.has_value()) {
+				errors.push_back(static_cast<element_type>(r).error());
+			} else if(errors.empty()) {
+				detail::append(out, *static_cast<element_type>(r));
+			}
+		}
+		if(!errors.empty()) {
+			return result_type(tim::in_place_error, std::move(errors));
+		}
+		return result_type(tim::in_place, std::move(out));
+	}
+}
+
+} /* inline namespace result */
+
+} /* namespace tim */
+
+#endif /* TIM_RESULT_COLLECT_HPP */
@@ -0,0 +1,338 @@
+#ifndef TIM_RESULT_COROUTINE_HPP
+#define TIM_RESULT_COROUTINE_HPP
+
+#include "tim/result/Result.hpp"
+
+// Coroutine support for 'Result'.
+//
+// With this header included, a function returning 'Result<T, E>' may be a
+// coroutine.  'co_await r' on a 'Result<U, G>' yields the value of 'r', or
+// completes the coroutine with the error of 'r' (which must be convertible to
+// 'E').  'co_await tim::Error(e)' completes it with 'e'.  The coroutine finishes
+// with 'co_return v' ('co_return;' for 'Result<cv void, E>').  Only 'Result'
+// and 'Error' can be awaited.
+//
+// Such a coroutine never suspends: it runs to completion, or stops at the first
+// failed 'co_await', before the call returns.  Its frame therefore never
+// outlives the call and frames are created and destroyed in strict LIFO order,
+// so they are carved out of a per-thread stack arena instead of the heap
+// ('TIM_RESULT_COROUTINE_ARENA_SIZE' bytes, 64 KiB by default; frames that do
+// not fit fall back to 'operator new').
+//
+// Scope: this header provides the early-return style only.  Eliding the frame
+// allocation, and matching the cost of branching by hand, are not part of it:
+// every call allocates a frame from the arena and runs the coroutine
+// machinery, and compilers do not elide a frame that is destroyed from inside
+// the coroutine (GCC never does).  At -O2 with GCC 12, a two-level chain in
+// bench/coroutine.cpp costs about 15-20 ns per call, against about 2 ns for
+// the same chain written with explicit branches or 'TIM_TRY_ASSIGN'.  Use
+// 'TIM_TRY' / 'TIM_TRY_ASSIGN' on hot paths.
+//
+// The returned 'Result' is produced by converting the return object once the
+// coroutine has finished, which GCC, MSVC and Clang 16 and later do.  Earlier
+// Clang releases convert it before the body runs and are not supported.
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>) \
+	&& !(defined(__clang__) && !defined(__apple_build_version__) && __clang_major__ < 16) \
+	&& !(defined(__apple_build_version__) && __clang_major__ < 15)
+# define TIM_RESULT_HAS_COROUTINES 1
+#else
+# define TIM_RESULT_HAS_COROUTINES 0
+#endif
+
+#if TIM_RESULT_HAS_COROUTINES
+
+#include <coroutine>
+#include <exception>
+
+#ifndef TIM_RESULT_COROUTINE_ARENA_SIZE
+# define TIM_RESULT_COROUTINE_ARENA_SIZE (64 * 1024)
+#endif
+
+namespace tim {
+
+inline namespace result {
+
+namespace detail {
+
+// Per-thread bump allocator for coroutine frames.  Deallocation must happen in
+// the reverse order of allocation, which 'ResultPromise' guarantees.  It makes
+// the allocation cheaper than 'operator new', but does not remove it.
+class CoroutineFrameArena {
+public:
+	static constexpr std::size_t capacity = TIM_RESULT_COROUTINE_ARENA_SIZE;
+	static constexpr std::size_t alignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+	static void* allocate(std::size_t size) {
+		auto& arena = local();
+		size = round_up(size);
+		if(!arena.base_) {
+			arena.base_ = static_cast<unsigned char*>(::operator new(capacity));
+		}
+		if(capacity - arena.top_ < size) {
+			return ::operator new(size);
+		}
+		void* p = arena.base_ + arena.top_;
+		arena.top_ += size;
+		return p;
+	}
+
+	static void deallocate(void* p, std::size_t size) noexcept {
+		auto& arena = local();
+		auto* byte = static_cast<unsigned char*>(p);
+		if(arena.base_ <= byte && byte < arena.base_ + capacity) {
+			arena.top_ = static_cast<std::size_t>(byte - arena.base_);
+		} else {
+			::operator delete(p, round_up(size));
+		}
+	}
+
+	// Bytes currently allocated from this thread's arena.
+	static std::size_t in_use() noexcept {
+		return local().top_;
+	}
+
+	CoroutineFrameArena(const CoroutineFrameArena&) = delete;
+	CoroutineFrameArena& operator=(const CoroutineFrameArena&) = delete;
+
+	~CoroutineFrameArena() {
+		::operator delete(base_);
+	}
+
+private:
+	CoroutineFrameArena() = default;
+
+	static constexpr std::size_t round_up(std::size_t size) noexcept {
+		return (size + alignment - 1) & ~(alignment - 1);
+	}
+
+	static CoroutineFrameArena& local() noexcept {
+		thread_local CoroutineFrameArena arena;
+		return arena;
+	}
+
+	unsigned char* base_ = nullptr;
+	std::size_t top_ = 0;
+};
+
+template <class T, class E>
+class ResultPromise;
+
+// The object returned to the caller of a 'Result' coroutine.  The promise
+// constructs the coroutine's 'Result' directly inside it; the compiler then
+// converts it to the 'Result' once the coroutine has finished.
+template <class T, class E>
+class ResultReturnObject {
+public:
+	explicit ResultReturnObject(ResultPromise<T, E>& promise) noexcept {
+		promise.return_object_ = this;
+	}
+
+	ResultReturnObject(const ResultReturnObject&) = delete;
+	ResultReturnObject& operator=(const ResultReturnObject&) = delete;
+
+	~ResultReturnObject() {
+		if(has_result_) {
+			result_.~Result();
+		}
+	}
+
+	operator Result<T, E>() && {
+#if defined(__cpp_exceptions)
+		if(exception_) {
+			std::rethrow_exception(exception_);
+		}
+#endif
+		if(!has_result_) {
+			// The coroutine did not run before the conversion.
+			std::terminate();
+		}
+		return std::move(result_);
+	}
+
+private:
+	friend class ResultPromise<T, E>;
+
+	template <class ... Args>
+	void emplace(Args&& ... args) {
+		::new(static_cast<void*>(std::addressof(result_))) Result<T, E>(std::forward<Args>(args)...);
+		has_result_ = true;
+	}
+
+	union {
+		Result<T, E> result_;
+	};
+	bool has_result_ = false;
+#if defined(__cpp_exceptions)
+	std::exception_ptr exception_;
+#endif
+};
+
+template <class R, class Promise>
+class ResultAwaiter {
+public:
+	explicit ResultAwaiter(R&& r) noexcept:
+		result_(std::forward<R>(r))
+	{
+
+	}
+
+	bool await_ready() const noexcept {
+		return result_.has_value();
+	}
+
+	void await_suspend(std::coroutine_handle<Promise> h) {
+		h.promise().return_error(detail::propagate_error(std::forward<R>(result_)));
+		// Nothing may touch '*this' after this point; it lives in the frame.
+		h.destroy();
+	}
+
+	decltype(auto) await_resume() {
+		return detail::try_value(std::forward<R>(result_));
+	}
+
+private:
+	R&& result_;
+};
+
+template <class G, class Promise>
+class ErrorAwaiter {
+public:
+	explicit ErrorAwaiter(G&& e) noexcept:
+		error_(std::forward<G>(e))
+	{
+
+	}
+
+	bool await_ready() const noexcept {
+		return false;
+	}
+
+	void await_suspend(std::coroutine_handle<Promise> h) {
+		h.promise().return_error(ErrorReference<decltype(std::forward<G>(error_).value())>{std::forward<G>(error_).value()});
+		h.destroy();
+	}
+
+	[[noreturn]] void await_resume() noexcept {
+		std::terminate();
+	}
+
+private:
+	G&& error_;
+};
+
+template <class Derived, class T, class E, bool = is_cv_void_v<T>>
+class ResultPromiseReturn {
+public:
+	template <
+		class U = T,
+		std::enable_if_t<
+			std::is_constructible_v<Result<T, E>, U&&>,
+			bool
+		> = false
+	>
+	void return_value(U&& v) {
+		static_cast<Derived*>(this)->emplace_result(std::forward<U>(v));
+	}
+};
+
+template <class Derived, class T, class E>
+class ResultPromiseReturn<Derived, T, E, true> {
+public:
+	void return_void() {
+		static_cast<Derived*>(this)->emplace_result(tim::in_place);
+	}
+};
+
+template <class T, class E>
+class ResultPromise: public ResultPromiseReturn<ResultPromise<T, E>, T, E> {
+public:
+	ResultReturnObject<T, E> get_return_object() noexcept {
+		return ResultReturnObject<T, E>(*this);
+	}
+
+	std::suspend_never initial_suspend() const noexcept {
+		return {};
+	}
+
+	std::suspend_never final_suspend() const noexcept {
+		return {};
+	}
+
+	void unhandled_exception() noexcept {
+#if defined(__cpp_exceptions)
+		return_object_->exception_ = std::current_exception();
+#else
+		std::terminate();
+#endif
+	}
+
+	template <
+		class R,
+		std::enable_if_t<
+			traits::is_result_v<std::remove_cv_t<std::remove_reference_t<R>>>,
+			bool
+		> = false
+	>
+	ResultAwaiter<R, ResultPromise> await_transform(R&& r) noexcept {
+		return ResultAwaiter<R, ResultPromise>(std::forward<R>(r));
+	}
+
+	template <
+		class G,
+		std::enable_if_t<
+			traits::is_error_v<std::remove_cv_t<std::remove_reference_t<G>>>,
+			bool
+		> = false
+	>
+	ErrorAwaiter<G, ResultPromise> await_transform(G&& e) noexcept {
+		return ErrorAwaiter<G, ResultPromise>(std::forward<G>(e));
+	}
+
+	static void* operator new(std::size_t size) {
+		return CoroutineFrameArena::allocate(size);
+	}
+
+	static void operator delete(void* p, std::size_t size) noexcept {
+		CoroutineFrameArena::deallocate(p, size);
+	}
+
+private:
+	template <class, class, class, bool>
+	friend class ResultPromiseReturn;
+
+	template <class, class>
+	friend class ResultAwaiter;
+
+	template <class, class>
+	friend class ErrorAwaiter;
+
+	template <class ... Args>
+	void emplace_result(Args&& ... args) {
+		return_object_->emplace(std::forward<Args>(args)...);
+	}
+
+	template <class Ref>
+	void return_error(ErrorReference<Ref> e) {
+		emplace_result(std::move(e));
+	}
+
+	friend class ResultReturnObject<T, E>;
+
+	ResultReturnObject<T, E>* return_object_ = nullptr;
+};
+
+} /* namespace detail */
+
+} /* inline namespace result */
+
+} /* namespace tim */
+
+template <class T, class E, class ... Args>
+struct std::coroutine_traits<tim::Result<T, E>, Args...> {
+	using promise_type = tim::result::detail::ResultPromise<T, E>;
+};
+
+#endif /* TIM_RESULT_HAS_COROUTINES */
+
+#endif /* TIM_RESULT_COROUTINE_HPP */
@@ -0,0 +1,455 @@
+#ifndef TIM_RESULT_ERROR_ARENA_HPP
+#define TIM_RESULT_ERROR_ARENA_HPP
+
+#include "tim/result/Result.hpp"
+#include "tim/result/boxed_error.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <vector>
+
+// Pooled storage for errors that live out of line.
+//
+// 'error_arena' is a 'std::pmr::memory_resource' for 'boxed_error's, the
+// shared errors of 'BadResultAccess<void, true>' and the like.  When error
+// rates spike, every failing call allocates its error, so allocating one
+// should not contend with other threads or fall through to the global heap:
+//
+//  - Requests of up to 'error_arena::largest_pooled_size' bytes are served
+//    from size-class free lists kept per thread, which take memory from
+//    upstream a slab at a time.  Allocating and freeing on one thread touches
+//    no shared state.
+//  - A chunk freed on another thread is pushed onto a lock-free list of its
+//    owning thread, which takes the whole list back when its own free list
+//    runs dry.
+//  - The free lists of a thread that exits are adopted by the next thread to
+//    use the arena.
+//  - With 'error_arena_options::max_bytes' set, the arena never holds more
+//    than that many bytes from upstream.  Past it, 'allocate()' throws
+//    'std::bad_alloc' and 'try_allocate()' returns null, so that an error
+//    storm sheds errors rather than exhausting memory.  Freed chunks are
+//    reused, not returned upstream, until the arena is destroyed.
+//
+// Larger or over-aligned requests go straight to upstream (and count against
+// 'max_bytes').  Like the standard pool resources, destroying the arena
+// releases all of its memory, so it must outlive everything allocated from
+// it.
+//
+// 'error_arena_allocator<T>' allocates from 'default_error_arena()' and is
+// empty, so 'pooled_error<E>' ('boxed_error<E, error_arena_allocator<E>>')
+// is still the size of a pointer.  A 'boxed_error<E,
+// std::pmr::polymorphic_allocator<E>>' can draw from any other arena.
+
+namespace tim {
+
+inline namespace result {
+
+struct error_arena_options {
+	// The most bytes the arena may take from upstream; 0 means no limit.
+	std::size_t max_bytes = 0u;
+	// The bytes a thread takes from upstream when one of its free lists is
+	// empty.  At least one chunk is taken.
+	std::size_t slab_size = 16u * 1024u;
+};
+
+namespace detail {
+
+struct ArenaCache;
+
+struct alignas(std::max_align_t) ArenaChunk {
+	ArenaCache* owner;
+	ArenaChunk* next;
+};
+
+struct alignas(std::max_align_t) ArenaSlab {
+	ArenaSlab* next;
+	std::size_t size;
+};
+
+inline constexpr std::size_t arena_size_classes = 7u;
+
+// Chunk sizes (including the 'ArenaChunk' header) are 32 << class.
+inline constexpr std::size_t arena_chunk_size(std::size_t size_class) noexcept {
+	return std::size_t(32u) << size_class;
+}
+
+// A thread's free lists in one arena.
+struct ArenaCache {
+	ArenaChunk* local[arena_size_classes] = {};
+	std::atomic<ArenaChunk*> remote[arena_size_classes] = {};
+	std::atomic<bool> orphaned{false};
+	ArenaCache* next = nullptr;
+};
+
+template <class T>
+void arena_push(std::atomic<T*>& head, T* node) noexcept {
+	T* old = head.load(std::memory_order_relaxed);
+	do {
+		node->next = old;
+	} while(!head.compare_exchange_weak(old, node, std::memory_order_release, std::memory_order_relaxed));
+}
+
+struct ArenaState {
+	ArenaState(std::pmr::memory_resource* up, const error_arena_options& opts):
+		upstream(up),
+		max_bytes(opts.max_bytes),
+		slab_size(opts.slab_size)
+	{
+
+	}
+
+	ArenaState(const ArenaState&) = delete;
+	ArenaState& operator=(const ArenaState&) = delete;
+
+	~ArenaState() {
+		for(ArenaSlab* slab = slabs.load(std::memory_order_acquire); slab;) {
+			ArenaSlab* next = slab->next;
+			upstream->deallocate(slab, slab->size, alignof(ArenaSlab));
+			slab = next;
+		}
+		for(ArenaCache* cache = caches.load(std::memory_order_acquire); cache;) {
+			ArenaCache* next = cache->next;
+			cache->~ArenaCache();
+			upstream->deallocate(cache, sizeof(ArenaCache), alignof(ArenaCache));
+			cache = next;
+		}
+	}
+
+	// Counts 'n' more bytes against 'max_bytes', or returns false if that
+	// would exceed it.
+	bool reserve(std::size_t n) noexcept {
+		std::size_t old = reserved.load(std::memory_order_relaxed);
+		do {
+			if(max_bytes != 0u && (n > max_bytes || old > max_bytes - n)) {
+				return false;
+			}
+		} while(!reserved.compare_exchange_weak(old, old + n, std::memory_order_relaxed));
+		return true;
+	}
+
+	void unreserve(std::size_t n) noexcept {
+		reserved.fetch_sub(n, std::memory_order_relaxed);
+	}
+
+	std::pmr::memory_resource* const upstream;
+	const std::size_t max_bytes;
+	const std::size_t slab_size;
+	const std::uint64_t id = next_id();
+	std::atomic<std::size_t> reserved{0u};
+	std::atomic<ArenaSlab*> slabs{nullptr};
+	std::atomic<ArenaCache*> caches{nullptr};
+
+private:
+	static std::uint64_t next_id() noexcept {
+		static std::atomic<std::uint64_t> ids{0u};
+		return ids.fetch_add(1u, std::memory_order_relaxed) + 1u;
+	}
+};
+
+// The caches of the current thread, by arena.  Arenas are told when the
+// thread exits, so that another thread can adopt its free lists.
+class ArenaThreadCaches {
+public:
+	ArenaThreadCaches() = default;
+	ArenaThreadCaches(const ArenaThreadCaches&) = delete;
+	ArenaThreadCaches& operator=(const ArenaThreadCaches&) = delete;
+
+	~ArenaThreadCaches() {
+		for(auto& entry: entries_) {
+			if(auto state = entry.state.lock()) {
+				entry.cache->orphaned.store(true, std::memory_order_release);
+			}
+		}
+	}
+
+	ArenaCache* find(std::uint64_t id) const noexcept {
+		for(const auto& entry: entries_) {
+			if(entry.id == id) {
+				return entry.cache;
+			}
+		}
+		return nullptr;
+	}
+
+	void add(const std::shared_ptr<ArenaState>& state, ArenaCache* cache) {
+		entries_.erase(
+			std::remove_if(entries_.begin(), entries_.end(), [](const Entry& entry) { return entry.state.expired(); }),
+			entries_.end()
+		);
+		entries_.push_back(Entry{state->id, cache, state});
+	}
+
+private:
+	struct Entry {
+		std::uint64_t id;
+		ArenaCache* cache;
+		std::weak_ptr<ArenaState> state;
+	};
+
+	std::vector<Entry> entries_;
+};
+
+inline ArenaThreadCaches& arena_thread_caches() {
+	thread_local ArenaThreadCaches caches;
+	return caches;
+}
+
+} /* namespace detail */
+
+class error_arena: public std::pmr::memory_resource {
+public:
+	static constexpr std::size_t largest_pooled_size =
+		detail::arena_chunk_size(detail::arena_size_classes - 1u) - sizeof(detail::ArenaChunk);
+
+	error_arena():
+		error_arena(std::pmr::get_default_resource(), error_arena_options())
+	{
+
+	}
+
+	explicit error_arena(const error_arena_options& options):
+		error_arena(std::pmr::get_default_resource(), options)
+	{
+
+	}
+
+	explicit error_arena(std::pmr::memory_resource* upstream, const error_arena_options& options = error_arena_options()):
+		state_(std::make_shared<detail::ArenaState>(upstream, options))
+	{
+
+	}
+
+	error_arena(const error_arena&) = delete;
+	error_arena& operator=(const error_arena&) = delete;
+
+	~error_arena() override = default;
+
+	// Like 'allocate()', but returns null instead of throwing when 'max_bytes'
+	// is reached or upstream fails.
+	void* try_allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) noexcept {
+#if TIM_RESULT_HAS_EXCEPTIONS
+		try {
+			return allocate_or_null(bytes, alignment);
+		} catch(...) {
+			return nullptr;
+		}
+#else
+		return allocate_or_null(bytes, alignment);
+#endif
+	}
+
+	// The bytes currently taken from upstream.
+	std::size_t bytes_reserved() const noexcept {
+		return state_->reserved.load(std::memory_order_relaxed);
+	}
+
+	std::size_t max_bytes() const noexcept {
+		return state_->max_bytes;
+	}
+
+	std::pmr::memory_resource* upstream_resource() const noexcept {
+		return state_->upstream;
+	}
+
+protected:
+	void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+		void* p = allocate_or_null(bytes, alignment);
+		if(!p) {
+#if TIM_RESULT_HAS_EXCEPTIONS
+			throw std::bad_alloc();
+#else
+			std::abort();
+#endif
+		}
+		return p;
+	}
+
+	void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+		std::size_t size_class = size_class_of(bytes, alignment);
+		if(size_class == detail::arena_size_classes) {
+			state_->upstream->deallocate(p, bytes, alignment);
+			state_->unreserve(bytes);
+			return;
+		}
+		auto* chunk = static_cast<detail::ArenaChunk*>(p) - 1;
+		detail::ArenaCache* owner = chunk->owner;
+		if(owner == detail::arena_thread_caches().find(state_->id)) {
+			chunk->next = owner->local[size_class];
+			owner->local[size_class] = chunk;
+		} else {
+			detail::arena_push(owner->remote[size_class], chunk);
+		}
+	}
+
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+		return this == &other;
+	}
+
+private:
+	// 'arena_size_classes' if the request is not pooled.
+	static std::size_t size_class_of(std::size_t bytes, std::size_t alignment) noexcept {
+		if(alignment > alignof(detail::ArenaChunk) || bytes > largest_pooled_size) {
+			return detail::arena_size_classes;
+		}
+		std::size_t size_class = 0u;
+		while(detail::arena_chunk_size(size_class) - sizeof(detail::ArenaChunk) < bytes) {
+			++size_class;
+		}
+		return size_class;
+	}
+
+	// Null if 'max_bytes' would be exceeded.
+	void* allocate_or_null(std::size_t bytes, std::size_t alignment) {
+		std::size_t size_class = size_class_of(bytes, alignment);
+		if(size_class == detail::arena_size_classes) {
+			if(!state_->reserve(bytes)) {
+				return nullptr;
+			}
+#if TIM_RESULT_HAS_EXCEPTIONS
+			try {
+				return state_->upstream->allocate(bytes, alignment);
+			} catch(...) {
+				state_->unreserve(bytes);
+				throw;
+			}
+#else
+			return state_->upstream->allocate(bytes, alignment);
+#endif
+		}
+		detail::ArenaCache* cache = thread_cache();
+		detail::ArenaChunk* chunk = cache->local[size_class];
+		if(!chunk) {
+			chunk = cache->remote[size_class].exchange(nullptr, std::memory_order_acquire);
+			if(!chunk) {
+				chunk = refill(cache, size_class);
+				if(!chunk) {
+					return nullptr;
+				}
+			}
+		}
+		cache->local[size_class] = chunk->next;
+		return chunk + 1;
+	}
+
+	// Carves a new slab into chunks of 'size_class' for 'cache'.
+	detail::ArenaChunk* refill(detail::ArenaCache* cache, std::size_t size_class) {
+		std::size_t chunk_size = detail::arena_chunk_size(size_class);
+		std::size_t count = state_->slab_size / chunk_size;
+		if(count == 0u) {
+			count = 1u;
+		}
+		std::size_t size = sizeof(detail::ArenaSlab) + count * chunk_size;
+		if(!state_->reserve(size)) {
+			return nullptr;
+		}
+		void* memory;
+#if TIM_RESULT_HAS_EXCEPTIONS
+		try {
+			memory = state_->upstream->allocate(size, alignof(detail::ArenaSlab));
+		} catch(...) {
+			state_->unreserve(size);
+			throw;
+		}
+#else
+		memory = state_->upstream->allocate(size, alignof(detail::ArenaSlab));
+#endif
+		auto* slab = ::new(memory) detail::ArenaSlab{nullptr, size};
+		detail::arena_push(state_->slabs, slab);
+		auto* bytes = reinterpret_cast<unsigned char*>(slab + 1);
+		detail::ArenaChunk* head = nullptr;
+		for(std::size_t i = count; i-- > 0u;) {
+			head = ::new(bytes + i * chunk_size) detail::ArenaChunk{cache, head};
+		}
+		return head;
+	}
+
+	// This thread's cache, adopting one left by an exited thread or making a
+	// new one the first time this thread uses the arena.
+	detail::ArenaCache* thread_cache() {
+		auto& caches = detail::arena_thread_caches();
+		if(detail::ArenaCache* cache = caches.find(state_->id)) {
+			return cache;
+		}
+		detail::ArenaCache* cache = nullptr;
+		for(auto* c = state_->caches.load(std::memory_order_acquire); c; c = c->next) {
+			bool orphaned = true;
+			if(c->orphaned.load(std::memory_order_relaxed)
+				&& c->orphaned.compare_exchange_strong(orphaned, false, std::memory_order_acquire))
+			{
+				cache = c;
+				break;
+			}
+		}
+		if(!cache) {
+			cache = ::new(state_->upstream->allocate(sizeof(detail::ArenaCache), alignof(detail::ArenaCache))) detail::ArenaCache();
+			detail::arena_push(state_->caches, cache);
+		}
+#if TIM_RESULT_HAS_EXCEPTIONS
+		try {
+			caches.add(state_, cache);
+		} catch(...) {
+			cache->orphaned.store(true, std::memory_order_release);
+			throw;
+		}
+#else
+		caches.add(state_, cache);
+#endif
+		return cache;
+	}
+
+	std::shared_ptr<detail::ArenaState> state_;
+};
+
+// The arena used by 'error_arena_allocator'.  It is never destroyed, so errors
+// allocated from it may outlive 'main()'.
+inline error_arena& default_error_arena() {
+	static error_arena* arena = new error_arena(std::pmr::new_delete_resource());
+	return *arena;
+}
+
+template <class T>
+class error_arena_allocator {
+public:
+	using value_type = T;
+	using is_always_equal = std::true_type;
+
+	error_arena_allocator() = default;
+
+	template <class U>
+	error_arena_allocator(const error_arena_allocator<U>&) noexcept {
+
+	}
+
+	T* allocate(std::size_t n) {
+		return static_cast<T*>(default_error_arena().allocate(n * sizeof(T), alignof(T)));
+	}
+
+	void deallocate(T* p, std::size_t n) noexcept {
+		default_error_arena().deallocate(p, n * sizeof(T), alignof(T));
+	}
+
+	template <class U>
+	friend bool operator==(const error_arena_allocator&, const error_arena_allocator<U>&) noexcept {
+		return true;
+	}
+
+	template <class U>
+	friend bool operator!=(const error_arena_allocator&, const error_arena_allocator<U>&) noexcept {
+		return false;
+	}
+};
+
+template <class E>
+using pooled_error = boxed_error<E, error_arena_allocator<E>>;
+
+} /* inline namespace result */
+
+} /* namespace tim */
+
+#endif /* TIM_RESULT_ERROR_ARENA_HPP */
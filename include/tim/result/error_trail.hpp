@@ -0,0 +1,341 @@
+#ifndef TIM_RESULT_ERROR_TRAIL_HPP
+#define TIM_RESULT_ERROR_TRAIL_HPP
+
+#include "tim/result/Result.hpp"
+
+#include <cstddef>
+#include <iterator>
+#include <mutex>
+#include <new>
+#include <utility>
+
+// Breadcrumbs for propagated errors.
+//
+// An error that carries an 'error_trail' can be annotated on its way up the
+// stack without wrapping it in a new type at each layer:
+//
+//   struct LoadError {
+//       int code;
+//       tim::error_trail trail;
+//   };
+//
+//   tim::Result<Shard, LoadError> load_shard(int id) {
+//       return read_file(path_of(id)).context("loading shard");
+//   }
+//
+// 'context()' appends the string and the location of the call to the trail
+// of the error, and does nothing (beyond testing 'has_value()') when there is
+// no error.  An 'error_trail' is the size of a pointer and iterates over its
+// 'breadcrumb's oldest first.
+//
+// Breadcrumbs are allocated from per-thread free lists, which take nodes from
+// the heap a slab at a time.  A trail is a circular list of its nodes, so
+// destroying it (or calling 'clear()') gives all of them back at once by
+// splicing the list onto the free list of the current thread, whichever
+// thread appended them.  The free list of a thread that exits is kept for
+// other threads, and slabs are never returned to the heap, so the memory held
+// is that of the most breadcrumbs alive at any one time.  If a node cannot be
+// allocated the breadcrumb is dropped: 'context()' never throws.
+//
+// The trait 'traits::error_context_traits' finds the trail in 'error_trail'
+// itself and in any error with an 'error_trail' data member named 'trail';
+// specialize it for errors that keep theirs elsewhere.
+
+namespace tim {
+
+inline namespace result {
+
+struct breadcrumb {
+	const char* what;
+	source_location where;
+};
+
+namespace detail {
+
+struct TrailNode {
+	breadcrumb crumb;
+	TrailNode* next;
+};
+
+// The free nodes left behind by threads that have exited.
+struct TrailDepot {
+	std::mutex mutex;
+	TrailNode* free = nullptr;
+
+	static TrailDepot& get() noexcept {
+		// Never destroyed: threads may exit during static destruction.
+		static TrailDepot* depot = new TrailDepot();
+		return *depot;
+	}
+};
+
+// Per-thread free list of trail nodes.
+class TrailPool {
+public:
+	static constexpr std::size_t slab_nodes = 64u;
+
+	static TrailNode* acquire() noexcept {
+		TrailNode*& free = free_list();
+		if(!free) {
+			free = refill();
+			if(!free) {
+				return nullptr;
+			}
+		}
+		return std::exchange(free, free->next);
+	}
+
+	// Gives back the nodes 'first' through 'last', linked by 'next'.
+	static void release(TrailNode* first, TrailNode* last) noexcept {
+		if(exited()) {
+			// Thread-local destructors are running; 'free_list()' is no
+			// longer drained into the depot.
+			auto& depot = TrailDepot::get();
+			std::lock_guard<std::mutex> lock(depot.mutex);
+			last->next = depot.free;
+			depot.free = first;
+			return;
+		}
+		TrailNode*& free = free_list();
+		last->next = free;
+		free = first;
+	}
+
+	TrailPool(const TrailPool&) = delete;
+	TrailPool& operator=(const TrailPool&) = delete;
+
+	~TrailPool() {
+		exited() = true;
+		TrailNode* first = std::exchange(free_list(), nullptr);
+		if(!first) {
+			return;
+		}
+		TrailNode* last = first;
+		while(last->next) {
+			last = last->next;
+		}
+		auto& depot = TrailDepot::get();
+		std::lock_guard<std::mutex> lock(depot.mutex);
+		last->next = depot.free;
+		depot.free = first;
+	}
+
+private:
+	TrailPool() = default;
+
+	static TrailNode*& free_list() noexcept {
+		thread_local TrailNode* free = nullptr;
+		return free;
+	}
+
+	static bool& exited() noexcept {
+		thread_local bool exited = false;
+		return exited;
+	}
+
+	static TrailNode* refill() noexcept {
+		if(exited()) {
+			return nullptr;
+		}
+		// Hands this thread's free list to the depot when the thread exits.
+		thread_local TrailPool pool;
+		(void)pool;
+		{
+			auto& depot = TrailDepot::get();
+			std::lock_guard<std::mutex> lock(depot.mutex);
+			if(depot.free) {
+				return std::exchange(depot.free, nullptr);
+			}
+		}
+		auto* slab = static_cast<TrailNode*>(::operator new(slab_nodes * sizeof(TrailNode), std::nothrow));
+		if(!slab) {
+			return nullptr;
+		}
+		for(std::size_t i = 0u; i + 1u < slab_nodes; ++i) {
+			slab[i].next = slab + i + 1u;
+		}
+		slab[slab_nodes - 1u].next = nullptr;
+		return slab;
+	}
+};
+
+} /* namespace detail */
+
+class error_trail {
+public:
+	class iterator {
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = breadcrumb;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const breadcrumb*;
+		using reference = const breadcrumb&;
+
+		iterator() = default;
+
+		reference operator*() const noexcept {
+			return node_->crumb;
+		}
+
+		pointer operator->() const noexcept {
+			return &node_->crumb;
+		}
+
+		iterator& operator++() noexcept {
+			node_ = node_ == last_ ? nullptr : node_->next;
+			return *this;
+		}
+
+		iterator operator++(int) noexcept {
+			iterator tmp(*this);
+			++*this;
+			return tmp;
+		}
+
+		friend bool operator==(const iterator& lhs, const iterator& rhs) noexcept {
+			return lhs.node_ == rhs.node_;
+		}
+
+		friend bool operator!=(const iterator& lhs, const iterator& rhs) noexcept {
+			return lhs.node_ != rhs.node_;
+		}
+
+	private:
+		friend class error_trail;
+
+		iterator(const detail::TrailNode* node, const detail::TrailNode* last) noexcept:
+			node_(node), last_(last)
+		{
+
+		}
+
+		const detail::TrailNode* node_ = nullptr;
+		const detail::TrailNode* last_ = nullptr;
+	};
+
+	using const_iterator = iterator;
+
+	error_trail() = default;
+
+	// Copies the breadcrumbs, as far as nodes can be allocated.
+	error_trail(const error_trail& other) noexcept {
+		for(const breadcrumb& crumb: other) {
+			append(crumb.what, crumb.where);
+		}
+	}
+
+	error_trail(error_trail&& other) noexcept:
+		last_(std::exchange(other.last_, nullptr))
+	{
+
+	}
+
+	error_trail& operator=(const error_trail& other) noexcept {
+		if(this != &other) {
+			error_trail tmp(other);
+			swap(tmp);
+		}
+		return *this;
+	}
+
+	error_trail& operator=(error_trail&& other) noexcept {
+		if(this != &other) {
+			clear();
+			last_ = std::exchange(other.last_, nullptr);
+		}
+		return *this;
+	}
+
+	~error_trail() {
+		clear();
+	}
+
+	// Appends a breadcrumb; 'what' must outlive the trail.  Dropped if no
+	// node can be allocated.
+	void append(const char* what, const source_location& where = source_location::current()) noexcept {
+		detail::TrailNode* node = detail::TrailPool::acquire();
+		if(!node) {
+			return;
+		}
+		node->crumb = breadcrumb{what, where};
+		if(last_) {
+			node->next = last_->next;
+			last_->next = node;
+		} else {
+			node->next = node;
+		}
+		last_ = node;
+	}
+
+	// Frees all breadcrumbs at once.
+	void clear() noexcept {
+		if(last_) {
+			detail::TrailPool::release(last_->next, last_);
+			last_ = nullptr;
+		}
+	}
+
+	bool empty() const noexcept {
+		return !last_;
+	}
+
+	std::size_t size() const noexcept {
+		return static_cast<std::size_t>(std::distance(begin(), end()));
+	}
+
+	iterator begin() const noexcept {
+		return last_ ? iterator(last_->next, last_) : iterator();
+	}
+
+	iterator end() const noexcept {
+		return iterator();
+	}
+
+	// The most recent breadcrumb.  The trail must not be empty.
+	const breadcrumb& back() const noexcept {
+		return last_->crumb;
+	}
+
+	void swap(error_trail& other) noexcept {
+		std::swap(last_, other.last_);
+	}
+
+	friend void swap(error_trail& lhs, error_trail& rhs) noexcept {
+		lhs.swap(rhs);
+	}
+
+private:
+	// The newest node, whose 'next' is the oldest.
+	detail::TrailNode* last_ = nullptr;
+};
+
+namespace traits {
+
+template <>
+struct error_context_traits<error_trail> {
+	static void append(error_trail& trail, const char* what, const source_location& where) noexcept {
+		trail.append(what, where);
+	}
+};
+
+template <class E>
+struct error_context_traits<
+	E,
+	std::enable_if_t<std::is_same_v<decltype(std::declval<E&>().trail), error_trail>>
+> {
+	static void append(E& error, const char* what, const source_location& where) noexcept {
+		error.trail.append(what, where);
+	}
+};
+
+// The trail is a single owning pointer.
+template <>
+struct is_trivially_relocatable<error_trail>: std::true_type {};
+
+} /* namespace traits */
+
+} /* inline namespace result */
+
+} /* namespace tim */
+
+#endif /* TIM_RESULT_ERROR_TRAIL_HPP */
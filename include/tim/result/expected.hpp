@@ -3,9 +3,30 @@
 
 #include "tim/result/Result.hpp"
 
+// 'std::expected'-style names for 'Result' and friends, so that code can be
+// written against one vocabulary while it moves between 'tim::Result' and
+// 'std::expected'.  When the standard library has 'std::expected', 'to_std()'
+// and 'from_std()' convert between the two.  Each conversion constructs the
+// active alternative of the new object once, directly from the one in the old
+// object (moved from an rvalue); for trivially copyable and trivially
+// relocatable alternatives that compiles down to copying its bytes.
+#if defined(__has_include)
+# if __has_include(<version>)
+#  include <version>
+# endif
+#endif
+
+#if defined(__cpp_lib_expected) && __cpp_lib_expected >= 202202L
+# include <expected>
+# define TIM_RESULT_HAS_STD_EXPECTED 1
+#else
+# define TIM_RESULT_HAS_STD_EXPECTED 0
+#endif
+
 namespace tim {
 
-inline namespace expected {
+// Not named 'expected', which would make 'tim::expected' ambiguous.
+inline namespace expected_compat {
 
 template <class T, class E>
 using expected = tim::result::Result<T, E>;
@@ -15,10 +36,10 @@ using unexpected = tim::result::Error<E>;
 
 template <
 	class E,
-	std::enable_if<
+	std::enable_if_t<
 		std::is_constructible_v<
 			unexpected<std::decay_t<E>>,
-			Err&&
+			E&&
 		>,
 		bool
 	> = false
@@ -28,24 +49,73 @@ constexpr unexpected<std::decay_t<E>> make_unexpected(E&& err) {
 }
 
 template <class E>
-using bad_expected_access = tim::result::BadExpectedAccess<E>;
+using bad_expected_access = tim::result::BadResultAccess<E, true>;
 
-template <class E>
-using unexpect_t = tim::result::in_place_error;
+using unexpect_t = tim::in_place_error_t;
+
+inline constexpr unexpect_t unexpect = tim::in_place_error;
 
-inline constexpr unexpect_t unexpect = tim::result::in_place_error;
+#if TIM_RESULT_HAS_STD_EXPECTED
+
+template <class T, class E>
+constexpr std::expected<T, E> to_std(const Result<T, E>& r) noexcept(
+	(std::is_void_v<T> || std::is_nothrow_copy_constructible_v<T>)
+	&& std::is_nothrow_copy_constructible_v<E>
+) {
+	if(!r.has_value()) {
+		return std::expected<T, E>(std::unexpect, r.error());
+	} else if constexpr(std::is_void_v<T>) {
+		return std::expected<T, E>();
+	} else {
+		return std::expected<T, E>(std::in_place, *r);
+	}
+}
 
-using in_place_t = tim::result::in_place_t;
+template <class T, class E>
+constexpr std::expected<T, E> to_std(Result<T, E>&& r) noexcept(
+	(std::is_void_v<T> || std::is_nothrow_move_constructible_v<T>)
+	&& std::is_nothrow_move_constructible_v<E>
+) {
+	if(!r.has_value()) {
+		return std::expected<T, E>(std::unexpect, std::move(r).error());
+	} else if constexpr(std::is_void_v<T>) {
+		return std::expected<T, E>();
+	} else {
+		return std::expected<T, E>(std::in_place, *std::move(r));
+	}
+}
 
-inline constexpr in_place_t in_place = tim::result::in_place;
+template <class T, class E>
+constexpr Result<T, E> from_std(const std::expected<T, E>& e) noexcept(
+	(std::is_void_v<T> || std::is_nothrow_copy_constructible_v<T>)
+	&& std::is_nothrow_copy_constructible_v<E>
+) {
+	if(!e.has_value()) {
+		return Result<T, E>(tim::in_place_error, e.error());
+	} else if constexpr(std::is_void_v<T>) {
+		return Result<T, E>(tim::in_place);
+	} else {
+		return Result<T, E>(tim::in_place, *e);
+	}
+}
 
-using tim::result::operator==;
-using tim::result::operator!=;
-using tim::result::swap;
+template <class T, class E>
+constexpr Result<T, E> from_std(std::expected<T, E>&& e) noexcept(
+	(std::is_void_v<T> || std::is_nothrow_move_constructible_v<T>)
+	&& std::is_nothrow_move_constructible_v<E>
+) {
+	if(!e.has_value()) {
+		return Result<T, E>(tim::in_place_error, std::move(e).error());
+	} else if constexpr(std::is_void_v<T>) {
+		return Result<T, E>(tim::in_place);
+	} else {
+		return Result<T, E>(tim::in_place, *std::move(e));
+	}
+}
 
-namespace traits = tim::result::traits;
+#endif /* TIM_RESULT_HAS_STD_EXPECTED */
 
-} /* inline namespace expected */
+} /* inline namespace expected_compat */
 
 } /* namespace tim */
 
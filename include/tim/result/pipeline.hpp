@@ -0,0 +1,474 @@
+#ifndef TIM_RESULT_PIPELINE_HPP
+#define TIM_RESULT_PIPELINE_HPP
+
+#include "tim/result/Result.hpp"
+
+#include <tuple>
+
+namespace tim {
+
+namespace pipeline {
+
+// Lazy, fused counterparts of the monadic operations on 'Result':
+//
+//     using namespace tim::pipeline;
+//     Result<U, G> out = pipe(r) | map(f) | and_then(g) | map_error(h);
+//
+// The steps only record what to do, in a 'Chain' that never holds the
+// 'Result' itself.  The whole chain runs in a single pass when the pipeline
+// is converted to its 'Result' type (or 'run()' is called): the source is
+// bound then, each intermediate value is handed to the next step by reference
+// instead of being moved into an intermediate 'Result', and the last step
+// constructs the final 'Result' directly.  An rvalue source is therefore moved
+// at most once, whatever the number of steps.
+//
+// 'pipe()' only refers to its source, so a pipeline must be run within the
+// full-expression that creates it.  To keep a pipeline around, keep the chain
+// and bind the source when running it:
+//
+//     auto steps = map(f) | or_else(g);
+//     Result<U, E> out = steps(make());
+
+template <class ... Steps>
+class Chain;
+
+namespace detail {
+
+using tim::result::detail::is_cv_void_v;
+using tim::result::detail::result_value_t;
+
+enum class PipelineStepKind {
+	Map,
+	MapError,
+	AndThen,
+	OrElse
+};
+
+template <PipelineStepKind K, class F>
+struct PipelineStep {
+	static constexpr PipelineStepKind kind = K;
+	F fn;
+};
+
+template <class T>
+using remove_cvref_t = std::remove_cv_t<std::remove_reference_t<T>>;
+
+// The value of a 'Result' flowing through the pipeline is tracked as the
+// reference type it is passed to the next step with, or as cv 'void'.
+template <class V>
+using pipeline_value_type_t = std::conditional_t<is_cv_void_v<V>, V, remove_cvref_t<V>>;
+
+template <class V>
+using pipeline_value_arg_t = std::add_rvalue_reference_t<V>;
+
+template <class F, class V, bool = is_cv_void_v<V>>
+struct value_call_result: std::invoke_result<F> {};
+
+template <class F, class V>
+struct value_call_result<F, V, false>: std::invoke_result<F, V> {};
+
+template <class F, class V>
+using value_call_result_t = typename value_call_result<F, V>::type;
+
+template <PipelineStepKind K, class F, class V, class E>
+struct pipeline_step_types_impl;
+
+template <class F, class V, class E>
+struct pipeline_step_types_impl<PipelineStepKind::Map, F, V, E> {
+	using value_arg = pipeline_value_arg_t<std::decay_t<value_call_result_t<F&&, V>>>;
+	using error_arg = E;
+};
+
+template <class F, class V, class E>
+struct pipeline_step_types_impl<PipelineStepKind::AndThen, F, V, E> {
+	using result_type = remove_cvref_t<value_call_result_t<F&&, V>>;
+	static_assert(traits::is_result_v<result_type>,
+		"The function passed to and_then() must return a Result.");
+	static_assert(std::is_same_v<typename result_type::error_type, remove_cvref_t<E>>,
+		"The function passed to and_then() must return a Result with the same error type.");
+	using value_arg = pipeline_value_arg_t<typename result_type::value_type>;
+	using error_arg = E;
+};
+
+template <class F, class V, class E>
+struct pipeline_step_types_impl<PipelineStepKind::MapError, F, V, E> {
+	using invoke_type = std::decay_t<std::invoke_result_t<F&&, E>>;
+	using value_arg = V;
+	using error_arg = std::conditional_t<std::is_void_v<invoke_type>, std::monostate, invoke_type>&&;
+};
+
+template <class R, class E>
+struct or_else_error_arg {
+	static_assert(traits::is_result_v<R>,
+		"The function passed to or_else() must return a Result or void.");
+	using type = typename R::error_type&&;
+};
+
+template <class E>
+struct or_else_error_arg<void, E> {
+	using type = E;
+};
+
+template <class F, class V, class E>
+struct pipeline_step_types_impl<PipelineStepKind::OrElse, F, V, E> {
+	using value_arg = V;
+	using error_arg = typename or_else_error_arg<remove_cvref_t<std::invoke_result_t<F&&, E>>, E>::type;
+};
+
+// 'F' is the reference type the function of a step is invoked through: an
+// rvalue when the chain is run once, a const lvalue when it is run again.
+template <class Step>
+using pipeline_step_fn_t = decltype((std::declval<Step>().fn));
+
+template <class Step, class V, class E>
+using pipeline_step_types = pipeline_step_types_impl<
+	remove_cvref_t<Step>::kind,
+	pipeline_step_fn_t<Step>,
+	V,
+	E
+>;
+
+template <class V, class E, class ... Steps>
+struct pipeline_types {
+	using result_type = Result<pipeline_value_type_t<V>, remove_cvref_t<E>>;
+};
+
+template <class V, class E, class Step, class ... Steps>
+struct pipeline_types<V, E, Step, Steps...>: pipeline_types<
+	typename pipeline_step_types<Step, V, E>::value_arg,
+	typename pipeline_step_types<Step, V, E>::error_arg,
+	Steps...
+> {};
+
+template <class R, bool = is_cv_void_v<result_value_t<R>>>
+struct source_value_arg {
+	using type = decltype(*std::declval<R>());
+};
+
+template <class R>
+struct source_value_arg<R, true> {
+	using type = result_value_t<R>;
+};
+
+// Defers a call so that its result can initialize an object in place through
+// a conversion operator, without an intermediate move.
+template <class F, class ... Args>
+struct DeferredCall {
+	using result_type = std::invoke_result_t<F&&, Args&&...>;
+
+	constexpr operator result_type() && {
+		return std::apply(
+			[&](auto&& ... args) -> result_type {
+				return tim::result::detail::invoke(std::forward<F>(fn), std::forward<decltype(args)>(args)...);
+			},
+			std::move(args)
+		);
+	}
+
+	F&& fn;
+	std::tuple<Args&&...> args;
+};
+
+// Used to detect types with a constructor template that would accept a
+// 'DeferredCall' itself rather than the result of calling it.
+struct DeferredCallProbe {};
+
+template <class T>
+inline constexpr bool can_construct_from_deferred_call_v =
+	!std::is_constructible_v<T, DeferredCallProbe>
+	&& std::is_move_constructible_v<T>;
+
+template <class V, class E, class Tuple, class Indices>
+struct pipeline_run_types;
+
+template <class V, class E, class Tuple, std::size_t ... I>
+struct pipeline_run_types<V, E, Tuple, std::index_sequence<I...>>:
+	pipeline_types<V, E, decltype(std::get<I>(std::declval<Tuple>()))...> {};
+
+// Runs the steps in 'Tuple' (a reference to a tuple of steps) over 'Source'.
+template <class Source, class Tuple>
+class PipelineRun {
+	using value_arg = typename source_value_arg<Source&&>::type;
+	using error_arg = decltype(std::declval<Source&&>().error());
+
+	static constexpr std::size_t step_count = std::tuple_size_v<std::remove_reference_t<Tuple>>;
+
+public:
+	using result_type = typename pipeline_run_types<
+		value_arg,
+		error_arg,
+		Tuple,
+		std::make_index_sequence<step_count>
+	>::result_type;
+
+	constexpr PipelineRun(Source&& source, Tuple steps):
+		source_(std::forward<Source>(source)),
+		steps_(static_cast<Tuple>(steps))
+	{
+
+	}
+
+	constexpr result_type run() && {
+		if(source_.has_value()) {
+			if constexpr(is_cv_void_v<result_value_t<Source>>) {
+				return on_value<0>();
+			} else {
+				return on_value<0>(*std::forward<Source>(source_));
+			}
+		}
+		return on_error<0>(std::forward<Source>(source_).error());
+	}
+
+private:
+	template <std::size_t I>
+	using step_fn_t = pipeline_step_fn_t<decltype(std::get<I>(std::declval<Tuple>()))>;
+
+	template <std::size_t I>
+	static constexpr PipelineStepKind step_kind =
+		remove_cvref_t<std::tuple_element_t<I, std::remove_reference_t<Tuple>>>::kind;
+
+	template <std::size_t I>
+	constexpr step_fn_t<I> step_fn() {
+		return static_cast<step_fn_t<I>>(std::get<I>(static_cast<Tuple>(steps_)).fn);
+	}
+
+	template <std::size_t I, class ... V>
+	constexpr result_type on_value(V&& ... v) {
+		if constexpr(I == step_count) {
+			return result_type(tim::in_place, std::forward<V>(v)...);
+		} else {
+			using fn_type = step_fn_t<I>;
+			constexpr auto kind = step_kind<I>;
+			if constexpr(kind == PipelineStepKind::Map) {
+				using invoke_type = std::invoke_result_t<fn_type, V&&...>;
+				if constexpr(std::is_void_v<invoke_type>) {
+					tim::result::detail::invoke(step_fn<I>(), std::forward<V>(v)...);
+					return on_value<I + 1>();
+				} else if constexpr(
+					I + 1 == step_count
+					&& std::is_same_v<std::decay_t<invoke_type>, invoke_type>
+					&& can_construct_from_deferred_call_v<invoke_type>
+				) {
+					// Last step: construct the final value in place.
+					return result_type(
+						tim::in_place,
+						DeferredCall<fn_type, V...>{step_fn<I>(), {std::forward<V>(v)...}}
+					);
+				} else {
+					return on_value<I + 1>(tim::result::detail::invoke(step_fn<I>(), std::forward<V>(v)...));
+				}
+			} else if constexpr(kind == PipelineStepKind::AndThen) {
+				using invoke_type = remove_cvref_t<std::invoke_result_t<fn_type, V&&...>>;
+				if constexpr(I + 1 == step_count && std::is_same_v<invoke_type, result_type>) {
+					return tim::result::detail::invoke(step_fn<I>(), std::forward<V>(v)...);
+				} else {
+					auto&& r = tim::result::detail::invoke(step_fn<I>(), std::forward<V>(v)...);
+					return dispatch<I + 1>(std::forward<decltype(r)>(r));
+				}
+			} else {
+				return on_value<I + 1>(std::forward<V>(v)...);
+			}
+		}
+	}
+
+	template <std::size_t I, class G>
+	constexpr result_type on_error(G&& e) {
+		if constexpr(I == step_count) {
+			return result_type(tim::in_place_error, std::forward<G>(e));
+		} else {
+			using fn_type = step_fn_t<I>;
+			constexpr auto kind = step_kind<I>;
+			if constexpr(kind == PipelineStepKind::MapError) {
+				using invoke_type = std::invoke_result_t<fn_type, G&&>;
+				if constexpr(std::is_void_v<invoke_type>) {
+					tim::result::detail::invoke(step_fn<I>(), std::forward<G>(e));
+					return on_error<I + 1>(std::monostate{});
+				} else {
+					return on_error<I + 1>(tim::result::detail::invoke(step_fn<I>(), std::forward<G>(e)));
+				}
+			} else if constexpr(kind == PipelineStepKind::OrElse) {
+				using invoke_type = remove_cvref_t<std::invoke_result_t<fn_type, G&&>>;
+				if constexpr(std::is_void_v<invoke_type>) {
+					// The function only observes the error, as an lvalue; the error
+					// is passed through.
+					static_assert(std::is_invocable_v<fn_type, G&>,
+						"A function passed to or_else() that returns void must accept the error as an lvalue.");
+					tim::result::detail::invoke(step_fn<I>(), e);
+					return on_error<I + 1>(std::forward<G>(e));
+				} else if constexpr(I + 1 == step_count && std::is_same_v<invoke_type, result_type>) {
+					return tim::result::detail::invoke(step_fn<I>(), std::forward<G>(e));
+				} else {
+					auto&& r = tim::result::detail::invoke(step_fn<I>(), std::forward<G>(e));
+					return dispatch<I + 1>(std::forward<decltype(r)>(r));
+				}
+			} else {
+				return on_error<I + 1>(std::forward<G>(e));
+			}
+		}
+	}
+
+	// Continues the pipeline at step 'I' with the contents of the 'Result'
+	// returned by an 'and_then()' or 'or_else()' step.
+	template <std::size_t I, class R>
+	constexpr result_type dispatch(R&& r) {
+		if(r.has_value()) {
+			if constexpr(is_cv_void_v<result_value_t<R>>) {
+				return on_value<I>();
+			} else {
+				return on_value<I>(*std::forward<R>(r));
+			}
+		}
+		return on_error<I>(std::forward<R>(r).error());
+	}
+
+	Source&& source_;
+	Tuple steps_;
+};
+
+template <PipelineStepKind K, class F>
+constexpr Chain<PipelineStep<K, std::decay_t<F>>> make_step(F&& f) {
+	using step_type = PipelineStep<K, std::decay_t<F>>;
+	return Chain<step_type>(std::tuple<step_type>(step_type{std::forward<F>(f)}));
+}
+
+} /* namespace detail */
+
+// A sequence of steps, without a source.  Chains are joined with '|', and
+// run over a 'Result' by calling them; a chain called as an lvalue can be run
+// again.
+template <class ... Steps>
+class Chain {
+	template <class ... S>
+	friend class Chain;
+
+	template <class Source, class ... S>
+	friend class Pipeline;
+
+	template <class R>
+	using run_type = detail::PipelineRun<R, std::tuple<Steps...>&&>;
+
+	template <class R>
+	using const_run_type = detail::PipelineRun<R, const std::tuple<Steps...>&>;
+
+public:
+	constexpr explicit Chain(std::tuple<Steps...>&& steps):
+		steps_(std::move(steps))
+	{
+
+	}
+
+	template <class ... Other>
+	constexpr Chain<Steps..., Other...> operator|(Chain<Other...>&& other) && {
+		return Chain<Steps..., Other...>(std::tuple_cat(std::move(steps_), std::move(other.steps_)));
+	}
+
+	template <class ... Other>
+	constexpr Chain<Steps..., Other...> operator|(const Chain<Other...>& other) && {
+		return Chain<Steps..., Other...>(std::tuple_cat(std::move(steps_), other.steps_));
+	}
+
+	template <
+		class R,
+		std::enable_if_t<
+			traits::is_result_v<detail::remove_cvref_t<R>>,
+			bool
+		> = false
+	>
+	constexpr typename run_type<R>::result_type operator()(R&& source) && {
+		return run_type<R>(std::forward<R>(source), std::move(steps_)).run();
+	}
+
+	template <
+		class R,
+		std::enable_if_t<
+			traits::is_result_v<detail::remove_cvref_t<R>>,
+			bool
+		> = false
+	>
+	constexpr typename const_run_type<R>::result_type operator()(R&& source) const& {
+		return const_run_type<R>(std::forward<R>(source), steps_).run();
+	}
+
+private:
+	std::tuple<Steps...> steps_;
+};
+
+// A chain bound to the 'Result' passed to 'pipe()', which it refers to.
+template <class Source, class ... Steps>
+class Pipeline {
+	using run_type = detail::PipelineRun<Source, std::tuple<Steps...>&&>;
+
+public:
+	using result_type = typename run_type::result_type;
+
+	constexpr Pipeline(Source&& source, Chain<Steps...>&& chain):
+		source_(std::forward<Source>(source)),
+		chain_(std::move(chain))
+	{
+
+	}
+
+	Pipeline(const Pipeline&) = delete;
+	Pipeline& operator=(const Pipeline&) = delete;
+
+	template <class ... Other>
+	friend constexpr Pipeline<Source, Steps..., Other...> operator|(Pipeline&& self, Chain<Other...>&& chain) {
+		return Pipeline<Source, Steps..., Other...>(
+			std::forward<Source>(self.source_),
+			std::move(self.chain_) | std::move(chain)
+		);
+	}
+
+	template <class ... Other>
+	friend constexpr Pipeline<Source, Steps..., Other...> operator|(Pipeline&& self, const Chain<Other...>& chain) {
+		return Pipeline<Source, Steps..., Other...>(
+			std::forward<Source>(self.source_),
+			std::move(self.chain_) | chain
+		);
+	}
+
+	constexpr result_type run() && {
+		return run_type(std::forward<Source>(source_), std::move(chain_.steps_)).run();
+	}
+
+	constexpr operator result_type() && {
+		return std::move(*this).run();
+	}
+
+private:
+	Source&& source_;
+	Chain<Steps...> chain_;
+};
+
+template <class R>
+constexpr Pipeline<R> pipe(R&& r) {
+	static_assert(traits::is_result_v<detail::remove_cvref_t<R>>,
+		"pipe() requires a Result.");
+	return Pipeline<R>(std::forward<R>(r), Chain<>(std::tuple<>()));
+}
+
+template <class F>
+constexpr Chain<detail::PipelineStep<detail::PipelineStepKind::Map, std::decay_t<F>>> map(F&& f) {
+	return detail::make_step<detail::PipelineStepKind::Map>(std::forward<F>(f));
+}
+
+template <class F>
+constexpr Chain<detail::PipelineStep<detail::PipelineStepKind::MapError, std::decay_t<F>>> map_error(F&& f) {
+	return detail::make_step<detail::PipelineStepKind::MapError>(std::forward<F>(f));
+}
+
+template <class F>
+constexpr Chain<detail::PipelineStep<detail::PipelineStepKind::AndThen, std::decay_t<F>>> and_then(F&& f) {
+	return detail::make_step<detail::PipelineStepKind::AndThen>(std::forward<F>(f));
+}
+
+template <class F>
+constexpr Chain<detail::PipelineStep<detail::PipelineStepKind::OrElse, std::decay_t<F>>> or_else(F&& f) {
+	return detail::make_step<detail::PipelineStepKind::OrElse>(std::forward<F>(f));
+}
+
+} /* namespace pipeline */
+
+} /* namespace tim */
+
+#endif /* TIM_RESULT_PIPELINE_HPP */
@@ -0,0 +1,41 @@
+#ifndef TIM_RESULT_REFERENCE_WRAPPER_HPP
+#define TIM_RESULT_REFERENCE_WRAPPER_HPP
+
+#include "tim/result/Result.hpp"
+
+#include <functional>
+
+// 'traits::niche_traits' for 'std::reference_wrapper', so that
+// 'sizeof(Result<std::reference_wrapper<T>, E>) == sizeof(T*)' when 'E' fits
+// in the niche.
+//
+// Kept out of Result.hpp so that every user of 'Result' does not pay for
+// including '<functional>'.  The niche changes the layout of the 'Result', so,
+// like any other specialization of 'niche_traits', this header must be
+// included in every translation unit that uses a 'Result' holding a
+// 'std::reference_wrapper', before the 'Result' is used.
+
+namespace tim {
+
+inline namespace result {
+
+namespace traits {
+
+// A 'std::reference_wrapper' is never null, and has the niche of 'T*' if any.
+template <class T>
+struct niche_traits<
+	std::reference_wrapper<T>,
+	std::enable_if_t<sizeof(std::reference_wrapper<T>) == sizeof(T*)>
+>: std::conditional_t<
+	has_niche_v<T*>,
+	pointer_low_bit_niche<std::reference_wrapper<T>>,
+	pointer_null_niche<std::reference_wrapper<T>>
+> {};
+
+} /* namespace traits */
+
+} /* inline namespace result */
+
+} /* namespace tim */
+
+#endif /* TIM_RESULT_REFERENCE_WRAPPER_HPP */
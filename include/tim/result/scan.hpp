@@ -0,0 +1,672 @@
+#ifndef TIM_RESULT_SCAN_HPP
+#define TIM_RESULT_SCAN_HPP
+
+#include "tim/result/ResultVector.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <utility>
+
+// Bulk status queries over contiguous arrays of 'Result'.
+//
+//  - 'count_values(range)' / 'count_errors(range)': how many elements hold a
+//    value / an error.
+//  - 'find_error(range)': the index of the first element holding an error, or
+//    the size of the range.
+//  - 'status_bitmap(range, words)': writes one bit per element, set when it
+//    holds a value, into '(size + 63) / 64' words (the layout 'ResultVector'
+//    uses).
+//  - 'partition_copy(range, values, errors)': copies the values to one output
+//    iterator and the errors to another, each in their original order.  This
+//    one is a plain loop; it is here so that callers need not write it.
+//
+// 'range' is anything with 'std::data()' and 'std::size()': a 'std::vector',
+// a 'std::array', a C++20 'std::span'.  Every function also has a
+// '(pointer, size)' form.
+//
+// When 'Result<T, E>' is trivially copyable and stores its discriminant in a
+// flag (rather than in a niche of 'T' or 'E'), these scan the raw bytes of the
+// array with SIMD instead of testing each element: AVX2 (with BMI2) or SSE2 on
+// x86 with GCC or Clang, chosen at run time, and NEON on little-endian
+// AArch64.  Otherwise, and for elements larger than 64 bytes, they fall back
+// to a branch-free loop over the flags, or to 'has_value()'.
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+# define TIM_RESULT_X86_STATUS_KERNELS 1
+# include <immintrin.h>
+#else
+# define TIM_RESULT_X86_STATUS_KERNELS 0
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON) \
+	&& defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+# define TIM_RESULT_NEON_STATUS_KERNELS 1
+# include <arm_neon.h>
+#else
+# define TIM_RESULT_NEON_STATUS_KERNELS 0
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+# define TIM_RESULT_KERNEL_INLINE __attribute__((always_inline)) inline
+#else
+# define TIM_RESULT_KERNEL_INLINE inline
+#endif
+
+namespace tim {
+
+inline namespace result {
+
+namespace detail {
+
+enum class StatusKernel: unsigned char {
+	Scalar,
+	SSE2,
+	AVX2,
+	NEON
+};
+
+// Where the flag of every element of an array of 'Result's lives: the byte at
+// 'flag' in each 'stride'-byte element is non-zero exactly when the element
+// holds a value.
+struct StatusLayout {
+	std::size_t stride;
+	std::size_t flag;
+};
+
+template <class T, class E>
+inline constexpr bool has_status_layout_v =
+	niche_layout<T, E>::kind == NicheKind::None
+	&& std::is_trivially_copyable_v<Result<T, E>>
+	&& sizeof(Result<T, E>) == sizeof(ResultUnion<T, E>) + alignof(ResultUnion<T, E>);
+
+template <class T, class E>
+constexpr StatusLayout status_layout() noexcept {
+	// The flag is a word as wide as the union's alignment, right after it; its
+	// value is 0 or 1, so only its least significant byte matters.
+	constexpr std::size_t flag = sizeof(ResultUnion<T, E>);
+	return StatusLayout{sizeof(Result<T, E>), traits::detail::is_little_endian ? flag : flag + alignof(ResultUnion<T, E>) - 1u};
+}
+
+// The first element whose flag is at or after 'byte'.
+inline std::size_t first_flag_at(std::size_t byte, std::size_t n, StatusLayout layout) noexcept {
+	if(byte <= layout.flag) {
+		return 0u;
+	}
+	return std::min(n, (byte - layout.flag + layout.stride - 1u) / layout.stride);
+}
+
+// Writes a stream of bits into consecutive 64-bit words.
+class BitAppender {
+public:
+	explicit BitAppender(std::uint64_t* out) noexcept:
+		out_(out)
+	{
+
+	}
+
+	// Appends the low 'count' bits of 'bits'; the others must be clear.
+	TIM_RESULT_KERNEL_INLINE void append(std::uint64_t bits, unsigned count) noexcept {
+		word_ |= bits << used_;
+		used_ += count;
+		if(used_ >= 64u) {
+			*out_++ = word_;
+			used_ -= 64u;
+			word_ = used_ ? bits >> (count - used_) : 0u;
+		}
+	}
+
+	void finish() noexcept {
+		if(used_) {
+			*out_++ = word_;
+		}
+	}
+
+private:
+	std::uint64_t* out_;
+	std::uint64_t word_ = 0;
+	unsigned used_ = 0;
+};
+
+inline std::size_t count_flags_scalar(const unsigned char* p, std::size_t from, std::size_t n, StatusLayout layout) noexcept {
+	std::size_t count = 0;
+	for(std::size_t i = from; i < n; ++i) {
+		count += p[i * layout.stride + layout.flag] != 0u;
+	}
+	return count;
+}
+
+inline std::size_t find_clear_flag_scalar(const unsigned char* p, std::size_t from, std::size_t n, StatusLayout layout) noexcept {
+	for(std::size_t i = from; i < n; ++i) {
+		if(!p[i * layout.stride + layout.flag]) {
+			return i;
+		}
+	}
+	return n;
+}
+
+inline void flag_bitmap_scalar(const unsigned char* p, std::size_t from, std::size_t n, StatusLayout layout, BitAppender& out) noexcept {
+	for(std::size_t i = from; i < n; ++i) {
+		out.append(p[i * layout.stride + layout.flag] != 0u, 1u);
+	}
+}
+
+// Elements with a larger stride are scanned one flag at a time.
+inline constexpr std::size_t max_status_stride = 64;
+
+// Scans an array 'Block::width' bytes at a time.  'Block::nonzero(p)' returns
+// a mask with bit 'j * Block::bits' set for every non-zero byte 'p[j]' (the
+// other bits of each group may be anything); it is ANDed with a mask that
+// selects the flag bytes in that block.  The flag positions repeat every
+// 'stride / gcd(stride, width)' blocks, so those masks are computed up front.
+// 'Block::count_blocks(p, blocks, masks, period)' counts the non-zero flags in
+// the first 'blocks' blocks.
+template <class Block>
+struct StatusEngine {
+	static constexpr std::size_t width = Block::width;
+
+	struct FlagMasks {
+		explicit FlagMasks(StatusLayout layout) noexcept {
+			period = layout.stride / std::gcd(layout.stride, width);
+			for(std::size_t k = 0; k < period; ++k) {
+				std::size_t start = k * width;
+				std::uint64_t mask = 0;
+				std::size_t pos = layout.flag;
+				if(start > pos) {
+					pos += (start - pos + layout.stride - 1u) / layout.stride * layout.stride;
+				}
+				for(; pos < start + width; pos += layout.stride) {
+					mask |= std::uint64_t(1) << ((pos - start) * Block::bits);
+				}
+				masks[k] = mask;
+			}
+		}
+
+		std::uint64_t masks[max_status_stride];
+		std::size_t period;
+	};
+
+	static TIM_RESULT_KERNEL_INLINE std::size_t count(const unsigned char* p, std::size_t n, StatusLayout layout) noexcept {
+		FlagMasks flags(layout);
+		std::size_t blocks = n * layout.stride / width;
+		std::size_t count = Block::count_blocks(p, blocks, flags.masks, flags.period);
+		return count + count_flags_scalar(p, first_flag_at(blocks * width, n, layout), n, layout);
+	}
+
+	static TIM_RESULT_KERNEL_INLINE std::size_t find_clear(const unsigned char* p, std::size_t n, StatusLayout layout) noexcept {
+		FlagMasks flags(layout);
+		std::size_t blocks = n * layout.stride / width;
+		for(std::size_t b = 0, k = 0; b < blocks; ++b) {
+			std::uint64_t clear = ~Block::nonzero(p + b * width) & flags.masks[k];
+			if(clear) {
+				std::size_t byte = b * width + static_cast<std::size_t>(countr_zero64(clear)) / Block::bits;
+				return (byte - layout.flag) / layout.stride;
+			}
+			k = k + 1u == flags.period ? 0u : k + 1u;
+		}
+		return find_clear_flag_scalar(p, first_flag_at(blocks * width, n, layout), n, layout);
+	}
+
+	// 64 elements span exactly '64 * stride / width' blocks, and the flag
+	// masks repeat within them, so each word of the bitmap is built from
+	// whole blocks.
+	static TIM_RESULT_KERNEL_INLINE void bitmap(const unsigned char* p, std::size_t n, StatusLayout layout, std::uint64_t* words) noexcept {
+		FlagMasks flags(layout);
+		unsigned counts[max_status_stride];
+		for(std::size_t k = 0; k < flags.period; ++k) {
+			counts[k] = static_cast<unsigned>(popcount64(flags.masks[k]));
+		}
+		std::size_t blocks_per_word = 64u * layout.stride / width;
+		std::size_t full_words = n / 64u;
+		for(std::size_t w = 0; w < full_words; ++w) {
+			const unsigned char* block = p + w * 64u * layout.stride;
+			std::uint64_t word = 0;
+			unsigned shift = 0;
+			for(std::size_t b = 0, k = 0; b < blocks_per_word; ++b, block += width) {
+				word |= Block::compress(Block::nonzero(block), flags.masks[k]) << (shift & 63u);
+				shift += counts[k];
+				k = k + 1u == flags.period ? 0u : k + 1u;
+			}
+			words[w] = word;
+		}
+		BitAppender out(words + full_words);
+		flag_bitmap_scalar(p, full_words * 64u, n, layout, out);
+		out.finish();
+	}
+};
+
+// Gathers the bits of 'bits' selected by 'mask' into the low bits.
+inline std::uint64_t compress_bits(std::uint64_t bits, std::uint64_t mask) noexcept {
+	std::uint64_t out = 0;
+	unsigned j = 0;
+	for(; mask; mask &= mask - 1u, ++j) {
+		out |= ((bits >> countr_zero64(mask)) & 1u) << j;
+	}
+	return out;
+}
+
+template <class Block>
+TIM_RESULT_KERNEL_INLINE std::size_t count_blocks_popcount(const unsigned char* p, std::size_t blocks, const std::uint64_t* masks, std::size_t period) noexcept {
+	std::size_t count = 0;
+	for(std::size_t b = 0, k = 0; b < blocks; ++b) {
+		count += static_cast<std::size_t>(popcount64(Block::nonzero(p + b * Block::width) & masks[k]));
+		k = k + 1u == period ? 0u : k + 1u;
+	}
+	return count;
+}
+
+// Expands a mask of 'Width' bits into 'Width' bytes of 0xFF or 0x00.
+template <std::size_t Width>
+void expand_byte_mask(std::uint64_t mask, unsigned char* bytes) noexcept {
+	for(std::size_t j = 0; j < Width; ++j) {
+		bytes[j] = ((mask >> j) & 1u) ? 0xFFu : 0x00u;
+	}
+}
+
+#if TIM_RESULT_X86_STATUS_KERNELS
+
+// The flag bytes are 0 or 1, so the x86 blocks count them by summing the
+// masked bytes with 'psadbw' rather than with 'popcnt', which keeps the loop
+// in vector registers.
+
+struct Sse2StatusBlock {
+	static constexpr std::size_t width = 16;
+	static constexpr std::size_t bits = 1;
+
+	__attribute__((target("sse2")))
+	static inline std::uint64_t nonzero(const unsigned char* p) noexcept {
+		__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+		__m128i zero = _mm_cmpeq_epi8(v, _mm_setzero_si128());
+		return ~static_cast<std::uint64_t>(static_cast<unsigned>(_mm_movemask_epi8(zero)));
+	}
+
+	__attribute__((target("sse2")))
+	static std::size_t count_blocks(const unsigned char* p, std::size_t blocks, const std::uint64_t* masks, std::size_t period) noexcept {
+		alignas(16) unsigned char bytes[max_status_stride][width];
+		for(std::size_t k = 0; k < period; ++k) {
+			expand_byte_mask<width>(masks[k], bytes[k]);
+		}
+		// Each byte lane gains at most 1 per block, so lanes are summed in
+		// bytes for up to 255 blocks at a time.
+		__m128i zero = _mm_setzero_si128();
+		__m128i sum = zero;
+		for(std::size_t b = 0, k = 0; b < blocks;) {
+			std::size_t run = std::min<std::size_t>(blocks - b, 255u);
+			__m128i bytes_sum = zero;
+			if(period == 1u) {
+				__m128i m = _mm_load_si128(reinterpret_cast<const __m128i*>(bytes[0]));
+				for(std::size_t i = 0; i < run; ++i) {
+					__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + (b + i) * width));
+					bytes_sum = _mm_add_epi8(bytes_sum, _mm_and_si128(v, m));
+				}
+			} else {
+				for(std::size_t i = 0; i < run; ++i) {
+					__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + (b + i) * width));
+					__m128i m = _mm_load_si128(reinterpret_cast<const __m128i*>(bytes[k]));
+					bytes_sum = _mm_add_epi8(bytes_sum, _mm_and_si128(v, m));
+					k = k + 1u == period ? 0u : k + 1u;
+				}
+			}
+			sum = _mm_add_epi64(sum, _mm_sad_epu8(bytes_sum, zero));
+			b += run;
+		}
+		alignas(16) std::uint64_t lanes[2];
+		_mm_store_si128(reinterpret_cast<__m128i*>(lanes), sum);
+		return static_cast<std::size_t>(lanes[0] + lanes[1]);
+	}
+
+	static std::uint64_t compress(std::uint64_t bits, std::uint64_t mask) noexcept {
+		return compress_bits(bits, mask);
+	}
+};
+
+struct Avx2StatusBlock {
+	static constexpr std::size_t width = 32;
+	static constexpr std::size_t bits = 1;
+
+	__attribute__((target("avx2")))
+	static inline std::uint64_t nonzero(const unsigned char* p) noexcept {
+		__m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+		__m256i zero = _mm256_cmpeq_epi8(v, _mm256_setzero_si256());
+		return ~static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(zero)));
+	}
+
+	__attribute__((target("avx2")))
+	static std::size_t count_blocks(const unsigned char* p, std::size_t blocks, const std::uint64_t* masks, std::size_t period) noexcept {
+		alignas(32) unsigned char bytes[max_status_stride][width];
+		for(std::size_t k = 0; k < period; ++k) {
+			expand_byte_mask<width>(masks[k], bytes[k]);
+		}
+		// Each byte lane gains at most 1 per block, so lanes are summed in
+		// bytes for up to 255 blocks at a time.
+		__m256i zero = _mm256_setzero_si256();
+		__m256i sum = zero;
+		for(std::size_t b = 0, k = 0; b < blocks;) {
+			std::size_t run = std::min<std::size_t>(blocks - b, 255u);
+			__m256i bytes_sum = zero;
+			if(period == 1u) {
+				__m256i m = _mm256_load_si256(reinterpret_cast<const __m256i*>(bytes[0]));
+				for(std::size_t i = 0; i < run; ++i) {
+					__m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + (b + i) * width));
+					bytes_sum = _mm256_add_epi8(bytes_sum, _mm256_and_si256(v, m));
+				}
+			} else {
+				for(std::size_t i = 0; i < run; ++i) {
+					__m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + (b + i) * width));
+					__m256i m = _mm256_load_si256(reinterpret_cast<const __m256i*>(bytes[k]));
+					bytes_sum = _mm256_add_epi8(bytes_sum, _mm256_and_si256(v, m));
+					k = k + 1u == period ? 0u : k + 1u;
+				}
+			}
+			sum = _mm256_add_epi64(sum, _mm256_sad_epu8(bytes_sum, zero));
+			b += run;
+		}
+		alignas(32) std::uint64_t lanes[4];
+		_mm256_store_si256(reinterpret_cast<__m256i*>(lanes), sum);
+		return static_cast<std::size_t>(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+	}
+
+	__attribute__((target("bmi2")))
+	static inline std::uint64_t compress(std::uint64_t bits, std::uint64_t mask) noexcept {
+#if defined(__x86_64__)
+		return _pext_u64(bits, mask);
+#else
+		return _pext_u32(static_cast<std::uint32_t>(bits), static_cast<std::uint32_t>(mask));
+#endif
+	}
+};
+
+__attribute__((target("sse2")))
+inline std::size_t count_flags_sse2(const unsigned char* p, std::size_t n, StatusLayout layout) noexcept {
+	return StatusEngine<Sse2StatusBlock>::count(p, n, layout);
+}
+
+__attribute__((target("sse2")))
+inline std::size_t find_clear_flag_sse2(const unsigned char* p, std::size_t n, StatusLayout layout) noexcept {
+	return StatusEngine<Sse2StatusBlock>::find_clear(p, n, layout);
+}
+
+__attribute__((target("sse2")))
+inline void flag_bitmap_sse2(const unsigned char* p, std::size_t n, StatusLayout layout, std::uint64_t* words) noexcept {
+	StatusEngine<Sse2StatusBlock>::bitmap(p, n, layout, words);
+}
+
+__attribute__((target("avx2,bmi,bmi2,popcnt")))
+inline std::size_t count_flags_avx2(const unsigned char* p, std::size_t n, StatusLayout layout) noexcept {
+	return StatusEngine<Avx2StatusBlock>::count(p, n, layout);
+}
+
+__attribute__((target("avx2,bmi,bmi2,popcnt")))
+inline std::size_t find_clear_flag_avx2(const unsigned char* p, std::size_t n, StatusLayout layout) noexcept {
+	return StatusEngine<Avx2StatusBlock>::find_clear(p, n, layout);
+}
+
+__attribute__((target("avx2,bmi,bmi2,popcnt")))
+inline void flag_bitmap_avx2(const unsigned char* p, std::size_t n, StatusLayout layout, std::uint64_t* words) noexcept {
+	StatusEngine<Avx2StatusBlock>::bitmap(p, n, layout, words);
+}
+
+#endif /* TIM_RESULT_X86_STATUS_KERNELS */
+
+#if TIM_RESULT_NEON_STATUS_KERNELS
+
+struct NeonStatusBlock {
+	static constexpr std::size_t width = 16;
+	static constexpr std::size_t bits = 4;
+
+	// Narrows the byte mask to one nibble per byte.
+	static inline std::uint64_t nonzero(const unsigned char* p) noexcept {
+		uint8x16_t v = vld1q_u8(p);
+		uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(vtstq_u8(v, v)), 4);
+		return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0);
+	}
+
+	static std::size_t count_blocks(const unsigned char* p, std::size_t blocks, const std::uint64_t* masks, std::size_t period) noexcept {
+		return count_blocks_popcount<NeonStatusBlock>(p, blocks, masks, period);
+	}
+
+	static std::uint64_t compress(std::uint64_t bits, std::uint64_t mask) noexcept {
+		return compress_bits(bits, mask);
+	}
+};
+
+#endif /* TIM_RESULT_NEON_STATUS_KERNELS */
+
+inline bool status_kernel_supported(StatusKernel kernel) noexcept {
+	switch(kernel) {
+	case StatusKernel::Scalar:
+		return true;
+#if TIM_RESULT_X86_STATUS_KERNELS
+	case StatusKernel::SSE2:
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("sse2");
+	case StatusKernel::AVX2:
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi2") && __builtin_cpu_supports("popcnt");
+#endif
+#if TIM_RESULT_NEON_STATUS_KERNELS
+	case StatusKernel::NEON:
+		return true;
+#endif
+	default:
+		return false;
+	}
+}
+
+// The best kernel for this machine, detected once.
+inline StatusKernel status_kernel() noexcept {
+	static const StatusKernel kernel = [] {
+		for(auto k: {StatusKernel::AVX2, StatusKernel::NEON, StatusKernel::SSE2}) {
+			if(status_kernel_supported(k)) {
+				return k;
+			}
+		}
+		return StatusKernel::Scalar;
+	}();
+	return kernel;
+}
+
+inline std::size_t count_flags(StatusKernel kernel, const unsigned char* p, std::size_t n, StatusLayout layout) noexcept {
+	if(layout.stride <= max_status_stride) {
+		switch(kernel) {
+#if TIM_RESULT_X86_STATUS_KERNELS
+		case StatusKernel::AVX2:
+			return count_flags_avx2(p, n, layout);
+		case StatusKernel::SSE2:
+			return count_flags_sse2(p, n, layout);
+#endif
+#if TIM_RESULT_NEON_STATUS_KERNELS
+		case StatusKernel::NEON:
+			return StatusEngine<NeonStatusBlock>::count(p, n, layout);
+#endif
+		default:
+			break;
+		}
+	}
+	return count_flags_scalar(p, 0u, n, layout);
+}
+
+inline std::size_t find_clear_flag(StatusKernel kernel, const unsigned char* p, std::size_t n, StatusLayout layout) noexcept {
+	if(layout.stride <= max_status_stride) {
+		switch(kernel) {
+#if TIM_RESULT_X86_STATUS_KERNELS
+		case StatusKernel::AVX2:
+			return find_clear_flag_avx2(p, n, layout);
+		case StatusKernel::SSE2:
+			return find_clear_flag_sse2(p, n, layout);
+#endif
+#if TIM_RESULT_NEON_STATUS_KERNELS
+		case StatusKernel::NEON:
+			return StatusEngine<NeonStatusBlock>::find_clear(p, n, layout);
+#endif
+		default:
+			break;
+		}
+	}
+	return find_clear_flag_scalar(p, 0u, n, layout);
+}
+
+inline void flag_bitmap(StatusKernel kernel, const unsigned char* p, std::size_t n, StatusLayout layout, std::uint64_t* words) noexcept {
+	if(layout.stride <= max_status_stride) {
+		switch(kernel) {
+#if TIM_RESULT_X86_STATUS_KERNELS
+		case StatusKernel::AVX2:
+			return flag_bitmap_avx2(p, n, layout, words);
+		case StatusKernel::SSE2:
+			return flag_bitmap_sse2(p, n, layout, words);
+#endif
+#if TIM_RESULT_NEON_STATUS_KERNELS
+		case StatusKernel::NEON:
+			return StatusEngine<NeonStatusBlock>::bitmap(p, n, layout, words);
+#endif
+		default:
+			break;
+		}
+	}
+	BitAppender out(words);
+	flag_bitmap_scalar(p, 0u, n, layout, out);
+	out.finish();
+}
+
+template <class T, class E>
+const unsigned char* result_bytes(const Result<T, E>* first) noexcept {
+	return reinterpret_cast<const unsigned char*>(first);
+}
+
+template <class Range, class = void>
+struct is_contiguous_result_range: std::false_type {};
+
+template <class Range>
+struct is_contiguous_result_range<Range, std::void_t<decltype(std::data(std::declval<const Range&>())), decltype(std::size(std::declval<const Range&>()))>>:
+	traits::is_result<std::remove_cv_t<std::remove_pointer_t<decltype(std::data(std::declval<const Range&>()))>>>
+{
+
+};
+
+template <class Range>
+inline constexpr bool is_contiguous_result_range_v = is_contiguous_result_range<Range>::value;
+
+} /* namespace detail */
+
+template <class T, class E>
+std::size_t count_values(const Result<T, E>* first, std::size_t n) noexcept {
+	if constexpr(detail::has_status_layout_v<T, E>) {
+		return detail::count_flags(detail::status_kernel(), detail::result_bytes(first), n, detail::status_layout<T, E>());
+	} else {
+		std::size_t count = 0;
+		for(std::size_t i = 0; i < n; ++i) {
+			count += first[i].has_value();
+		}
+		return count;
+	}
+}
+
+template <
+	class Range,
+	std::enable_if_t<
+		detail::is_contiguous_result_range_v<Range>,
+		bool
+	> = false
+>
+std::size_t count_values(const Range& range) noexcept {
+	return count_values(std::data(range), std::size(range));
+}
+
+template <class T, class E>
+std::size_t count_errors(const Result<T, E>* first, std::size_t n) noexcept {
+	return n - count_values(first, n);
+}
+
+template <
+	class Range,
+	std::enable_if_t<
+		detail::is_contiguous_result_range_v<Range>,
+		bool
+	> = false
+>
+std::size_t count_errors(const Range& range) noexcept {
+	return count_errors(std::data(range), std::size(range));
+}
+
+template <class T, class E>
+std::size_t find_error(const Result<T, E>* first, std::size_t n) noexcept {
+	if constexpr(detail::has_status_layout_v<T, E>) {
+		return detail::find_clear_flag(detail::status_kernel(), detail::result_bytes(first), n, detail::status_layout<T, E>());
+	} else {
+		for(std::size_t i = 0; i < n; ++i) {
+			if(!first[i].has_value()) {
+				return i;
+			}
+		}
+		return n;
+	}
+}
+
+template <
+	class Range,
+	std::enable_if_t<
+		detail::is_contiguous_result_range_v<Range>,
+		bool
+	> = false
+>
+std::size_t find_error(const Range& range) noexcept {
+	return find_error(std::data(range), std::size(range));
+}
+
+template <class T, class E>
+void status_bitmap(const Result<T, E>* first, std::size_t n, std::uint64_t* words) noexcept {
+	if constexpr(detail::has_status_layout_v<T, E>) {
+		detail::flag_bitmap(detail::status_kernel(), detail::result_bytes(first), n, detail::status_layout<T, E>(), words);
+	} else {
+		detail::BitAppender out(words);
+		for(std::size_t i = 0; i < n; ++i) {
+			out.append(first[i].has_value(), 1u);
+		}
+		out.finish();
+	}
+}
+
+template <
+	class Range,
+	std::enable_if_t<
+		detail::is_contiguous_result_range_v<Range>,
+		bool
+	> = false
+>
+void status_bitmap(const Range& range, std::uint64_t* words) noexcept {
+	status_bitmap(std::data(range), std::size(range), words);
+}
+
+template <class T, class E, class ValueOut, class ErrorOut>
+std::pair<ValueOut, ErrorOut> partition_copy(const Result<T, E>* first, std::size_t n, ValueOut values, ErrorOut errors) {
+	static_assert(!detail::is_cv_void_v<T>, "'partition_copy()' requires a non-void 'T'.");
+	// A single pass: building a bitmap first and copying the runs it
+	// describes measured slower, as the copies dominate.
+	for(std::size_t i = 0; i < n; ++i) {
+		if(first[i].has_value()) {
+			*values++ = *first[i];
+		} else {
+			*errors++ = first[i].error();
+		}
+	}
+	return std::pair<ValueOut, ErrorOut>(std::move(values), std::move(errors));
+}
+
+template <
+	class Range,
+	class ValueOut,
+	class ErrorOut,
+	std::enable_if_t<
+		detail::is_contiguous_result_range_v<Range>,
+		bool
+	> = false
+>
+std::pair<ValueOut, ErrorOut> partition_copy(const Range& range, ValueOut values, ErrorOut errors) {
+	return partition_copy(std::data(range), std::size(range), std::move(values), std::move(errors));
+}
+
+} /* inline namespace result */
+
+} /* namespace tim */
+
+#endif /* TIM_RESULT_SCAN_HPP */
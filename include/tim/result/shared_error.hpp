@@ -0,0 +1,173 @@
+#ifndef TIM_RESULT_SHARED_ERROR_HPP
+#define TIM_RESULT_SHARED_ERROR_HPP
+
+#include "tim/result/Result.hpp"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <typeinfo>
+
+// 'BadResultAccess<void, true>': the exception that 'value()' throws for
+// errors that opt in with 'traits::bad_result_access_traits<E>::shared'.
+//
+// Kept out of Result.hpp so that every user of 'Result' does not pay for
+// including '<string>', '<atomic>' and '<typeinfo>'.  Include it wherever
+// 'value()' may be called on a 'Result' holding such an error; under
+// 'TIM_RESULT_ACCESS_THROW', the call does not compile without it.
+
+namespace tim {
+
+inline namespace result {
+
+namespace detail {
+
+template <class E, class = void>
+struct has_bad_result_access_what: std::false_type {};
+
+template <class E>
+struct has_bad_result_access_what<
+	E,
+	std::void_t<decltype(std::string(traits::bad_result_access_traits<E>::what(std::declval<const E&>())))>
+>: std::true_type {};
+
+template <class E, class = void>
+struct bad_result_access_allocator {
+	using type = std::allocator<E>;
+};
+
+template <class E>
+struct bad_result_access_allocator<
+	E,
+	std::void_t<typename traits::bad_result_access_traits<E>::allocator_type>
+> {
+	using type = typename traits::bad_result_access_traits<E>::allocator_type;
+};
+
+// The error shared by the copies of a 'BadResultAccess<void, true>', and the
+// description of it that 'what()' builds on first use.
+class SharedError {
+public:
+	SharedError() = default;
+	SharedError(const SharedError&) = delete;
+	SharedError& operator=(const SharedError&) = delete;
+
+	virtual ~SharedError() {
+		delete what_.load(std::memory_order_relaxed);
+	}
+
+	virtual const void* error() const noexcept = 0;
+	virtual const std::type_info& type() const noexcept = 0;
+
+	const char* what() const noexcept {
+		const std::string* what = what_.load(std::memory_order_acquire);
+		if(!what) {
+			const std::string* described = describe();
+			if(!described) {
+				return "bad result access";
+			}
+			if(what_.compare_exchange_strong(what, described, std::memory_order_acq_rel)) {
+				what = described;
+			} else {
+				delete described;
+			}
+		}
+		return what->c_str();
+	}
+
+private:
+	// A new description of the error, or null if there is none or building
+	// it failed.
+	virtual const std::string* describe() const noexcept = 0;
+
+	mutable std::atomic<const std::string*> what_{nullptr};
+};
+
+template <class E>
+class SharedErrorFor final: public SharedError {
+public:
+	template <class Err>
+	explicit SharedErrorFor(Err&& err):
+		error_(std::forward<Err>(err))
+	{
+
+	}
+
+	const void* error() const noexcept override {
+		return std::addressof(error_);
+	}
+
+	const std::type_info& type() const noexcept override {
+		return typeid(E);
+	}
+
+private:
+	const std::string* describe() const noexcept override {
+		if constexpr(has_bad_result_access_what<E>::value) {
+#if TIM_RESULT_HAS_EXCEPTIONS
+			try {
+				return new std::string(traits::bad_result_access_traits<E>::what(error_));
+			} catch(...) {
+				return nullptr;
+			}
+#else
+			return new std::string(traits::bad_result_access_traits<E>::what(error_));
+#endif
+		} else {
+			return nullptr;
+		}
+	}
+
+	E error_;
+};
+
+} /* namespace detail */
+
+// Thrown in place of 'BadResultAccess<E, true>' for errors that opt in with
+// 'traits::bad_result_access_traits<E>::shared'.  Copying it does not copy the
+// error; 'error<E>()' gives access to it if 'E' is its type.
+template <>
+class BadResultAccess<void, true>: public BadResultAccess<void, false> {
+public:
+	template <
+		class Err,
+		std::enable_if_t<
+			!std::is_same_v<std::decay_t<Err>, BadResultAccess>
+			&& std::is_constructible_v<std::decay_t<Err>, Err&&>,
+			bool
+		> = false
+	>
+	explicit BadResultAccess(Err&& err):
+		error_(std::allocate_shared<detail::SharedErrorFor<std::decay_t<Err>>>(
+			typename detail::bad_result_access_allocator<std::decay_t<Err>>::type(),
+			std::forward<Err>(err)
+		))
+	{
+
+	}
+
+	const char* what() const noexcept override {
+		return error_->what();
+	}
+
+	template <class E>
+	const E* error() const noexcept {
+		if(error_->type() != typeid(E)) {
+			return nullptr;
+		}
+		return static_cast<const E*>(error_->error());
+	}
+
+	const std::type_info& error_type() const noexcept {
+		return error_->type();
+	}
+
+private:
+	std::shared_ptr<const detail::SharedError> error_;
+};
+
+} /* inline namespace result */
+
+} /* namespace tim */
+
+#endif /* TIM_RESULT_SHARED_ERROR_HPP */
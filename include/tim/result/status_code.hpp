@@ -0,0 +1,321 @@
+#ifndef TIM_RESULT_STATUS_CODE_HPP
+#define TIM_RESULT_STATUS_CODE_HPP
+
+#include "tim/result/Result.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+// Compact error codes.
+//
+// 'status_code' is a 'std::error_code' packed into 4 bytes: a 24-bit signed
+// value and an 8-bit index into a global table of 'std::error_category's.
+// The table holds up to 255 categories; 'std::system_category()' and
+// 'std::generic_category()' come first ('status_code::system_category' and
+// 'status_code::generic_category'), and any other category is added the first
+// time a code of it is converted, or by 'status_code::register_category()'.
+// Categories are never removed.
+//
+// A 'status_code' converts implicitly to and from 'std::error_code', and from
+// error code enumerations and 'std::errc'.  Converting throws
+// 'std::out_of_range' if the value does not fit in 24 bits and
+// 'std::length_error' if the table is full.
+//
+// Category index 255 is never used, and provides a niche (see
+// 'traits::niche_traits'), so that
+//
+//   sizeof(tim::Result<std::uint32_t, tim::status_code>) == 8
+//   sizeof(tim::Result<std::uint16_t, tim::status_code>) == 4
+//   sizeof(tim::Result<void, tim::status_code>) == 4
+//
+// against 24 bytes each with 'std::error_code' on 64-bit targets.  All of
+// them are trivially copyable, and so are returned in registers.
+
+namespace tim {
+
+inline namespace result {
+
+// The index of a category in the table of 'status_code' categories.
+struct status_category {
+	std::uint8_t index;
+
+	friend constexpr bool operator==(status_category lhs, status_category rhs) noexcept {
+		return lhs.index == rhs.index;
+	}
+
+	friend constexpr bool operator!=(status_category lhs, status_category rhs) noexcept {
+		return lhs.index != rhs.index;
+	}
+};
+
+namespace detail {
+
+class StatusCategoryTable {
+public:
+	static constexpr std::size_t capacity = 255u;
+
+	static StatusCategoryTable& get() noexcept {
+		// Never destroyed: codes may be converted during static destruction.
+		static StatusCategoryTable* table = new StatusCategoryTable();
+		return *table;
+	}
+
+	const std::error_category& at(std::uint8_t index) const noexcept {
+		return *entries_[index].load(std::memory_order_acquire);
+	}
+
+	std::uint8_t index_of(const std::error_category& category) {
+		const int found = find(category);
+		if(found >= 0) {
+			return static_cast<std::uint8_t>(found);
+		}
+		std::lock_guard<std::mutex> lock(mutex_);
+		const int again = find(category);
+		if(again >= 0) {
+			return static_cast<std::uint8_t>(again);
+		}
+		const std::size_t size = size_.load(std::memory_order_relaxed);
+		if(size == capacity) {
+#if TIM_RESULT_HAS_EXCEPTIONS
+			throw std::length_error("tim::status_code: too many error categories");
+#else
+			std::abort();
+#endif
+		}
+		entries_[size].store(&category, std::memory_order_relaxed);
+		size_.store(size + 1u, std::memory_order_release);
+		return static_cast<std::uint8_t>(size);
+	}
+
+	StatusCategoryTable(const StatusCategoryTable&) = delete;
+	StatusCategoryTable& operator=(const StatusCategoryTable&) = delete;
+
+private:
+	StatusCategoryTable() noexcept {
+		entries_[0].store(&std::system_category(), std::memory_order_relaxed);
+		entries_[1].store(&std::generic_category(), std::memory_order_relaxed);
+		size_.store(2u, std::memory_order_release);
+	}
+
+	int find(const std::error_category& category) const noexcept {
+		const std::size_t size = size_.load(std::memory_order_acquire);
+		for(std::size_t i = 0u; i < size; ++i) {
+			if(*entries_[i].load(std::memory_order_relaxed) == category) {
+				return static_cast<int>(i);
+			}
+		}
+		return -1;
+	}
+
+	std::mutex mutex_;
+	std::atomic<const std::error_category*> entries_[capacity] = {};
+	std::atomic<std::size_t> size_{0u};
+};
+
+} /* namespace detail */
+
+class status_code {
+public:
+	static constexpr int min_value = -(1 << 23);
+	static constexpr int max_value = (1 << 23) - 1;
+
+	static constexpr status_category system_category{0u};
+	static constexpr status_category generic_category{1u};
+
+	// The index of 'category', adding it to the table if it is not there.
+	static status_category register_category(const std::error_category& category) {
+		return status_category{detail::StatusCategoryTable::get().index_of(category)};
+	}
+
+	// A value of 0 in the system category: no error.
+	constexpr status_code() noexcept = default;
+
+	// 'value' must be in ['min_value', 'max_value'] and 'category' must have
+	// come from 'register_category()' (or be one of the two above).
+	constexpr status_code(int value, status_category category) noexcept:
+		bits_((static_cast<std::uint32_t>(category.index) << 24u) | (static_cast<std::uint32_t>(value) & value_mask))
+	{
+
+	}
+
+	status_code(int value, const std::error_category& category):
+		status_code(checked(value), register_category(category))
+	{
+
+	}
+
+	status_code(const std::error_code& code):
+		status_code(code.value(), code.category())
+	{
+
+	}
+
+	template <
+		class ErrorCodeEnum,
+		std::enable_if_t<std::is_error_code_enum_v<ErrorCodeEnum>, bool> = false
+	>
+	status_code(ErrorCodeEnum e):
+		status_code(std::error_code(make_error_code(e)))
+	{
+
+	}
+
+	constexpr status_code(std::errc e) noexcept:
+		status_code(static_cast<int>(e), generic_category)
+	{
+
+	}
+
+	constexpr int value() const noexcept {
+		// Sign-extends the low 24 bits.
+		return static_cast<int>((bits_ & value_mask) ^ sign_bit) - static_cast<int>(sign_bit);
+	}
+
+	constexpr status_category category_index() const noexcept {
+		return status_category{static_cast<std::uint8_t>(bits_ >> 24u)};
+	}
+
+	const std::error_category& category() const noexcept {
+		return detail::StatusCategoryTable::get().at(category_index().index);
+	}
+
+	std::string message() const {
+		return category().message(value());
+	}
+
+	std::error_code to_error_code() const noexcept {
+		return std::error_code(value(), category());
+	}
+
+	operator std::error_code() const noexcept {
+		return to_error_code();
+	}
+
+	explicit constexpr operator bool() const noexcept {
+		return (bits_ & value_mask) != 0u;
+	}
+
+	friend constexpr bool operator==(status_code lhs, status_code rhs) noexcept {
+		return lhs.bits_ == rhs.bits_;
+	}
+
+	friend constexpr bool operator!=(status_code lhs, status_code rhs) noexcept {
+		return lhs.bits_ != rhs.bits_;
+	}
+
+	friend bool operator==(status_code lhs, const std::error_code& rhs) noexcept {
+		return lhs.to_error_code() == rhs;
+	}
+
+	friend bool operator==(const std::error_code& lhs, status_code rhs) noexcept {
+		return lhs == rhs.to_error_code();
+	}
+
+	friend bool operator!=(status_code lhs, const std::error_code& rhs) noexcept {
+		return !(lhs == rhs);
+	}
+
+	friend bool operator!=(const std::error_code& lhs, status_code rhs) noexcept {
+		return !(lhs == rhs);
+	}
+
+	friend bool operator==(status_code lhs, const std::error_condition& rhs) noexcept {
+		return lhs.to_error_code() == rhs;
+	}
+
+	friend bool operator==(const std::error_condition& lhs, status_code rhs) noexcept {
+		return lhs == rhs.to_error_code();
+	}
+
+	friend bool operator!=(status_code lhs, const std::error_condition& rhs) noexcept {
+		return !(lhs == rhs);
+	}
+
+	friend bool operator!=(const std::error_condition& lhs, status_code rhs) noexcept {
+		return !(lhs == rhs);
+	}
+
+	// Error code enumerations compare as 'std::error_code's, and error
+	// condition enumerations (including 'std::errc') as 'std::error_condition's.
+	template <
+		class Enum,
+		std::enable_if_t<std::is_error_code_enum_v<Enum> || std::is_error_condition_enum_v<Enum>, bool> = false
+	>
+	friend bool operator==(status_code lhs, Enum rhs) noexcept {
+		if constexpr(std::is_error_code_enum_v<Enum>) {
+			return lhs.to_error_code() == std::error_code(rhs);
+		} else {
+			return lhs.to_error_code() == std::error_condition(rhs);
+		}
+	}
+
+	template <
+		class Enum,
+		std::enable_if_t<std::is_error_code_enum_v<Enum> || std::is_error_condition_enum_v<Enum>, bool> = false
+	>
+	friend bool operator==(Enum lhs, status_code rhs) noexcept {
+		return rhs == lhs;
+	}
+
+	template <
+		class Enum,
+		std::enable_if_t<std::is_error_code_enum_v<Enum> || std::is_error_condition_enum_v<Enum>, bool> = false
+	>
+	friend bool operator!=(status_code lhs, Enum rhs) noexcept {
+		return !(lhs == rhs);
+	}
+
+	template <
+		class Enum,
+		std::enable_if_t<std::is_error_code_enum_v<Enum> || std::is_error_condition_enum_v<Enum>, bool> = false
+	>
+	friend bool operator!=(Enum lhs, status_code rhs) noexcept {
+		return !(rhs == lhs);
+	}
+
+private:
+	static constexpr std::uint32_t value_mask = 0x00FF'FFFFu;
+	static constexpr std::uint32_t sign_bit = 0x0080'0000u;
+
+	static int checked(int value) {
+		if(value < min_value || value > max_value) {
+#if TIM_RESULT_HAS_EXCEPTIONS
+			throw std::out_of_range("tim::status_code: value does not fit in 24 bits");
+#else
+			std::abort();
+#endif
+		}
+		return value;
+	}
+
+	std::uint32_t bits_ = 0u;
+};
+
+namespace traits {
+
+// The category index is never 255.  It is the most significant byte.
+template <>
+struct niche_traits<status_code> {
+	static_assert(sizeof(status_code) == 4u);
+
+	static constexpr bool has_niche = true;
+	static constexpr std::size_t offset = detail::is_little_endian ? 3u : 0u;
+	static constexpr std::size_t size = 1u;
+
+	static bool is_niche(const unsigned char* niche) noexcept { return *niche == 0xFFu; }
+	static void set_niche(unsigned char* niche) noexcept { *niche = 0xFFu; }
+};
+
+} /* namespace traits */
+
+} /* inline namespace result */
+
+} /* namespace tim */
+
+#endif /* TIM_RESULT_STATUS_CODE_HPP */
@@ -0,0 +1,1186 @@
+#ifndef TIM_RESULT_TASK_HPP
+#define TIM_RESULT_TASK_HPP
+
+#include "tim/result/coroutine.hpp"
+
+// Asynchronous 'Result' coroutines.
+//
+// 'Task<T, E>' is a lazily started coroutine that finishes with a
+// 'Result<T, E>'.  Inside a task, 'co_await' accepts:
+//
+//  - a 'Result' or 'Error', with the same short-circuiting as 'Result'
+//    coroutines (see coroutine.hpp);
+//  - another task, which runs to completion and yields its value, or finishes
+//    the awaiting task with its error;
+//  - 'pool.schedule()', which moves the task onto a 'ThreadPool' worker;
+//  - 'when_all(tasks)' / 'when_any(tasks)', which run tasks concurrently on
+//    the awaiting task's pool;
+//  - 'check_cancellation()', which ends the task early if it was cancelled.
+//
+// Failures never throw.  Exceptions that escape a task body are captured and
+// rethrown by whatever awaits it.
+//
+// Cancellation is cooperative.  A cancelled task stops at its next
+// cancellation point (awaiting a task, 'schedule()' or 'check_cancellation()')
+// and produces no result; it is only ever cancelled by an enclosing 'when_all'
+// or 'when_any', which discard its result anyway.
+//
+// 'sync_wait(task)' and 'sync_wait(pool, task)' block the calling thread until
+// a task finishes and return its 'Result'.  Do not call them from a pool
+// worker.
+
+#if TIM_RESULT_HAS_COROUTINES
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#ifndef TIM_RESULT_TASK_FRAME_CACHE_SIZE
+# define TIM_RESULT_TASK_FRAME_CACHE_SIZE 64
+#endif
+
+namespace tim {
+
+inline namespace result {
+
+template <class T, class E>
+class Task;
+
+class ThreadPool;
+
+namespace detail {
+
+// Per-thread free lists of task frames, bucketed by size.  Up to
+// 'TIM_RESULT_TASK_FRAME_CACHE_SIZE' frames are kept per bucket; larger frames
+// and overflow go straight to 'operator new' / 'operator delete'.  A frame may
+// be released on a different thread than the one that allocated it.
+class TaskFrameCache {
+public:
+	static constexpr std::size_t granularity = 64;
+	static constexpr std::size_t size_classes = 16;
+	static constexpr std::size_t max_cached = TIM_RESULT_TASK_FRAME_CACHE_SIZE;
+
+	static void* allocate(std::size_t size) {
+		std::size_t k = size_class(size);
+		if(k >= size_classes) {
+			return ::operator new(size);
+		}
+		auto& cache = local();
+		if(Node* node = cache.free_[k]) {
+			cache.free_[k] = node->next;
+			--cache.count_[k];
+			return node;
+		}
+		return ::operator new(class_size(k));
+	}
+
+	static void deallocate(void* p, std::size_t size) noexcept {
+		std::size_t k = size_class(size);
+		if(k >= size_classes) {
+			::operator delete(p, size);
+			return;
+		}
+		auto& cache = local();
+		if(cache.count_[k] == max_cached) {
+			::operator delete(p, class_size(k));
+			return;
+		}
+		cache.free_[k] = ::new(p) Node{cache.free_[k]};
+		++cache.count_[k];
+	}
+
+	TaskFrameCache(const TaskFrameCache&) = delete;
+	TaskFrameCache& operator=(const TaskFrameCache&) = delete;
+
+	~TaskFrameCache() {
+		for(std::size_t k = 0; k < size_classes; ++k) {
+			while(Node* node = free_[k]) {
+				free_[k] = node->next;
+				::operator delete(node, class_size(k));
+			}
+		}
+	}
+
+private:
+	struct Node {
+		Node* next;
+	};
+
+	TaskFrameCache() = default;
+
+	static constexpr std::size_t size_class(std::size_t size) noexcept {
+		return (size - 1u) / granularity;
+	}
+
+	static constexpr std::size_t class_size(std::size_t k) noexcept {
+		return (k + 1u) * granularity;
+	}
+
+	static TaskFrameCache& local() noexcept {
+		thread_local TaskFrameCache cache;
+		return cache;
+	}
+
+	Node* free_[size_classes] = {};
+	std::size_t count_[size_classes] = {};
+};
+
+// A cancellation flag that is also set whenever any of its ancestors is.
+class CancellationState {
+public:
+	CancellationState() = default;
+
+	explicit CancellationState(const CancellationState* parent) noexcept:
+		parent_(parent)
+	{
+
+	}
+
+	CancellationState(const CancellationState&) = delete;
+	CancellationState& operator=(const CancellationState&) = delete;
+
+	void request() noexcept {
+		requested_.store(true, std::memory_order_release);
+	}
+
+	bool requested() const noexcept {
+		for(auto* state = this; state; state = state->parent_) {
+			if(state->requested_.load(std::memory_order_acquire)) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+private:
+	const CancellationState* parent_ = nullptr;
+	std::atomic<bool> requested_{false};
+};
+
+// Awaitables deriving from this pass through 'TaskPromise::await_transform()'
+// unchanged.  They are copied into the frame, so they should be cheap to copy.
+struct TaskAwaitableTag {};
+
+template <class A>
+inline constexpr bool is_task_awaitable_v = std::is_base_of_v<TaskAwaitableTag, std::remove_cv_t<std::remove_reference_t<A>>>;
+
+enum class TaskState: unsigned char {
+	Running,
+	Returned,
+	Threw,
+	Cancelled
+};
+
+// The parts of a task's promise that do not depend on its 'Result' type.
+//
+// Whoever starts a task registers a completion function with
+// 'on_complete()'.  It is called once the task has returned, thrown or been
+// cancelled, while the task is suspended, and returns the coroutine to resume
+// next (usually whoever awaited the task).
+class TaskPromiseBase {
+public:
+	using completion_function = std::coroutine_handle<> (*)(void*) noexcept;
+
+	class FinalAwaiter {
+	public:
+		bool await_ready() const noexcept {
+			return false;
+		}
+
+		template <class P>
+		std::coroutine_handle<> await_suspend(std::coroutine_handle<P> h) noexcept {
+			return h.promise().complete();
+		}
+
+		void await_resume() const noexcept {
+
+		}
+	};
+
+	std::suspend_always initial_suspend() const noexcept {
+		return {};
+	}
+
+	FinalAwaiter final_suspend() const noexcept {
+		return {};
+	}
+
+	void unhandled_exception() noexcept {
+#if defined(__cpp_exceptions)
+		exception_ = std::current_exception();
+		state_ = TaskState::Threw;
+#else
+		std::terminate();
+#endif
+	}
+
+	TaskState state() const noexcept {
+		return state_;
+	}
+
+	void rethrow_if_exception() const {
+#if defined(__cpp_exceptions)
+		if(state_ == TaskState::Threw) {
+			std::rethrow_exception(exception_);
+		}
+#endif
+	}
+
+#if defined(__cpp_exceptions)
+	std::exception_ptr exception() const noexcept {
+		return exception_;
+	}
+#endif
+
+	void on_complete(completion_function f, void* context) noexcept {
+		on_complete_ = f;
+		context_ = context;
+	}
+
+	ThreadPool* pool() const noexcept {
+		return pool_;
+	}
+
+	void set_pool(ThreadPool* pool) noexcept {
+		pool_ = pool;
+	}
+
+	const CancellationState* cancellation() const noexcept {
+		return cancellation_;
+	}
+
+	void set_cancellation(const CancellationState* cancellation) noexcept {
+		cancellation_ = cancellation;
+	}
+
+	// Runs on the same pool, and is cancelled along with, 'parent'.
+	void inherit(const TaskPromiseBase& parent) noexcept {
+		pool_ = parent.pool_;
+		cancellation_ = parent.cancellation_;
+	}
+
+	bool cancellation_requested() const noexcept {
+		return cancellation_ && cancellation_->requested();
+	}
+
+	std::coroutine_handle<> complete() noexcept {
+		if(on_complete_) {
+			return on_complete_(context_);
+		}
+		return std::noop_coroutine();
+	}
+
+	std::coroutine_handle<> cancel() noexcept {
+		state_ = TaskState::Cancelled;
+		return complete();
+	}
+
+	static void* operator new(std::size_t size) {
+		return TaskFrameCache::allocate(size);
+	}
+
+	static void operator delete(void* p, std::size_t size) noexcept {
+		TaskFrameCache::deallocate(p, size);
+	}
+
+protected:
+	TaskState state_ = TaskState::Running;
+
+private:
+	completion_function on_complete_ = nullptr;
+	void* context_ = nullptr;
+	ThreadPool* pool_ = nullptr;
+	const CancellationState* cancellation_ = nullptr;
+#if defined(__cpp_exceptions)
+	std::exception_ptr exception_;
+#endif
+};
+
+class CancellationCheck: public TaskAwaitableTag {
+public:
+	bool await_ready() const noexcept {
+		return false;
+	}
+
+	template <class P>
+	std::coroutine_handle<> await_suspend(std::coroutine_handle<P> h) noexcept {
+		if(h.promise().cancellation_requested()) {
+			return h.promise().cancel();
+		}
+		return h;
+	}
+
+	void await_resume() const noexcept {
+
+	}
+};
+
+} /* namespace detail */
+
+// A work-stealing pool of threads that resume coroutines.
+//
+// Every worker owns a queue.  Coroutines posted from a worker go to the back
+// of its own queue and others are spread over the queues round-robin.  A
+// worker takes from the front of its own queue, so a task that reschedules
+// itself lets the rest of the queue run first, and an idle worker steals from
+// the back of the others' queues.
+class ThreadPool {
+public:
+	class ScheduleAwaiter: public detail::TaskAwaitableTag {
+	public:
+		explicit ScheduleAwaiter(ThreadPool& pool) noexcept:
+			pool_(&pool)
+		{
+
+		}
+
+		bool await_ready() const noexcept {
+			return false;
+		}
+
+		template <class P>
+		std::coroutine_handle<> await_suspend(std::coroutine_handle<P> h) {
+			auto& promise = h.promise();
+			if(promise.cancellation_requested()) {
+				return promise.cancel();
+			}
+			promise.set_pool(pool_);
+			pool_->post(h);
+			return std::noop_coroutine();
+		}
+
+		void await_resume() const noexcept {
+
+		}
+
+	private:
+		ThreadPool* pool_;
+	};
+
+	explicit ThreadPool(std::size_t threads = std::thread::hardware_concurrency()) {
+		threads = threads ? threads : 1u;
+		workers_.reserve(threads);
+		for(std::size_t i = 0; i < threads; ++i) {
+			workers_.push_back(std::make_unique<Worker>());
+		}
+		threads_.reserve(threads);
+		for(std::size_t i = 0; i < threads; ++i) {
+			threads_.emplace_back([this, i] { run(i); });
+		}
+	}
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	// Waits for all posted coroutines to be resumed.
+	~ThreadPool() {
+		{
+			std::lock_guard<std::mutex> lock(sleep_mutex_);
+			stop_ = true;
+		}
+		wake_.notify_all();
+		for(auto& thread: threads_) {
+			thread.join();
+		}
+	}
+
+	std::size_t size() const noexcept {
+		return workers_.size();
+	}
+
+	// Queues 'h' to be resumed on one of the pool's threads.
+	void post(std::coroutine_handle<> h) {
+		auto& context = current();
+		std::size_t index = context.pool == this
+			? context.index
+			: next_.fetch_add(1u, std::memory_order_relaxed) % workers_.size();
+		{
+			std::lock_guard<std::mutex> lock(workers_[index]->mutex);
+			workers_[index]->queue.push_back(h);
+		}
+		bool wake = false;
+		{
+			std::lock_guard<std::mutex> lock(sleep_mutex_);
+			pending_.fetch_add(1u, std::memory_order_relaxed);
+			wake = sleeping_ > 0u;
+		}
+		if(wake) {
+			wake_.notify_one();
+		}
+	}
+
+	// 'co_await pool.schedule()' resumes the awaiting task on the pool.
+	ScheduleAwaiter schedule() noexcept {
+		return ScheduleAwaiter(*this);
+	}
+
+private:
+	struct Worker {
+		std::mutex mutex;
+		std::deque<std::coroutine_handle<>> queue;
+	};
+
+	struct WorkerContext {
+		ThreadPool* pool = nullptr;
+		std::size_t index = 0;
+	};
+
+	static WorkerContext& current() noexcept {
+		thread_local WorkerContext context;
+		return context;
+	}
+
+	bool pop(std::size_t index, std::coroutine_handle<>& h) {
+		auto& worker = *workers_[index];
+		std::lock_guard<std::mutex> lock(worker.mutex);
+		if(worker.queue.empty()) {
+			return false;
+		}
+		h = worker.queue.front();
+		worker.queue.pop_front();
+		return true;
+	}
+
+	bool steal(std::size_t index, std::coroutine_handle<>& h) {
+		for(std::size_t i = 1; i < workers_.size(); ++i) {
+			auto& victim = *workers_[(index + i) % workers_.size()];
+			std::lock_guard<std::mutex> lock(victim.mutex);
+			if(!victim.queue.empty()) {
+				h = victim.queue.back();
+				victim.queue.pop_back();
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void run(std::size_t index) {
+		current() = WorkerContext{this, index};
+		for(;;) {
+			std::coroutine_handle<> h;
+			if(pop(index, h) || steal(index, h)) {
+				pending_.fetch_sub(1u, std::memory_order_relaxed);
+				h.resume();
+				continue;
+			}
+			std::unique_lock<std::mutex> lock(sleep_mutex_);
+			if(pending_.load(std::memory_order_relaxed) > 0u) {
+				// Posted, but not yet taken by whoever took it.
+				continue;
+			}
+			if(stop_) {
+				return;
+			}
+			++sleeping_;
+			wake_.wait(lock, [this] {
+				return stop_ || pending_.load(std::memory_order_relaxed) > 0u;
+			});
+			--sleeping_;
+		}
+	}
+
+	std::vector<std::unique_ptr<Worker>> workers_;
+	std::vector<std::thread> threads_;
+	std::atomic<std::size_t> next_{0};
+	std::atomic<std::size_t> pending_{0};
+	std::mutex sleep_mutex_;
+	std::condition_variable wake_;
+	std::size_t sleeping_ = 0;
+	bool stop_ = false;
+};
+
+namespace detail {
+
+template <class T, class E>
+class TaskPromise;
+
+struct TaskAccess {
+	template <class T, class E>
+	static std::coroutine_handle<TaskPromise<T, E>> handle(Task<T, E>& task) noexcept {
+		return task.handle_;
+	}
+};
+
+template <class R, class Promise>
+class TaskResultAwaiter {
+public:
+	explicit TaskResultAwaiter(R&& r) noexcept:
+		result_(std::forward<R>(r))
+	{
+
+	}
+
+	bool await_ready() const noexcept {
+		return result_.has_value();
+	}
+
+	std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> h) noexcept {
+		return h.promise().fail(detail::propagate_error(std::forward<R>(result_)));
+	}
+
+	decltype(auto) await_resume() {
+		return detail::try_value(std::forward<R>(result_));
+	}
+
+private:
+	R&& result_;
+};
+
+template <class G, class Promise>
+class TaskErrorAwaiter {
+public:
+	explicit TaskErrorAwaiter(G&& e) noexcept:
+		error_(std::forward<G>(e))
+	{
+
+	}
+
+	bool await_ready() const noexcept {
+		return false;
+	}
+
+	std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> h) noexcept {
+		using reference = decltype(std::forward<G>(error_).value());
+		return h.promise().fail(ErrorReference<reference>{std::forward<G>(error_).value()});
+	}
+
+	[[noreturn]] void await_resume() noexcept {
+		std::terminate();
+	}
+
+private:
+	G&& error_;
+};
+
+// Runs a child task to completion, then resumes the awaiting task with its
+// value or finishes the awaiting task with its error.
+template <class U, class G, class Promise>
+class TaskAwaiter {
+public:
+	explicit TaskAwaiter(std::coroutine_handle<TaskPromise<U, G>> child) noexcept:
+		child_(child)
+	{
+
+	}
+
+	bool await_ready() const noexcept {
+		return false;
+	}
+
+	std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> parent) noexcept {
+		if(parent.promise().cancellation_requested()) {
+			return parent.promise().cancel();
+		}
+		parent_ = parent;
+		child_.promise().inherit(parent.promise());
+		child_.promise().on_complete(&TaskAwaiter::child_done, this);
+		return child_;
+	}
+
+	std::conditional_t<is_cv_void_v<U>, void, U> await_resume() {
+		auto& child = child_.promise();
+		child.rethrow_if_exception();
+		if constexpr(!is_cv_void_v<U>) {
+			return *std::move(child.result());
+		}
+	}
+
+private:
+	static std::coroutine_handle<> child_done(void* self) noexcept {
+		auto& awaiter = *static_cast<TaskAwaiter*>(self);
+		auto& child = awaiter.child_.promise();
+		switch(child.state()) {
+		case TaskState::Returned:
+			if(child.result().has_value()) {
+				return awaiter.parent_;
+			}
+			return awaiter.parent_.promise().fail(detail::propagate_error(std::move(child.result())));
+		case TaskState::Threw:
+			return awaiter.parent_;
+		default:
+			return awaiter.parent_.promise().cancel();
+		}
+	}
+
+	std::coroutine_handle<TaskPromise<U, G>> child_;
+	std::coroutine_handle<Promise> parent_;
+};
+
+template <class T, class E>
+class TaskPromise:
+	public TaskPromiseBase,
+	public ResultPromiseReturn<TaskPromise<T, E>, T, E>
+{
+public:
+	TaskPromise() noexcept {
+
+	}
+
+	TaskPromise(const TaskPromise&) = delete;
+	TaskPromise& operator=(const TaskPromise&) = delete;
+
+	~TaskPromise() {
+		if(state_ == TaskState::Returned) {
+			result_.~Result();
+		}
+	}
+
+	Task<T, E> get_return_object() noexcept {
+		return Task<T, E>(std::coroutine_handle<TaskPromise>::from_promise(*this));
+	}
+
+	template <
+		class R,
+		std::enable_if_t<
+			traits::is_result_v<std::remove_cv_t<std::remove_reference_t<R>>>,
+			bool
+		> = false
+	>
+	TaskResultAwaiter<R, TaskPromise> await_transform(R&& r) noexcept {
+		return TaskResultAwaiter<R, TaskPromise>(std::forward<R>(r));
+	}
+
+	template <
+		class G,
+		std::enable_if_t<
+			traits::is_error_v<std::remove_cv_t<std::remove_reference_t<G>>>,
+			bool
+		> = false
+	>
+	TaskErrorAwaiter<G, TaskPromise> await_transform(G&& e) noexcept {
+		return TaskErrorAwaiter<G, TaskPromise>(std::forward<G>(e));
+	}
+
+	template <class U, class G>
+	TaskAwaiter<U, G, TaskPromise> await_transform(Task<U, G>&& task) noexcept {
+		return TaskAwaiter<U, G, TaskPromise>(TaskAccess::handle(task));
+	}
+
+	template <
+		class A,
+		std::enable_if_t<
+			is_task_awaitable_v<A>,
+			bool
+		> = false
+	>
+	std::decay_t<A> await_transform(A&& a) noexcept {
+		return std::forward<A>(a);
+	}
+
+	// The 'Result' the task returned.  Only valid in the 'Returned' state.
+	Result<T, E>& result() noexcept {
+		return result_;
+	}
+
+	// Finishes the task with the error 'e'.
+	template <class Ref>
+	std::coroutine_handle<> fail(ErrorReference<Ref> e) noexcept {
+#if defined(__cpp_exceptions)
+		try {
+			emplace_result(std::move(e));
+		} catch(...) {
+			unhandled_exception();
+		}
+#else
+		emplace_result(std::move(e));
+#endif
+		return complete();
+	}
+
+	Result<T, E> take() {
+		rethrow_if_exception();
+		if(state_ != TaskState::Returned) {
+			// Only tasks run by 'when_all' or 'when_any' can be cancelled.
+			std::terminate();
+		}
+		return std::move(result_);
+	}
+
+private:
+	template <class, class, class, bool>
+	friend class ResultPromiseReturn;
+
+	template <class ... Args>
+	void emplace_result(Args&& ... args) {
+		::new(static_cast<void*>(std::addressof(result_))) Result<T, E>(std::forward<Args>(args)...);
+		state_ = TaskState::Returned;
+	}
+
+	union {
+		Result<T, E> result_;
+	};
+};
+
+} /* namespace detail */
+
+// A lazily started coroutine that produces a 'Result<T, E>'.  Run it by
+// awaiting it from another task, or with 'sync_wait()'.
+template <class T, class E>
+class [[nodiscard]] Task {
+public:
+	using promise_type = detail::TaskPromise<T, E>;
+	using value_type = T;
+	using error_type = E;
+	using result_type = Result<T, E>;
+
+	Task(Task&& other) noexcept:
+		handle_(std::exchange(other.handle_, nullptr))
+	{
+
+	}
+
+	Task& operator=(Task&& other) noexcept {
+		if(this != &other) {
+			destroy();
+			handle_ = std::exchange(other.handle_, nullptr);
+		}
+		return *this;
+	}
+
+	~Task() {
+		destroy();
+	}
+
+	bool valid() const noexcept {
+		return static_cast<bool>(handle_);
+	}
+
+private:
+	friend class detail::TaskPromise<T, E>;
+	friend struct detail::TaskAccess;
+
+	explicit Task(std::coroutine_handle<promise_type> h) noexcept:
+		handle_(h)
+	{
+
+	}
+
+	void destroy() noexcept {
+		if(handle_) {
+			handle_.destroy();
+		}
+	}
+
+	std::coroutine_handle<promise_type> handle_;
+};
+
+namespace detail {
+
+template <class T>
+using when_all_value_t = std::conditional_t<is_cv_void_v<T>, T, std::vector<T>>;
+
+// State shared by the tasks started by 'when_all' or 'when_any', kept in the
+// awaiting task's frame.
+template <class T, class E, class Derived, class Parent>
+class WhenStateBase {
+public:
+	using parent_promise_type = Parent;
+
+	explicit WhenStateBase(std::vector<Task<T, E>>& tasks):
+		tasks_(tasks),
+		branches_(tasks.size()),
+		remaining_(tasks.size() + 1u)
+	{
+
+	}
+
+	WhenStateBase(const WhenStateBase&) = delete;
+	WhenStateBase& operator=(const WhenStateBase&) = delete;
+
+	// Starts the tasks; the last of them to finish resumes 'parent'.
+	std::coroutine_handle<> start(std::coroutine_handle<Parent> parent) {
+		auto& promise = parent.promise();
+		if(promise.cancellation_requested()) {
+			return promise.cancel();
+		}
+		parent_ = parent;
+		cancellation_.emplace(promise.cancellation());
+		for(std::size_t i = 0; i < tasks_.size(); ++i) {
+			branches_[i] = Branch{static_cast<Derived*>(this), i};
+			auto child = TaskAccess::handle(tasks_[i]);
+			child.promise().set_pool(promise.pool());
+			child.promise().set_cancellation(&*cancellation_);
+			child.promise().on_complete(&WhenStateBase::branch_done, &branches_[i]);
+		}
+		for(auto& task: tasks_) {
+			if(ThreadPool* pool = promise.pool()) {
+				pool->post(TaskAccess::handle(task));
+			} else {
+				TaskAccess::handle(task).resume();
+			}
+		}
+		return finish_branch();
+	}
+
+protected:
+	// Claims the right to report the outcome; only the first caller gets it.
+	bool claim() noexcept {
+		return !claimed_.exchange(true, std::memory_order_acq_rel);
+	}
+
+	void cancel_branches() noexcept {
+		cancellation_->request();
+	}
+
+	void store_exception() noexcept {
+#if defined(__cpp_exceptions)
+		exception_ = std::current_exception();
+#endif
+	}
+
+	void rethrow_if_exception() const {
+#if defined(__cpp_exceptions)
+		if(exception_) {
+			std::rethrow_exception(exception_);
+		}
+#endif
+	}
+
+	bool failed_with_exception() const noexcept {
+#if defined(__cpp_exceptions)
+		return static_cast<bool>(exception_);
+#else
+		return false;
+#endif
+	}
+
+	std::vector<Task<T, E>>& tasks_;
+	std::optional<E> error_;
+#if defined(__cpp_exceptions)
+	std::exception_ptr exception_;
+#endif
+
+private:
+	struct Branch {
+		Derived* owner = nullptr;
+		std::size_t index = 0;
+	};
+
+	static std::coroutine_handle<> branch_done(void* p) noexcept {
+		auto& branch = *static_cast<Branch*>(p);
+		Derived& self = *branch.owner;
+		auto& child = TaskAccess::handle(self.tasks_[branch.index]).promise();
+#if defined(__cpp_exceptions)
+		try {
+#endif
+			switch(child.state()) {
+			case TaskState::Returned:
+				self.on_result(branch.index, child.result());
+				break;
+			case TaskState::Threw:
+#if defined(__cpp_exceptions)
+				if(self.claim()) {
+					self.exception_ = child.exception();
+					self.cancel_branches();
+				}
+#endif
+				break;
+			default:
+				self.cancelled_.store(true, std::memory_order_relaxed);
+				break;
+			}
+#if defined(__cpp_exceptions)
+		} catch(...) {
+			if(self.claim()) {
+				self.store_exception();
+				self.cancel_branches();
+			}
+		}
+#endif
+		return self.finish_branch();
+	}
+
+	std::coroutine_handle<> finish_branch() noexcept {
+		if(remaining_.fetch_sub(1u, std::memory_order_acq_rel) != 1u) {
+			return std::noop_coroutine();
+		}
+		auto& promise = parent_.promise();
+		if(error_) {
+			return promise.fail(ErrorReference<E&&>{std::move(*error_)});
+		}
+		if(!failed_with_exception() && !static_cast<Derived&>(*this).succeeded()
+				&& cancelled_.load(std::memory_order_relaxed)) {
+			return promise.cancel();
+		}
+		return parent_;
+	}
+
+	std::vector<Branch> branches_;
+	std::atomic<std::size_t> remaining_;
+	std::atomic<bool> claimed_{false};
+	std::atomic<bool> cancelled_{false};
+	std::optional<CancellationState> cancellation_;
+	std::coroutine_handle<Parent> parent_;
+};
+
+template <class T, class E>
+class WhenAllState:
+	public WhenStateBase<T, E, WhenAllState<T, E>, TaskPromise<when_all_value_t<T>, E>>
+{
+	using base_type = WhenStateBase<T, E, WhenAllState<T, E>, TaskPromise<when_all_value_t<T>, E>>;
+	using slot_type = std::conditional_t<is_cv_void_v<T>, bool, std::optional<T>>;
+
+public:
+	explicit WhenAllState(std::vector<Task<T, E>>& tasks):
+		base_type(tasks),
+		values_(tasks.size())
+	{
+
+	}
+
+	when_all_value_t<T> take() {
+		this->rethrow_if_exception();
+		if constexpr(!is_cv_void_v<T>) {
+			std::vector<T> values;
+			values.reserve(values_.size());
+			for(auto& value: values_) {
+				values.push_back(std::move(*value));
+			}
+			return values;
+		}
+	}
+
+private:
+	friend base_type;
+
+	void on_result(std::size_t index, Result<T, E>& r) {
+		if(r.has_value()) {
+			if constexpr(is_cv_void_v<T>) {
+				values_[index] = true;
+			} else {
+				values_[index].emplace(*std::move(r));
+			}
+		} else if(this->claim()) {
+			this->error_.emplace(std::move(r).error());
+			this->cancel_branches();
+		}
+	}
+
+	bool succeeded() const noexcept {
+		for(const auto& value: values_) {
+			if(!value) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	std::vector<slot_type> values_;
+};
+
+template <class T, class E>
+class WhenAnyState:
+	public WhenStateBase<T, E, WhenAnyState<T, E>, TaskPromise<T, E>>
+{
+	using base_type = WhenStateBase<T, E, WhenAnyState<T, E>, TaskPromise<T, E>>;
+	using slot_type = std::conditional_t<is_cv_void_v<T>, bool, std::optional<T>>;
+
+public:
+	using base_type::base_type;
+
+	std::conditional_t<is_cv_void_v<T>, void, T> take() {
+		this->rethrow_if_exception();
+		if(!succeeded()) {
+			// Unreachable: 'when_any' rejects an empty 'tasks', and otherwise
+			// the parent is resumed only with a value, an error or an exception.
+			std::terminate();
+		}
+		if constexpr(!is_cv_void_v<T>) {
+			return std::move(*value_);
+		}
+	}
+
+private:
+	friend base_type;
+
+	void on_result(std::size_t, Result<T, E>& r) {
+		if(r.has_value()) {
+			if(this->claim()) {
+				if constexpr(is_cv_void_v<T>) {
+					value_ = true;
+				} else {
+					value_.emplace(*std::move(r));
+				}
+				this->cancel_branches();
+			}
+		} else if(this->failures_.fetch_add(1u, std::memory_order_acq_rel) + 1u == this->tasks_.size()) {
+			// Every task failed; report the last error.
+			if(this->claim()) {
+				this->error_.emplace(std::move(r).error());
+			}
+		}
+	}
+
+	bool succeeded() const noexcept {
+		return static_cast<bool>(value_);
+	}
+
+	std::atomic<std::size_t> failures_{0};
+	slot_type value_{};
+};
+
+[[noreturn]] inline void reject_empty_when_any() {
+#if defined(__cpp_exceptions)
+	throw std::invalid_argument("tim::when_any: no tasks were given");
+#else
+	std::abort();
+#endif
+}
+
+template <class State>
+class WhenAwaiter: public TaskAwaitableTag {
+public:
+	explicit WhenAwaiter(State& state) noexcept:
+		state_(&state)
+	{
+
+	}
+
+	bool await_ready() const noexcept {
+		return false;
+	}
+
+	std::coroutine_handle<> await_suspend(std::coroutine_handle<typename State::parent_promise_type> parent) {
+		return state_->start(parent);
+	}
+
+	decltype(auto) await_resume() {
+		return state_->take();
+	}
+
+private:
+	State* state_;
+};
+
+struct SyncWaitState {
+	static std::coroutine_handle<> notify(void* p) noexcept {
+		auto& state = *static_cast<SyncWaitState*>(p);
+		std::lock_guard<std::mutex> lock(state.mutex);
+		state.done = true;
+		state.finished.notify_one();
+		return std::noop_coroutine();
+	}
+
+	void wait() {
+		std::unique_lock<std::mutex> lock(mutex);
+		finished.wait(lock, [this] { return done; });
+	}
+
+	std::mutex mutex;
+	std::condition_variable finished;
+	bool done = false;
+};
+
+template <class T, class E>
+Result<T, E> sync_wait(ThreadPool* pool, Task<T, E>& task) {
+	auto h = TaskAccess::handle(task);
+	SyncWaitState state;
+	h.promise().on_complete(&SyncWaitState::notify, &state);
+	if(pool) {
+		h.promise().set_pool(pool);
+		pool->post(h);
+	} else {
+		h.resume();
+	}
+	state.wait();
+	return h.promise().take();
+}
+
+} /* namespace detail */
+
+// 'co_await check_cancellation()' ends the awaiting task if it was cancelled.
+inline detail::CancellationCheck check_cancellation() noexcept {
+	return {};
+}
+
+// Runs 'tasks' concurrently on the awaiting task's pool (or one after another
+// if it has none) and yields their values in order.  The first task to fail
+// cancels the others and its error becomes the result.
+template <
+	class T,
+	class E,
+	std::enable_if_t<
+		!detail::is_cv_void_v<T>,
+		bool
+	> = false
+>
+Task<std::vector<T>, E> when_all(std::vector<Task<T, E>> tasks) {
+	detail::WhenAllState<T, E> state(tasks);
+	co_return co_await detail::WhenAwaiter(state);
+}
+
+template <
+	class T,
+	class E,
+	std::enable_if_t<
+		detail::is_cv_void_v<T>,
+		bool
+	> = false
+>
+Task<T, E> when_all(std::vector<Task<T, E>> tasks) {
+	detail::WhenAllState<T, E> state(tasks);
+	co_await detail::WhenAwaiter(state);
+}
+
+// Runs 'tasks' concurrently on the awaiting task's pool (or one after another
+// if it has none) and yields the value of the first to succeed, cancelling
+// the others.  If every task fails, the last error becomes the result.
+// An empty 'tasks' has no value or error to yield: the task throws
+// 'std::invalid_argument' (rethrown by whatever awaits it) instead.
+template <
+	class T,
+	class E,
+	std::enable_if_t<
+		!detail::is_cv_void_v<T>,
+		bool
+	> = false
+>
+Task<T, E> when_any(std::vector<Task<T, E>> tasks) {
+	if(tasks.empty()) {
+		detail::reject_empty_when_any();
+	}
+	detail::WhenAnyState<T, E> state(tasks);
+	co_return co_await detail::WhenAwaiter(state);
+}
+
+template <
+	class T,
+	class E,
+	std::enable_if_t<
+		detail::is_cv_void_v<T>,
+		bool
+	> = false
+>
+Task<T, E> when_any(std::vector<Task<T, E>> tasks) {
+	if(tasks.empty()) {
+		detail::reject_empty_when_any();
+	}
+	detail::WhenAnyState<T, E> state(tasks);
+	co_await detail::WhenAwaiter(state);
+}
+
+// Runs 'task' on the calling thread and blocks until it finishes.
+template <class T, class E>
+Result<T, E> sync_wait(Task<T, E> task) {
+	return detail::sync_wait(nullptr, task);
+}
+
+// Runs 'task' on 'pool' and blocks until it finishes.
+template <class T, class E>
+Result<T, E> sync_wait(ThreadPool& pool, Task<T, E> task) {
+	return detail::sync_wait(&pool, task);
+}
+
+} /* inline namespace result */
+
+} /* namespace tim */
+
+#endif /* TIM_RESULT_HAS_COROUTINES */
+
+#endif /* TIM_RESULT_TASK_HPP */
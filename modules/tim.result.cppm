@@ -0,0 +1,36 @@
+// The 'tim.result' module: everything declared by 'tim/result/Result.hpp' and
+// 'tim/result/shared_error.hpp', exported as a named module.
+//
+// The standard headers that they use are included into the global module
+// fragment, so that the includes below only add the library's own
+// declarations to the module purview.  Those declarations are
+// attached to the global module ('extern "C++"'), so a program may import the
+// module in some translation units and include the header in others.
+//
+// Macros are not exported from a module: code that uses 'TIM_TRY()' or
+// 'TIM_TRY_ASSIGN()' must include 'Result.hpp' as well.
+
+module;
+
+#include <type_traits>
+#include <exception>
+#include <utility>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <variant>
+#include <string>
+#include <atomic>
+#include <typeinfo>
+#include <tuple>
+#if !defined(__GNUC__) && !defined(__clang__)
+# include <cstring>
+#endif
+
+export module tim.result;
+
+export extern "C++" {
+#include "tim/result/Result.hpp"
+#include "tim/result/shared_error.hpp"
+}
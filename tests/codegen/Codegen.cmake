@@ -0,0 +1,101 @@
+# Helpers shared by the codegen check scripts.  Each script is run in script
+# mode ('cmake -P') with the following variables defined:
+#
+#   COMPILER     the C++ compiler to use
+#   CXXSTD       the C++ standard to compile with (e.g. '17')
+#   INCLUDE_DIR  the library's include directory
+#   SOURCE       the probe source file to compile
+#   OUTPUT_DIR   a scratch directory for the generated assembly
+
+foreach(var COMPILER CXXSTD INCLUDE_DIR SOURCE OUTPUT_DIR)
+	if(NOT DEFINED ${var})
+		message(FATAL_ERROR "Codegen check requires -D${var}=...")
+	endif()
+endforeach()
+
+# Compile SOURCE to AT&T-syntax assembly and store the text in OUT_VAR.
+function(codegen_compile OUT_VAR)
+	get_filename_component(name ${SOURCE} NAME_WE)
+	set(asm ${OUTPUT_DIR}/${name}.s)
+	file(MAKE_DIRECTORY ${OUTPUT_DIR})
+	execute_process(
+		COMMAND ${COMPILER} -std=c++${CXXSTD} -O2 -S
+			-fno-asynchronous-unwind-tables -fno-exceptions
+			-I${INCLUDE_DIR} ${ARGN} ${SOURCE} -o ${asm}
+		RESULT_VARIABLE status
+		ERROR_VARIABLE errors)
+	if(NOT status EQUAL 0)
+		message(FATAL_ERROR "Failed to compile ${SOURCE}:\n${errors}")
+	endif()
+	file(STRINGS ${asm} lines)
+	set(${OUT_VAR} "${lines}" PARENT_SCOPE)
+endfunction()
+
+# Extract the instructions of function FUNC (an unmangled 'extern "C"' name)
+# from ASM.  Directives are dropped; labels are kept.
+function(codegen_function_body ASM FUNC OUT_VAR)
+	set(body)
+	set(inside FALSE)
+	foreach(line IN LISTS ASM)
+		if(line MATCHES "^${FUNC}:")
+			set(inside TRUE)
+		elseif(inside)
+			if(line MATCHES "^[ \t]*\\.size[ \t]+${FUNC},")
+				break()
+			elseif(line MATCHES "^[A-Za-z_][A-Za-z0-9_]*:")
+				break()
+			elseif(NOT line MATCHES "^[ \t]*\\.")
+				string(STRIP "${line}" line)
+				list(APPEND body "${line}")
+			endif()
+		endif()
+	endforeach()
+	if(NOT inside)
+		message(FATAL_ERROR "No function '${FUNC}' in the generated assembly.")
+	endif()
+	set(${OUT_VAR} "${body}" PARENT_SCOPE)
+endfunction()
+
+# Fail unless no instruction in BODY matches REGEX.
+function(codegen_forbid FUNC BODY REGEX WHAT)
+	foreach(insn IN LISTS BODY)
+		if(insn MATCHES "${REGEX}")
+			string(REPLACE ";" "\n\t" dump "${BODY}")
+			message(FATAL_ERROR "${FUNC}: ${WHAT}: '${insn}'\n\t${dump}")
+		endif()
+	endforeach()
+endfunction()
+
+# Fail unless some instruction in BODY matches REGEX.
+function(codegen_require FUNC BODY REGEX WHAT)
+	foreach(insn IN LISTS BODY)
+		if(insn MATCHES "${REGEX}")
+			return()
+		endif()
+	endforeach()
+	string(REPLACE ";" "\n\t" dump "${BODY}")
+	message(FATAL_ERROR "${FUNC}: ${WHAT}\n\t${dump}")
+endfunction()
+
+# Reduce BODY to a sorted list of instructions so that two functions can be
+# compared independently of how the compiler laid out their basic blocks:
+# labels and unconditional local jumps are dropped, conditional jumps lose
+# their condition and target, and a tail call becomes a call and a return.
+function(codegen_normalize BODY OUT_VAR)
+	set(result)
+	foreach(insn IN LISTS BODY)
+		if(insn MATCHES ":$")
+			continue()
+		elseif(insn MATCHES "^jmp[ \t]+\\.L")
+			continue()
+		elseif(insn MATCHES "^jmp[ \t]+([^*%].*)$")
+			list(APPEND result "call\t${CMAKE_MATCH_1}" "ret")
+		elseif(insn MATCHES "^j[a-z]+[ \t]+\\.L")
+			list(APPEND result "jcc")
+		else()
+			list(APPEND result "${insn}")
+		endif()
+	endforeach()
+	list(SORT result)
+	set(${OUT_VAR} "${result}" PARENT_SCOPE)
+endfunction()
@@ -0,0 +1,33 @@
+# Checks that chaining with 'and_then()' is free: 'probe_chain' must compile to
+# the same instructions as the hand-written 'probe_manual' (up to block layout),
+# and to no more instructions than 'probe_manual_error'.
+
+include(${CMAKE_CURRENT_LIST_DIR}/Codegen.cmake)
+
+codegen_compile(asm)
+
+codegen_function_body("${asm}" probe_chain chain)
+codegen_function_body("${asm}" probe_manual manual)
+codegen_function_body("${asm}" probe_manual_error manual_error)
+
+foreach(probe chain manual manual_error)
+	codegen_forbid(probe_${probe} "${${probe}}" "\\(%" "memory access")
+endforeach()
+
+codegen_normalize("${chain}" chain_normalized)
+codegen_normalize("${manual}" manual_normalized)
+codegen_normalize("${manual_error}" manual_error_normalized)
+
+if(NOT chain_normalized STREQUAL manual_normalized)
+	string(REPLACE ";" "\n\t" chain_dump "${chain}")
+	string(REPLACE ";" "\n\t" manual_dump "${manual}")
+	message(FATAL_ERROR "probe_chain differs from probe_manual:\n"
+		"probe_chain:\n\t${chain_dump}\nprobe_manual:\n\t${manual_dump}")
+endif()
+
+list(LENGTH chain_normalized chain_length)
+list(LENGTH manual_error_normalized manual_error_length)
+if(chain_length GREATER manual_error_length)
+	message(FATAL_ERROR "probe_chain is longer than probe_manual_error "
+		"(${chain_length} > ${manual_error_length} instructions).")
+endif()
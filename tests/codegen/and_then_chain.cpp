@@ -0,0 +1,73 @@
+// Probe functions for the cost of chaining with 'tim::Result::and_then()'.
+//
+// 'probe_chain' threads a value through five fallible steps with 'and_then()';
+// 'probe_manual' does the same with hand-written early returns of the failed
+// 'Result', and 'probe_manual_error' rebuilds the error with 'tim::Error()'
+// instead.  The steps are only declared here so that every probe keeps its five
+// calls.  'and_then_chain.cmake' checks that 'probe_chain' compiles to the same
+// instructions as 'probe_manual' and to no more than 'probe_manual_error'.
+
+#include "tim/result/Result.hpp"
+
+enum class ErrCode: int {
+	NotFound = 1,
+	Invalid = 2
+};
+
+extern "C" {
+
+tim::Result<long, ErrCode> step1(long);
+tim::Result<long, ErrCode> step2(long);
+tim::Result<long, ErrCode> step3(long);
+tim::Result<long, ErrCode> step4(long);
+tim::Result<long, ErrCode> step5(long);
+
+tim::Result<long, ErrCode> probe_chain(long v) {
+	return step1(v)
+		.and_then(step2)
+		.and_then(step3)
+		.and_then(step4)
+		.and_then(step5);
+}
+
+tim::Result<long, ErrCode> probe_manual(long v) {
+	auto r1 = step1(v);
+	if(!r1) {
+		return r1;
+	}
+	auto r2 = step2(*r1);
+	if(!r2) {
+		return r2;
+	}
+	auto r3 = step3(*r2);
+	if(!r3) {
+		return r3;
+	}
+	auto r4 = step4(*r3);
+	if(!r4) {
+		return r4;
+	}
+	return step5(*r4);
+}
+
+tim::Result<long, ErrCode> probe_manual_error(long v) {
+	auto r1 = step1(v);
+	if(!r1) {
+		return tim::Error(r1.error());
+	}
+	auto r2 = step2(*r1);
+	if(!r2) {
+		return tim::Error(r2.error());
+	}
+	auto r3 = step3(*r2);
+	if(!r3) {
+		return tim::Error(r3.error());
+	}
+	auto r4 = step4(*r3);
+	if(!r4) {
+		return tim::Error(r4.error());
+	}
+	return step5(*r4);
+}
+
+} /* extern "C" */
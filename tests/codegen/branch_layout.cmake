@@ -0,0 +1,41 @@
+# Checks that the 'expectation' of a 'Result' decides which side of a branch on
+# it falls through: with 'expect_success' the value path must run before the
+# function's first return and the error path after it, and the reverse with
+# 'expect_failure'.
+
+include(${CMAKE_CURRENT_LIST_DIR}/Codegen.cmake)
+
+# Fail unless a call to CALLEE in BODY comes before the first return ('INLINE')
+# or only after it ('OUT_OF_LINE').  A tail call counts as a call.
+function(require_layout FUNC BODY CALLEE LAYOUT)
+	set(seen_ret FALSE)
+	set(found FALSE)
+	foreach(insn IN LISTS BODY)
+		if(insn MATCHES "^ret")
+			set(seen_ret TRUE)
+		elseif(insn MATCHES "^(call|jmp)[ \t]+${CALLEE}")
+			set(found TRUE)
+			break()
+		endif()
+	endforeach()
+	string(REPLACE ";" "\n\t" dump "${BODY}")
+	if(NOT found)
+		message(FATAL_ERROR "${FUNC}: no call to ${CALLEE}()\n\t${dump}")
+	endif()
+	if(LAYOUT STREQUAL "INLINE" AND seen_ret)
+		message(FATAL_ERROR "${FUNC}: ${CALLEE}() is out of line, expected it to fall through\n\t${dump}")
+	elseif(LAYOUT STREQUAL "OUT_OF_LINE" AND NOT seen_ret)
+		message(FATAL_ERROR "${FUNC}: ${CALLEE}() falls through, expected it out of line\n\t${dump}")
+	endif()
+endfunction()
+
+codegen_compile(asm)
+
+codegen_function_body("${asm}" probe_try_success body)
+require_layout(probe_try_success "${body}" on_value INLINE)
+codegen_function_body("${asm}" probe_try_failure body)
+require_layout(probe_try_failure "${body}" on_value OUT_OF_LINE)
+codegen_function_body("${asm}" probe_or_else_success body)
+require_layout(probe_or_else_success "${body}" on_error OUT_OF_LINE)
+codegen_function_body("${asm}" probe_or_else_failure body)
+require_layout(probe_or_else_failure "${body}" on_error INLINE)
@@ -0,0 +1,56 @@
+// Probe functions for the branch layout hints of 'TIM_RESULT_EXPECT_HAS_VALUE'.
+//
+// 'Rare' is specialized to 'expect_success' and 'Common' to 'expect_failure'.
+// Each probe branches once on a 'Result' and calls 'on_value()' or
+// 'on_error()' on one side only; 'branch_layout.cmake' compiles this file to
+// assembly and checks that the expected side falls through and the other one
+// is laid out after the function's first return.
+
+#include "tim/result/Result.hpp"
+
+struct Rare {
+	int code;
+};
+
+struct Common {
+	int code;
+};
+
+namespace tim::traits {
+
+template <class T>
+struct expectation<T, Rare>: std::integral_constant<Expectation, expect_success> {};
+
+template <class T>
+struct expectation<T, Common>: std::integral_constant<Expectation, expect_failure> {};
+
+} /* namespace tim::traits */
+
+extern "C" {
+
+void on_value(long v) noexcept;
+void on_error(int code) noexcept;
+
+tim::Result<void, Rare> probe_try_success(tim::Result<long, Rare> r) {
+	TIM_TRY_ASSIGN(long v, r);
+	on_value(v);
+	on_value(v + 1);
+	return {};
+}
+
+tim::Result<void, Common> probe_try_failure(tim::Result<long, Common> r) {
+	TIM_TRY_ASSIGN(long v, r);
+	on_value(v);
+	on_value(v + 1);
+	return {};
+}
+
+void probe_or_else_success(const tim::Result<long, Rare>& r) {
+	r.or_else([](const Rare& e) { on_error(e.code); on_error(e.code + 1); });
+}
+
+void probe_or_else_failure(const tim::Result<long, Common>& r) {
+	r.or_else([](const Common& e) { on_error(e.code); on_error(e.code + 1); });
+}
+
+}
@@ -0,0 +1,25 @@
+# Checks that 'tim::to_std()' and 'tim::from_std()' compile away: converting a
+# 'Result' to 'std::expected' and back must not touch memory, call anything or
+# branch for a register-passed 'Result', and must compile to the same code as
+# a move for one holding a 'std::unique_ptr'.
+
+include(${CMAKE_CURRENT_LIST_DIR}/Codegen.cmake)
+
+codegen_compile(asm)
+
+codegen_function_body("${asm}" probe_small_round_trip body)
+codegen_forbid(probe_small_round_trip "${body}" "\\(%" "memory access")
+codegen_forbid(probe_small_round_trip "${body}" "^(call|jmp)" "out-of-line call")
+codegen_forbid(probe_small_round_trip "${body}" "^j[a-ln-z]" "conditional jump")
+
+codegen_function_body("${asm}" probe_owned_move move)
+codegen_function_body("${asm}" probe_owned_round_trip round_trip)
+codegen_normalize("${move}" move_normalized)
+codegen_normalize("${round_trip}" round_trip_normalized)
+
+if(NOT round_trip_normalized STREQUAL move_normalized)
+	string(REPLACE ";" "\n\t" round_trip_dump "${round_trip}")
+	string(REPLACE ";" "\n\t" move_dump "${move}")
+	message(FATAL_ERROR "probe_owned_round_trip differs from probe_owned_move:\n"
+		"probe_owned_round_trip:\n\t${round_trip_dump}\nprobe_owned_move:\n\t${move_dump}")
+endif()
@@ -0,0 +1,49 @@
+// Probe functions for the conversions between 'tim::Result' and
+// 'std::expected'.  'expected_round_trip.cmake' compiles this file to assembly
+// (as C++23) and checks that converting a 'Result' to 'std::expected' and back
+// compiles to the same code as moving it, or for 'Small' (passed in
+// registers), to branchless register moves.  The error of 'Small' is as large
+// as 'long' so that both alternatives fill their storage: a smaller error
+// leaves bytes that the round trip does not preserve, and it branches to leave
+// them out.
+
+#include "tim/result/expected.hpp"
+
+#include <memory>
+#include <new>
+
+enum class ErrCode: int {
+	NotFound = 1,
+	Invalid = 2
+};
+
+enum class WideErrCode: long {
+	NotFound = 1,
+	Invalid = 2
+};
+
+struct Payload {
+	long value;
+};
+
+template <>
+struct tim::traits::niche_traits<Payload*>: tim::traits::pointer_low_bit_niche<Payload*> {};
+
+using Small = tim::Result<long, WideErrCode>;
+using Owned = tim::Result<std::unique_ptr<Payload>, ErrCode>;
+
+extern "C" {
+
+Small probe_small_round_trip(Small r) {
+	return tim::from_std(tim::to_std(r));
+}
+
+void probe_owned_move(Owned* out, Owned* in) {
+	::new(static_cast<void*>(out)) Owned(std::move(*in));
+}
+
+void probe_owned_round_trip(Owned* out, Owned* in) {
+	::new(static_cast<void*>(out)) Owned(tim::from_std(tim::to_std(std::move(*in))));
+}
+
+}
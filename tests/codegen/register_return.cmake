@@ -0,0 +1,32 @@
+# Checks the register-passable contract of 'tim::Result' on x86-64: every probe
+# in 'register_return.cpp' must work entirely in registers, and the probes
+# returning a 16-byte 'Result' must return it in RAX:RDX.
+
+include(${CMAKE_CURRENT_LIST_DIR}/Codegen.cmake)
+
+codegen_compile(asm)
+
+set(probes
+	probe_return_value
+	probe_return_error
+	probe_pass_through
+	probe_take
+	probe_return_small
+	probe_return_void
+	probe_return_niche)
+
+set(two_register_probes
+	probe_return_value
+	probe_return_error
+	probe_pass_through)
+
+foreach(probe IN LISTS probes)
+	codegen_function_body("${asm}" ${probe} body)
+	codegen_forbid(${probe} "${body}" "\\(%" "memory access")
+	codegen_forbid(${probe} "${body}" "^call" "out-of-line call")
+endforeach()
+
+foreach(probe IN LISTS two_register_probes)
+	codegen_function_body("${asm}" ${probe} body)
+	codegen_require(${probe} "${body}" "%[re]?dx?$" "'Result' is not returned in RAX:RDX")
+endforeach()
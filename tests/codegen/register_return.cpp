@@ -0,0 +1,62 @@
+// Probe functions for the register-passable contract of 'tim::Result'.
+//
+// Every probe below takes or returns a 'Result' with trivially copyable 'T'
+// and 'E' that is at most two eightbytes large.  Under the Itanium C++ ABI such
+// a 'Result' must be passed and returned in registers; 'register_return.cmake'
+// compiles this file to assembly and checks that none of the probes touch the
+// stack or return through a hidden pointer.
+
+#include "tim/result/Result.hpp"
+
+enum class ErrCode: int {
+	NotFound = 1,
+	Invalid = 2
+};
+
+struct Aligned {
+	long value;
+};
+
+template <>
+struct tim::traits::niche_traits<Aligned*>: tim::traits::pointer_low_bit_niche<Aligned*> {};
+
+extern "C" {
+
+tim::Result<long, ErrCode> probe_return_value(long v) {
+	return v;
+}
+
+tim::Result<long, ErrCode> probe_return_error(ErrCode e) {
+	return tim::Error(e);
+}
+
+tim::Result<long, ErrCode> probe_pass_through(tim::Result<long, ErrCode> r) {
+	return r;
+}
+
+long probe_take(tim::Result<long, ErrCode> r) {
+	return r.has_value() ? *r : -static_cast<long>(r.error());
+}
+
+tim::Result<int, ErrCode> probe_return_small(int v) {
+	if(v < 0) {
+		return tim::Error(ErrCode::Invalid);
+	}
+	return v;
+}
+
+tim::Result<void, ErrCode> probe_return_void(bool ok) {
+	if(!ok) {
+		return tim::Error(ErrCode::NotFound);
+	}
+	return tim::Result<void, ErrCode>();
+}
+
+tim::Result<Aligned*, ErrCode> probe_return_niche(Aligned* p) {
+	if(!p) {
+		return tim::Error(ErrCode::NotFound);
+	}
+	return p;
+}
+
+} /* extern "C" */
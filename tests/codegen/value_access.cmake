@@ -0,0 +1,50 @@
+# Checks the code 'value()' generates under each 'TIM_RESULT_ACCESS_POLICY':
+# with 'TIM_RESULT_ACCESS_THROW' and 'TIM_RESULT_ACCESS_TERMINATE' each probe in
+# 'value_access.cpp' must test the 'Result' once and call the out-of-line
+# failure function, without spilling the 'Result' or allocating an exception
+# inline; with 'TIM_RESULT_ACCESS_UNREACHABLE' it must not test at all.
+
+include(${CMAKE_CURRENT_LIST_DIR}/Codegen.cmake)
+
+set(probes
+	probe_value
+	probe_value_ref)
+
+# Fail unless exactly one instruction in BODY is a conditional jump.
+function(require_one_branch FUNC BODY)
+	set(count 0)
+	foreach(insn IN LISTS BODY)
+		if(insn MATCHES "^j[a-z]+[ \t]" AND NOT insn MATCHES "^jmp[ \t]")
+			math(EXPR count "${count} + 1")
+		endif()
+	endforeach()
+	if(NOT count EQUAL 1)
+		string(REPLACE ";" "\n\t" dump "${BODY}")
+		message(FATAL_ERROR "${FUNC}: ${count} conditional jumps, expected 1\n\t${dump}")
+	endif()
+endfunction()
+
+set(failure_THROW throw_bad_result_access)
+set(failure_TERMINATE terminate_bad_result_access)
+set(flags_THROW -fexceptions)
+set(flags_TERMINATE)
+
+foreach(policy THROW TERMINATE)
+	codegen_compile(asm ${flags_${policy}} -DTIM_RESULT_ACCESS_POLICY=TIM_RESULT_ACCESS_${policy})
+	foreach(probe IN LISTS probes)
+		codegen_function_body("${asm}" ${probe} body)
+		require_one_branch("${probe} (${policy})" "${body}")
+		codegen_require("${probe} (${policy})" "${body}" "^(call|jmp)[ \t].*${failure_${policy}}"
+			"no call to ${failure_${policy}}()")
+		codegen_forbid("${probe} (${policy})" "${body}" "__cxa_" "inline exception handling")
+	endforeach()
+	codegen_function_body("${asm}" probe_value body)
+	codegen_forbid("probe_value (${policy})" "${body}" "\\(%" "memory access")
+endforeach()
+
+codegen_compile(asm -DTIM_RESULT_ACCESS_POLICY=TIM_RESULT_ACCESS_UNREACHABLE)
+foreach(probe IN LISTS probes)
+	codegen_function_body("${asm}" ${probe} body)
+	codegen_forbid("${probe} (UNREACHABLE)" "${body}" "^j[a-ln-z]" "conditional jump")
+	codegen_forbid("${probe} (UNREACHABLE)" "${body}" "^call" "out-of-line call")
+endforeach()
@@ -0,0 +1,24 @@
+// Probe functions for the code 'value()' generates under each
+// 'TIM_RESULT_ACCESS_POLICY'.  'value_access.cmake' compiles this file to
+// assembly once per policy and checks that the access is a single test and
+// branch to an out-of-line function, or nothing at all for
+// 'TIM_RESULT_ACCESS_UNREACHABLE'.
+
+#include "tim/result/Result.hpp"
+
+enum class ErrCode: int {
+	NotFound = 1,
+	Invalid = 2
+};
+
+extern "C" {
+
+long probe_value(tim::Result<long, ErrCode> r) {
+	return r.value();
+}
+
+long probe_value_ref(const tim::Result<long, ErrCode>& r) {
+	return r.value();
+}
+
+}
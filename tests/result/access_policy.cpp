@@ -0,0 +1,52 @@
+// Built into 'result-access-policy-tests' with
+// 'TIM_RESULT_ACCESS_POLICY=TIM_RESULT_ACCESS_HANDLER'.
+
+#include "catch.hpp"
+#include "tim/result/Result.hpp"
+#include "tim/result/ResultVector.hpp"
+
+#include <string>
+
+namespace {
+
+struct HandlerCalled {};
+
+int handler_calls = 0;
+
+[[noreturn]] void throwing_handler() {
+	++handler_calls;
+	throw HandlerCalled{};
+}
+
+} /* namespace */
+
+static_assert(TIM_RESULT_ACCESS_POLICY == TIM_RESULT_ACCESS_HANDLER);
+
+TEST_CASE("Access Policy Handler", "[access_policy]") {
+	REQUIRE(tim::get_bad_result_access_handler() == nullptr);
+	REQUIRE(tim::set_bad_result_access_handler(throwing_handler) == nullptr);
+	REQUIRE(tim::get_bad_result_access_handler() == throwing_handler);
+	handler_calls = 0;
+
+	tim::Result<std::string, int> value(tim::in_place, "value");
+	tim::Result<std::string, int> error(tim::in_place_error, 3);
+	REQUIRE(value.value() == "value");
+	REQUIRE(handler_calls == 0);
+	REQUIRE_THROWS_AS(error.value(), HandlerCalled);
+	REQUIRE_THROWS_AS(std::as_const(error).value(), HandlerCalled);
+	REQUIRE_THROWS_AS(std::move(error).value(), HandlerCalled);
+	REQUIRE(handler_calls == 3);
+
+	tim::Result<void, std::string> void_error(tim::in_place_error, "error");
+	REQUIRE_THROWS_AS(void_error.value(), HandlerCalled);
+	REQUIRE(handler_calls == 4);
+
+	tim::ResultVector<long, int> v;
+	v.emplace_back(tim::in_place, 1L);
+	v.emplace_back(tim::in_place_error, 2);
+	REQUIRE(v[0].value() == 1L);
+	REQUIRE_THROWS_AS(v[1].value(), HandlerCalled);
+	REQUIRE(handler_calls == 5);
+
+	REQUIRE(tim::set_bad_result_access_handler(nullptr) == throwing_handler);
+}
@@ -0,0 +1,164 @@
+#include "catch.hpp"
+#include "tim/result/Result.hpp"
+
+#include "support/test_allocator.h"
+#include "support/uses_alloc_types.h"
+
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+namespace {
+
+template <class T>
+using TestVector = std::vector<T, test_allocator<T>>;
+
+using TestString = std::basic_string<char, std::char_traits<char>, test_allocator<char>>;
+
+template <class T>
+using OtherVector = std::vector<T, other_allocator<T>>;
+
+using OtherString = std::basic_string<char, std::char_traits<char>, other_allocator<char>>;
+
+// Long enough not to fit in the small string buffer.
+constexpr const char message[] = "an error message that does not fit in place";
+
+} /* namespace */
+
+TEST_CASE("Allocator Construction", "[allocators.construction]") {
+	using A = test_allocator<int>;
+	const A a(42);
+	int x = 7;
+	SECTION("Values") {
+		tim::Result<UsesAllocatorV1<A, 1>, int> r1(std::allocator_arg, a, tim::in_place, x);
+		REQUIRE(checkConstruct<int&>(*r1, UA_AllocArg, a));
+		tim::Result<UsesAllocatorV2<A, 1>, int> r2(std::allocator_arg, a, tim::in_place, x);
+		REQUIRE(checkConstruct<int&>(*r2, UA_AllocLast, a));
+		tim::Result<UsesAllocatorV3<A, 1>, int> r3(std::allocator_arg, a, tim::in_place, x);
+		REQUIRE(checkConstruct<int&>(*r3, UA_AllocArg, a));
+		tim::Result<NotUsesAllocator<A, 1>, int> r4(std::allocator_arg, a, tim::in_place, x);
+		REQUIRE(checkConstruct<int&>(*r4, UA_None));
+		tim::Result<UsesAllocatorV1<A, 1>, int> r5(std::allocator_arg, a, std::move(x));
+		REQUIRE(checkConstruct<int&&>(*r5, UA_AllocArg, a));
+		tim::Result<UsesAllocatorV2<A, 0>, int> r6(std::allocator_arg, a);
+		REQUIRE(checkConstruct<>(*r6, UA_AllocLast, a));
+	}
+	SECTION("Errors") {
+		tim::Result<int, UsesAllocatorV1<A, 1>> e1(std::allocator_arg, a, tim::in_place_error, x);
+		REQUIRE(checkConstruct<int&>(e1.error(), UA_AllocArg, a));
+		tim::Result<int, UsesAllocatorV2<A, 1>> e2(std::allocator_arg, a, tim::in_place_error, x);
+		REQUIRE(checkConstruct<int&>(e2.error(), UA_AllocLast, a));
+		tim::Result<int, NotUsesAllocator<A, 1>> e3(std::allocator_arg, a, tim::in_place_error, x);
+		REQUIRE(checkConstruct<int&>(e3.error(), UA_None));
+		tim::Result<void, UsesAllocatorV3<A, 1>> e4(std::allocator_arg, a, tim::in_place_error, x);
+		REQUIRE(checkConstruct<int&>(e4.error(), UA_AllocArg, a));
+		tim::Result<int, UsesAllocatorV1<A, 1>> e5(std::allocator_arg, a, tim::make_error(x));
+		REQUIRE(checkConstruct<int&&>(e5.error(), UA_AllocArg, a));
+	}
+	SECTION("Uses allocator") {
+		static_assert(std::uses_allocator_v<tim::Result<UsesAllocatorV1<A, 1>, int>, A>);
+		static_assert(std::uses_allocator_v<tim::Result<int, UsesAllocatorV2<A, 1>>, A>);
+		static_assert(std::uses_allocator_v<tim::Result<void, TestString>, A>);
+		static_assert(!std::uses_allocator_v<tim::Result<int, int>, A>);
+		static_assert(!std::uses_allocator_v<tim::Result<NotUsesAllocator<A, 1>, int>, A>);
+	}
+}
+
+TEST_CASE("Allocator Replacement", "[allocators.replacement]") {
+	using R = tim::Result<TestVector<int>, TestString>;
+	R r(std::allocator_arg, test_allocator<int>(5), tim::in_place_error, message);
+	REQUIRE(r.error().get_allocator().get_data() == 5);
+	SECTION("Assignment") {
+		r = TestVector<int>{1, 2, 3};
+		REQUIRE(r->get_allocator().get_data() == 5);
+		REQUIRE(*r == TestVector<int>{1, 2, 3});
+		r = tim::make_error(TestString(message));
+		REQUIRE(r.error().get_allocator().get_data() == 5);
+		REQUIRE(r.error() == message);
+		const R other(std::allocator_arg, test_allocator<int>(9), tim::in_place, std::size_t(2), 1);
+		r = other;
+		REQUIRE(r->get_allocator().get_data() == 5);
+		REQUIRE(*r == *other);
+		const R error(std::allocator_arg, test_allocator<int>(9), tim::in_place_error, message);
+		r = error;
+		REQUIRE(r.error().get_allocator().get_data() == 5);
+		r = R(std::allocator_arg, test_allocator<int>(9), tim::in_place, std::size_t(2), 1);
+		REQUIRE(r->get_allocator().get_data() == 5);
+		r = R(std::allocator_arg, test_allocator<int>(9), tim::in_place_error, message);
+		REQUIRE(r.error().get_allocator().get_data() == 5);
+	}
+	SECTION("Emplace") {
+		r.emplace(std::size_t(3), 7);
+		REQUIRE(r->get_allocator().get_data() == 5);
+		REQUIRE(*r == TestVector<int>{7, 7, 7});
+		r.emplace({1, 2});
+		REQUIRE(r->get_allocator().get_data() == 5);
+		REQUIRE(*r == TestVector<int>{1, 2});
+	}
+	SECTION("Swap") {
+		R other(std::allocator_arg, test_allocator<int>(9), tim::in_place, std::size_t(2), 1);
+		r.swap(other);
+		REQUIRE(r->get_allocator().get_data() == 5);
+		REQUIRE(*r == TestVector<int>{1, 1});
+		REQUIRE(other.error().get_allocator().get_data() == 9);
+		REQUIRE(other.error() == message);
+		swap(r, other);
+		REQUIRE(r.error().get_allocator().get_data() == 5);
+		REQUIRE(other->get_allocator().get_data() == 9);
+	}
+	SECTION("Allocator-extended copy and move") {
+		R copy(std::allocator_arg, test_allocator<int>(11), r);
+		REQUIRE(copy.error().get_allocator().get_data() == 11);
+		REQUIRE(copy.error() == message);
+		R moved(std::allocator_arg, test_allocator<int>(12), std::move(copy));
+		REQUIRE(moved.error().get_allocator().get_data() == 12);
+		REQUIRE(moved.error() == message);
+	}
+}
+
+TEST_CASE("Allocator Propagation", "[allocators.propagation]") {
+	using R = tim::Result<OtherVector<int>, OtherString>;
+	R r(std::allocator_arg, other_allocator<int>(1), tim::in_place_error, message);
+	R other(std::allocator_arg, other_allocator<int>(2), tim::in_place, std::size_t(3), 4);
+	SECTION("Copy assignment") {
+		r = other;
+		// Copied as if by the copy constructor.
+		REQUIRE(r->get_allocator() == other_allocator<int>(-2));
+	}
+	SECTION("Move assignment") {
+		r = std::move(other);
+		REQUIRE(r->get_allocator() == other_allocator<int>(2));
+	}
+	SECTION("Swap") {
+		r.swap(other);
+		REQUIRE(r->get_allocator() == other_allocator<int>(2));
+		REQUIRE(other.error().get_allocator() == other_allocator<char>(1));
+	}
+}
+
+TEST_CASE("Allocator Memory Resource", "[allocators.pmr]") {
+	std::pmr::monotonic_buffer_resource resource;
+	SECTION("Alternatives") {
+		tim::Result<std::pmr::vector<int>, std::pmr::string> r(
+			std::allocator_arg,
+			std::pmr::polymorphic_allocator<int>(&resource),
+			tim::in_place_error,
+			message
+		);
+		REQUIRE(r.error().get_allocator().resource() == &resource);
+		r = std::pmr::vector<int>{1, 2, 3};
+		REQUIRE(r->get_allocator().resource() == &resource);
+		r = tim::make_error(std::pmr::string(message));
+		REQUIRE(r.error().get_allocator().resource() == &resource);
+	}
+	SECTION("Containers") {
+		std::pmr::vector<tim::Result<std::pmr::string, int>> results(&resource);
+		results.emplace_back(tim::in_place, message);
+		results.emplace_back(tim::in_place_error, 3);
+		results.emplace_back(tim::in_place, message);
+		REQUIRE(results[0]->get_allocator().resource() == &resource);
+		REQUIRE(results[2]->get_allocator().resource() == &resource);
+		REQUIRE(*results[0] == message);
+		REQUIRE(results[1].error() == 3);
+	}
+}
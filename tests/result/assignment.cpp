@@ -2031,4 +2031,85 @@ TEST_CASE("Conv assignment") {
 
 } /* namespace conv_assignment */
 
+namespace assign_hint_test {
+
+template <bool Hinted>
+struct Counted {
+	static inline int copies = 0;
+	static inline int moves = 0;
+	Counted(int v): v(v) {}
+	Counted(const Counted& other) noexcept(false): v(other.v) { ++copies; }
+	Counted(Counted&& other) noexcept: v(other.v) { ++moves; }
+	Counted& operator=(const Counted& other) noexcept(false) { v = other.v; ++copies; return *this; }
+	Counted& operator=(Counted&& other) noexcept { v = other.v; ++moves; return *this; }
+	static void reset() {
+		copies = 0;
+		moves = 0;
+	}
+	int v;
+};
 
+} /* namespace assign_hint_test */
+
+template <>
+struct tim::traits::nothrow_assign_hint<assign_hint_test::Counted<true>>: std::true_type {};
+
+static_assert(!tim::traits::nothrow_assign_hint_v<assign_hint_test::Counted<false>>);
+static_assert(tim::traits::nothrow_assign_hint_v<const assign_hint_test::Counted<true>>);
+
+TEST_CASE("Assignment between alternatives constructs in place", "[assignment.hint]") {
+	using assign_hint_test::Counted;
+	SECTION("copy without hint") {
+		using R = tim::Result<Counted<false>, Counted<false>>;
+		R a(tim::in_place, 1);
+		const R b(tim::in_place_error, 2);
+		Counted<false>::reset();
+		a = b;
+		REQUIRE(a.error().v == 2);
+		// Built aside and moved in, so a throwing copy leaves 'a' unchanged.
+		REQUIRE(Counted<false>::copies == 1);
+		REQUIRE(Counted<false>::moves == 1);
+	}
+	SECTION("copy with hint") {
+		using R = tim::Result<Counted<true>, Counted<true>>;
+		R a(tim::in_place, 1);
+		const R b(tim::in_place_error, 2);
+		Counted<true>::reset();
+		a = b;
+		REQUIRE(a.error().v == 2);
+		REQUIRE(Counted<true>::copies == 1);
+		REQUIRE(Counted<true>::moves == 0);
+		a = R(tim::in_place, 3);
+		Counted<true>::reset();
+		a = b;
+		REQUIRE(a.error().v == 2);
+		REQUIRE(Counted<true>::copies == 1);
+		REQUIRE(Counted<true>::moves == 0);
+		Counted<true>::reset();
+		const R c(tim::in_place, 4);
+		a = c;
+		REQUIRE(a.value().v == 4);
+		REQUIRE(Counted<true>::copies == 1);
+		REQUIRE(Counted<true>::moves == 0);
+	}
+	SECTION("error with hint") {
+		tim::Result<Counted<true>, Counted<true>> a(tim::in_place, 1);
+		const tim::Error<Counted<true>> e(tim::in_place, 5);
+		Counted<true>::reset();
+		a = e;
+		REQUIRE(a.error().v == 5);
+		REQUIRE(Counted<true>::copies == 1);
+		REQUIRE(Counted<true>::moves == 0);
+	}
+	SECTION("emplace with hint") {
+		tim::Result<Counted<true>, int> a(tim::in_place_error, 1);
+		const Counted<true> v(6);
+		Counted<true>::reset();
+		REQUIRE(a.emplace(v).v == 6);
+		REQUIRE(Counted<true>::copies == 1);
+		REQUIRE(Counted<true>::moves == 0);
+		REQUIRE(a.emplace(v).v == 6);
+		REQUIRE(Counted<true>::copies == 2);
+		REQUIRE(Counted<true>::moves == 0);
+	}
+}
@@ -1,165 +1,254 @@
-#include "catch.hpp"
-#include "tim/result/Result.hpp"
-
-struct NoMove {
-	NoMove() = default;
-	NoMove(const NoMove&) = default;
-	NoMove& operator=(const NoMove&) = default;
-	NoMove(NoMove&&) = delete;
-	NoMove& operator=(NoMove&&) = delete;
-};
-
-struct NoCopy {
-	NoCopy() = default;
-	NoCopy(const NoCopy&) = delete;
-	NoCopy& operator=(const NoCopy&) = delete;
-	NoCopy(NoCopy&&) = default;
-	NoCopy& operator=(NoCopy&&) = default;
-};
-
-struct NoMoveOrCopy {
-	NoMoveOrCopy() = default;
-	NoMoveOrCopy(const NoMoveOrCopy&) = delete;
-	NoMoveOrCopy& operator=(const NoMoveOrCopy&) = delete;
-	NoMoveOrCopy(NoMoveOrCopy&&) = delete;
-	NoMoveOrCopy& operator=(NoMoveOrCopy&&) = delete;
-};
-
-struct Dummy{};
-
-TEST_CASE("Bad Result Access", "[BadResultAccess]") {
-	static_assert(std::is_base_of<std::exception, tim::BadResultAccess<>>::value,
-	              "");
-	static_assert(std::is_base_of<tim::BadResultAccess<>, tim::BadResultAccess<int, true>>::value,
-	              "");
-	static_assert(std::is_base_of<tim::BadResultAccess<int, false>, tim::BadResultAccess<int, true>>::value,
-	              "");
-	static_assert(noexcept(tim::BadResultAccess<>{}), "must be noexcept");
-	static_assert(noexcept(tim::BadResultAccess<int, false>{}.what()), "must be noexcept");
-	static_assert(noexcept(tim::BadResultAccess<int, true>{}.what()), "must be noexcept");
-
-	{
-		tim::BadResultAccess<> ex;
-		REQUIRE(ex.what());
-	}
-
-	{
-		try {
-			tim::Result<int, int> res(tim::Error(42));
-			res.value();
-			REQUIRE(false);
-		} catch(const tim::BadResultAccess<int, true>& e) {
-			REQUIRE(e.what());
-			REQUIRE(e.error());
-			REQUIRE(e.error() == 42);
-			REQUIRE(dynamic_cast<const tim::BadResultAccess<int>*>(&e));
-		}
-	}
-	{
-		try {
-			tim::Result<void, int> res(tim::Error(42));
-			res.value();
-			REQUIRE(false);
-		} catch(const tim::BadResultAccess<int, true>& e) {
-			REQUIRE(e.what());
-			REQUIRE(e.error());
-			REQUIRE(e.error() == 42);
-			REQUIRE(dynamic_cast<const tim::BadResultAccess<int>*>(&e));
-		}
-	}
-	{
-		try {
-			tim::Result<int, Dummy> res(tim::in_place_error);
-			res.value();
-			REQUIRE(false);
-		} catch(const tim::BadResultAccess<Dummy, true>& e) {
-			REQUIRE(e.what());
-			e.error();
-		}
-	}
-	{
-		try {
-			tim::Result<void, Dummy> res(tim::in_place_error);
-			res.value();
-			REQUIRE(false);
-		} catch(const tim::BadResultAccess<Dummy, true>& e) {
-			REQUIRE(e.what());
-			e.error();
-		}
-	}
-
-}
-
-TEST_CASE("Bad Result Access Noncopyable Error", "[BadResultAccess]") {
-	{
-		try {
-			tim::Result<int, NoCopy> res(tim::in_place_error);
-			res.value();
-			REQUIRE(false);
-		} catch(const tim::BadResultAccess<NoCopy, true>& e) {
-			REQUIRE(false);
-		} catch(const tim::BadResultAccess<NoCopy, false>& e) {
-			REQUIRE(e.what());
-		}
-	}
-	{
-		try {
-			tim::Result<void, NoCopy> res(tim::in_place_error);
-			std::move(res).value();
-			REQUIRE(false);
-		} catch(const tim::BadResultAccess<NoCopy, true>& e) {
-			REQUIRE(e.what());
-			e.error();
-		}
-	}
-}
-
-TEST_CASE("Bad Result Access Nonmovable Error", "[BadResultAccess]") {
-	{
-		try {
-			tim::Result<int, NoMove> res(tim::in_place_error);
-			res.value();
-			REQUIRE(false);
-		} catch(const tim::BadResultAccess<NoMove, true>& e) {
-			REQUIRE(e.what());
-			e.error();
-		}
-	}
-	{
-		try {
-			tim::Result<void, NoMove> res(tim::in_place_error);
-			std::move(res).value();
-			REQUIRE(false);
-		} catch(const tim::BadResultAccess<NoMove, true>& e) {
-			REQUIRE(e.what());
-			// Still works because overload resolution selects the copy constructor.
-			e.error();
-		}
-	}
-}
-
-TEST_CASE("Bad Result Access Noncopyable and Nonmovable Error", "[BadResultAccess]") {
-	{
-		try {
-			tim::Result<int, NoMoveOrCopy> res(tim::in_place_error);
-			res.value();
-			REQUIRE(false);
-		} catch(const tim::BadResultAccess<NoMoveOrCopy, true>& e) {
-			REQUIRE(false);
-		} catch(const tim::BadResultAccess<NoMoveOrCopy>& e) {
-			REQUIRE(e.what());
-		}
-	}
-	{
-		try {
-			tim::Result<void, NoMoveOrCopy> res(tim::in_place_error);
-			std::move(res).value();
-			REQUIRE(false);
-		} catch(const tim::BadResultAccess<NoMoveOrCopy, true>& e) {
-			REQUIRE(false);
-		} catch(const tim::BadResultAccess<NoMoveOrCopy>& e) {
-			REQUIRE(e.what());
-		}
-	}
-}
-
+#include "catch.hpp"
+#include "tim/result/Result.hpp"
+#include "tim/result/shared_error.hpp"
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+struct NoMove {
+	NoMove() = default;
+	NoMove(const NoMove&) = default;
+	NoMove& operator=(const NoMove&) = default;
+	NoMove(NoMove&&) = delete;
+	NoMove& operator=(NoMove&&) = delete;
+};
+
+struct NoCopy {
+	NoCopy() = default;
+	NoCopy(const NoCopy&) = delete;
+	NoCopy& operator=(const NoCopy&) = delete;
+	NoCopy(NoCopy&&) = default;
+	NoCopy& operator=(NoCopy&&) = default;
+};
+
+struct NoMoveOrCopy {
+	NoMoveOrCopy() = default;
+	NoMoveOrCopy(const NoMoveOrCopy&) = delete;
+	NoMoveOrCopy& operator=(const NoMoveOrCopy&) = delete;
+	NoMoveOrCopy(NoMoveOrCopy&&) = delete;
+	NoMoveOrCopy& operator=(NoMoveOrCopy&&) = delete;
+};
+
+struct Dummy{};
+
+TEST_CASE("Bad Result Access", "[BadResultAccess]") {
+	static_assert(std::is_base_of<std::exception, tim::BadResultAccess<>>::value,
+	              "");
+	static_assert(std::is_base_of<tim::BadResultAccess<>, tim::BadResultAccess<int, true>>::value,
+	              "");
+	static_assert(std::is_base_of<tim::BadResultAccess<int, false>, tim::BadResultAccess<int, true>>::value,
+	              "");
+	static_assert(noexcept(tim::BadResultAccess<>{}), "must be noexcept");
+	static_assert(noexcept(tim::BadResultAccess<int, false>{}.what()), "must be noexcept");
+	static_assert(noexcept(tim::BadResultAccess<int, true>{}.what()), "must be noexcept");
+
+	{
+		tim::BadResultAccess<> ex;
+		REQUIRE(ex.what());
+	}
+
+	{
+		try {
+			tim::Result<int, int> res(tim::Error(42));
+			res.value();
+			REQUIRE(false);
+		} catch(const tim::BadResultAccess<int, true>& e) {
+			REQUIRE(e.what());
+			REQUIRE(e.error());
+			REQUIRE(e.error() == 42);
+			REQUIRE(dynamic_cast<const tim::BadResultAccess<int>*>(&e));
+		}
+	}
+	{
+		try {
+			tim::Result<void, int> res(tim::Error(42));
+			res.value();
+			REQUIRE(false);
+		} catch(const tim::BadResultAccess<int, true>& e) {
+			REQUIRE(e.what());
+			REQUIRE(e.error());
+			REQUIRE(e.error() == 42);
+			REQUIRE(dynamic_cast<const tim::BadResultAccess<int>*>(&e));
+		}
+	}
+	{
+		try {
+			tim::Result<int, Dummy> res(tim::in_place_error);
+			res.value();
+			REQUIRE(false);
+		} catch(const tim::BadResultAccess<Dummy, true>& e) {
+			REQUIRE(e.what());
+			e.error();
+		}
+	}
+	{
+		try {
+			tim::Result<void, Dummy> res(tim::in_place_error);
+			res.value();
+			REQUIRE(false);
+		} catch(const tim::BadResultAccess<Dummy, true>& e) {
+			REQUIRE(e.what());
+			e.error();
+		}
+	}
+
+}
+
+TEST_CASE("Bad Result Access Noncopyable Error", "[BadResultAccess]") {
+	{
+		try {
+			tim::Result<int, NoCopy> res(tim::in_place_error);
+			res.value();
+			REQUIRE(false);
+		} catch(const tim::BadResultAccess<NoCopy, true>& e) {
+			REQUIRE(false);
+		} catch(const tim::BadResultAccess<NoCopy, false>& e) {
+			REQUIRE(e.what());
+		}
+	}
+	{
+		try {
+			tim::Result<void, NoCopy> res(tim::in_place_error);
+			std::move(res).value();
+			REQUIRE(false);
+		} catch(const tim::BadResultAccess<NoCopy, true>& e) {
+			REQUIRE(e.what());
+			e.error();
+		}
+	}
+}
+
+TEST_CASE("Bad Result Access Nonmovable Error", "[BadResultAccess]") {
+	{
+		try {
+			tim::Result<int, NoMove> res(tim::in_place_error);
+			res.value();
+			REQUIRE(false);
+		} catch(const tim::BadResultAccess<NoMove, true>& e) {
+			REQUIRE(e.what());
+			e.error();
+		}
+	}
+	{
+		try {
+			tim::Result<void, NoMove> res(tim::in_place_error);
+			std::move(res).value();
+			REQUIRE(false);
+		} catch(const tim::BadResultAccess<NoMove, true>& e) {
+			REQUIRE(e.what());
+			// Still works because overload resolution selects the copy constructor.
+			e.error();
+		}
+	}
+}
+
+TEST_CASE("Bad Result Access Noncopyable and Nonmovable Error", "[BadResultAccess]") {
+	{
+		try {
+			tim::Result<int, NoMoveOrCopy> res(tim::in_place_error);
+			res.value();
+			REQUIRE(false);
+		} catch(const tim::BadResultAccess<NoMoveOrCopy, true>& e) {
+			REQUIRE(false);
+		} catch(const tim::BadResultAccess<NoMoveOrCopy>& e) {
+			REQUIRE(e.what());
+		}
+	}
+	{
+		try {
+			tim::Result<void, NoMoveOrCopy> res(tim::in_place_error);
+			std::move(res).value();
+			REQUIRE(false);
+		} catch(const tim::BadResultAccess<NoMoveOrCopy, true>& e) {
+			REQUIRE(false);
+		} catch(const tim::BadResultAccess<NoMoveOrCopy>& e) {
+			REQUIRE(e.what());
+		}
+	}
+}
+
+namespace shared_error_test {
+
+struct Diagnostics {
+	static inline int copies = 0;
+	static inline int moves = 0;
+	Diagnostics(std::vector<std::string> messages): messages(std::move(messages)) {}
+	Diagnostics(const Diagnostics& other): messages(other.messages) { ++copies; }
+	Diagnostics(Diagnostics&& other) noexcept: messages(std::move(other.messages)) { ++moves; }
+	std::vector<std::string> messages;
+};
+
+struct Unformatted {
+	int code;
+};
+
+} /* namespace shared_error_test */
+
+template <>
+struct tim::traits::bad_result_access_traits<shared_error_test::Diagnostics> {
+	static constexpr bool shared = true;
+
+	static std::string what(const shared_error_test::Diagnostics& d) {
+		std::string s = std::to_string(d.messages.size()) + " errors";
+		for(const auto& m: d.messages) {
+			s += "; " + m;
+		}
+		return s;
+	}
+};
+
+template <>
+struct tim::traits::bad_result_access_traits<shared_error_test::Unformatted> {
+	static constexpr bool shared = true;
+};
+
+TEST_CASE("Bad Result Access Shared Error", "[BadResultAccess]") {
+	using shared_error_test::Diagnostics;
+	using shared_error_test::Unformatted;
+	static_assert(std::is_base_of_v<tim::BadResultAccess<>, tim::BadResultAccess<void, true>>);
+	SECTION("lvalue") {
+		const tim::Result<int, Diagnostics> res(tim::in_place_error, std::vector<std::string>{"first", "second"});
+		Diagnostics::copies = 0;
+		Diagnostics::moves = 0;
+		try {
+			res.value();
+			REQUIRE(false);
+		} catch(const tim::BadResultAccess<void, true>& e) {
+			REQUIRE(Diagnostics::copies == 1);
+			REQUIRE(e.error_type() == typeid(Diagnostics));
+			REQUIRE(e.error<int>() == nullptr);
+			const Diagnostics* d = e.error<Diagnostics>();
+			REQUIRE(d);
+			REQUIRE(d->messages == res.error().messages);
+			REQUIRE(std::string(e.what()) == "2 errors; first; second");
+			REQUIRE(e.what() == e.what());
+			tim::BadResultAccess<void, true> copy(e);
+			REQUIRE(copy.error<Diagnostics>() == d);
+			REQUIRE(copy.what() == e.what());
+			REQUIRE(Diagnostics::copies == 1);
+		}
+	}
+	SECTION("rvalue") {
+		tim::Result<void, Diagnostics> res(tim::in_place_error, std::vector<std::string>{"only"});
+		Diagnostics::copies = 0;
+		Diagnostics::moves = 0;
+		try {
+			std::move(res).value();
+			REQUIRE(false);
+		} catch(const tim::BadResultAccess<>& e) {
+			REQUIRE(Diagnostics::copies == 0);
+			REQUIRE(Diagnostics::moves == 1);
+			REQUIRE(std::string(e.what()) == "1 errors; only");
+		}
+	}
+	SECTION("without what") {
+		tim::Result<int, Unformatted> res(tim::in_place_error, Unformatted{3});
+		try {
+			res.value();
+			REQUIRE(false);
+		} catch(const tim::BadResultAccess<void, true>& e) {
+			REQUIRE(e.error<Unformatted>()->code == 3);
+			REQUIRE(std::string(e.what()) == tim::BadResultAccess<>().what());
+		}
+	}
+}
@@ -0,0 +1,197 @@
+#include "catch.hpp"
+#include "tim/result/boxed_error.hpp"
+
+#include <array>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+namespace {
+
+struct RichError {
+	static int constructions;
+
+	RichError(int c, std::string m):
+		code(c), message(std::move(m))
+	{
+		++constructions;
+	}
+
+	RichError(const RichError& other):
+		code(other.code), message(other.message), frames(other.frames)
+	{
+		++constructions;
+	}
+
+	RichError(RichError&& other) noexcept:
+		code(other.code), message(std::move(other.message)), frames(other.frames)
+	{
+		++constructions;
+	}
+
+	friend bool operator==(const RichError& lhs, const RichError& rhs) {
+		return lhs.code == rhs.code && lhs.message == rhs.message;
+	}
+
+	friend bool operator!=(const RichError& lhs, const RichError& rhs) {
+		return !(lhs == rhs);
+	}
+
+	int code;
+	std::string message;
+	std::array<const void*, 20> frames{};
+};
+
+int RichError::constructions = 0;
+
+using Boxed = tim::boxed_error<RichError>;
+
+template <class T>
+struct CountingAllocator: std::allocator<T> {
+	template <class U>
+	struct rebind {
+		using other = CountingAllocator<U>;
+	};
+
+	static int allocations;
+	static int deallocations;
+
+	CountingAllocator() = default;
+
+	template <class U>
+	CountingAllocator(const CountingAllocator<U>&) noexcept {}
+
+	T* allocate(std::size_t n) {
+		++allocations;
+		return std::allocator<T>::allocate(n);
+	}
+
+	void deallocate(T* p, std::size_t n) {
+		++deallocations;
+		std::allocator<T>::deallocate(p, n);
+	}
+};
+
+template <class T>
+int CountingAllocator<T>::allocations = 0;
+
+template <class T>
+int CountingAllocator<T>::deallocations = 0;
+
+tim::Result<int, Boxed> parse(int v) {
+	if(v < 0) {
+		return tim::make_error(RichError(v, "negative"));
+	}
+	return v;
+}
+
+tim::Result<long, Boxed> twice(int v) {
+	TIM_TRY_ASSIGN(int x, parse(v));
+	return 2L * x;
+}
+
+} /* namespace */
+
+TEST_CASE("Boxed Error Layout", "[boxed_error.layout]") {
+	static_assert(sizeof(Boxed) == sizeof(void*));
+	static_assert(sizeof(tim::Result<int, RichError>) > sizeof(RichError));
+	static_assert(sizeof(tim::Result<int, Boxed>) == sizeof(void*));
+	static_assert(sizeof(tim::Result<void*, Boxed>) == 2 * sizeof(void*));
+	static_assert(sizeof(tim::Result<void, Boxed>) == sizeof(void*));
+	static_assert(tim::traits::is_trivially_relocatable_v<Boxed>);
+
+	static_assert(!std::is_copy_constructible_v<Boxed>);
+	static_assert(!std::is_copy_assignable_v<Boxed>);
+	static_assert(std::is_nothrow_move_constructible_v<Boxed>);
+	static_assert(std::is_nothrow_move_assignable_v<Boxed>);
+	static_assert(std::is_nothrow_move_constructible_v<tim::Result<int, Boxed>>);
+
+	static_assert(std::is_same_v<tim::auto_boxed_error_t<RichError>, Boxed>);
+	static_assert(std::is_same_v<tim::auto_boxed_error_t<int>, int>);
+	static_assert(std::is_same_v<tim::auto_boxed_error_t<RichError, sizeof(RichError)>, RichError>);
+}
+
+TEST_CASE("Boxed Error", "[boxed_error]") {
+	SECTION("Success path") {
+		RichError::constructions = 0;
+		auto r = twice(21);
+		REQUIRE(r.has_value());
+		REQUIRE(*r == 42);
+		REQUIRE(RichError::constructions == 0);
+	}
+	SECTION("Error path") {
+		auto r = parse(-1);
+		REQUIRE(!r.has_value());
+		REQUIRE(r.error());
+		REQUIRE(r.error()->code == -1);
+		REQUIRE(r.error()->message == "negative");
+		REQUIRE(r.error() == RichError(-1, "negative"));
+		REQUIRE(RichError(-1, "negative") == r.error());
+		REQUIRE(r.error() != RichError(-2, "negative"));
+	}
+	SECTION("Propagation keeps the box") {
+		auto inner = parse(-3);
+		const RichError* address = inner.error().get();
+		RichError::constructions = 0;
+		tim::Result<long, Boxed> outer = tim::make_error(std::move(inner).error());
+		REQUIRE(outer.error().get() == address);
+		REQUIRE(!inner.error());
+		REQUIRE(RichError::constructions == 0);
+	}
+	SECTION("TIM_TRY keeps the box") {
+		RichError::constructions = 0;
+		(void)parse(-4);
+		const int in_parse = RichError::constructions;
+		RichError::constructions = 0;
+		auto r = twice(-4);
+		REQUIRE(!r.has_value());
+		REQUIRE(r.error()->code == -4);
+		// Only the error built in 'parse()' was constructed.
+		REQUIRE(RichError::constructions == in_parse);
+	}
+	SECTION("Swap") {
+		Boxed a(tim::in_place, 1, "one");
+		Boxed b(tim::in_place, 2, "two");
+		const RichError* pa = a.get();
+		const RichError* pb = b.get();
+		swap(a, b);
+		REQUIRE(a.get() == pb);
+		REQUIRE(b.get() == pa);
+		tim::Result<int, Boxed> r(tim::in_place, 5);
+		tim::Result<int, Boxed> e(tim::in_place_error, std::move(a));
+		r.swap(e);
+		REQUIRE(!r.has_value());
+		REQUIRE(r.error().get() == pb);
+		REQUIRE(*e == 5);
+	}
+	SECTION("Assignment") {
+		Boxed a(tim::in_place, 1, "one");
+		Boxed b(tim::in_place, 2, "two");
+		const RichError* pb = b.get();
+		a = std::move(b);
+		REQUIRE(a.get() == pb);
+		REQUIRE(!b);
+		b = std::move(a);
+		REQUIRE(b.get() == pb);
+	}
+}
+
+TEST_CASE("Boxed Error Allocator", "[boxed_error.allocator]") {
+	using Alloc = CountingAllocator<RichError>;
+	using AllocBoxed = tim::boxed_error<RichError, Alloc>;
+	static_assert(sizeof(AllocBoxed) == sizeof(void*));
+	static_assert(sizeof(tim::Result<int, AllocBoxed>) == sizeof(void*));
+	Alloc::allocations = 0;
+	Alloc::deallocations = 0;
+	{
+		tim::Result<int, AllocBoxed> r(tim::in_place_error, std::allocator_arg, Alloc(), 7, "seven");
+		REQUIRE(Alloc::allocations == 1);
+		tim::Result<int, AllocBoxed> s(std::move(r));
+		REQUIRE(Alloc::allocations == 1);
+		REQUIRE(s.error()->code == 7);
+		s = 3;
+		REQUIRE(Alloc::deallocations == 1);
+	}
+	REQUIRE(Alloc::allocations == 1);
+	REQUIRE(Alloc::deallocations == 1);
+}
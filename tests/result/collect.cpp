@@ -0,0 +1,215 @@
+#include "catch.hpp"
+#include "tim/result/collect.hpp"
+
+#include <list>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#if TIM_RESULT_HAS_STD_RANGES
+# include <span>
+#endif
+
+namespace {
+
+struct Counted {
+	static int moves;
+	static int copies;
+
+	Counted(int v): value(v) {}
+	Counted(const Counted& other): value(other.value) { ++copies; }
+	Counted(Counted&& other) noexcept: value(other.value) { ++moves; }
+	Counted& operator=(const Counted&) = default;
+	Counted& operator=(Counted&&) = default;
+
+	static void reset() {
+		moves = 0;
+		copies = 0;
+	}
+
+	int value;
+};
+
+int Counted::moves = 0;
+int Counted::copies = 0;
+
+template <class T>
+struct CountingAllocator: std::allocator<T> {
+	template <class U>
+	struct rebind {
+		using other = CountingAllocator<U>;
+	};
+
+	static int allocations;
+
+	CountingAllocator() = default;
+
+	template <class U>
+	CountingAllocator(const CountingAllocator<U>&) noexcept {}
+
+	T* allocate(std::size_t n) {
+		++allocations;
+		return std::allocator<T>::allocate(n);
+	}
+};
+
+template <class T>
+int CountingAllocator<T>::allocations = 0;
+
+using IntResult = tim::Result<int, std::string>;
+
+// A view over storage it does not own, like 'std::span'.
+template <class It>
+struct View {
+	It first;
+	It last;
+
+	It begin() const { return first; }
+	It end() const { return last; }
+	std::size_t size() const { return static_cast<std::size_t>(last - first); }
+};
+
+template <class It>
+View<It> view(It first, It last) {
+	return View<It>{first, last};
+}
+
+} /* namespace */
+
+TEST_CASE("Collect", "[collect]") {
+	{
+		std::vector<IntResult> rs{1, 2, 3};
+		auto r = tim::collect(rs);
+		static_assert(std::is_same_v<decltype(r), tim::Result<std::vector<int>, std::string>>);
+		REQUIRE(*r == std::vector<int>{1, 2, 3});
+	}
+	{
+		std::vector<IntResult> rs{1, IntResult(tim::in_place_error, "two"), IntResult(tim::in_place_error, "three")};
+		auto r = tim::collect(rs);
+		REQUIRE(r.error() == "two");
+		// Lvalue ranges are copied from.
+		REQUIRE(rs[1].error() == "two");
+	}
+	{
+		std::vector<IntResult> rs{3, 1, 2, 1};
+		auto r = tim::collect<std::set<int>>(rs);
+		REQUIRE(*r == std::set<int>{1, 2, 3});
+	}
+	{
+		std::vector<tim::Result<void, std::string>> rs(3);
+		REQUIRE(tim::collect(rs).has_value());
+		rs[1] = tim::Error(std::string("void"));
+		auto r = tim::collect(rs);
+		static_assert(std::is_same_v<decltype(r), tim::Result<void, std::string>>);
+		REQUIRE(r.error() == "void");
+	}
+}
+
+TEST_CASE("Collect Views", "[collect.views]") {
+	using StringResult = tim::Result<std::string, int>;
+	const std::string message(100, 'x');
+	std::vector<StringResult> rs(3, StringResult(tim::in_place, message));
+	{
+		// An rvalue view does not own its elements, so they are copied.
+		auto r = tim::collect(view(rs.data(), rs.data() + rs.size()));
+		REQUIRE(*r == std::vector<std::string>(3, message));
+		REQUIRE(*rs[0] == message);
+		REQUIRE(*rs[2] == message);
+	}
+#if TIM_RESULT_HAS_STD_RANGES
+	{
+		auto r = tim::collect(std::span(rs));
+		REQUIRE(*r == std::vector<std::string>(3, message));
+		REQUIRE(*rs[1] == message);
+	}
+#endif
+	{
+		// Move iterators opt in to moving.
+		auto r = tim::collect(view(std::make_move_iterator(rs.begin()), std::make_move_iterator(rs.end())));
+		REQUIRE(*r == std::vector<std::string>(3, message));
+		REQUIRE(rs[0]->empty());
+		REQUIRE(rs[2]->empty());
+	}
+}
+
+TEST_CASE("Collect Moves And Allocations", "[collect.moves]") {
+	std::vector<tim::Result<Counted, int>> rs;
+	for(int i = 0; i < 100; ++i) {
+		rs.emplace_back(tim::in_place, i);
+	}
+	{
+		Counted::reset();
+		auto r = tim::collect(std::move(rs));
+		REQUIRE(r->size() == 100u);
+		REQUIRE(Counted::copies == 0);
+		REQUIRE(Counted::moves == 100);
+	}
+	{
+		Counted::reset();
+		auto r = tim::collect(rs);
+		REQUIRE(Counted::copies == 100);
+		REQUIRE(Counted::moves == 0);
+	}
+	{
+		CountingAllocator<Counted>::allocations = 0;
+		auto r = tim::collect<std::vector<Counted, CountingAllocator<Counted>>>(rs);
+		REQUIRE(r->size() == 100u);
+		REQUIRE(CountingAllocator<Counted>::allocations == 1);
+	}
+	{
+		// No 'size()', so no reservation.
+		std::list<tim::Result<Counted, int>> list(rs.begin(), rs.end());
+		std::vector<Counted> out;
+		REQUIRE(tim::collect_into(list, out).has_value());
+		REQUIRE(out.size() == 100u);
+	}
+}
+
+TEST_CASE("Collect Into", "[collect.into]") {
+	std::vector<int> out{0};
+	{
+		std::vector<IntResult> rs{1, 2};
+		auto r = tim::collect_into(rs, out);
+		static_assert(std::is_same_v<decltype(r), tim::Result<void, std::string>>);
+		REQUIRE(r.has_value());
+		REQUIRE(out == std::vector<int>{0, 1, 2});
+	}
+	{
+		std::vector<IntResult> rs{3, IntResult(tim::in_place_error, "four"), 5};
+		auto r = tim::collect_into(std::move(rs), out);
+		REQUIRE(r.error() == "four");
+		REQUIRE(out == std::vector<int>{0, 1, 2, 3});
+		// Rvalue ranges are moved from.
+		REQUIRE(rs[1].error().empty());
+	}
+}
+
+TEST_CASE("Collect All Errors", "[collect.all_errors]") {
+	std::vector<IntResult> rs{1, IntResult(tim::in_place_error, "two"), 3, IntResult(tim::in_place_error, "four")};
+	{
+		auto r = tim::collect(tim::all_errors, rs);
+		static_assert(std::is_same_v<decltype(r), tim::Result<std::vector<int>, std::vector<std::string>>>);
+		REQUIRE(r.error() == std::vector<std::string>{"two", "four"});
+	}
+	{
+		std::vector<int> out;
+		auto r = tim::collect_into(tim::all_errors, rs, out);
+		REQUIRE(r.error() == std::vector<std::string>{"two", "four"});
+		REQUIRE(out == std::vector<int>{1, 3});
+	}
+	{
+		std::vector<IntResult> ok{1, 2};
+		REQUIRE(*tim::collect(tim::all_errors, ok) == std::vector<int>{1, 2});
+		std::vector<int> out;
+		REQUIRE(tim::collect_into(tim::all_errors, ok, out).has_value());
+		REQUIRE(out == std::vector<int>{1, 2});
+	}
+	{
+		std::vector<tim::Result<void, int>> vs(2);
+		REQUIRE(tim::collect(tim::all_errors, vs).has_value());
+		vs[0] = tim::Error(1);
+		vs[1] = tim::Error(2);
+		REQUIRE(tim::collect(tim::all_errors, vs).error() == std::vector<int>{1, 2});
+	}
+}
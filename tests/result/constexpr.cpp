@@ -1,6 +1,41 @@
 #include "catch.hpp"
 #include "tim/result/Result.hpp"
 
+namespace {
+
+enum class Code {
+	NotFound = 1,
+	Invalid
+};
+
+int object = 0;
+
+} /* namespace */
+
 TEST_CASE("Constexpr", "[constexpr]") {
-    //TODO
+	// Pointers have no niche unless they opt in, so Results holding them stay
+	// literal types.
+	{
+		constexpr tim::Result<int*, int> r(nullptr);
+		static_assert(r.has_value());
+		static_assert(*r == nullptr);
+	}
+	{
+		constexpr tim::Result<long*, Code> r(tim::make_error(Code::Invalid));
+		static_assert(!r.has_value());
+		static_assert(r.error() == Code::Invalid);
+	}
+	{
+		constexpr tim::Result<int*, Code> r(&object);
+		static_assert(r.has_value());
+		static_assert(*r == &object);
+		constexpr tim::Result<int*, Code> copy(r);
+		static_assert(*copy == &object);
+	}
+	{
+		constexpr tim::Result<void, Code> r;
+		static_assert(r.has_value());
+		constexpr tim::Result<void, Code> e(tim::in_place_error, Code::NotFound);
+		static_assert(e.error() == Code::NotFound);
+	}
 }
@@ -0,0 +1,113 @@
+#include "catch.hpp"
+#include "tim/result/coroutine.hpp"
+
+#if TIM_RESULT_HAS_COROUTINES
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+using Arena = tim::result::detail::CoroutineFrameArena;
+
+tim::Result<int, std::string> parse(int v) {
+	if(v < 0) {
+		return tim::Error(std::string("negative"));
+	}
+	return v;
+}
+
+tim::Result<int, std::string> add(int a, int b) {
+	int x = co_await parse(a);
+	int y = co_await parse(b);
+	co_return x + y;
+}
+
+tim::Result<long, std::string> nested(int a, int b, int c) {
+	int ab = co_await add(a, b);
+	long abc = co_await add(ab, c);
+	if(abc > 100) {
+		co_await tim::Error(std::string("too big"));
+	}
+	co_return abc * 2;
+}
+
+tim::Result<void, std::string> check(int v) {
+	co_await parse(v);
+	co_return;
+}
+
+tim::Result<std::unique_ptr<int>, std::string> boxed(int v) {
+	co_return std::make_unique<int>(co_await parse(v));
+}
+
+tim::Result<int, std::string> from_lvalue(const tim::Result<int, std::string>& r) {
+	const int& x = co_await r;
+	co_return x;
+}
+
+tim::Result<int, std::string> throws() {
+	co_await parse(1);
+	throw std::runtime_error("thrown");
+}
+
+} /* namespace */
+
+TEST_CASE("Coroutine", "[coroutine]") {
+	{
+		auto r = add(1, 2);
+		REQUIRE(r.has_value());
+		REQUIRE(*r == 3);
+	}
+	{
+		auto r = add(1, -2);
+		REQUIRE(!r.has_value());
+		REQUIRE(r.error() == "negative");
+	}
+	{
+		REQUIRE(*nested(1, 2, 3) == 12);
+		REQUIRE(nested(-1, 2, 3).error() == "negative");
+		REQUIRE(nested(1, 2, -3).error() == "negative");
+		REQUIRE(nested(50, 50, 50).error() == "too big");
+	}
+	{
+		REQUIRE(check(1).has_value());
+		REQUIRE(check(-1).error() == "negative");
+	}
+	{
+		auto r = boxed(7);
+		REQUIRE(**r == 7);
+		REQUIRE(boxed(-7).error() == "negative");
+	}
+	{
+		tim::Result<int, std::string> r = 5;
+		REQUIRE(*from_lvalue(r) == 5);
+		REQUIRE(*r == 5);
+		tim::Result<int, std::string> e(tim::in_place_error, "lvalue");
+		REQUIRE(from_lvalue(e).error() == "lvalue");
+		REQUIRE(e.error() == "lvalue");
+	}
+	{
+		REQUIRE_THROWS_AS(throws(), std::runtime_error);
+	}
+	// Every frame has been returned to the arena.
+	REQUIRE(Arena::in_use() == 0);
+}
+
+TEST_CASE("Coroutine Frame Arena", "[coroutine.arena]") {
+	void* a = Arena::allocate(40);
+	void* b = Arena::allocate(100);
+	REQUIRE(Arena::in_use() >= 140);
+	REQUIRE(static_cast<unsigned char*>(b) > static_cast<unsigned char*>(a));
+	Arena::deallocate(b, 100);
+	Arena::deallocate(a, 40);
+	REQUIRE(Arena::in_use() == 0);
+
+	// Allocations that do not fit come from the heap.
+	void* big = Arena::allocate(Arena::capacity + 1);
+	REQUIRE(Arena::in_use() == 0);
+	Arena::deallocate(big, Arena::capacity + 1);
+}
+
+#endif /* TIM_RESULT_HAS_COROUTINES */
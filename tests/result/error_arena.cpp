@@ -0,0 +1,233 @@
+#include "catch.hpp"
+#include "tim/result/error_arena.hpp"
+#include "tim/result/shared_error.hpp"
+
+#include "support/controlled_allocators.h"
+#include "support/test_memory_resource.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory_resource>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// 'test_memory_resource.h' is written against 'std::experimental::pmr';
+// this forwards a 'std::pmr' upstream to it.
+class Upstream: public std::pmr::memory_resource {
+public:
+	NewDeleteResource resource;
+
+	AllocController& controller() {
+		return resource.getController();
+	}
+
+private:
+	void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+		return resource.allocate(bytes, alignment);
+	}
+
+	void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+		resource.deallocate(p, bytes, alignment);
+	}
+
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+		return this == &other;
+	}
+};
+
+struct ArenaError {
+	ArenaError(int c, std::string m):
+		code(c), message(std::move(m))
+	{
+
+	}
+
+	int code;
+	std::string message;
+};
+
+struct SharedArenaError {
+	int code;
+};
+
+} /* namespace */
+
+template <>
+struct tim::traits::bad_result_access_traits<SharedArenaError> {
+	static constexpr bool shared = true;
+	using allocator_type = std::pmr::polymorphic_allocator<SharedArenaError>;
+};
+
+TEST_CASE("Error Arena Pooling", "[error_arena]") {
+	Upstream upstream;
+	{
+		tim::error_arena arena(&upstream, tim::error_arena_options{0u, 4096u});
+		std::vector<void*> ps;
+		for(int i = 0; i < 100; ++i) {
+			ps.push_back(arena.allocate(64, alignof(std::max_align_t)));
+		}
+		const int allocations = upstream.controller().alloc_count;
+		// One cache, and 32 chunks of 128 bytes per slab.
+		REQUIRE(allocations == 1 + 4);
+		REQUIRE(arena.bytes_reserved() > 100u * 64u);
+		for(void* p: ps) {
+			arena.deallocate(p, 64, alignof(std::max_align_t));
+		}
+		// A second burst reuses the freed chunks.
+		for(int round = 0; round < 10; ++round) {
+			for(auto& p: ps) {
+				p = arena.allocate(64, alignof(std::max_align_t));
+			}
+			for(void* p: ps) {
+				arena.deallocate(p, 64, alignof(std::max_align_t));
+			}
+		}
+		REQUIRE(upstream.controller().alloc_count == allocations);
+		REQUIRE(upstream.controller().dealloc_count == 0);
+
+		void* large = arena.allocate(tim::error_arena::largest_pooled_size + 1u);
+		REQUIRE(upstream.controller().alloc_count == allocations + 1);
+		REQUIRE(upstream.controller().checkAlloc(large, tim::error_arena::largest_pooled_size + 1u, alignof(std::max_align_t)));
+		arena.deallocate(large, tim::error_arena::largest_pooled_size + 1u);
+		REQUIRE(upstream.controller().dealloc_count == 1);
+	}
+	// Destroying the arena returns everything.
+	REQUIRE(upstream.controller().alive == 0);
+	REQUIRE(upstream.controller().alloc_count == upstream.controller().dealloc_count);
+}
+
+TEST_CASE("Error Arena Threads", "[error_arena.threads]") {
+	Upstream upstream;
+	tim::error_arena arena(&upstream, tim::error_arena_options{0u, 4096u});
+	SECTION("Cross-thread frees") {
+		std::vector<void*> ps;
+		for(int i = 0; i < 32; ++i) {
+			ps.push_back(arena.allocate(100));
+		}
+		const int allocations = upstream.controller().alloc_count;
+		std::thread([&] {
+			for(void* p: ps) {
+				arena.deallocate(p, 100);
+			}
+		}).join();
+		// The other thread gave the chunks back to this one rather than
+		// keeping them.
+		REQUIRE(upstream.controller().alloc_count == allocations);
+		std::vector<void*> again;
+		for(int i = 0; i < 32; ++i) {
+			again.push_back(arena.allocate(100));
+		}
+		REQUIRE(upstream.controller().alloc_count == allocations);
+		for(void* p: again) {
+			REQUIRE(std::find(ps.begin(), ps.end(), p) != ps.end());
+			arena.deallocate(p, 100);
+		}
+	}
+	SECTION("Exited threads") {
+		std::thread([&] {
+			void* p = arena.allocate(200);
+			arena.deallocate(p, 200);
+		}).join();
+		const int allocations = upstream.controller().alloc_count;
+		REQUIRE(allocations == 2);
+		// The next thread adopts the free lists of the one that exited.
+		std::thread([&] {
+			void* p = arena.allocate(200);
+			arena.deallocate(p, 200);
+		}).join();
+		REQUIRE(upstream.controller().alloc_count == allocations);
+	}
+	SECTION("Storm") {
+		std::atomic<int> mismatches{0};
+		std::vector<std::thread> threads;
+		for(int t = 0; t < 4; ++t) {
+			threads.emplace_back([&] {
+				for(int round = 0; round < 1000; ++round) {
+					tim::Result<int, tim::boxed_error<ArenaError, std::pmr::polymorphic_allocator<ArenaError>>> r(
+						tim::in_place_error, std::allocator_arg, &arena, round, "unavailable"
+					);
+					if(r.error()->code != round) {
+						++mismatches;
+					}
+				}
+			});
+		}
+		for(auto& thread: threads) {
+			thread.join();
+		}
+		REQUIRE(mismatches == 0);
+		// At most a cache and a slab per thread.
+		REQUIRE(upstream.controller().alloc_count <= 8);
+	}
+}
+
+TEST_CASE("Error Arena Backpressure", "[error_arena.backpressure]") {
+	Upstream upstream;
+	tim::error_arena arena(&upstream, tim::error_arena_options{8192u, 4096u});
+	REQUIRE(arena.max_bytes() == 8192u);
+	std::vector<void*> ps;
+	while(void* p = arena.try_allocate(1000)) {
+		ps.push_back(p);
+		REQUIRE(ps.size() < 100u);
+	}
+	REQUIRE(!ps.empty());
+	REQUIRE(arena.bytes_reserved() <= arena.max_bytes());
+	REQUIRE_THROWS_AS(arena.allocate(1000), std::bad_alloc);
+	REQUIRE(arena.try_allocate(tim::error_arena::largest_pooled_size * 8u) == nullptr);
+	const int allocations = upstream.controller().alloc_count;
+	// Freed chunks are served again without going upstream.
+	arena.deallocate(ps.back(), 1000);
+	ps.back() = arena.try_allocate(1000);
+	REQUIRE(ps.back() != nullptr);
+	REQUIRE(upstream.controller().alloc_count == allocations);
+	for(void* p: ps) {
+		arena.deallocate(p, 1000);
+	}
+}
+
+TEST_CASE("Error Arena Upstream Failure", "[error_arena.upstream]") {
+	Upstream upstream;
+	tim::error_arena arena(&upstream);
+	void* p = arena.allocate(16);
+	upstream.controller().throw_on_alloc = true;
+	REQUIRE(arena.try_allocate(32) == nullptr);
+	REQUIRE_THROWS_AS(arena.allocate(32), TestException);
+	REQUIRE(arena.try_allocate(16) != nullptr);
+	upstream.controller().throw_on_alloc = false;
+	arena.deallocate(p, 16);
+}
+
+TEST_CASE("Error Arena Errors", "[error_arena.errors]") {
+	using Pooled = tim::pooled_error<ArenaError>;
+	static_assert(sizeof(Pooled) == sizeof(void*));
+	static_assert(sizeof(tim::Result<int, Pooled>) == sizeof(void*));
+	static_assert(std::is_nothrow_move_assignable_v<Pooled>);
+	SECTION("Default arena") {
+		tim::Result<int, Pooled> r = tim::make_error(ArenaError{1, "one"});
+		REQUIRE(r.error()->message == "one");
+		REQUIRE(tim::default_error_arena().bytes_reserved() > 0u);
+		const std::size_t reserved = tim::default_error_arena().bytes_reserved();
+		for(int i = 0; i < 100; ++i) {
+			tim::Result<int, Pooled> s = tim::make_error(ArenaError{i, "again"});
+			REQUIRE(s.error()->code == i);
+		}
+		REQUIRE(tim::default_error_arena().bytes_reserved() == reserved);
+	}
+	SECTION("Shared bad result access") {
+		Upstream upstream;
+		tim::error_arena arena(&upstream);
+		std::pmr::memory_resource* previous = std::pmr::set_default_resource(&arena);
+		tim::Result<int, SharedArenaError> r(tim::in_place_error, SharedArenaError{7});
+		try {
+			(void)r.value();
+			FAIL("value() did not throw");
+		} catch(const tim::BadResultAccess<void, true>& e) {
+			REQUIRE(e.error<SharedArenaError>()->code == 7);
+			REQUIRE(arena.bytes_reserved() > 0u);
+		}
+		std::pmr::set_default_resource(previous);
+	}
+}
@@ -0,0 +1,156 @@
+#include "catch.hpp"
+#include "tim/result/error_trail.hpp"
+#include "tim/result/boxed_error.hpp"
+
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct LoadError {
+	int code;
+	tim::error_trail trail;
+};
+
+tim::Result<int, LoadError> read_file(int id) {
+	if(id < 0) {
+		return tim::make_error(LoadError{id, {}});
+	}
+	return id;
+}
+
+tim::Result<int, LoadError> load_shard(int id) {
+	return read_file(id).context("loading shard");
+}
+
+tim::Result<long, LoadError> start_server(int id) {
+	TIM_TRY_ASSIGN(int shard, load_shard(id).context("starting server"));
+	return 2L * shard;
+}
+
+tim::Result<void, LoadError> check(int id) {
+	if(id < 0) {
+		return tim::make_error(LoadError{id, {}});
+	}
+	return tim::Result<void, LoadError>();
+}
+
+tim::Result<int, tim::boxed_error<LoadError>> boxed(int id) {
+	if(id < 0) {
+		return tim::make_error(LoadError{id, {}});
+	}
+	return id;
+}
+
+std::vector<std::string> whats(const tim::error_trail& trail) {
+	std::vector<std::string> result;
+	for(const tim::breadcrumb& crumb: trail) {
+		result.emplace_back(crumb.what);
+	}
+	return result;
+}
+
+} /* namespace */
+
+TEST_CASE("Error Trail Layout", "[error_trail.layout]") {
+	using R = tim::Result<int, LoadError>;
+	static_assert(sizeof(tim::error_trail) == sizeof(void*));
+	static_assert(std::is_same_v<decltype(std::declval<R&>().context("")), R&>);
+	static_assert(std::is_same_v<decltype(std::declval<R>().context("")), R>);
+	static_assert(std::is_nothrow_move_constructible_v<tim::error_trail>);
+	static_assert(std::is_nothrow_copy_constructible_v<tim::error_trail>);
+	static_assert(tim::traits::is_trivially_relocatable_v<tim::error_trail>);
+}
+
+TEST_CASE("Error Trail", "[error_trail]") {
+	SECTION("Success path") {
+		auto r = start_server(21);
+		REQUIRE(r.has_value());
+		REQUIRE(*r == 42);
+	}
+	SECTION("Breadcrumbs") {
+		auto r = start_server(-1);
+		REQUIRE(!r.has_value());
+		REQUIRE(r.error().code == -1);
+		REQUIRE(r.error().trail.size() == 2u);
+		REQUIRE(whats(r.error().trail) == std::vector<std::string>{"loading shard", "starting server"});
+		const tim::breadcrumb& first = *r.error().trail.begin();
+		REQUIRE(std::strcmp(first.where.file, __FILE__) == 0);
+		REQUIRE(std::string(first.where.function).find("load_shard") != std::string::npos);
+		REQUIRE(std::string(r.error().trail.back().where.function).find("start_server") != std::string::npos);
+	}
+	SECTION("Location") {
+		auto r = read_file(-2);
+		r.context("here");
+		REQUIRE(r.error().trail.back().where.line == __LINE__ - 1);
+		REQUIRE(std::string(r.error().trail.back().where.function).find("____C_A_T_C_H") != std::string::npos);
+	}
+	SECTION("Void results") {
+		auto r = check(-3).context("checking");
+		REQUIRE(whats(r.error().trail) == std::vector<std::string>{"checking"});
+		auto s = check(3).context("checking");
+		REQUIRE(s.has_value());
+	}
+	SECTION("Boxed errors") {
+		auto r = boxed(-4).context("boxed");
+		REQUIRE(whats(r.error()->trail) == std::vector<std::string>{"boxed"});
+	}
+	SECTION("Copies") {
+		auto r = start_server(-5);
+		tim::Result<long, LoadError> s(r);
+		REQUIRE(whats(s.error().trail) == whats(r.error().trail));
+		REQUIRE(&*s.error().trail.begin() != &*r.error().trail.begin());
+		s.context("copied");
+		REQUIRE(s.error().trail.size() == 3u);
+		REQUIRE(r.error().trail.size() == 2u);
+	}
+}
+
+TEST_CASE("Error Trail Storage", "[error_trail.storage]") {
+	SECTION("Freed at once") {
+		tim::error_trail a;
+		a.append("one");
+		a.append("two");
+		a.append("three");
+		const tim::breadcrumb* newest = &a.back();
+		a.clear();
+		REQUIRE(a.empty());
+		// The freed nodes head the free list, newest last.
+		tim::error_trail b;
+		b.append("again");
+		REQUIRE(&*b.begin() != newest);
+		b.append("again");
+		b.append("again");
+		REQUIRE(&b.back() == newest);
+	}
+	SECTION("Threads") {
+		std::vector<tim::Result<int, LoadError>> results;
+		std::vector<std::thread> threads;
+		results.resize(4, tim::Result<int, LoadError>(0));
+		for(std::size_t t = 0; t < results.size(); ++t) {
+			threads.emplace_back([&results, t] {
+				for(int round = 0; round < 100; ++round) {
+					auto r = read_file(-1).context("first").context("second");
+					(void)r;
+				}
+				results[t] = read_file(-1).context("kept");
+			});
+		}
+		for(auto& thread: threads) {
+			thread.join();
+		}
+		// Trails appended on threads that have exited are freed here.
+		for(auto& r: results) {
+			REQUIRE(whats(r.error().trail) == std::vector<std::string>{"kept"});
+			r = 1;
+		}
+		std::size_t size = 0u;
+		std::thread([&size] {
+			auto r = load_shard(-1).context("again");
+			size = r.error().trail.size();
+		}).join();
+		REQUIRE(size == 2u);
+	}
+}
@@ -0,0 +1,77 @@
+#include "catch.hpp"
+#include "tim/result/Result.hpp"
+
+#include <string>
+
+namespace {
+
+struct Rare {
+	int code;
+};
+
+struct Common {
+	int code;
+};
+
+} /* namespace */
+
+namespace tim::traits {
+
+template <class T>
+struct expectation<T, Rare>: std::integral_constant<Expectation, expect_success> {};
+
+template <class T>
+struct expectation<T, Common>: std::integral_constant<Expectation, expect_failure> {};
+
+} /* namespace tim::traits */
+
+static_assert(tim::traits::expectation_v<int, int> == TIM_RESULT_EXPECT);
+static_assert(tim::traits::expectation_v<int, Rare> == tim::expect_success);
+static_assert(tim::traits::expectation_v<const void, Rare> == tim::expect_success);
+static_assert(tim::traits::expectation_v<std::string, Common> == tim::expect_failure);
+
+namespace {
+
+template <class E>
+tim::Result<int, E> half(int x) {
+	if(x % 2 != 0) {
+		return tim::Result<int, E>(tim::in_place_error, E{x});
+	}
+	return x / 2;
+}
+
+template <class E>
+tim::Result<int, E> quarter(int x) {
+	TIM_TRY_ASSIGN(int h, half<E>(x));
+	return half<E>(h);
+}
+
+template <class E>
+void check_expectation() {
+	REQUIRE(quarter<E>(8).value() == 2);
+	REQUIRE(quarter<E>(6).error().code == 3);
+	REQUIRE(half<E>(4).map([](int v) { return v + 1; }).value_or(0) == 3);
+	REQUIRE(half<E>(3).and_then(half<E>).error().code == 3);
+
+	tim::Result<std::string, E> a(tim::in_place, "a");
+	tim::Result<std::string, E> b(tim::in_place_error, E{1});
+	a = b;
+	REQUIRE(a.error().code == 1);
+	b = tim::Result<std::string, E>(tim::in_place, "b");
+	a.swap(b);
+	REQUIRE(a.value() == "b");
+	REQUIRE(b.error().code == 1);
+	REQUIRE(a != b);
+
+	tim::Result<void, E> v;
+	REQUIRE(v.has_value());
+	v = tim::make_error(E{2});
+	REQUIRE(v.error().code == 2);
+}
+
+} /* namespace */
+
+TEST_CASE("Expectation", "[expectation]") {
+	check_expectation<Rare>();
+	check_expectation<Common>();
+}
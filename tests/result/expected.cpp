@@ -0,0 +1,65 @@
+#include "catch.hpp"
+#include "tim/result/expected.hpp"
+#include <memory>
+#include <string>
+#include <utility>
+
+static_assert(std::is_same_v<tim::expected<int, long>, tim::Result<int, long>>);
+static_assert(std::is_same_v<tim::unexpected<long>, tim::Error<long>>);
+static_assert(std::is_same_v<tim::bad_expected_access<long>, tim::BadResultAccess<long, true>>);
+static_assert(std::is_same_v<tim::unexpect_t, tim::in_place_error_t>);
+
+TEST_CASE("Expected aliases", "[expected]") {
+	tim::expected<int, std::string> a = tim::make_unexpected(std::string("bad"));
+	REQUIRE(!a);
+	REQUIRE(a.error() == "bad");
+	tim::expected<int, std::string> b(tim::unexpect, 3, 'x');
+	REQUIRE(b.error() == "xxx");
+	tim::expected<int, std::string> c(tim::in_place, 4);
+	REQUIRE(*c == 4);
+	REQUIRE_THROWS_AS(a.value(), tim::bad_expected_access<std::string>);
+	constexpr tim::expected<int, int> d = tim::make_unexpected(5);
+	static_assert(d.error() == 5);
+}
+
+#if TIM_RESULT_HAS_STD_EXPECTED
+
+TEST_CASE("Expected conversions", "[expected]") {
+	SECTION("value") {
+		const tim::Result<std::string, int> r(tim::in_place, "abc");
+		std::expected<std::string, int> e = tim::to_std(r);
+		REQUIRE(e.has_value());
+		REQUIRE(*e == "abc");
+		tim::Result<std::string, int> back = tim::from_std(std::move(e));
+		REQUIRE(back == r);
+	}
+	SECTION("error") {
+		tim::Result<int, std::string> r(tim::in_place_error, "abc");
+		std::expected<int, std::string> e = tim::to_std(std::move(r));
+		REQUIRE(!e.has_value());
+		REQUIRE(e.error() == "abc");
+		const auto& ce = e;
+		REQUIRE(tim::from_std(ce).error() == "abc");
+	}
+	SECTION("void") {
+		tim::Result<void, int> r(tim::in_place);
+		REQUIRE(tim::to_std(r).has_value());
+		REQUIRE(tim::from_std(std::expected<void, int>()).has_value());
+		r = tim::Error<int>(7);
+		REQUIRE(tim::to_std(r).error() == 7);
+		REQUIRE(tim::from_std(std::expected<void, int>(std::unexpect, 8)).error() == 8);
+	}
+	SECTION("move only") {
+		auto e = tim::to_std(tim::Result<std::unique_ptr<int>, int>(std::make_unique<int>(9)));
+		REQUIRE(**e == 9);
+		auto r = tim::from_std(std::move(e));
+		REQUIRE(**r == 9);
+	}
+	SECTION("constant expression") {
+		constexpr tim::Result<int, long> r(tim::in_place, 10);
+		static_assert(*tim::from_std(tim::to_std(r)) == 10);
+		static_assert(noexcept(tim::to_std(r)));
+	}
+}
+
+#endif
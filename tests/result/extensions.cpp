@@ -1,15 +1,13 @@
 #include "catch.hpp"
 #include "tim/result/Result.hpp"
 
-#define TOKENPASTE(x, y) x##y
-#define TOKENPASTE2(x, y) TOKENPASTE(x, y)
-#define STATIC_REQUIRE(e)                                                      \
-  constexpr bool TOKENPASTE2(rqure, __LINE__) = e;                             \
-  REQUIRE(e);
+#include <functional>
+#include <memory>
+#include <string>
 
 TEST_CASE("Map extensions", "[extensions.map]") {
   auto mul2 = [](int a) { return a * 2; };
-  auto ret_void = [](int a) {};
+  auto ret_void = [](int) {};
 
   {
     tim::Result<int, int> e = 21;
@@ -143,7 +141,7 @@ TEST_CASE("Map extensions", "[extensions.map]") {
 
 TEST_CASE("Map error extensions", "[extensions.map_error]") {
   auto mul2 = [](int a) { return a * 2; };
-  auto ret_void = [](int a) {};
+  auto ret_void = [](int) {};
 
   {
     tim::Result<int, int> e = 21;
@@ -252,8 +250,8 @@ TEST_CASE("Map error extensions", "[extensions.map_error]") {
 }
 
 TEST_CASE("And then extensions", "[extensions.and_then]") {
-  auto succeed = [](int a) { return tim::Result<int, int>(21 * 2); };
-  auto fail = [](int a) { return tim::Result<int, int>(tim::in_place_error, 17); };
+  auto succeed = [](int) { return tim::Result<int, int>(21 * 2); };
+  auto fail = [](int) { return tim::Result<int, int>(tim::in_place_error, 17); };
 
   {
     tim::Result<int, int> e = 21;
@@ -370,14 +368,13 @@ TEST_CASE("And then extensions", "[extensions.and_then]") {
 
 TEST_CASE("or_else", "[extensions.or_else]") {
   using eptr = std::unique_ptr<int>;
-  auto succeed = [](int a) { return tim::Result<int, int>(21 * 2); };
-  auto succeedptr = [](eptr e) { return tim::Result<int,eptr>(21*2);};
-  auto fail =    [](int a) { return tim::Result<int,int>(tim::in_place_error, 17);};
+  auto succeed = [](int) { return tim::Result<int, int>(21 * 2); };
+  auto succeedptr = [](eptr) { return tim::Result<int,eptr>(21*2);};
+  auto fail =    [](int) { return tim::Result<int,int>(tim::in_place_error, 17);};
   auto efail =   [](eptr e) { *e = 17;return tim::Result<int,eptr>(tim::in_place_error, std::move(e));};
-  auto failptr = [](eptr e) { return tim::Result<int,eptr>(tim::in_place_error, std::move(e));};
   auto failvoid = [](int) {};
   auto failvoidptr = [](const eptr&) { /* don't consume */};
-  auto consumeptr = [](eptr) {};
+  auto consumestring = [](std::string) {};
   auto make_u_int = [](int n) { return std::unique_ptr<int>(new int(n));};
 
   {
@@ -536,10 +533,12 @@ TEST_CASE("or_else", "[extensions.or_else]") {
   }
 
   {
-    tim::Result<int, eptr> e(tim::in_place_error, make_u_int(21));
-    auto ret = std::move(e).or_else(consumeptr);
+    // A void function only observes the error, even when it takes it by value.
+    const std::string message(100, 'x');
+    tim::Result<int, std::string> e(tim::in_place_error, message);
+    auto ret = std::move(e).or_else(consumestring);
     REQUIRE(!ret);
-    REQUIRE(ret.error() == nullptr);
+    REQUIRE(ret.error() == message);
   }
 
   {
@@ -568,7 +567,7 @@ struct F {
 TEST_CASE("14", "[issue.14]") {
     auto res = tim::Result<S,F>{tim::in_place_error, F{}};
 
-    res.map_error([](F f) {
+    res.map_error([](F) {
 
     });
 }
@@ -582,3 +581,117 @@ TEST_CASE("32", "[issue.32]") {
     auto x = a.map([]{return 42;});
     REQUIRE(*x == 42);
 }
+
+TEST_CASE("Void extensions", "[extensions.void]") {
+  auto succeed = [] { return tim::Result<int, int>(42); };
+  auto fail = [] { return tim::Result<void, int>(tim::in_place_error, 17); };
+  auto recover = [](int) { return tim::Result<const void, long>(); };
+  auto mul2 = [](int a) { return a * 2; };
+
+  {
+    tim::Result<void, int> e;
+    auto ret = e.and_then(succeed);
+    REQUIRE(ret);
+    REQUIRE(*ret == 42);
+  }
+
+  {
+    const tim::Result<void, int> e(tim::in_place_error, 21);
+    auto ret = std::move(e).and_then(fail);
+    REQUIRE(!ret);
+    REQUIRE(ret.error() == 21);
+  }
+
+  {
+    tim::Result<const void, int> e(tim::in_place_error, 21);
+    auto ret = std::move(e).map_error(mul2);
+    STATIC_REQUIRE(
+        (std::is_same<decltype(ret), tim::Result<const void, int>>::value));
+    REQUIRE(!ret);
+    REQUIRE(ret.error() == 42);
+  }
+
+  {
+    tim::Result<volatile void, int> e(tim::in_place_error, 21);
+    auto ret = e.map_error([](int) {});
+    STATIC_REQUIRE(
+        (std::is_same<decltype(ret), tim::Result<volatile void, std::monostate>>::value));
+    REQUIRE(!ret);
+  }
+
+  {
+    const tim::Result<const void, int> e(tim::in_place_error, 21);
+    auto ret = e.or_else(recover);
+    REQUIRE(ret);
+  }
+
+  {
+    tim::Result<const volatile void, int> e;
+    auto ret = e.transform([] { return 42; });
+    STATIC_REQUIRE(
+        (std::is_same<decltype(ret), tim::Result<int, int>>::value));
+    REQUIRE(*ret == 42);
+  }
+}
+
+TEST_CASE("Transform extensions", "[extensions.transform]") {
+  auto mul2 = [](int a) { return a * 2; };
+
+  {
+    tim::Result<int, int> e = 21;
+    auto ret = e.transform(mul2).and_then([](int a) {
+      return tim::Result<long, int>(a + 1);
+    });
+    REQUIRE(*ret == 43);
+  }
+
+  {
+    tim::Result<std::unique_ptr<int>, int> e(std::make_unique<int>(21));
+    auto ret = std::move(e).transform([](std::unique_ptr<int>&& p) {
+      return std::move(p);
+    });
+    REQUIRE(ret);
+    REQUIRE(**ret == 21);
+    REQUIRE(*e == nullptr);
+  }
+
+  {
+    tim::Result<int, int> e(tim::in_place_error, 21);
+    auto ret = e.transform_error(mul2);
+    REQUIRE(ret.error() == 42);
+  }
+}
+
+TEST_CASE("Member pointer extensions", "[extensions.member]") {
+  struct Point {
+    int x;
+    int y;
+
+    int sum() const { return x + y; }
+  };
+
+  {
+    tim::Result<Point, int> e(Point{1, 2});
+    REQUIRE(*e.map(&Point::x) == 1);
+    REQUIRE(*e.map(&Point::sum) == 3);
+    auto moved = std::move(e).map(&Point::y);
+    REQUIRE(*moved == 2);
+  }
+
+  {
+    Point p{3, 4};
+    tim::Result<Point*, int> e(&p);
+    REQUIRE(*e.map(&Point::sum) == 7);
+  }
+
+  {
+    Point p{5, 6};
+    tim::Result<std::reference_wrapper<Point>, int> e(std::ref(p));
+    REQUIRE(*e.map(&Point::x) == 5);
+  }
+
+  {
+    tim::Result<std::unique_ptr<Point>, int> e(std::make_unique<Point>(Point{7, 8}));
+    REQUIRE(*e.map(&Point::sum) == 15);
+  }
+}
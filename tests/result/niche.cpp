@@ -0,0 +1,154 @@
+#include "catch.hpp"
+#include "tim/result/Result.hpp"
+#include "tim/result/reference_wrapper.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace {
+
+enum class Code: unsigned char {
+	Ok,
+	NotFound,
+	Invalid = 0xFF
+};
+
+struct Aligned {
+	int value;
+};
+
+struct Empty {};
+
+} /* namespace */
+
+template <>
+struct tim::traits::niche_traits<Code>: tim::traits::enum_niche<Code, Code::Invalid> {};
+
+template <>
+struct tim::traits::niche_traits<Aligned*>: tim::traits::pointer_low_bit_niche<Aligned*> {};
+
+TEST_CASE("Niche Layout", "[niche.layout]") {
+	// Pointers only have a niche when their type opts in.
+	static_assert(tim::traits::has_niche_v<Aligned*>);
+	static_assert(!tim::traits::has_niche_v<const Aligned*>);
+	static_assert(!tim::traits::has_niche_v<int*>);
+	static_assert(!tim::traits::has_niche_v<std::max_align_t*>);
+	static_assert(!tim::traits::has_niche_v<char*>);
+	static_assert(!tim::traits::has_niche_v<void*>);
+	static_assert(tim::traits::has_niche_v<std::unique_ptr<Aligned>>);
+	static_assert(!tim::traits::has_niche_v<std::unique_ptr<int>>);
+	static_assert(tim::traits::has_niche_v<std::reference_wrapper<char>>);
+	static_assert(tim::traits::has_niche_v<Code>);
+	static_assert(!tim::traits::has_niche_v<int>);
+
+	static_assert(sizeof(tim::Result<Aligned*, Code>) == sizeof(void*));
+	static_assert(sizeof(tim::Result<std::unique_ptr<Aligned>, Code>) == sizeof(void*));
+	static_assert(sizeof(tim::Result<std::reference_wrapper<Aligned>, Code>) == sizeof(void*));
+	static_assert(sizeof(tim::Result<std::reference_wrapper<char>, Empty>) == sizeof(void*));
+	static_assert(sizeof(tim::Result<void, Code>) == sizeof(Code));
+	static_assert(sizeof(tim::Result<Empty, Code>) == sizeof(Code));
+	static_assert(sizeof(tim::Result<char*, Code>) > sizeof(void*));
+	static_assert(sizeof(tim::Result<int*, Code>) > sizeof(void*));
+	static_assert(sizeof(tim::Result<Aligned*, std::string>) > sizeof(std::string));
+	if constexpr(sizeof(void*) > sizeof(int)) {
+		static_assert(sizeof(tim::Result<Aligned*, int>) == sizeof(void*));
+	}
+
+	static_assert(std::is_trivially_copyable_v<tim::Result<Aligned*, Code>>);
+	static_assert(std::is_trivially_copyable_v<tim::Result<void, Code>>);
+	static_assert(!std::is_trivially_destructible_v<tim::Result<std::unique_ptr<Aligned>, Code>>);
+}
+
+TEST_CASE("Niche In Value", "[niche.value]") {
+	Aligned a{1};
+	Aligned b{2};
+	{
+		tim::Result<Aligned*, Code> r(&a);
+		REQUIRE(r.has_value());
+		REQUIRE((*r)->value == 1);
+		r = tim::Error(Code::NotFound);
+		REQUIRE(!r.has_value());
+		REQUIRE(r.error() == Code::NotFound);
+		r = &b;
+		REQUIRE(r.has_value());
+		REQUIRE(*r == &b);
+	}
+	{
+		tim::Result<Aligned*, Code> r(nullptr);
+		REQUIRE(r.has_value());
+		REQUIRE(*r == nullptr);
+	}
+	{
+		tim::Result<Aligned*, Code> r(tim::in_place_error, Code::Ok);
+		REQUIRE(!r.has_value());
+		REQUIRE(r.error() == Code::Ok);
+		tim::Result<Aligned*, Code> copy(r);
+		REQUIRE(!copy.has_value());
+		REQUIRE(copy.error() == Code::Ok);
+		copy = tim::Result<Aligned*, Code>(&a);
+		REQUIRE(copy.has_value());
+		r = copy;
+		REQUIRE(r.has_value());
+		REQUIRE(*r == &a);
+	}
+	{
+		tim::Result<std::unique_ptr<Aligned>, Code> r(std::make_unique<Aligned>(Aligned{3}));
+		tim::Result<std::unique_ptr<Aligned>, Code> s(tim::in_place_error, Code::NotFound);
+		REQUIRE(r.has_value());
+		REQUIRE(!s.has_value());
+		swap(r, s);
+		REQUIRE(!r.has_value());
+		REQUIRE(r.error() == Code::NotFound);
+		REQUIRE(s.has_value());
+		REQUIRE((*s)->value == 3);
+		r = std::move(s);
+		REQUIRE(r.has_value());
+		REQUIRE((*r)->value == 3);
+		r = tim::Error(Code::Ok);
+		REQUIRE(!r.has_value());
+	}
+	{
+		tim::Result<std::reference_wrapper<Aligned>, Code> r(std::ref(a));
+		REQUIRE(r.has_value());
+		REQUIRE(r->get().value == 1);
+		r = tim::Error(Code::Ok);
+		REQUIRE(!r.has_value());
+	}
+	{
+		char c = 'c';
+		tim::Result<std::reference_wrapper<char>, Empty> r(tim::in_place_error);
+		REQUIRE(!r.has_value());
+		r = std::ref(c);
+		REQUIRE(r.has_value());
+		REQUIRE(r->get() == 'c');
+	}
+}
+
+TEST_CASE("Niche In Error", "[niche.error]") {
+	{
+		tim::Result<void, Code> r;
+		REQUIRE(r.has_value());
+		r = tim::Error(Code::NotFound);
+		REQUIRE(!r.has_value());
+		REQUIRE(r.error() == Code::NotFound);
+		r.emplace();
+		REQUIRE(r.has_value());
+	}
+	{
+		tim::Result<void, Code> r(tim::in_place_error, Code::Ok);
+		tim::Result<void, Code> s;
+		REQUIRE(!r.has_value());
+		r.swap(s);
+		REQUIRE(r.has_value());
+		REQUIRE(!s.has_value());
+		REQUIRE(s.error() == Code::Ok);
+	}
+	{
+		tim::Result<Empty, Code> r(tim::in_place_error, Code::NotFound);
+		REQUIRE(!r.has_value());
+		r = Empty{};
+		REQUIRE(r.has_value());
+	}
+}
@@ -0,0 +1,177 @@
+#include "catch.hpp"
+#include "tim/result/pipeline.hpp"
+
+#include <array>
+#include <memory>
+#include <string>
+
+namespace {
+
+struct Big {
+	static int moves;
+	static int copies;
+
+	Big() = default;
+	explicit Big(int v) { data[0] = v; }
+	Big(const Big& other): data(other.data) { ++copies; }
+	Big(Big&& other) noexcept: data(other.data) { ++moves; }
+	Big& operator=(const Big&) = default;
+	Big& operator=(Big&&) = default;
+
+	static void reset() {
+		moves = 0;
+		copies = 0;
+	}
+
+	std::array<int, 256> data{};
+};
+
+int Big::moves = 0;
+int Big::copies = 0;
+
+Big grow(const Big& b) {
+	return Big(b.data[0] + 1);
+}
+
+tim::Result<Big, std::string> check(Big&& b) {
+	if(b.data[0] > 100) {
+		return tim::Error(std::string("too big"));
+	}
+	return std::move(b);
+}
+
+} /* namespace */
+
+TEST_CASE("Pipeline", "[pipeline]") {
+	using tim::pipeline::pipe;
+	using tim::pipeline::map;
+	using tim::pipeline::map_error;
+	using tim::pipeline::and_then;
+	using tim::pipeline::or_else;
+
+	{
+		tim::Result<int, std::string> r = 20;
+		tim::Result<long, std::size_t> out = pipe(r)
+			| map([](int i) { return i * 2; })
+			| and_then([](int i) { return tim::Result<long, std::string>(i + 2L); })
+			| map_error([](const std::string& s) { return s.size(); });
+		REQUIRE(out.has_value());
+		REQUIRE(*out == 42);
+		REQUIRE(*r == 20);
+	}
+	{
+		const tim::Result<int, std::string> r(tim::in_place_error, "nope");
+		auto out = (pipe(r)
+			| map([](int i) { return i * 2; })
+			| map_error([](const std::string& s) { return s.size(); })).run();
+		static_assert(std::is_same_v<decltype(out), tim::Result<int, std::size_t>>);
+		REQUIRE(!out.has_value());
+		REQUIRE(out.error() == 4u);
+		REQUIRE(r.error() == "nope");
+	}
+	{
+		tim::Result<int, int> out = pipe(tim::Result<int, int>(tim::in_place_error, 1))
+			| or_else([](int e) { return tim::Result<int, int>(e + 1); })
+			| map([](int i) { return i * 10; });
+		REQUIRE(*out == 20);
+	}
+	{
+		int seen = 0;
+		tim::Result<void, int> out = pipe(tim::Result<void, int>(tim::in_place_error, 3))
+			| or_else([&](int e) { seen = e; })
+			| map([] {});
+		REQUIRE(seen == 3);
+		REQUIRE(out.error() == 3);
+	}
+	{
+		// A void function only observes the error, even when it takes it by value.
+		const std::string message(100, 'x');
+		tim::Result<int, std::string> r(tim::in_place_error, message);
+		tim::Result<int, std::string> out = pipe(std::move(r))
+			| or_else([](std::string) {});
+		REQUIRE(out.error() == message);
+	}
+	{
+		tim::Result<const void, int> r;
+		auto out = (pipe(r) | map_error([](int) {})).run();
+		static_assert(std::is_same_v<decltype(out), tim::Result<const void, std::monostate>>);
+		REQUIRE(out.has_value());
+	}
+	{
+		tim::Result<std::unique_ptr<int>, int> r(std::make_unique<int>(4));
+		tim::Result<int, int> out = pipe(std::move(r))
+			| map([](std::unique_ptr<int>&& p) { return std::move(p); })
+			| map([](std::unique_ptr<int>&& p) { return *p; });
+		REQUIRE(*out == 4);
+		REQUIRE(*r == nullptr);
+	}
+}
+
+TEST_CASE("Pipeline Lifetime", "[pipeline.lifetime]") {
+	using tim::pipeline::pipe;
+	using tim::pipeline::map;
+	using tim::pipeline::or_else;
+
+	const std::string message(100, 'x');
+	auto make = [&] { return tim::Result<std::string, int>(tim::in_place, message); };
+	// A chain holds no source, so it can be kept past the full-expression
+	// that creates it, and run over temporaries later.
+	auto steps = map([](std::string&& s) { return s.size(); });
+	auto more = std::move(steps) | or_else([](int) {});
+	tim::Result<std::size_t, int> out = more(make());
+	REQUIRE(*out == message.size());
+	out = more(tim::Result<std::string, int>(tim::in_place, "abc"));
+	REQUIRE(*out == 3);
+
+	tim::Result<std::string, int> r(tim::in_place, message);
+	tim::Result<std::string, int> appended = pipe(r)
+		| map([](std::string& s) -> std::string& { return s += "y"; });
+	REQUIRE(*r == message + "y");
+	REQUIRE(*appended == message + "y");
+}
+
+TEST_CASE("Pipeline Intermediate Moves", "[pipeline.moves]") {
+	using tim::pipeline::pipe;
+	using tim::pipeline::map;
+	using tim::pipeline::and_then;
+
+	tim::Result<Big, std::string> r(tim::in_place, 1);
+	{
+		Big::reset();
+		auto eager = r.map(grow).map(grow).map(grow);
+		REQUIRE(eager->data[0] == 4);
+		REQUIRE(Big::moves == 3);
+	}
+	{
+		Big::reset();
+		tim::Result<Big, std::string> fused = pipe(r) | map(grow) | map(grow) | map(grow);
+		REQUIRE(fused->data[0] == 4);
+		REQUIRE(Big::moves == 0);
+		REQUIRE(Big::copies == 0);
+	}
+	{
+		Big::reset();
+		tim::Result<Big, std::string> fused = pipe(r) | map(grow) | and_then(check);
+		REQUIRE(fused->data[0] == 2);
+		REQUIRE(Big::moves == 1);
+		REQUIRE(Big::copies == 0);
+	}
+	{
+		// The source is bound once, when the pipeline runs, however many
+		// steps it has.
+		Big::reset();
+		auto pass = [](Big&& b) -> Big&& { return std::move(b); };
+		tim::Result<Big, std::string> owned(tim::in_place, 1);
+		tim::Result<Big, std::string> fused = pipe(std::move(owned))
+			| map(pass) | map(pass) | map(pass) | map(pass) | map(pass) | map(pass);
+		REQUIRE(fused->data[0] == 1);
+		REQUIRE(Big::moves == 1);
+		REQUIRE(Big::copies == 0);
+	}
+	{
+		tim::Result<Big, std::string> big(tim::in_place, 1000);
+		tim::Result<Big, std::string> fused = pipe(std::move(big)) | and_then(check) | map(grow);
+		REQUIRE(!fused.has_value());
+		REQUIRE(fused.error() == "too big");
+	}
+}
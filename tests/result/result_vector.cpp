@@ -0,0 +1,138 @@
+#include "catch.hpp"
+#include "tim/result/ResultVector.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+TEST_CASE("Result Vector", "[result_vector]") {
+	tim::ResultVector<std::string, int> v;
+	REQUIRE(v.empty());
+	v.emplace_back(tim::in_place, "one");
+	v.emplace_back(tim::in_place_error, 2);
+	v.push_back(tim::Result<std::string, int>(tim::in_place, "three"));
+	const tim::Result<std::string, int> four(tim::in_place_error, 4);
+	v.push_back(four);
+	REQUIRE(v.size() == 4u);
+
+	REQUIRE(v[0].has_value());
+	REQUIRE(*v[0] == "one");
+	REQUIRE(v[0]->size() == 3u);
+	REQUIRE(!v[1]);
+	REQUIRE(v[1].error() == 2);
+	REQUIRE(v[1].value_or("none") == "none");
+	REQUIRE_THROWS_AS(v[1].value(), tim::BadResultAccess<int>);
+	REQUIRE(v[2].value() == "three");
+
+	tim::Result<std::string, int> copy = v[3];
+	REQUIRE(copy.error() == 4);
+
+	// Assigning through a reference switches the alternative.
+	v[0] = tim::Result<std::string, int>(tim::in_place_error, 10);
+	v[1] = tim::Result<std::string, int>(tim::in_place, "two");
+	REQUIRE(v[0].error() == 10);
+	REQUIRE(*v[1] == "two");
+	v[3] = v[1];
+	REQUIRE(*v[3] == "two");
+	REQUIRE(*v[1] == "two");
+
+	const auto& cv = v;
+	tim::ResultVector<std::string, int>::const_reference r = cv[1];
+	REQUIRE(*r == "two");
+
+	int values = 0;
+	for(auto e: v) {
+		values += e.has_value();
+	}
+	REQUIRE(values == 3);
+	REQUIRE(v.end() - v.begin() == 4);
+
+	auto moved = std::move(v);
+	REQUIRE(moved.size() == 4u);
+	REQUIRE(v.empty());
+	auto copied = moved;
+	REQUIRE(*copied[3] == "two");
+	copied.pop_back();
+	REQUIRE(copied.size() == 3u);
+	REQUIRE(copied.count_values() == 2u);
+}
+
+TEST_CASE("Result Vector Aliasing", "[result_vector.aliasing]") {
+	// Growing the storage must not invalidate an argument that refers to an
+	// element before the new element is constructed from it.
+	const std::string message(100, 'x');
+	tim::ResultVector<std::string, std::string> v;
+	v.emplace_back(tim::in_place, message);
+	v.emplace_back(tim::in_place_error, message + "e");
+	while(v.size() < v.capacity()) {
+		v.emplace_back(tim::in_place, "filler");
+	}
+	v.emplace_back(tim::in_place, *v[0]);
+	v.emplace_back(tim::in_place_error, v[1].error());
+	REQUIRE(v.size() > 64u);
+	REQUIRE(*v[v.size() - 2u] == message);
+	REQUIRE(v[v.size() - 1u].error() == message + "e");
+	REQUIRE(*v[0] == message);
+}
+
+TEST_CASE("Result Vector Bitmap Scans", "[result_vector.scan]") {
+	tim::ResultVector<double, std::uint16_t> v;
+	std::vector<std::size_t> errors;
+	for(std::size_t i = 0; i < 1000; ++i) {
+		if(i % 7 == 3 || i == 999) {
+			v.emplace_back(tim::in_place_error, static_cast<std::uint16_t>(i));
+			errors.push_back(i);
+		} else {
+			v.emplace_back(tim::in_place, static_cast<double>(i));
+		}
+	}
+	REQUIRE(v.count_errors() == errors.size());
+	REQUIRE(v.count_values() == 1000u - errors.size());
+
+	std::vector<std::size_t> seen;
+	for(std::size_t i = v.find_error(); i != v.size(); i = v.find_error(i + 1)) {
+		seen.push_back(i);
+	}
+	REQUIRE(seen == errors);
+
+	seen.clear();
+	v.for_each_error([&](std::size_t i, std::uint16_t e) {
+		REQUIRE(e == i);
+		seen.push_back(i);
+	});
+	REQUIRE(seen == errors);
+
+	double sum = 0.0;
+	std::size_t count = 0;
+	v.for_each_value([&](std::size_t i, double& x) {
+		REQUIRE(x == static_cast<double>(i));
+		sum += x;
+		++count;
+	});
+	REQUIRE(count == v.count_values());
+	REQUIRE(v.find_value(3) == 4u);
+	REQUIRE(v.find_value(999) == v.size());
+	REQUIRE(v.find_error(1000) == v.size());
+
+	// Bits past 'size()' are never reported.
+	v.pop_back();
+	REQUIRE(v.count_errors() == errors.size() - 1u);
+	REQUIRE(v.find_error(998) == v.size());
+}
+
+TEST_CASE("Result Vector Layout", "[result_vector.layout]") {
+	// One slot per element; 'Result<double, std::uint16_t>' needs 16 bytes.
+	STATIC_REQUIRE(sizeof(tim::detail::ResultSlot<double, std::uint16_t>) == sizeof(double));
+	STATIC_REQUIRE(sizeof(tim::Result<double, std::uint16_t>) == 2 * sizeof(double));
+
+	tim::ResultVector<std::unique_ptr<int>, std::string> v;
+	for(int i = 0; i < 200; ++i) {
+		v.emplace_back(tim::in_place, std::make_unique<int>(i));
+	}
+	REQUIRE(v.capacity() >= 200u);
+	REQUIRE(**v[199] == 199);
+	v.clear();
+	REQUIRE(v.empty());
+	REQUIRE(v.count_values() == 0u);
+}
@@ -0,0 +1,191 @@
+#include "catch.hpp"
+#include "tim/result/scan.hpp"
+
+#include <array>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Bytes3 {
+	char c[3];
+};
+
+struct Bytes5 {
+	char c[5];
+};
+
+struct Floats3 {
+	float f[3];
+};
+
+struct Words5 {
+	std::uint64_t w[5];
+};
+
+struct Words9 {
+	std::uint64_t w[9];
+};
+
+struct Node {
+	int value;
+};
+
+template <class T>
+T make_value(std::size_t i) {
+	T t{};
+	// Fill the value with a non-zero pattern so that the kernels cannot get
+	// away with reading the wrong byte.
+	auto* p = reinterpret_cast<unsigned char*>(&t);
+	for(std::size_t j = 0; j < sizeof(T); ++j) {
+		p[j] = static_cast<unsigned char>(0xA5u ^ (i + j));
+	}
+	return t;
+}
+
+template <class T, class E>
+std::vector<tim::Result<T, E>> make_results(std::size_t n, unsigned error_percent, std::mt19937& rng) {
+	std::vector<tim::Result<T, E>> rs;
+	rs.reserve(n);
+	std::uniform_int_distribution<unsigned> dist(0, 99);
+	for(std::size_t i = 0; i < n; ++i) {
+		if(dist(rng) < error_percent) {
+			rs.emplace_back(tim::in_place_error, make_value<E>(i));
+		} else if constexpr(std::is_void_v<T>) {
+			rs.emplace_back(tim::in_place);
+		} else {
+			rs.emplace_back(tim::in_place, make_value<T>(i));
+		}
+	}
+	return rs;
+}
+
+const std::array<tim::detail::StatusKernel, 4> kernels{
+	tim::detail::StatusKernel::Scalar,
+	tim::detail::StatusKernel::SSE2,
+	tim::detail::StatusKernel::AVX2,
+	tim::detail::StatusKernel::NEON
+};
+
+template <class T, class E>
+void check_kernels() {
+	static_assert(tim::detail::has_status_layout_v<T, E>);
+	constexpr auto layout = tim::detail::status_layout<T, E>();
+	std::mt19937 rng(42);
+	for(std::size_t n: {0u, 1u, 2u, 31u, 63u, 64u, 65u, 200u, 1000u, 5000u}) {
+		for(unsigned error_percent: {0u, 1u, 50u, 100u}) {
+			auto rs = make_results<T, E>(n, error_percent, rng);
+			std::size_t values = 0;
+			std::size_t first_error = n;
+			std::vector<std::uint64_t> bitmap((n + 63u) / 64u, 0u);
+			for(std::size_t i = 0; i < n; ++i) {
+				if(rs[i].has_value()) {
+					++values;
+					bitmap[i / 64u] |= std::uint64_t(1) << (i % 64u);
+				} else if(first_error == n) {
+					first_error = i;
+				}
+			}
+			const auto* bytes = tim::detail::result_bytes(rs.data());
+			for(auto kernel: kernels) {
+				if(!tim::detail::status_kernel_supported(kernel)) {
+					continue;
+				}
+				INFO("kernel " << static_cast<int>(kernel) << ", n " << n << ", errors " << error_percent << "%");
+				REQUIRE(tim::detail::count_flags(kernel, bytes, n, layout) == values);
+				REQUIRE(tim::detail::find_clear_flag(kernel, bytes, n, layout) == first_error);
+				std::vector<std::uint64_t> words(bitmap.size(), ~std::uint64_t(0));
+				tim::detail::flag_bitmap(kernel, bytes, n, layout, words.data());
+				REQUIRE(words == bitmap);
+			}
+			REQUIRE(tim::count_values(rs) == values);
+			REQUIRE(tim::count_errors(rs) == n - values);
+			REQUIRE(tim::find_error(rs) == first_error);
+		}
+	}
+}
+
+} /* namespace */
+
+template <>
+struct tim::traits::niche_traits<Node*>: tim::traits::pointer_low_bit_niche<Node*> {};
+
+TEST_CASE("Scan Kernels", "[scan]") {
+	check_kernels<char, char>();
+	check_kernels<int, int>();
+	check_kernels<double, std::uint16_t>();
+	check_kernels<Bytes3, char>();
+	check_kernels<Bytes5, char>();
+	check_kernels<Floats3, int>();
+	check_kernels<Words5, int>();
+	check_kernels<Words9, int>();
+	check_kernels<void, int>();
+}
+
+TEST_CASE("Scan Without Flag Layout", "[scan]") {
+	// The discriminant of 'Result<Node*, int>' lives in the pointer's low bit.
+	static_assert(!tim::detail::has_status_layout_v<Node*, int>);
+	static_assert(!tim::detail::has_status_layout_v<std::string, int>);
+	Node x{0};
+	const tim::Result<Node*, int> ps[3] = {
+		tim::Result<Node*, int>(tim::in_place, &x),
+		tim::Result<Node*, int>(tim::in_place_error, 1),
+		tim::Result<Node*, int>(tim::in_place_error, 2)
+	};
+	REQUIRE(tim::count_values(ps) == 1u);
+	REQUIRE(tim::find_error(ps) == 1u);
+
+	std::vector<tim::Result<std::string, int>> rs;
+	rs.emplace_back(tim::in_place, "a");
+	rs.emplace_back(tim::in_place, "b");
+	rs.emplace_back(tim::in_place_error, 3);
+	rs.emplace_back(tim::in_place, "d");
+	REQUIRE(tim::count_values(rs) == 3u);
+	REQUIRE(tim::count_errors(rs) == 1u);
+	REQUIRE(tim::find_error(rs) == 2u);
+	std::uint64_t word = 0;
+	tim::status_bitmap(rs, &word);
+	REQUIRE(word == 0b1011u);
+	std::vector<std::string> values;
+	std::vector<int> errors;
+	tim::partition_copy(rs, std::back_inserter(values), std::back_inserter(errors));
+	REQUIRE(values == std::vector<std::string>{"a", "b", "d"});
+	REQUIRE(errors == std::vector<int>{3});
+}
+
+TEST_CASE("Scan Partition", "[scan]") {
+	std::mt19937 rng(7);
+	auto rs = make_results<int, int>(3000, 30, rng);
+	std::vector<int> expected_values;
+	std::vector<int> expected_errors;
+	for(const auto& r: rs) {
+		if(r) {
+			expected_values.push_back(*r);
+		} else {
+			expected_errors.push_back(r.error());
+		}
+	}
+	std::vector<int> values;
+	std::vector<int> errors;
+	auto [v, e] = tim::partition_copy(rs.data(), rs.size(), std::back_inserter(values), std::back_inserter(errors));
+	(void)v;
+	(void)e;
+	REQUIRE(values == expected_values);
+	REQUIRE(errors == expected_errors);
+
+	const std::array<tim::Result<int, int>, 3> arr{{
+		tim::Result<int, int>(tim::in_place_error, 1),
+		tim::Result<int, int>(tim::in_place, 2),
+		tim::Result<int, int>(tim::in_place_error, 3)
+	}};
+	int vout[3] = {};
+	int eout[3] = {};
+	auto ends = tim::partition_copy(arr, vout, eout);
+	REQUIRE(ends.first == vout + 1);
+	REQUIRE(ends.second == eout + 2);
+	REQUIRE(vout[0] == 2);
+	REQUIRE(eout[0] == 1);
+	REQUIRE(eout[1] == 3);
+}
@@ -0,0 +1,101 @@
+#include "catch.hpp"
+#include "tim/result/Result.hpp"
+
+#include <memory>
+#include <string>
+#include <type_traits>
+
+namespace {
+
+struct CopyOnly {
+	CopyOnly(const CopyOnly&) = default;
+	CopyOnly(CopyOnly&&) = delete;
+	CopyOnly& operator=(const CopyOnly&) = default;
+	CopyOnly& operator=(CopyOnly&&) = delete;
+};
+
+struct NoDefault {
+	NoDefault(int) {}
+};
+
+struct ThrowingMove {
+	ThrowingMove() = default;
+	ThrowingMove(const ThrowingMove&) {}
+	ThrowingMove(ThrowingMove&&) noexcept(false) {}
+	ThrowingMove& operator=(const ThrowingMove&) { return *this; }
+	ThrowingMove& operator=(ThrowingMove&&) noexcept(false) { return *this; }
+};
+
+struct NonTrivialDestructor {
+	~NonTrivialDestructor() {}
+};
+
+template <class A, class B>
+constexpr bool same_special_members() {
+	return std::is_default_constructible_v<A> == std::is_default_constructible_v<B>
+		&& std::is_copy_constructible_v<A> == std::is_copy_constructible_v<B>
+		&& std::is_move_constructible_v<A> == std::is_move_constructible_v<B>
+		&& std::is_copy_assignable_v<A> == std::is_copy_assignable_v<B>
+		&& std::is_move_assignable_v<A> == std::is_move_assignable_v<B>
+		&& std::is_trivially_copy_constructible_v<A> == std::is_trivially_copy_constructible_v<B>
+		&& std::is_trivially_move_constructible_v<A> == std::is_trivially_move_constructible_v<B>
+		&& std::is_trivially_copy_assignable_v<A> == std::is_trivially_copy_assignable_v<B>
+		&& std::is_trivially_move_assignable_v<A> == std::is_trivially_move_assignable_v<B>
+		&& std::is_trivially_destructible_v<A> == std::is_trivially_destructible_v<B>
+		&& std::is_trivially_copyable_v<A> == std::is_trivially_copyable_v<B>
+		&& std::is_nothrow_move_constructible_v<A> == std::is_nothrow_move_constructible_v<B>
+		&& std::is_nothrow_copy_assignable_v<A> == std::is_nothrow_copy_assignable_v<B>
+		&& std::is_nothrow_move_assignable_v<A> == std::is_nothrow_move_assignable_v<B>;
+}
+
+// Whatever 'result_data_type' is, it has the special members of the chain of
+// base classes.
+template <class T, class E>
+constexpr bool matches_chain() {
+	using tim::detail::result_data_type;
+	using tim::detail::result_move_assign_type;
+	return same_special_members<result_data_type<T, E>, result_move_assign_type<T, E>>();
+}
+
+static_assert(matches_chain<int, int>());
+static_assert(matches_chain<void, int>());
+static_assert(matches_chain<int*, int>());
+static_assert(matches_chain<std::string, int>());
+static_assert(matches_chain<int, std::string>());
+static_assert(matches_chain<std::unique_ptr<int>, int>());
+static_assert(matches_chain<void, std::unique_ptr<int>>());
+static_assert(matches_chain<CopyOnly, int>());
+static_assert(matches_chain<int, CopyOnly>());
+static_assert(matches_chain<NoDefault, int>());
+static_assert(matches_chain<ThrowingMove, int>());
+static_assert(matches_chain<ThrowingMove, ThrowingMove>());
+static_assert(matches_chain<NonTrivialDestructor, int>());
+
+} /* namespace */
+
+TEST_CASE("Special Members", "[special_members]") {
+	using R = tim::Result<std::string, int>;
+	R a(tim::in_place, "value");
+	R b(tim::in_place_error, 3);
+	R c(a);
+	R d(std::move(b));
+	REQUIRE(c.value() == "value");
+	REQUIRE(d.error() == 3);
+	c = d;
+	REQUIRE(c.error() == 3);
+	d = a;
+	REQUIRE(d.value() == "value");
+	c = std::move(d);
+	REQUIRE(c.value() == "value");
+
+	using P = tim::Result<std::unique_ptr<int>, int>;
+	P p(tim::in_place, std::make_unique<int>(5));
+	P q(std::move(p));
+	REQUIRE(*q.value() == 5);
+	p = P(tim::in_place_error, 1);
+	q = std::move(p);
+	REQUIRE(q.error() == 1);
+
+	const tim::Result<int, long> r;
+	REQUIRE(r.value() == 0);
+}
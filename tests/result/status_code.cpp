@@ -0,0 +1,121 @@
+#include "catch.hpp"
+#include "tim/result/status_code.hpp"
+
+#include <cerrno>
+#include <cstdint>
+#include <future>
+#include <string>
+#include <system_error>
+
+namespace {
+
+class StorageCategory: public std::error_category {
+public:
+	const char* name() const noexcept override {
+		return "storage";
+	}
+
+	std::string message(int value) const override {
+		return "storage error " + std::to_string(value);
+	}
+};
+
+const StorageCategory& storage_category() {
+	static const StorageCategory category;
+	return category;
+}
+
+tim::Result<std::uint32_t, tim::status_code> read_page(std::uint32_t page) {
+	if(page == 0u) {
+		return tim::make_error(tim::status_code(std::errc::invalid_argument));
+	}
+	if(page > 100u) {
+		return tim::make_error(tim::status_code(-7, storage_category()));
+	}
+	return page * 2u;
+}
+
+} /* namespace */
+
+TEST_CASE("Status Code Layout", "[status_code.layout]") {
+	static_assert(sizeof(tim::status_code) == 4u);
+	static_assert(std::is_trivially_copyable_v<tim::status_code>);
+	static_assert(sizeof(tim::Result<std::uint32_t, tim::status_code>) == 8u);
+	static_assert(sizeof(tim::Result<std::uint16_t, tim::status_code>) == 4u);
+	static_assert(sizeof(tim::Result<void, tim::status_code>) == 4u);
+	static_assert(std::is_trivially_copyable_v<tim::Result<std::uint32_t, tim::status_code>>);
+	static_assert(sizeof(tim::Result<std::uint32_t, tim::status_code>) < sizeof(tim::Result<std::uint32_t, std::error_code>));
+
+	constexpr tim::status_code none;
+	static_assert(none.value() == 0 && !none);
+	static_assert(none.category_index() == tim::status_code::system_category);
+	constexpr tim::status_code low(tim::status_code::min_value, tim::status_code::generic_category);
+	static_assert(low.value() == tim::status_code::min_value);
+	static_assert(low.category_index() == tim::status_code::generic_category);
+	constexpr tim::status_code high(tim::status_code::max_value, tim::status_code::generic_category);
+	static_assert(high.value() == tim::status_code::max_value);
+}
+
+TEST_CASE("Status Code", "[status_code]") {
+	SECTION("Standard categories") {
+		tim::status_code code(std::errc::no_such_file_or_directory);
+		REQUIRE(code);
+		REQUIRE(code.value() == ENOENT);
+		REQUIRE(&code.category() == &std::generic_category());
+		REQUIRE(code == std::errc::no_such_file_or_directory);
+		REQUIRE(code.message() == std::generic_category().message(ENOENT));
+		const std::error_code ec = code;
+		REQUIRE(ec == std::make_error_code(std::errc::no_such_file_or_directory));
+		REQUIRE(tim::status_code(std::error_code(EIO, std::system_category())).category_index() == tim::status_code::system_category);
+	}
+	SECTION("Registered categories") {
+		const tim::status_category index = tim::status_code::register_category(storage_category());
+		REQUIRE(index.index >= 2u);
+		REQUIRE(tim::status_code::register_category(storage_category()) == index);
+		tim::status_code code(-42, storage_category());
+		REQUIRE(code.category_index() == index);
+		REQUIRE(code.value() == -42);
+		REQUIRE(code == tim::status_code(-42, index));
+		REQUIRE(code.message() == "storage error -42");
+		const std::error_code ec = code;
+		REQUIRE(&ec.category() == &storage_category());
+		REQUIRE(ec.value() == -42);
+		REQUIRE(tim::status_code(ec) == code);
+		REQUIRE(code == ec);
+		REQUIRE(ec == code);
+		REQUIRE(code != tim::status_code(42, storage_category()));
+	}
+	SECTION("Error code enumerations") {
+		tim::status_code code(std::future_errc::no_state);
+		REQUIRE(&code.category() == &std::future_category());
+		REQUIRE(code == std::make_error_code(std::future_errc::no_state));
+	}
+	SECTION("Out of range") {
+		REQUIRE_THROWS_AS(tim::status_code(tim::status_code::max_value + 1, std::generic_category()), std::out_of_range);
+		REQUIRE_THROWS_AS(tim::status_code(std::error_code(tim::status_code::min_value - 1, std::system_category())), std::out_of_range);
+	}
+	SECTION("Results") {
+		auto r = read_page(21u);
+		REQUIRE(*r == 42u);
+		auto e = read_page(0u);
+		REQUIRE(!e.has_value());
+		REQUIRE(e.error() == std::errc::invalid_argument);
+		auto s = read_page(101u);
+		REQUIRE(!s.has_value());
+		REQUIRE(s.error().value() == -7);
+		REQUIRE(&s.error().category() == &storage_category());
+		s = 3u;
+		REQUIRE(*s == 3u);
+		tim::Result<void, tim::status_code> v(tim::in_place_error, std::errc::timed_out);
+		REQUIRE(!v.has_value());
+		REQUIRE(v.error() == std::errc::timed_out);
+		v = tim::Result<void, tim::status_code>();
+		REQUIRE(v.has_value());
+		tim::Result<std::uint16_t, tim::status_code> w(std::uint16_t(0xFFFFu));
+		REQUIRE(w.has_value());
+		REQUIRE(*w == 0xFFFFu);
+		w = tim::make_error(tim::status_code(-1, tim::status_code::generic_category));
+		REQUIRE(!w.has_value());
+		REQUIRE(w.error().value() == -1);
+	}
+}
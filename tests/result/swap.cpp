@@ -1,6 +1,8 @@
 #include "catch.hpp"
 #include "tim/result/Result.hpp"
 #include <cassert>
+#include <memory>
+#include <string>
 #include <utility>
 
 struct no_throw {
@@ -825,4 +827,99 @@ TEST_CASE("Noexcept Swap Not Swappable") {
 	std::swap(v1, v2);
 }
 
+template <class V>
+void check_void_swap() {
+	using R = tim::Result<V, int>;
+	R v1;
+	R v2(tim::in_place_error, 7);
+	v1.swap(v2);
+	REQUIRE(!v1.has_value());
+	REQUIRE(v1.error() == 7);
+	REQUIRE(v2.has_value());
+	v1.swap(v2);
+	REQUIRE(v1.has_value());
+	REQUIRE(!v2.has_value());
+	REQUIRE(v2.error() == 7);
+	swap(v1, v2);
+	REQUIRE(!v1.has_value());
+	REQUIRE(v2.has_value());
+	tim::result::swap(v1, v2);
+	REQUIRE(v1.has_value());
+	REQUIRE(!v2.has_value());
+}
+
+TEST_CASE("Swap CV Void") {
+	check_void_swap<void>();
+	check_void_swap<const void>();
+	check_void_swap<volatile void>();
+	check_void_swap<const volatile void>();
+}
+
 } /* namespace swap_test_namespace */
+
+namespace relocation_test {
+
+// Relocatable, but counts the moves that swapping would otherwise perform.
+struct Counted {
+	static inline int moves = 0;
+	Counted(int v): v(std::make_unique<int>(v)) {}
+	Counted(Counted&& other) noexcept: v(std::move(other.v)) { ++moves; }
+	Counted& operator=(Counted&& other) noexcept { v = std::move(other.v); ++moves; return *this; }
+	std::unique_ptr<int> v;
+};
+
+} /* namespace relocation_test */
+
+template <>
+struct tim::traits::is_trivially_relocatable<relocation_test::Counted>: std::true_type {};
+
+static_assert(tim::traits::is_trivially_relocatable_v<int>);
+static_assert(tim::traits::is_trivially_relocatable_v<std::unique_ptr<int>>);
+static_assert(tim::traits::is_trivially_relocatable_v<const std::shared_ptr<int>>);
+static_assert(tim::traits::is_trivially_relocatable_v<tim::Result<void, std::exception_ptr>>);
+static_assert(!tim::traits::is_trivially_relocatable_v<willthrow_move>);
+static_assert(!tim::traits::is_trivially_relocatable_v<tim::Result<int, willthrow_move>>);
+
+TEST_CASE("Swap Relocatable") {
+	using relocation_test::Counted;
+	SECTION("value and error") {
+		tim::Result<Counted, std::unique_ptr<long>> a(tim::in_place, 1);
+		tim::Result<Counted, std::unique_ptr<long>> b(tim::in_place_error, std::make_unique<long>(2));
+		Counted::moves = 0;
+		swap(a, b);
+		REQUIRE(Counted::moves == 0);
+		REQUIRE(!a.has_value());
+		REQUIRE(*a.error() == 2);
+		REQUIRE(b.has_value());
+		REQUIRE(*b->v == 1);
+		a.swap(b);
+		REQUIRE(Counted::moves == 0);
+		REQUIRE(*a->v == 1);
+		REQUIRE(*b.error() == 2);
+		b.swap(a);
+		REQUIRE(Counted::moves == 0);
+		REQUIRE(*b->v == 1);
+		REQUIRE(*a.error() == 2);
+	}
+	SECTION("same alternative") {
+		tim::Result<Counted, std::unique_ptr<long>> a(tim::in_place, 1);
+		tim::Result<Counted, std::unique_ptr<long>> b(tim::in_place, 2);
+		swap(a, b);
+		REQUIRE(*a->v == 2);
+		REQUIRE(*b->v == 1);
+	}
+	SECTION("void") {
+		tim::Result<const void, Counted> a(tim::in_place);
+		tim::Result<const void, Counted> b(tim::in_place_error, 3);
+		Counted::moves = 0;
+		swap(a, b);
+		REQUIRE(Counted::moves == 0);
+		REQUIRE(!a.has_value());
+		REQUIRE(*a.error().v == 3);
+		REQUIRE(b.has_value());
+		b.swap(a);
+		REQUIRE(Counted::moves == 0);
+		REQUIRE(a.has_value());
+		REQUIRE(*b.error().v == 3);
+	}
+}
@@ -0,0 +1,174 @@
+#include "catch.hpp"
+#include "tim/result/task.hpp"
+
+#if TIM_RESULT_HAS_COROUTINES
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+tim::Result<int, std::string> parse(int v) {
+	if(v < 0) {
+		return tim::Error(std::string("negative"));
+	}
+	return v;
+}
+
+tim::Task<int, std::string> leaf(int v) {
+	co_return co_await parse(v);
+}
+
+tim::Task<long, std::string> sum(int a, int b) {
+	int x = co_await leaf(a);
+	int y = co_await leaf(b);
+	co_return static_cast<long>(x) + y;
+}
+
+tim::Task<void, std::string> check(int v) {
+	co_await leaf(v);
+}
+
+tim::Task<int, std::string> throws() {
+	co_await leaf(1);
+	throw std::runtime_error("thrown");
+}
+
+tim::Task<int, std::string> on_pool(tim::ThreadPool& pool, int v) {
+	co_await pool.schedule();
+	co_return co_await leaf(v);
+}
+
+// Keeps rescheduling itself until it is cancelled (or gives up after long
+// enough that a sibling has certainly run).
+tim::Task<int, std::string> spin(tim::ThreadPool& pool, int v, std::atomic<int>& finished) {
+	for(int i = 0; i < 10000000; ++i) {
+		co_await tim::check_cancellation();
+		co_await pool.schedule();
+	}
+	++finished;
+	co_return v;
+}
+
+tim::Task<int, std::string> fail_after(tim::ThreadPool& pool, int yields) {
+	for(int i = 0; i < yields; ++i) {
+		co_await pool.schedule();
+	}
+	co_await tim::Error(std::string("failed"));
+	co_return 0;
+}
+
+tim::Task<std::vector<int>, std::string> gather(std::vector<tim::Task<int, std::string>> tasks) {
+	co_return co_await tim::when_all(std::move(tasks));
+}
+
+} /* namespace */
+
+TEST_CASE("Task", "[task]") {
+	{
+		auto r = tim::sync_wait(sum(1, 2));
+		REQUIRE(r.has_value());
+		REQUIRE(*r == 3);
+	}
+	{
+		auto r = tim::sync_wait(sum(1, -2));
+		REQUIRE(!r.has_value());
+		REQUIRE(r.error() == "negative");
+	}
+	{
+		REQUIRE(tim::sync_wait(check(1)).has_value());
+		REQUIRE(tim::sync_wait(check(-1)).error() == "negative");
+	}
+	{
+		REQUIRE_THROWS_AS(tim::sync_wait(throws()), std::runtime_error);
+	}
+	{
+		// Without a pool, 'when_all' runs the tasks one after another.
+		std::vector<tim::Task<int, std::string>> tasks;
+		for(int i = 0; i < 4; ++i) {
+			tasks.push_back(leaf(i));
+		}
+		auto r = tim::sync_wait(gather(std::move(tasks)));
+		REQUIRE(*r == std::vector<int>{0, 1, 2, 3});
+	}
+}
+
+TEST_CASE("Task Thread Pool", "[task.pool]") {
+	tim::ThreadPool pool(2);
+	REQUIRE(pool.size() == 2u);
+	{
+		REQUIRE(*tim::sync_wait(pool, on_pool(pool, 5)) == 5);
+		REQUIRE(tim::sync_wait(on_pool(pool, -5)).error() == "negative");
+	}
+	{
+		std::vector<tim::Task<int, std::string>> tasks;
+		for(int i = 0; i < 100; ++i) {
+			tasks.push_back(on_pool(pool, i));
+		}
+		auto r = tim::sync_wait(pool, tim::when_all(std::move(tasks)));
+		REQUIRE(r.has_value());
+		REQUIRE(r->size() == 100u);
+		for(int i = 0; i < 100; ++i) {
+			REQUIRE((*r)[static_cast<std::size_t>(i)] == i);
+		}
+	}
+	{
+		std::vector<tim::Task<void, std::string>> tasks;
+		tasks.push_back(check(1));
+		tasks.push_back(check(-1));
+		REQUIRE(tim::sync_wait(pool, tim::when_all(std::move(tasks))).error() == "negative");
+	}
+	{
+		// The first error cancels the tasks that are still running.
+		std::atomic<int> finished{0};
+		std::vector<tim::Task<int, std::string>> tasks;
+		for(int i = 0; i < 8; ++i) {
+			tasks.push_back(spin(pool, i, finished));
+		}
+		tasks.push_back(fail_after(pool, 2));
+		auto r = tim::sync_wait(pool, tim::when_all(std::move(tasks)));
+		REQUIRE(r.error() == "failed");
+		REQUIRE(finished.load() == 0);
+	}
+	{
+		std::atomic<int> finished{0};
+		std::vector<tim::Task<int, std::string>> tasks;
+		tasks.push_back(spin(pool, 1, finished));
+		tasks.push_back(on_pool(pool, -1));
+		tasks.push_back(on_pool(pool, 2));
+		auto r = tim::sync_wait(pool, tim::when_any(std::move(tasks)));
+		REQUIRE(*r == 2);
+		REQUIRE(finished.load() == 0);
+	}
+	{
+		std::vector<tim::Task<int, std::string>> tasks;
+		tasks.push_back(on_pool(pool, -1));
+		tasks.push_back(on_pool(pool, -2));
+		REQUIRE(tim::sync_wait(pool, tim::when_any(std::move(tasks))).error() == "negative");
+	}
+	{
+		// There is nothing to yield from no tasks; the awaiter gets an exception.
+		REQUIRE_THROWS_AS(tim::sync_wait(pool, tim::when_any(std::vector<tim::Task<int, std::string>>())), std::invalid_argument);
+		REQUIRE_THROWS_AS(tim::sync_wait(tim::when_any(std::vector<tim::Task<void, std::string>>())), std::invalid_argument);
+	}
+	{
+		// Cancellation reaches tasks nested inside another 'when_all'.
+		std::atomic<int> finished{0};
+		std::vector<tim::Task<int, std::string>> inner;
+		for(int i = 0; i < 4; ++i) {
+			inner.push_back(spin(pool, i, finished));
+		}
+		std::vector<tim::Task<std::vector<int>, std::string>> outer;
+		outer.push_back(gather(std::move(inner)));
+		std::vector<tim::Task<int, std::string>> failing;
+		failing.push_back(fail_after(pool, 2));
+		outer.push_back(gather(std::move(failing)));
+		auto r = tim::sync_wait(pool, tim::when_all(std::move(outer)));
+		REQUIRE(r.error() == "failed");
+		REQUIRE(finished.load() == 0);
+	}
+}
+
+#endif /* TIM_RESULT_HAS_COROUTINES */
@@ -0,0 +1,115 @@
+#include "catch.hpp"
+#include "tim/result/Result.hpp"
+
+#include <string>
+
+namespace {
+
+struct BigError {
+	static int moves;
+	static int copies;
+
+	explicit BigError(int c): code(c) {}
+	BigError(const BigError& other): code(other.code) { ++copies; }
+	BigError(BigError&& other) noexcept: code(other.code) { ++moves; }
+
+	static void reset() {
+		moves = 0;
+		copies = 0;
+	}
+
+	int code;
+	char payload[512] = {};
+};
+
+int BigError::moves = 0;
+int BigError::copies = 0;
+
+tim::Result<int, BigError> parse(int v) {
+	if(v < 0) {
+		return tim::Result<int, BigError>(tim::in_place_error, v);
+	}
+	return v;
+}
+
+tim::Result<void, BigError> validate(int v) {
+	if(v > 100) {
+		return tim::Result<void, BigError>(tim::in_place_error, v);
+	}
+	return tim::Result<void, BigError>();
+}
+
+tim::Result<long, BigError> twice(int v) {
+	TIM_TRY_ASSIGN(int x, parse(v));
+	TIM_TRY_ASSIGN(x, parse(x * 2));
+	return x;
+}
+
+tim::Result<int, BigError> checked(int v) {
+	int x = 0;
+	TIM_TRY_ASSIGN(x, parse(v));
+	TIM_TRY(validate(x));
+	return x + 1;
+}
+
+struct Wider {
+	Wider(const BigError& e): code(e.code) {}
+	Wider(BigError&& e): code(e.code + 1000) {}
+
+	int code;
+};
+
+tim::Result<int, Wider> convert(const tim::Result<int, BigError>& r) {
+	TIM_TRY_ASSIGN(int x, r);
+	return x;
+}
+
+#if TIM_RESULT_HAS_STATEMENT_EXPRESSIONS
+tim::Result<int, BigError> sum(int a, int b) {
+	return TIM_TRY(parse(a)) + TIM_TRY(parse(b));
+}
+#endif
+
+} /* namespace */
+
+TEST_CASE("Try", "[try]") {
+	{
+		auto r = twice(21);
+		REQUIRE(r.has_value());
+		REQUIRE(*r == 42);
+	}
+	{
+		BigError::reset();
+		auto r = twice(-3);
+		REQUIRE(!r.has_value());
+		REQUIRE(r.error().code == -3);
+		// Moved once, straight from the callee's Result into ours.
+		REQUIRE(BigError::moves == 1);
+		REQUIRE(BigError::copies == 0);
+	}
+	{
+		REQUIRE(*checked(5) == 6);
+		REQUIRE(checked(-1).error().code == -1);
+		BigError::reset();
+		REQUIRE(checked(500).error().code == 500);
+		REQUIRE(BigError::moves == 1);
+	}
+	{
+		tim::Result<int, BigError> r(tim::in_place_error, 7);
+		BigError::reset();
+		auto w = convert(r);
+		REQUIRE(!w.has_value());
+		REQUIRE(w.error().code == 7);
+		REQUIRE(BigError::copies == 0);
+		REQUIRE(r.error().code == 7);
+		REQUIRE(*convert(tim::Result<int, BigError>(9)) == 9);
+	}
+#if TIM_RESULT_HAS_STATEMENT_EXPRESSIONS
+	{
+		REQUIRE(*sum(1, 2) == 3);
+		BigError::reset();
+		REQUIRE(sum(1, -2).error().code == -2);
+		REQUIRE(BigError::moves == 1);
+	}
+#endif
+}